@@ -21,6 +21,8 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <cstring>
+#include <unordered_map>
 
 #include "class.hpp"
 #include "exceptions.hpp"
@@ -34,33 +36,92 @@ ArrayRef Array::make(const Class& classtype_, uint32_t size_) {
 	return Array::make(classtype_, std::vector<uint32_t>{size_});
 }
 ArrayRef Array::make(const Class& classtype_, const std::vector<uint32_t>& dimensions_) {
-	auto u = std::make_unique<Array>(classtype_, dimensions_);
-	auto ptr = u.get();
-	GC::getInstance().track(std::move(u));
-	return ptr;
+	return GC::getInstance().make<Array>(classtype_, dimensions_);
 }
 
+namespace {
+	Array::ElementType elementTypeOf(const Class& classtype_) {
+		static const std::unordered_map<std::string, Array::ElementType> types = {
+		    {"boolean", Array::ElementType::BOOLEAN}, {"byte", Array::ElementType::BYTE}, {"char", Array::ElementType::CHAR},
+		    {"short", Array::ElementType::SHORT},     {"int", Array::ElementType::INT},   {"long", Array::ElementType::LONG},
+		    {"float", Array::ElementType::FLOAT},     {"double", Array::ElementType::DOUBLE}};
+		auto it = types.find(classtype_.getFullname());
+		return it != types.end() ? it->second : Array::ElementType::OBJECT;
+	}
+
+	uint8_t elementSizeOf(Array::ElementType type_) {
+		switch (type_) {
+			case Array::ElementType::BOOLEAN:
+			case Array::ElementType::BYTE:
+				return sizeof(int8_t);
+			case Array::ElementType::CHAR:
+			case Array::ElementType::SHORT:
+				return sizeof(int16_t);
+			case Array::ElementType::INT:
+			case Array::ElementType::FLOAT:
+				return sizeof(int32_t);
+			case Array::ElementType::LONG:
+			case Array::ElementType::DOUBLE:
+				return sizeof(int64_t);
+			default:
+				return sizeof(ObjectRef);
+		}
+	}
+
+	template <typename T>
+	T loadRaw(const uint8_t* data_) {
+		T value;
+		std::memcpy(&value, data_, sizeof(T));
+		return value;
+	}
+
+	template <typename T>
+	void storeRaw(uint8_t* data_, T value_) {
+		std::memcpy(data_, &value_, sizeof(T));
+	}
+
+	bool isAssignable(const Class& from_, const Class& to_) {
+		for (const Class* cur = &from_;; cur = &cur->getSuperClass()) {
+			if (cur->getFullname() == to_.getFullname() || cur->implements(to_)) {
+				return true;
+			}
+			if (!cur->hasSuperClass()) {
+				return false;
+			}
+		}
+	}
+}  // namespace
+
 Array::Array(const Class& classtype_, const std::vector<uint32_t>& dimensions_)
-    : Object(), _classtype(classtype_), _dimensions(dimensions_), _offset(0), _length(0) {
-	uint32_t totalSize = 1;
-	for (auto d : _dimensions) {
-		totalSize *= d;
+    : Object(),
+      _classtype(classtype_),
+      _dimensions(dimensions_),
+      _elementType(_dimensions.size() == 1 ? elementTypeOf(classtype_) : ElementType::OBJECT),
+      _elementSize(elementSizeOf(_elementType)),
+      _rawAccess(_elementType != ElementType::OBJECT),
+      _length(_dimensions.at(0)) {
+	// primitive storage is zero initialized, reference storage starts with null references
+	_data = std::make_shared<ArrayStorage>(_length * _elementSize);
+	if (_elementType == ElementType::OBJECT) {
+		auto null = Object::makeNull();
+		for (size_t i = 0; i < _length; ++i) {
+			storeRaw(_data->data() + i * sizeof(ObjectRef), null);
+		}
+		// as in java, the rows of a multi-dimensional array are arrays of their own held by reference
+		if (_dimensions.size() > 1) {
+			const std::vector<uint32_t> rowDimensions(_dimensions.begin() + 1, _dimensions.end());
+			for (size_t i = 0; i < _length; ++i) {
+				store(i, Array::make(_classtype, rowDimensions));
+			}
+		}
 	}
-	_length = totalSize;
-	_data = std::make_shared<ObjectRefVector>();
-	_data->resize(totalSize);
-	std::generate(_data->begin(), _data->end(), []() { return Object::makeNull(); });
+	_externalSize = _data->size();
+	GC::getInstance().getHeap().addExternalBytes(static_cast<int64_t>(_externalSize));
 }
 
-Array::Array(std::shared_ptr<ObjectRefVector> data_, const Class& classtype_, const std::vector<uint32_t>& dimensions_, size_t offset_)
-    : Object(), _classtype(classtype_), _dimensions(dimensions_), _data(data_), _offset(offset_) {
-	uint32_t totalSize = 1;
-	for (auto d : _dimensions) {
-		totalSize *= d;
-	}
-	_length = totalSize;
-	if (_offset + _length > _data->size()) {
-		throw std::out_of_range("Subarray out of range");
+Array::~Array() {
+	if (_externalSize) {
+		GC::getInstance().getHeap().addExternalBytes(-static_cast<int64_t>(_externalSize));
 	}
 }
 
@@ -118,53 +179,94 @@ uint32_t Array::getArrayLength() const {
 }
 
 void Array::setElement(uint32_t idx_, ObjectRef value_) {
-	if (_dimensions.size() != 1) {
-		throw std::invalid_argument("Use multi-dimensional setElement for arrays with more than one dimension");
-	}
 	if (idx_ >= getArrayLength()) {
 		throw std::out_of_range("Array index out of bounds");
 	}
-	(*_data)[_offset + idx_] = value_;
+	store(idx_, value_);
 }
 
 ObjectRef Array::getElement(uint32_t idx_) const {
-	if (_dimensions.size() != 1) {
-		return getArray(idx_);
-	}
 	if (idx_ >= getArrayLength()) {
 		throw std::out_of_range("Array index out of bounds");
 	}
-	return (*_data)[_offset + idx_];
+	return load(idx_);
 }
 
 void Array::setElement(const std::vector<uint32_t>& indices_, ObjectRef value_) {
-	uint32_t idx = flattenIndex(indices_);
-	if (idx >= _data->size()) {
-		throw std::out_of_range("Array index out of bounds");
-	}
-	(*_data)[idx] = value_;
+	getRow(indices_)->setElement(indices_.back(), value_);
 }
 
 ObjectRef Array::getElement(const std::vector<uint32_t>& indices_) const {
-	uint32_t idx = flattenIndex(indices_);
-	if (idx >= _data->size()) {
-		throw std::out_of_range("Array index out of bounds");
+	return getRow(indices_)->getElement(indices_.back());
+}
+
+ObjectRef Array::load(size_t idx_) const {
+	const uint8_t* data = _data->data() + idx_ * _elementSize;
+	switch (_elementType) {
+		case ElementType::OBJECT:
+			return loadRaw<ObjectRef>(data);
+		case ElementType::BOOLEAN:
+			return Object::make(static_cast<uint64_t>(loadRaw<uint8_t>(data) != 0));
+		case ElementType::BYTE:
+			return Object::make(static_cast<uint64_t>(loadRaw<int8_t>(data)));
+		case ElementType::CHAR:
+			return Object::make(static_cast<uint64_t>(loadRaw<uint16_t>(data)));
+		case ElementType::SHORT:
+			return Object::make(static_cast<uint64_t>(loadRaw<int16_t>(data)));
+		case ElementType::INT:
+		case ElementType::FLOAT:
+			return Object::make(static_cast<uint64_t>(loadRaw<int32_t>(data)));
+		case ElementType::LONG:
+		case ElementType::DOUBLE:
+			return Object::make(loadRaw<uint64_t>(data));
+	}
+	throw VmException("Unknown array element type");
+}
+
+void Array::store(size_t idx_, ObjectRef value_) {
+	uint8_t* data = _data->data() + idx_ * _elementSize;
+	if (_elementType == ElementType::OBJECT) {
+		GC::writeBarrier(value_);
+		storeRaw(data, value_);
+		return;
+	}
+	int64_t value = value_->isNumberObject() ? value_->getLongValue() : 0;
+	switch (_elementSize) {
+		case sizeof(int8_t):
+			storeRaw(data, static_cast<int8_t>(_elementType == ElementType::BOOLEAN ? value != 0 : value));
+			break;
+		case sizeof(int16_t):
+			storeRaw(data, static_cast<int16_t>(value));
+			break;
+		case sizeof(int32_t):
+			storeRaw(data, static_cast<int32_t>(value));
+			break;
+		default:
+			storeRaw(data, value);
+			break;
 	}
-	return (*_data)[idx];
 }
 
-uint32_t Array::flattenIndex(const std::vector<uint32_t>& indices_) const {
+int64_t Array::getNumber(uint32_t idx_) const {
+	auto element = getElement(idx_);
+	if (element->isNull()) {
+		return 0;
+	}
+	if (!element->isNumberObject()) {
+		throw VmException("Array element is not a number");
+	}
+	return element->getLongValue();
+}
+
+ArrayRef Array::getRow(const std::vector<uint32_t>& indices_) const {
 	if (indices_.size() != _dimensions.size()) {
 		throw std::invalid_argument("Incorrect number of indices for Array");
 	}
-	uint32_t idx = 0;
-	for (size_t i = 0; i < _dimensions.size(); ++i) {
-		if (indices_[i] >= _dimensions[i]) {
-			throw std::out_of_range("Array index out of bounds");
-		}
-		idx = idx * _dimensions[i] + indices_[i];
+	auto row = const_cast<ArrayRef>(this);
+	for (size_t i = 0; i + 1 < indices_.size(); ++i) {
+		row = row->getArray(indices_[i]);
 	}
-	return idx;
+	return row;
 }
 
 ArrayRef Array::getArray(uint32_t idx_) const {
@@ -176,32 +278,87 @@ ArrayRef Array::getArray(uint32_t idx_) const {
 	if (idx_ >= _dimensions[0]) {
 		throw std::out_of_range("Array index out of bounds");
 	}
-	// Calculate the size of the sub-array
-	uint32_t subArraySize = 1;
-	for (size_t i = 1; i < _dimensions.size(); ++i) {
-		subArraySize *= _dimensions[i];
+	auto row = load(idx_);
+	if (row->isNull()) {
+		throw NullPointerException(fmt::format("{}: row {} is null", toString(), idx_));
 	}
-	// Calculate the starting index of the sub-array in the flattened data
-	uint32_t startIdx = idx_ * subArraySize;
-	// Create a sub-array that references the original data
-	auto subArray = std::make_unique<Array>(_data, _classtype, std::vector<uint32_t>(_dimensions.begin() + 1, _dimensions.end()), _offset + startIdx);
-	auto ptr = subArray.get();
-	GC::getInstance().track(std::move(subArray));
-	return ptr;
+	return static_cast<ArrayRef>(row);
+}
+
+void Array::copy(const Array& src_, int32_t srcPos_, Array& dst_, int32_t dstPos_, int32_t length_) {
+	// any reference, rows included, can be stored in an Object[]
+	const bool toObjects = src_._elementType == ElementType::OBJECT && dst_._dimensions.size() == 1 &&
+	                       dst_._classtype.getFullname() == "java.lang.Object";
+	// rows are held by reference, only the component type matters, not the length of the rows
+	if (!toObjects && (src_._elementType != dst_._elementType || src_._dimensions.size() != dst_._dimensions.size() ||
+	                   elementTypeOf(src_._classtype) != elementTypeOf(dst_._classtype))) {
+		throw ArrayStoreException(fmt::format("arraycopy: cannot copy {} into {}", src_.toString(), dst_.toString()));
+	}
+	if (srcPos_ < 0 || dstPos_ < 0 || length_ < 0 || static_cast<uint64_t>(srcPos_) + length_ > src_.getArrayLength() ||
+	    static_cast<uint64_t>(dstPos_) + length_ > dst_.getArrayLength()) {
+		throw ArrayIndexOutOfBoundsException(fmt::format("arraycopy: range [{}, {}) -> [{}, {}) out of bounds for lengths {} and {}", srcPos_,
+		                                                 srcPos_ + length_, dstPos_, dstPos_ + length_, src_.getArrayLength(), dst_.getArrayLength()));
+	}
+	if (length_ == 0) {
+		return;
+	}
+	size_t count = length_;
+	const uint8_t* from = src_.getRawData() + srcPos_ * src_._elementSize;
+	uint8_t* to = dst_.getRawData() + dstPos_ * dst_._elementSize;
+	if (src_._elementType == ElementType::OBJECT) {
+		const auto& dstType = dst_._classtype;
+		if (src_._classtype.getFullname() != dstType.getFullname() && dstType.getFullname() != "java.lang.Object") {
+			// a row is storable when its own component type is assignable to the one of the destination rows
+			auto isStorable = [&dst_, &dstType](ObjectRef element_) {
+				if (element_->isNull()) {
+					return true;
+				}
+				if (dst_.getDimensions() == 1) {
+					return dstType.isInstanceOf(element_);
+				}
+				auto row = static_cast<ArrayRef>(element_);
+				return row->getDimensions() + 1 == dst_.getDimensions() && isAssignable(row->getClassType(), dstType);
+			};
+			// different component types never share storage, copy forward and stop at the first incompatible element
+			for (size_t i = 0; i < count; ++i) {
+				auto element = loadRaw<ObjectRef>(from + i * sizeof(ObjectRef));
+				if (!isStorable(element)) {
+					throw ArrayStoreException(fmt::format("arraycopy: {} cannot be stored in {}", element->toString(), dst_.toString()));
+				}
+				GC::writeBarrier(element);
+				storeRaw(to + i * sizeof(ObjectRef), element);
+			}
+			return;
+		}
+		if (GC::isMarking()) [[unlikely]] {
+			for (size_t i = 0; i < count; ++i) {
+				GC::writeBarrier(loadRaw<ObjectRef>(from + i * sizeof(ObjectRef)));
+			}
+		}
+	}
+	std::memmove(to, from, count * src_._elementSize);
 }
 
 ObjectRef Array::clone() const {
 	auto newArray = Array::make(_classtype, _dimensions);
-	for (uint32_t i = 0; i < _length; ++i) {
-		(*newArray->_data)[i] = (*_data)[_offset + i];
+	if (_elementType == ElementType::OBJECT) {
+		for (size_t i = 0; i < _length; ++i) {
+			GC::writeBarrier(load(i));
+		}
 	}
+	// a multi-dimensional array is cloned shallow, the clone shares the rows
+	std::memcpy(newArray->_data->data(), getRawData(), _length * _elementSize);
 	return newArray;
 }
 
 void Array::visitReferences(const std::function<void(Object*)>& visitor_) const {
 	Object::visitReferences(visitor_);
+	// primitive storage holds no references, the GC does not need to scan it
+	if (_elementType != ElementType::OBJECT) {
+		return;
+	}
 	for (size_t i = 0; i < _length; ++i) {
-		Object* obj = (*_data)[_offset + i];
+		Object* obj = load(i);
 		if (obj != nullptr) {
 			visitor_(obj);
 		}
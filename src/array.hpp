@@ -19,6 +19,8 @@
 #ifndef __ARRAY_HPP__
 #define __ARRAY_HPP__
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,6 +30,8 @@
 namespace sandvik {
 	/** @brief Vector of Object references */
 	using ObjectRefVector = std::vector<ObjectRef>;
+	/** @brief Raw element storage of an array, shared with its subarray views */
+	using ArrayStorage = std::vector<uint8_t>;
 	/** @brief Array reference type */
 	using ArrayRef = Array*;
 	/**
@@ -37,9 +41,16 @@ namespace sandvik {
 	 * The Array class provides an interface for array objects that can store elements, support type checking,
 	 * and represent various array types such as one-dimensional and multi-dimensional arrays. Copy and move operations
 	 * are explicitly disabled to ensure unique object identity.
+	 *
+	 * Elements are stored unboxed in a buffer typed by the element class: one byte per boolean/byte, two per char/short,
+	 * four per int/float, eight per long/double and one ObjectRef per reference. Only reference arrays are traced by the GC.
+	 * A multi-dimensional array stores one reference per row, each row being an array of one dimension less.
 	 */
 	class Array : public Object {
 		public:
+			/** @brief Type of the elements held in the array storage */
+			enum class ElementType : uint8_t { OBJECT, BOOLEAN, BYTE, CHAR, SHORT, INT, LONG, FLOAT, DOUBLE };
+
 			/** @brief Creates a new array object.
 			 * @param classtype_ Reference to the Class type of the array
 			 * @param size_ Size of the array
@@ -57,15 +68,7 @@ namespace sandvik {
 			 * @param dimensions_ Vector of dimensions for the array
 			 */
 			explicit Array(const Class& classtype_, const std::vector<uint32_t>& dimensions_);
-
-			/** @brief Constructor for subarray view
-			 * @param data_ Shared pointer to the data vector
-			 * @param classtype_ Reference to the Class type of the array
-			 * @param dimensions_ Vector of dimensions for the array
-			 * @param offset_ Offset for the subarray
-			 */
-			Array(std::shared_ptr<ObjectRefVector> data_, const Class& classtype_, const std::vector<uint32_t>& dimensions_, size_t offset_);
-			~Array() override = default;
+			~Array() override;
 
 			/** @brief Returns a string representation of the array. */
 			std::string toString() const override;
@@ -78,9 +81,10 @@ namespace sandvik {
 			 * @return true if the object is an array, false otherwise.
 			 */
 			bool isArray() const override;
-			/** @brief Gets the array at the specified index.
-			 * @param idx_ Index of the array.
-			 * @return Shared pointer to the Array at the specified index.
+			/** @brief Gets the row at the specified index of a multi-dimensional array.
+			 * @param idx_ Index of the row.
+			 * @return The row, shared with every array holding a reference to it.
+			 * @throws NullPointerException if the row is null
 			 */
 			ArrayRef getArray(uint32_t idx_) const;
 			/**
@@ -108,6 +112,60 @@ namespace sandvik {
 			 */
 			uint32_t getArrayLength() const override;
 
+			/** @brief Gets the type of the elements stored in the array.
+			 * @return Element type, OBJECT for reference and multi-dimensional arrays.
+			 */
+			ElementType getElementType() const {
+				return _elementType;
+			}
+			/** @brief Checks if the array stores primitive values.
+			 * @return true if the elements are primitive values, false for reference arrays.
+			 */
+			bool isPrimitiveArray() const {
+				return _elementType != ElementType::OBJECT;
+			}
+			/** @brief Gets the size of one element in the storage.
+			 * @return Element size in bytes.
+			 */
+			size_t getElementSize() const {
+				return _elementSize;
+			}
+			/** @brief Gets the raw element storage of the array.
+			 * @return Pointer to the first element.
+			 */
+			uint8_t* getRawData() const {
+				return _data->data();
+			}
+			/** @brief Gets a primitive element without boxing.
+			 * Falls back to getElement() when the storage does not hold elements of type T.
+			 * @tparam T Value type of the accessing instruction (int32_t for aget, int64_t for aget-wide, ...)
+			 * @param idx_ Index of the element, bounds are checked by the caller.
+			 * @return Value of the element.
+			 */
+			template <typename T>
+			T getPrimitive(uint32_t idx_) const {
+				if (_rawAccess && _elementSize == sizeof(T)) [[likely]] {
+					T value;
+					std::memcpy(&value, getRawData() + idx_ * sizeof(T), sizeof(T));
+					return value;
+				}
+				return static_cast<T>(getNumber(idx_));
+			}
+			/** @brief Sets a primitive element without boxing.
+			 * Falls back to setElement() when the storage does not hold elements of type T.
+			 * @tparam T Value type of the accessing instruction (int32_t for aput, int64_t for aput-wide, ...)
+			 * @param idx_ Index of the element, bounds are checked by the caller.
+			 * @param value_ Value to store.
+			 */
+			template <typename T>
+			void setPrimitive(uint32_t idx_, T value_) {
+				if (_rawAccess && _elementSize == sizeof(T)) [[likely]] {
+					std::memcpy(getRawData() + idx_ * sizeof(T), &value_, sizeof(T));
+					return;
+				}
+				setElement(idx_, Object::make(static_cast<uint64_t>(value_)));
+			}
+
 			/** @brief Sets the element at the specified index.
 			 * @param idx_ Index of the element.
 			 * @param value_ ObjectRef to set at the specified index.
@@ -130,6 +188,19 @@ namespace sandvik {
 			 */
 			ObjectRef getElement(const std::vector<uint32_t>& indices_) const;
 
+			/** @brief Copies a range of elements between two arrays (java.lang.System.arraycopy).
+			 * Bounds are checked once, then the range is moved with a single memmove over the storage, overlapping ranges
+			 * included. References are store checked one by one only when the component types differ.
+			 * @param src_ Source array.
+			 * @param srcPos_ Index of the first source element.
+			 * @param dst_ Destination array.
+			 * @param dstPos_ Index of the first destination element.
+			 * @param length_ Number of elements to copy.
+			 * @throws ArrayIndexOutOfBoundsException if the range does not fit in src_ or dst_
+			 * @throws ArrayStoreException if the element types are not compatible
+			 */
+			static void copy(const Array& src_, int32_t srcPos_, Array& dst_, int32_t dstPos_, int32_t length_);
+
 			/** @brief Clones the array.
 			 * @return Shared pointer to the cloned Array.
 			 */
@@ -141,14 +212,26 @@ namespace sandvik {
 			void visitReferences(const std::function<void(Object*)>& visitor_) const override;
 
 		private:
-			uint32_t flattenIndex(const std::vector<uint32_t>& indices_) const;
+			/** Row holding the element at the multi-dimensional indices */
+			ArrayRef getRow(const std::vector<uint32_t>& indices_) const;
+			/** Box the element at the flattened storage index */
+			ObjectRef load(size_t idx_) const;
+			/** Unbox and store a value at the flattened storage index */
+			void store(size_t idx_, ObjectRef value_);
+			/** Numeric value of an element of a one-dimensional array, null references read as 0 */
+			int64_t getNumber(uint32_t idx_) const;
 
 			const Class& _classtype;
 			std::vector<uint32_t> _dimensions;
-			std::shared_ptr<ObjectRefVector> _data;
+			std::shared_ptr<ArrayStorage> _data;
+			ElementType _elementType;
+			uint8_t _elementSize;
+			/** one-dimensional primitive array, elements can be accessed raw */
+			bool _rawAccess;
 
-			size_t _offset;
 			size_t _length;
+			/** size of the element storage accounted in the heap */
+			size_t _externalSize = 0;
 	};
 }  // namespace sandvik
 
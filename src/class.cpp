@@ -38,6 +38,24 @@
 
 using namespace sandvik;
 
+namespace {
+	/** slot of a method in a table, the size of the table if it is not there */
+	size_t findSlot(const std::vector<Method*>& table_, std::string_view name_, std::string_view descriptor_) {
+		for (size_t i = 0; i < table_.size(); ++i) {
+			const auto* method = table_[i];
+			if (method && method->getName() == name_ && method->getSignature() == descriptor_) {
+				return i;
+			}
+		}
+		return table_.size();
+	}
+
+	Method* findInTable(const std::vector<Method*>& table_, std::string_view name_, std::string_view descriptor_) {
+		const auto slot = findSlot(table_, name_, descriptor_);
+		return slot < table_.size() ? table_[slot] : nullptr;
+	}
+}  // namespace
+
 Class::Class(ClassLoader& classloader_, const std::string& packagename_, const std::string& fullname_)
     : _classloader(classloader_),
       _packagename(packagename_),
@@ -90,34 +108,52 @@ Class::Class(ClassLoader& classloader_, const uint32_t dexIdx_, const LIEF::DEX:
 Class::~Class() {
 }
 
-bool Class::isStaticInitialized() {
-	if (_isStaticInitialized) {
-		return true;
-	}
-	// Check if the class has a static initializer
-	for (const auto& [name, method] : _methods) {
-		if (method->isStatic() && method->getName() == "<clinit>") {
-			return _isStaticInitialized;
-		}
+void Class::setStaticInitialized() {
+	std::lock_guard lock(_initMutex);
+	_initState.store(InitState::INITIALIZED, std::memory_order_release);
+	_initCv.notify_all();
+}
+
+Class::InitState Class::getInitState() const {
+	return _initState.load(std::memory_order_acquire);
+}
+
+bool Class::beginInitialization() {
+	std::unique_lock lock(_initMutex);
+	const auto self = std::this_thread::get_id();
+	// wait for the initialization running on another thread
+	_initCv.wait(lock, [&]() { return _initState.load(std::memory_order_relaxed) != InitState::IN_PROGRESS || _initOwner == self; });
+	switch (_initState.load(std::memory_order_relaxed)) {
+		case InitState::INITIALIZED:
+		case InitState::IN_PROGRESS:
+			// recursive request of the initializing thread
+			return false;
+		case InitState::ERRONEOUS:
+			throw NoClassDefFoundError(fmt::format("Could not initialize class {}", _fullname));
+		case InitState::UNINITIALIZED:
+			break;
 	}
-	// no static initializer found, mark as initialized
-	_isStaticInitialized = true;
-	return _isStaticInitialized;
+	_initState.store(InitState::IN_PROGRESS, std::memory_order_relaxed);
+	_initOwner = self;
+	return true;
 }
 
-void Class::setStaticInitialized() {
-	_isStaticInitialized = true;
+void Class::endInitialization(bool success_) {
+	std::lock_guard lock(_initMutex);
+	_initOwner = std::thread::id();
+	_initState.store(success_ ? InitState::INITIALIZED : InitState::ERRONEOUS, std::memory_order_release);
+	_initCv.notify_all();
 }
 
 uint32_t Class::getDexIdx() const {
 	return _dexIdx;
 }
 
-std::string Class::getName() const {
+const std::string& Class::getName() const {
 	return _name;
 }
 
-std::string Class::getFullname() const {
+const std::string& Class::getFullname() const {
 	return _fullname;
 }
 
@@ -215,12 +251,21 @@ bool Class::isMethodOverloaded(const std::string& name_) const {
 }
 
 Method& Class::getMethod(const std::string& name_, const std::string& descriptor_) {
-	auto sig = name_ + descriptor_;
+	if (auto* method = findMethod(name_, descriptor_)) {
+		return *method;
+	}
+	throw VmException("Method not found: {} {}", name_, descriptor_);
+}
+
+Method* Class::findMethod(std::string_view name_, std::string_view descriptor_) const {
+	std::string sig;
+	sig.reserve(name_.size() + descriptor_.size());
+	sig.append(name_).append(descriptor_);
 	auto it = _methods.find(sig);
 	if (it != _methods.end()) {
-		return *(it->second);
+		return it->second.get();
 	}
-	throw VmException("Method not found: {} {}", name_, descriptor_);
+	return nullptr;
 }
 
 Method& Class::getMethod(uint32_t idx_) {
@@ -269,6 +314,178 @@ std::vector<std::string> Class::getFieldList() const {
 	return fieldList;
 }
 
+void Class::link() {
+	if (_isLinked.load(std::memory_order_acquire)) {
+		return;
+	}
+	std::lock_guard lock(_linkMutex);
+	if (_isLinked.load(std::memory_order_relaxed) || _isLinking) {
+		// linked meanwhile by another thread, or recursive request of the linking thread
+		return;
+	}
+	_isLinking = true;
+	try {
+		buildTables();
+	} catch (...) {
+		// left unlinked, the next call retries
+		_instanceFields.clear();
+		_referenceSlots.clear();
+		_vtable.clear();
+		_itable.clear();
+		_isLinking = false;
+		throw;
+	}
+	_isLinking = false;
+	_isLinked.store(true, std::memory_order_release);
+}
+
+void Class::buildTables() {
+	if (hasSuperClass()) {
+		auto& super = getSuperClass();
+		super.link();
+		_instanceFields = super._instanceFields;
+		_referenceSlots = super._referenceSlots;
+		if (!_isInterface) {
+			_vtable = super._vtable;
+			_itable = super._itable;
+		}
+	}
+	for (auto& [name, field] : _fields) {
+		if (field->isStatic()) {
+			continue;
+		}
+		field->_slot = static_cast<uint32_t>(_instanceFields.size());
+		if (field->isReference()) {
+			_referenceSlots.push_back(field->_slot);
+		}
+		_instanceFields.push_back(field.get());
+	}
+	for (auto& [key, method] : _methods) {
+		if (!method->isVirtual()) {
+			continue;
+		}
+		// an override takes the slot of the overridden method, interfaces only number their own methods
+		// the slot is looked up by position: an inherited interface method keeps the index of its interface
+		const auto index = static_cast<uint32_t>(findSlot(_vtable, method->getName(), method->getSignature()));
+		if (index < _vtable.size()) {
+			_vtable[index] = method.get();
+		} else {
+			_vtable.push_back(method.get());
+		}
+		method->_vtableIndex = index;
+	}
+	if (!_isInterface) {
+		// inherited itable entries may be overridden by this class
+		for (auto& [interface, methods] : _itable) {
+			for (size_t i = 0; i < methods.size(); ++i) {
+				const auto* method = interface->_vtable[i];
+				auto* impl = findInTable(_vtable, method->getName(), method->getSignature());
+				if (impl != nullptr && !impl->getClass().isInterface()) {
+					methods[i] = impl;
+				}
+			}
+		}
+		for (const auto& name : _interfaces) {
+			try {
+				linkInterface(_classloader.getOrLoad(name));
+			} catch (const std::exception& e) {
+				LOG_DEBUG("Class {}: interface {} not linked ({})", _fullname, name, e.what());
+			}
+		}
+		// default and miranda methods: interface methods the class does not implement get a vtable slot, so that
+		// virtual calls through the class find them. They keep their interface index and dispatch through the itable.
+		for (const auto& [interface, methods] : _itable) {
+			for (auto* method : interface->_vtable) {
+				if (findInTable(_vtable, method->getName(), method->getSignature()) == nullptr) {
+					_vtable.push_back(method);
+				}
+			}
+		}
+	}
+	LOG_DEBUG("Class {} linked: {} instance fields, {} virtual methods, {} interfaces", _fullname, _instanceFields.size(), _vtable.size(),
+	          _itable.size());
+}
+
+void Class::linkInterface(Class& interface_) {
+	for (const auto& [interface, methods] : _itable) {
+		if (interface == &interface_) {
+			return;
+		}
+	}
+	interface_.link();
+	std::vector<Method*> methods;
+	methods.reserve(interface_._vtable.size());
+	for (auto* method : interface_._vtable) {
+		auto* impl = findInTable(_vtable, method->getName(), method->getSignature());
+		if (impl == nullptr || impl->getClass().isInterface()) {
+			// default method, the class or its superclass only holds the miranda slot of an interface method
+			impl = method->isAbstract() ? nullptr : method;
+		}
+		methods.push_back(impl);
+	}
+	_itable.emplace_back(&interface_, std::move(methods));
+	for (const auto& name : interface_._interfaces) {
+		try {
+			linkInterface(_classloader.getOrLoad(name));
+		} catch (const std::exception& e) {
+			LOG_DEBUG("Class {}: interface {} not linked ({})", _fullname, name, e.what());
+		}
+	}
+}
+
+uint32_t Class::getInstanceFieldCount() {
+	link();
+	return static_cast<uint32_t>(_instanceFields.size());
+}
+
+const std::vector<uint32_t>& Class::getReferenceSlots() {
+	link();
+	return _referenceSlots;
+}
+
+const Field* Class::findInstanceField(std::string_view name_) {
+	link();
+	// most derived fields come last, search backward so they shadow inherited ones
+	for (auto it = _instanceFields.rbegin(); it != _instanceFields.rend(); ++it) {
+		if ((*it)->getName() == name_) {
+			return *it;
+		}
+	}
+	return nullptr;
+}
+
+Method* Class::findVirtualMethod(std::string_view name_, std::string_view descriptor_) {
+	link();
+	return findInTable(_vtable, name_, descriptor_);
+}
+
+Method* Class::findInterfaceMethod(std::string_view name_, std::string_view descriptor_) {
+	link();
+	if (auto* method = findInTable(_vtable, name_, descriptor_)) {
+		return method;
+	}
+	for (const auto& name : _interfaces) {
+		try {
+			if (auto* method = _classloader.getOrLoad(name).findInterfaceMethod(name_, descriptor_)) {
+				return method;
+			}
+		} catch (const std::exception&) {
+			// super interface not available
+		}
+	}
+	return nullptr;
+}
+
+Method* Class::getInterfaceMethod(const Class& interface_, uint32_t index_) {
+	link();
+	for (const auto& [interface, methods] : _itable) {
+		if (interface == &interface_) {
+			return index_ < methods.size() ? methods[index_] : nullptr;
+		}
+	}
+	return nullptr;
+}
+
 Class& Class::getSuperClass() const {
 	if (hasSuperClass()) {
 		return _classloader.getOrLoad(_superClassname);
@@ -296,7 +513,7 @@ bool Class::isExternal() const {
 }
 
 void Class::debug() const {
-	logger.fdebug("Class: {}", getFullname());
+	LOG_DEBUG("Class: {}", getFullname());
 }
 
 void Class::monitorEnter() {
@@ -311,10 +528,25 @@ void Class::monitorCheck() const {
 	_monitor->check();
 }
 
+ObjectRef Class::getClassObject() {
+	auto* obj = _classObject.load(std::memory_order_acquire);
+	if (obj == nullptr) [[unlikely]] {
+		// racing threads may both create one, the first published is kept and the other is garbage
+		auto* created = Object::make(*this);
+		if (_classObject.compare_exchange_strong(obj, created, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			obj = created;
+		}
+	}
+	return obj;
+}
+
 void Class::visitReferences(const std::function<void(Object*)>& visitor_) const {
 	for (const auto& [name, field] : _fields) {
 		if (field->isStatic()) {
 			field->visitReferences(visitor_);
 		}
 	}
+	if (auto* obj = _classObject.load(std::memory_order_acquire)) {
+		visitor_(obj);
+	}
 }
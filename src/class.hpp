@@ -19,9 +19,14 @@
 #ifndef __CLASS_HPP__
 #define __CLASS_HPP__
 
+#include <atomic>
+#include <condition_variable>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #include "object.hpp"
@@ -56,12 +61,32 @@ namespace sandvik {
 			/** @brief Prints debug information about the class. */
 			void debug() const;
 
-			/** @brief Checks if the class is statically initialized.
+			/** @brief Class initialization states (JLS 12.4.2) */
+			enum class InitState : uint8_t { UNINITIALIZED, IN_PROGRESS, INITIALIZED, ERRONEOUS };
+
+			/** @brief Checks if the class is statically initialized, fast check done before static accesses.
 			 * @return true if the class is statically initialized, false otherwise.
 			 */
-			bool isStaticInitialized();
-			/** @brief Sets the class as statically initialized. */
+			inline bool isStaticInitialized() const {
+				return _initState.load(std::memory_order_acquire) == InitState::INITIALIZED;
+			}
+			/** @brief Sets the class as statically initialized without running its initializer. */
 			void setStaticInitialized();
+			/** @brief Gets the initialization state of the class.
+			 * @return Initialization state.
+			 */
+			InitState getInitState() const;
+			/** @brief Takes the initialization of the class for the current thread.
+			 * Blocks while another thread initializes the class.
+			 * @return true if the caller must run the initializer then call endInitialization(), false if the class is
+			 * initialized or being initialized by the current thread (recursive request).
+			 * @throw NoClassDefFoundError if a previous initialization of the class failed
+			 */
+			bool beginInitialization();
+			/** @brief Publishes the result of the initialization started by beginInitialization() and wakes up waiting threads.
+			 * @param success_ true if the initializer completed normally, the class becomes erroneous otherwise
+			 */
+			void endInitialization(bool success_);
 
 			/** @brief Gets the DEX index of the class.
 			 * @return DEX index.
@@ -70,11 +95,11 @@ namespace sandvik {
 			/** @brief Gets the class name.
 			 * @return Class name.
 			 */
-			std::string getName() const;
+			const std::string& getName() const;
 			/** @brief Gets the full name of the class.
 			 * @return Full name of the class.
 			 */
-			std::string getFullname() const;
+			const std::string& getFullname() const;
 
 			/** @brief Checks if a class method is overloaded.
 			 * @param name_ Name of the method.
@@ -98,6 +123,12 @@ namespace sandvik {
 			 * @return Reference to the Method object.
 			 */
 			Method& getMethod(const std::string& name_, const std::string& descriptor_);
+			/** @brief Finds a method declared by this class.
+			 * @param name_ Name of the method.
+			 * @param descriptor_ Descriptor of the method.
+			 * @return Pointer to the Method, nullptr if not found.
+			 */
+			Method* findMethod(std::string_view name_, std::string_view descriptor_) const;
 			/** @brief Gets a class method by index.
 			 * @param idx_ Index of the method.
 			 * @return Reference to the Method object.
@@ -129,6 +160,58 @@ namespace sandvik {
 			 */
 			std::vector<std::string> getFieldList() const;
 
+			/** @brief Links the class instance layout and method tables.
+			 *
+			 * Assigns a fixed slot to every instance field, inherited fields first, so objects can store their fields
+			 * in a contiguous slot array. Builds the vtable (overrides keep the index of the overridden method) and
+			 * the itable mapping every implemented interface method to its implementation.
+			 * Super classes are linked first. Calling it again has no effect.
+			 * Thread safe: concurrent callers wait for the tables to be complete, a failed link leaves the class unlinked.
+			 */
+			void link();
+			/** @brief Gets the number of instance field slots (inherited fields included).
+			 * @return Number of slots of an instance of this class.
+			 */
+			uint32_t getInstanceFieldCount();
+			/** @brief Gets the slots holding a reference (inherited fields included).
+			 * @return Vector of slot indexes.
+			 */
+			const std::vector<uint32_t>& getReferenceSlots();
+			/** @brief Finds an instance field by name, searching from this class up to its super classes.
+			 * @param name_ Name of the field.
+			 * @return Pointer to the Field, nullptr if not found.
+			 */
+			const Field* findInstanceField(std::string_view name_);
+
+			/** @brief Finds a virtual method in the vtable, inherited methods included.
+			 * @param name_ Name of the method.
+			 * @param descriptor_ Descriptor of the method.
+			 * @return Pointer to the Method, nullptr if not found.
+			 */
+			Method* findVirtualMethod(std::string_view name_, std::string_view descriptor_);
+			/** @brief Finds a method of an interface, searching its super interfaces too.
+			 * @param name_ Name of the method.
+			 * @param descriptor_ Descriptor of the method.
+			 * @return Pointer to the Method, nullptr if not found.
+			 */
+			Method* findInterfaceMethod(std::string_view name_, std::string_view descriptor_);
+			/** @brief Gets the implementation of a vtable entry.
+			 * @param index_ vtable index (see Method::getVtableIndex).
+			 * @return Pointer to the Method, nullptr if the index is out of the vtable.
+			 */
+			inline Method* getVirtualMethod(uint32_t index_) {
+				if (!_isLinked.load(std::memory_order_acquire)) [[unlikely]] {
+					link();
+				}
+				return index_ < _vtable.size() ? _vtable[index_] : nullptr;
+			}
+			/** @brief Gets the implementation of an interface method through the itable.
+			 * @param interface_ Interface declaring the method.
+			 * @param index_ Index of the method in the interface (see Method::getVtableIndex).
+			 * @return Pointer to the Method, nullptr if the class does not implement it.
+			 */
+			Method* getInterfaceMethod(const Class& interface_, uint32_t index_);
+
 			/** @brief Checks if a class implements an interface.
 			 * @param interface_ Name of the interface.
 			 * @return true if the class implements the interface, false otherwise.
@@ -178,6 +261,11 @@ namespace sandvik {
 			 * @return Superclass name.
 			 */
 			std::string getSuperClassname() const;
+			/** @brief Gets the object passed as jclass to the static native methods of the class.
+			 * Created on first use and kept for the lifetime of the class.
+			 * @return Class object.
+			 */
+			ObjectRef getClassObject();
 
 			/** @brief Enters the monitor.
 			 *
@@ -202,7 +290,11 @@ namespace sandvik {
 
 		private:
 			ClassLoader& _classloader;
-			bool _isStaticInitialized = false;
+			std::atomic<InitState> _initState = InitState::UNINITIALIZED;
+			/** thread running the initializer while IN_PROGRESS */
+			std::thread::id _initOwner;
+			std::mutex _initMutex;
+			std::condition_variable _initCv;
 
 			std::string _packagename;
 			std::string _fullname;
@@ -219,7 +311,23 @@ namespace sandvik {
 			std::vector<std::string> _interfaces;
 			friend class ClassBuilder;
 
+			/** instance layout, computed by link(), published once the layout and the method tables are complete */
+			std::atomic<bool> _isLinked{false};
+			/** serializes link(), recursive so a super interface can be linked while the lock is held */
+			std::recursive_mutex _linkMutex;
+			bool _isLinking = false;
+			std::vector<const Field*> _instanceFields;
+			std::vector<uint32_t> _referenceSlots;
+			/** method tables, computed by link() */
+			std::vector<Method*> _vtable;
+			std::vector<std::pair<const Class*, std::vector<Method*>>> _itable;
+			void linkInterface(Class& interface_);
+			/** builds the instance layout and the method tables, the link lock must be held */
+			void buildTables();
+
 			std::unique_ptr<Monitor> _monitor;
+			/** jclass of the static native calls, see getClassObject() */
+			std::atomic<Object*> _classObject{nullptr};
 	};
 }  // namespace sandvik
 
@@ -18,6 +18,8 @@
 
 #include "classbuilder.hpp"
 
+#include <algorithm>
+
 #include "class.hpp"
 #include "classloader.hpp"
 #include "field.hpp"
@@ -33,6 +35,11 @@ ClassBuilder::ClassBuilder(ClassLoader& classLoader, const std::string& packageN
 
 void ClassBuilder::setSuperClass(const std::string& superClassName_) {
 	_class->_superClassname = superClassName_;
+	_class->_hasSuperClass = !superClassName_.empty();
+}
+
+void ClassBuilder::addInterface(const std::string& interfaceName_) {
+	_class->_interfaces.push_back(interfaceName_);
 }
 
 void ClassBuilder::setInterface() {
@@ -59,6 +66,18 @@ void ClassBuilder::addMethod(const std::string& name_, const std::string& signat
 	_class->_methods[name_ + signature_] = std::move(method);
 }
 
+void ClassBuilder::setBytecode(const std::string& name_, const std::string& signature_, uint32_t nbRegisters_, const std::vector<uint8_t>& bytecode_) {
+	auto& method = _class->_methods.at(name_ + signature_);
+	method->_nbRegisters = nbRegisters_;
+	method->_bytecode = bytecode_;
+}
+
+void ClassBuilder::addTryRange(const std::string& name_, const std::string& signature_, uint32_t start_, uint32_t end_, uint32_t catchAll_) {
+	auto& ranges = _class->_methods.at(name_ + signature_)->_tryRanges;
+	ranges.push_back({start_, end_, {}, catchAll_});
+	std::sort(ranges.begin(), ranges.end(), [](const Method::TryRange& a_, const Method::TryRange& b_) { return a_.start < b_.start; });
+}
+
 void ClassBuilder::addField(const std::string& name_, const std::string& type_, bool isStatic_, ObjectRef value_) {
 	_class->_fields[name_] = std::make_unique<Field>(*_class, name_, type_, isStatic_, _fieldIndex);
 	_fieldIndex++;
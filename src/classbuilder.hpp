@@ -64,6 +64,21 @@ namespace sandvik {
 			 */
 			void addMethod(const std::string& name_, const std::string& signature_, uint64_t flags_,
 			               std::function<void(Frame&, std::vector<ObjectRef>&)> function_);
+			/** @brief Gives Dalvik bytecode to a method of the class, the interpreter runs it instead of its function
+			 * @param name_ Name of the method
+			 * @param signature_ Signature of the method
+			 * @param nbRegisters_ Number of registers of the frame, the arguments take the last ones
+			 * @param bytecode_ Bytecode of the method
+			 */
+			void setBytecode(const std::string& name_, const std::string& signature_, uint32_t nbRegisters_, const std::vector<uint8_t>& bytecode_);
+			/** @brief Adds a try block to a method of the class
+			 * @param name_ Name of the method
+			 * @param signature_ Signature of the method
+			 * @param start_ First code unit protected
+			 * @param end_ Code unit following the last one protected
+			 * @param catchAll_ Catch all handler address
+			 */
+			void addTryRange(const std::string& name_, const std::string& signature_, uint32_t start_, uint32_t end_, uint32_t catchAll_);
 
 			/** @brief Adds a field to the class
 			 * @param name_ Name of the field
@@ -77,6 +92,10 @@ namespace sandvik {
 			 * @param superClassName_ Name of the superclass
 			 */
 			void setSuperClass(const std::string& superClassName_);
+			/** @brief Adds an interface implemented by the class
+			 * @param interfaceName_ Name of the interface
+			 */
+			void addInterface(const std::string& interfaceName_);
 			/** @brief Sets the class as an interface */
 			void setInterface();
 			/** @brief Finalizes the class definition */
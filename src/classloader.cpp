@@ -25,10 +25,12 @@
 #include "class.hpp"
 #include "exceptions.hpp"
 #include "field.hpp"
+#include "gc.hpp"
 #include "loader/apk.hpp"
 #include "loader/dex.hpp"
 #include "loader/rtld.hpp"
 #include "method.hpp"
+#include "object.hpp"
 #include "system/logger.hpp"
 #include "types.hpp"
 
@@ -43,7 +45,7 @@ ClassLoader::~ClassLoader() {
 void ClassLoader::loadRt(const std::string& rt_) {
 	try {
 		rtld::load(rt_, _dexs);
-		logger.fdebug("RT loaded: {}", rt_);
+		LOG_DEBUG("RT loaded: {}", rt_);
 	} catch (const std::exception& e) {
 		logger.ferror("Failed to load DEX: {}", e.what());
 		return;
@@ -53,7 +55,7 @@ void ClassLoader::loadRt(const std::string& rt_) {
 void ClassLoader::loadDex(const std::string& dex_) {
 	try {
 		auto dex = std::make_unique<Dex>(dex_);
-		logger.fdebug("DEX loaded: {}", dex->getPath());
+		LOG_DEBUG("DEX loaded: {}", dex->getPath());
 		_dexs.push_back(std::move(dex));
 	} catch (const std::exception& e) {
 		logger.ferror("Failed to load DEX: {}", e.what());
@@ -64,7 +66,7 @@ void ClassLoader::loadDex(const std::string& dex_) {
 void ClassLoader::loadApk(const std::string& apk_) {
 	try {
 		auto apk = std::make_unique<Apk>(apk_, _dexs);
-		logger.fdebug("APK loaded: {}", apk->getPath());
+		LOG_DEBUG("APK loaded: {}", apk->getPath());
 		_apks.push_back(std::move(apk));
 	} catch (const std::exception& e) {
 		logger.ferror("Failed to load APK: {}", e.what());
@@ -74,10 +76,10 @@ void ClassLoader::loadApk(const std::string& apk_) {
 
 void ClassLoader::addClassPath(const std::string& classpath_) {
 	if (std::find(_classpath.begin(), _classpath.end(), classpath_) == _classpath.end()) {
-		logger.fdebug("classpath add {}", classpath_);
+		LOG_DEBUG("classpath add {}", classpath_);
 		_classpath.push_back(classpath_);
 	} else {
-		logger.fdebug("classpath already exists: {}", classpath_);
+		LOG_DEBUG("classpath already exists: {}", classpath_);
 	}
 }
 
@@ -116,6 +118,13 @@ void ClassLoader::addClass(std::unique_ptr<Class> class_) {
 }
 
 Class& ClassLoader::getOrLoad(const std::string& classname_) {
+	// fast path: already loaded class referenced with its dotted name
+	if (classname_.find('/') == std::string::npos) {
+		auto it = _classes.find(classname_);
+		if (it != _classes.end()) [[likely]] {
+			return *(it->second);
+		}
+	}
 	auto dotclassname = classname_;
 	std::replace(dotclassname.begin(), dotclassname.end(), '/', '.');
 	// Check if the class is already loaded
@@ -159,88 +168,130 @@ Class& ClassLoader::getOrLoad(const std::string& classname_) {
 	throw VmException("ClassNotFoundError: {}", dotclassname);
 }
 
-Method& ClassLoader::resolveMethod(uint32_t dex_, uint16_t idx_, std::string& classname_, std::string& method_, std::string& sig_) {
-	if (dex_ >= _dexs.size()) {
+Dex& ClassLoader::getDex(uint32_t dex_) {
+	if (dex_ >= _dexs.size()) [[unlikely]] {
 		throw VmException("Invalid DEX index: {} (size: {})", dex_, _dexs.size());
 	}
+	return *_dexs[dex_];
+}
+
+Method& ClassLoader::resolveMethod(uint32_t dex_, uint16_t idx_) {
+	auto& dex = getDex(dex_);
+	auto& cache = dex.getResolutionCache().methods;
+	if (idx_ < cache.size()) [[likely]] {
+		if (auto* method = cache[idx_].load(std::memory_order_acquire)) {
+			return *method;
+		}
+	}
+	const MethodRef* ref = nullptr;
 	try {
-		_dexs[dex_]->resolveMethod(idx_, classname_, method_, sig_);
-		auto& cls = getOrLoad(classname_);
-		return cls.getMethod(method_, sig_);
+		ref = &dex.resolveMethod(idx_);
+		auto& method = getOrLoad(ref->classname).getMethod(ref->name, ref->signature);
+		cache[idx_].store(&method, std::memory_order_release);
+		return method;
 	} catch (std::exception& e) {
-		throw VmException("Method {}.{}{} not found: {} ({})", classname_, method_, sig_, idx_, e.what());
+		if (ref == nullptr) {
+			throw VmException("Method not found: {} ({})", idx_, e.what());
+		}
+		throw VmException("Method {}.{}{} not found: {} ({})", ref->classname, ref->name, ref->signature, idx_, e.what());
 	}
 }
-Method& ClassLoader::resolveMethod(uint32_t dex_, uint16_t idx_) {
-	std::string classname;
-	std::string method;
-	std::string sig;
-	return resolveMethod(dex_, idx_, classname, method, sig);
+
+const MethodRef& ClassLoader::findMethod(uint32_t dex_, uint16_t idx_) {
+	return getDex(dex_).resolveMethod(idx_);
 }
-void ClassLoader::findMethod(uint32_t dex_, uint16_t idx_, std::string& classname_, std::string& method_, std::string& sig_) {
-	if (dex_ >= _dexs.size()) {
-		throw VmException("Invalid DEX index: {} (size: {})", dex_, _dexs.size());
+
+Method* ClassLoader::resolveVirtualMethod(uint32_t dex_, uint16_t idx_) {
+	auto& dex = getDex(dex_);
+	auto& cache = dex.getResolutionCache().virtualMethods;
+	if (idx_ < cache.size()) [[likely]] {
+		if (auto* method = cache[idx_].load(std::memory_order_acquire)) {
+			return method;
+		}
 	}
-	_dexs[dex_]->resolveMethod(idx_, classname_, method_, sig_);
+	const auto& ref = dex.resolveMethod(idx_);
+	Class* cls = nullptr;
+	try {
+		cls = &getOrLoad(ref.classname);
+	} catch (const std::exception& e) {
+		LOG_DEBUG("resolveVirtualMethod: class {} not found ({})", ref.classname, e.what());
+		return nullptr;
+	}
+	auto* method = cls->isInterface() ? cls->findInterfaceMethod(ref.name, ref.signature) : cls->findVirtualMethod(ref.name, ref.signature);
+	cache[idx_].store(method, std::memory_order_release);
+	return method;
 }
 
-Class& ClassLoader::resolveClass(uint32_t dex_, uint16_t idx_, std::string& classname_) {
-	if (dex_ >= _dexs.size()) {
-		throw VmException("Invalid DEX index: {} (size: {})", dex_, _dexs.size());
+Class& ClassLoader::resolveClass(uint32_t dex_, uint16_t idx_) {
+	auto& dex = getDex(dex_);
+	auto& cache = dex.getResolutionCache().classes;
+	if (idx_ < cache.size()) [[likely]] {
+		if (auto* cls = cache[idx_].load(std::memory_order_acquire)) {
+			return *cls;
+		}
 	}
 	try {
-		_dexs[dex_]->resolveClass(idx_, classname_);
-		return getOrLoad(classname_);
+		auto& cls = getOrLoad(dex.resolveClass(idx_));
+		cache[idx_].store(&cls, std::memory_order_release);
+		return cls;
 	} catch (std::exception& e) {
 		throw VmException("Class not found: {} ({})", idx_, e.what());
 	}
 }
-Class& ClassLoader::resolveClass(uint32_t dex_, uint16_t idx_) {
-	std::string classname;
-	return resolveClass(dex_, idx_, classname);
-}
 
 Field& ClassLoader::resolveField(uint32_t dex_, uint16_t idx_) {
-	std::string classname;
-	std::string field;
-	return resolveField(dex_, idx_, classname, field);
-}
-
-Field& ClassLoader::resolveField(uint32_t dex_, uint16_t idx_, std::string& classname_, std::string& field_) {
-	if (dex_ >= _dexs.size()) {
-		throw VmException("Invalid DEX index: {} (size: {})", dex_, _dexs.size());
+	auto& dex = getDex(dex_);
+	auto& cache = dex.getResolutionCache().fields;
+	if (idx_ < cache.size()) [[likely]] {
+		if (auto* field = cache[idx_].load(std::memory_order_acquire)) {
+			return *field;
+		}
 	}
 	try {
-		_dexs[dex_]->resolveField(idx_, classname_, field_);
-		auto& cls = getOrLoad(classname_);
-		return cls.getField(field_);
+		std::string classname;
+		std::string fieldname;
+		dex.resolveField(idx_, classname, fieldname);
+		auto& field = getOrLoad(classname).getField(fieldname);
+		cache[idx_].store(&field, std::memory_order_release);
+		return field;
 	} catch (std::exception& e) {
 		throw VmException("Field not found: {} ({})", idx_, e.what());
 	}
 }
 
-std::string ClassLoader::resolveType(uint32_t dex_, uint16_t idx_, TYPES& type_) {
-	if (dex_ >= _dexs.size()) {
-		throw VmException("Invalid DEX index: {} (size: {})", dex_, _dexs.size());
-	}
+const std::string& ClassLoader::resolveType(uint32_t dex_, uint16_t idx_, TYPES& type_) {
 	try {
-		return _dexs[dex_]->resolveType(idx_, type_);
+		return getDex(dex_).resolveType(idx_, type_);
 	} catch (const std::exception& e) {
 		throw VmException("Type not found: {} ({})", idx_, e.what());
 	}
 }
 
-std::string ClassLoader::resolveString(uint32_t dex_, uint16_t idx_) {
-	if (dex_ >= _dexs.size()) {
-		throw VmException("Invalid DEX index: {} (size: {})", dex_, _dexs.size());
-	}
+const std::string& ClassLoader::resolveString(uint32_t dex_, uint32_t idx_) {
 	try {
-		return _dexs[dex_]->resolveString(idx_);
+		return getDex(dex_).resolveString(idx_);
 	} catch (const std::exception& e) {
 		throw VmException("String not found: {} ({})", idx_, e.what());
 	}
 }
 
+Object* ClassLoader::resolveStringObject(uint32_t dex_, uint32_t idx_) {
+	auto& cache = getDex(dex_).getResolutionCache().strings;
+	if (idx_ < cache.size()) [[likely]] {
+		if (auto* str = cache[idx_].load(std::memory_order_acquire)) {
+			return str;
+		}
+	}
+	auto* str = Object::make(*this, resolveString(dex_, idx_));
+	// the thread losing the race returns the published object, its own copy is left to the GC
+	Object* published = nullptr;
+	if (!cache[idx_].compare_exchange_strong(published, str, std::memory_order_acq_rel, std::memory_order_acquire)) {
+		return published;
+	}
+	GC::writeBarrier(str);
+	return str;
+}
+
 std::vector<std::pair<std::string, uint32_t>> ClassLoader::resolveArray(uint32_t dex_, uint16_t idx_) {
 	if (dex_ >= _dexs.size()) {
 		throw VmException("Invalid DEX index: {} (size: {})", dex_, _dexs.size());
@@ -265,4 +316,11 @@ void ClassLoader::visitReferences(const std::function<void(Object*)>& visitor_)
 	for (const auto& [name, classPtr] : _classes) {
 		classPtr->visitReferences(visitor_);
 	}
+	for (const auto& dex : _dexs) {
+		for (const auto& str : dex->getResolutionCache().strings) {
+			if (auto* obj = str.load(std::memory_order_acquire)) {
+				visitor_(obj);
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -32,6 +32,7 @@ namespace sandvik {
 	class Field;
 	class Apk;
 	class Dex;
+	struct MethodRef;
 	enum class TYPES;
 	/** @brief Class Loader class
 	 */
@@ -76,68 +77,59 @@ namespace sandvik {
 			Class& getOrLoad(const std::string& classname_);
 
 			/** @brief Resolve method by dex and index
+			 * The resolved method is cached per dex.
 			 * @param dex_ dex index
 			 * @param idx_ method index
 			 * @return reference to method
 			 */
 			Method& resolveMethod(uint32_t dex_, uint16_t idx_);
-			/** @brief Resolve method by dex and index with names
+			/** @brief Find method names by dex and index
 			 * @param dex_ dex index
 			 * @param idx_ method index
-			 * @param classname_ reference to store class name
-			 * @param method_ reference to store method name
-			 * @param sig_ reference to store method signature
-			 * @return reference to method
+			 * @return symbolic method reference (class name, method name, signature)
 			 */
-			Method& resolveMethod(uint32_t dex_, uint16_t idx_, std::string& classname_, std::string& method_, std::string& sig_);
-			/** @brief Find method names by dex and index
+			const MethodRef& findMethod(uint32_t dex_, uint16_t idx_);
+			/** @brief Resolve the method a virtual or interface call dispatches on
+			 * The method is looked up in the vtable of the referenced class, or in the referenced interface and its
+			 * super interfaces, and is cached per dex. Its vtable index is used to select the implementation of the receiver.
 			 * @param dex_ dex index
 			 * @param idx_ method index
-			 * @param classname_ reference to store class name
-			 * @param method_ reference to store method name
-			 * @param sig_ reference to store method signature
+			 * @return pointer to method, nullptr if it cannot be resolved
 			 */
-			void findMethod(uint32_t dex_, uint16_t idx_, std::string& classname_, std::string& method_, std::string& sig_);
+			Method* resolveVirtualMethod(uint32_t dex_, uint16_t idx_);
 			/** @brief Resolve class by dex and index
+			 * The resolved class is cached per dex.
 			 * @param dex_ dex index
 			 * @param idx_ class index
 			 * @return reference to class
 			 */
 			Class& resolveClass(uint32_t dex_, uint16_t idx_);
-			/** @brief Resolve class by dex and index with name
-			 * @param dex_ dex index
-			 * @param idx_ class index
-			 * @param classname_ reference to store class name
-			 * @return reference to class
-			 */
-			Class& resolveClass(uint32_t dex_, uint16_t idx_, std::string& classname_);
 			/** @brief Resolve field by dex and index
+			 * The resolved field is cached per dex.
 			 * @param dex_ dex index
 			 * @param idx_ field index
 			 * @return reference to field
 			 */
 			Field& resolveField(uint32_t dex_, uint16_t idx_);
-			/** @brief Resolve field by dex and index with names
-			 * @param dex_ dex index
-			 * @param idx_ field index
-			 * @param classname_ reference to store class name
-			 * @param field_ reference to store field name
-			 * @return reference to field
-			 */
-			Field& resolveField(uint32_t dex_, uint16_t idx_, std::string& classname_, std::string& field_);
 			/** @brief Resolve type by dex and index
 			 * @param dex_ dex index
 			 * @param idx_ type index
 			 * @param type_ reference to store type enum
 			 * @return type as string
 			 */
-			std::string resolveType(uint32_t dex_, uint16_t idx_, TYPES& type_);
+			const std::string& resolveType(uint32_t dex_, uint16_t idx_, TYPES& type_);
 			/** @brief Resolve string by dex and index
 			 * @param dex_ dex index
 			 * @param idx_ string index
 			 * @return resolved string
 			 */
-			std::string resolveString(uint32_t dex_, uint16_t idx_);
+			const std::string& resolveString(uint32_t dex_, uint32_t idx_);
+			/** @brief Resolve the String object of a literal by dex and index, created once and shared by every const-string
+			 * @param dex_ dex index
+			 * @param idx_ string index
+			 * @return String object
+			 */
+			Object* resolveStringObject(uint32_t dex_, uint32_t idx_);
 			/** @brief Resolve array type by dex and index
 			 * @param dex_ dex index
 			 * @param idx_ type index
@@ -158,6 +150,7 @@ namespace sandvik {
 		private:
 			friend class ClassBuilder;
 			void addClass(std::unique_ptr<Class> class_);
+			Dex& getDex(uint32_t dex_);
 
 			std::vector<std::string> _classpath;
 			std::vector<std::unique_ptr<Apk>> _apks;
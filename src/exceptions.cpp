@@ -32,6 +32,10 @@ const char* VmException::what() const noexcept {
 JavaException::JavaException(const std::string& type_, const std::string& message_) : _type(type_), _message(message_) {
 }
 
+JavaException::JavaException(Object* throwable_, const std::string& type_, const std::string& message_)
+    : _type(type_), _message(message_), _throwable(throwable_) {
+}
+
 const char* JavaException::what() const noexcept {
 	return _message.c_str();
 }
@@ -41,3 +45,6 @@ std::string JavaException::getExceptionType() const {
 std::string JavaException::getMessage() const {
 	return _message;
 }
+Object* JavaException::getThrowable() const {
+	return _throwable;
+}
@@ -25,6 +25,7 @@
 #include <string>
 
 namespace sandvik {
+	class Object;
 	/**
 	 * @class VmException
 	 * @brief Exception class representing a VM exception.
@@ -60,6 +61,11 @@ namespace sandvik {
 			 * @param type_ exception class type
 			 * @param message_ Exception message. */
 			explicit JavaException(const std::string& type_, const std::string& message_ = "");
+			/** exception constructor for a java throwable left uncaught by a method run nested (class initializer, JNI call)
+			 * @param throwable_ throwable object, rethrown as is on the other side of the nested run
+			 * @param type_ exception class type
+			 * @param message_ Exception message. */
+			explicit JavaException(Object* throwable_, const std::string& type_, const std::string& message_ = "");
 			~JavaException() noexcept override = default;
 			/** get exception message
 			 * @return exception message
@@ -73,10 +79,15 @@ namespace sandvik {
 			 * @return A string containing the exception message.
 			 */
 			std::string getMessage() const;
+			/** Retrieves the java throwable object carried by the exception.
+			 * @return Throwable object, nullptr if the exception is only described by its type and message.
+			 */
+			Object* getThrowable() const;
 
 		private:
 			std::string _type;
 			std::string _message;
+			Object* _throwable = nullptr;
 	};
 	/** @brief ArithmeticException exception class */
 	class ArithmeticException : public JavaException {
@@ -265,6 +276,15 @@ namespace sandvik {
 			}
 			~OutOfMemoryError() noexcept override = default;
 	};
+	/** @brief StackOverflowError exception class */
+	class StackOverflowError : public JavaException {
+		public:
+			/** constructor
+			 * @param message Exception message. */
+			explicit StackOverflowError(const std::string& message = "") : JavaException("java.lang.StackOverflowError", message) {
+			}
+			~StackOverflowError() noexcept override = default;
+	};
 	/** @brief CloneNotSupportedException exception class */
 	class CloneNotSupportedException : public JavaException {
 		public:
@@ -68,11 +68,11 @@ Class& Field::getClass() const {
 	return _class;
 }
 
-std::string Field::getName() const {
+const std::string& Field::getName() const {
 	return _name;
 }
 
-std::string Field::getType() const {
+const std::string& Field::getType() const {
 	return _type;
 }
 
@@ -80,6 +80,10 @@ bool Field::isStatic() const {
 	return _isStatic;
 }
 
+bool Field::isReference() const {
+	return !_type.empty() && (_type[0] == 'L' || _type[0] == '[');
+}
+
 uint32_t Field::getIntValue() const {
 	if (isStatic()) {
 		_class.monitorCheck();
@@ -137,6 +141,5 @@ void Field::setObjectValue(ObjectRef value) {
 void Field::visitReferences(const std::function<void(Object*)>& visitor_) const {
 	if (_obj) {
 		visitor_(_obj);
-		_obj->visitReferences(visitor_);
 	}
 }
@@ -53,6 +53,16 @@ namespace sandvik {
 			 * @return Index of the field.
 			 */
 			uint32_t getIndex() const;
+			/** @brief Returns the instance slot of the field, assigned when its class is linked.
+			 * @return Slot of the field in the object field storage.
+			 */
+			inline uint32_t getSlot() const {
+				return _slot;
+			}
+			/** @brief Checks if the field holds a reference (object or array).
+			 * @return true if the field type is an object or an array.
+			 */
+			bool isReference() const;
 
 			/** @brief Returns a string representation of the field.
 			 * @return String representation.
@@ -105,11 +115,11 @@ namespace sandvik {
 			/** @brief Gets the name of the field.
 			 * @return Name of the field.
 			 */
-			std::string getName() const;
+			const std::string& getName() const;
 			/** @brief Gets the type of the field.
 			 * @return Type of the field.
 			 */
-			std::string getType() const;
+			const std::string& getType() const;
 			/** @brief Checks if the field is static.
 			 * @return true if the field is static, false otherwise.
 			 */
@@ -126,6 +136,8 @@ namespace sandvik {
 			std::string _type;
 			bool _isStatic;
 			uint32_t _index;
+			uint32_t _slot = 0;
+			friend class Class;
 
 			uint64_t _value = 0;
 			std::string _strValue = "";
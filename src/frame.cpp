@@ -24,25 +24,25 @@
 
 #include "class.hpp"
 #include "exceptions.hpp"
+#include "gc.hpp"
 #include "method.hpp"
 #include "object.hpp"
 #include "system/logger.hpp"
 
 using namespace sandvik;
 
-Frame::Frame(Method& method_) : _method(method_) {
-	logger.fdebug("new Frame for method = {}.{} registers ={}", method_.getClass().getFullname(), method_.getName(), method_.getNbRegisters());
-	_exception = Object::makeNull();
-	_objectReturn = Object::makeNull();
-	increaseRegSize(method_.getNbRegisters());
-}
-
-void Frame::increaseRegSize(uint32_t size_) {
-	if (size_ > _registers.size()) {
-		size_t oldSize = _registers.size();
-		_registers.resize(size_);
-		std::generate(_registers.begin() + oldSize, _registers.end(), []() { return Object::makeNull(); });
-	}
+Frame::Frame(Method& method_, Frame* caller_)
+    : _method(method_),
+      _caller(caller_),
+      _nbRegisters(method_.getNbRegisters()),
+      _references(reinterpret_cast<ObjectRef*>(this + 1)),
+      _registers(reinterpret_cast<uint32_t*>(_references + _nbRegisters)) {
+	// registers read as null or 0 until they are written
+	auto null = Object::makeNull();
+	_exception = null;
+	_objectReturn = null;
+	std::fill_n(_references, _nbRegisters, null);
+	std::fill_n(_registers, _nbRegisters, 0);
 }
 
 uint32_t Frame::getDexIdx() const {
@@ -53,65 +53,58 @@ Method& Frame::getMethod() const {
 	return _method;
 }
 
-uint16_t Frame::pc() const {
-	return _pc;
-}
-
-uint16_t& Frame::pc() {
-	return _pc;
-}
-
 void Frame::setPc(uint16_t pc_) {
 	_pc = pc_;
 }
 
+uint32_t Frame::getRawRegister(uint32_t reg) const {
+	if (reg >= _nbRegisters) {
+		throw VmException("getRawRegister: reg={} out of bounds", reg);
+	}
+	auto obj = _references[reg];
+	if (obj == nullptr) {
+		return _registers[reg];
+	}
+	// object slot : null reads as 0, boxed numbers are unboxed
+	if (obj->isNull()) {
+		return 0;
+	}
+	if (!obj->isNumberObject()) {
+		throw VmException("Register does not contain an NumberObject {}", obj->toString());
+	}
+	return static_cast<uint32_t>(obj->getValue());
+}
+
 uint64_t Frame::getRawLongRegister(uint32_t reg) const {
-	if (reg + 1 >= _registers.size()) {
+	if (reg + 1 >= _nbRegisters) {
 		throw VmException("getRawLongRegister: reg={} out of bounds", reg);
 	}
-	const Object& lsb = *_registers[reg];
-	const Object& msb = *_registers[reg + 1];
-	if (!lsb.isNumberObject() || !msb.isNumberObject()) {
-		throw VmException("Register does not contain valid NumberObjects");
-	}
-	uint64_t value = static_cast<uint32_t>(msb.getValue());
+	uint64_t value = getRawRegister(reg + 1);
 	value <<= 32;
-	value |= static_cast<uint32_t>(lsb.getValue());
+	value |= getRawRegister(reg);
 	return value;
 }
 
 void Frame::setRawLongRegister(uint32_t reg, uint64_t value) {
-	logger.fdebug("setRawLongRegister: reg={}, value={:x}", reg, value);
-	if (reg + 1 >= _registers.size()) {
+	if (reg + 1 >= _nbRegisters) {
 		throw VmException("setRawLongRegister: reg={} out of bounds", reg);
 	}
-	_registers[reg] = Object::make(static_cast<uint32_t>(value & 0xFFFFFFFF));
-	_registers[reg + 1] = Object::make(static_cast<uint32_t>((value >> 32) & 0xFFFFFFFF));
+	_registers[reg] = static_cast<uint32_t>(value & 0xFFFFFFFF);
+	_registers[reg + 1] = static_cast<uint32_t>((value >> 32) & 0xFFFFFFFF);
+	_references[reg] = nullptr;
+	_references[reg + 1] = nullptr;
 }
 
 void Frame::setIntRegister(uint32_t reg, int32_t value) {
-	logger.fdebug("setIntRegister: reg={}, value={:x}", reg, value);
-	if (reg >= _registers.size()) {
+	if (reg >= _nbRegisters) {
 		throw VmException("setIntRegister: reg={} out of bounds", reg);
 	}
-	_registers[reg] = Object::make(value);
+	_registers[reg] = static_cast<uint32_t>(value);
+	_references[reg] = nullptr;
 }
 
 int32_t Frame::getIntRegister(uint32_t reg) const {
-	if (reg >= _registers.size()) {
-		throw VmException("getIntRegister: reg={} out of bounds", reg);
-	}
-	auto obj = _registers[reg];
-	if (obj->isNull()) {
-		logger.fdebug("getIntRegister: reg={} -> null", reg);
-		return 0;
-	}
-	if (!obj->isNumberObject()) {
-		throw VmException("Register does not contain an NumberObject {}", obj->toString());
-	}
-	auto number = obj->getValue();
-	logger.fdebug("getIntRegister: reg={} -> {}", reg, number);
-	return number;
+	return static_cast<int32_t>(getRawRegister(reg));
 }
 
 void Frame::setLongRegister(uint32_t reg, int64_t value) {
@@ -119,61 +112,61 @@ void Frame::setLongRegister(uint32_t reg, int64_t value) {
 }
 
 int64_t Frame::getLongRegister(uint32_t reg) const {
-	uint64_t value = getRawLongRegister(reg);
-	logger.fdebug("getLongRegister: reg={} --> {:x}", reg, value);
-	return (int64_t)value;
+	return (int64_t)getRawLongRegister(reg);
 }
 
 void Frame::setFloatRegister(uint32_t reg, float value) {
-	logger.fdebug("setFloatRegister: reg={}, value={}", reg, value);
-	if (reg >= _registers.size()) {
-		throw VmException("setFloatRegister: reg={} out of bounds", reg);
-	}
-	uint32_t intValue;
-	intValue = std::bit_cast<uint32_t>(value);
-	_registers[reg] = Object::make(intValue);
+	setIntRegister(reg, std::bit_cast<int32_t>(value));
 }
 
 float Frame::getFloatRegister(uint32_t reg) const {
-	logger.fdebug("getFloatRegister: reg={}", reg);
-	if (reg >= _registers.size()) {
-		throw VmException("getFloatRegister: reg={} out of bounds", reg);
-	}
-	const Object& obj = *_registers[reg];
-	if (!obj.isNumberObject()) {
-		throw VmException("Register does not contain an NumberObject {}", obj.toString());
-	}
-	auto intValue = static_cast<uint32_t>(obj.getValue());
-	return std::bit_cast<float>(intValue);
+	return std::bit_cast<float>(getRawRegister(reg));
 }
 
 void Frame::setDoubleRegister(uint32_t reg, double value) {
-	logger.fdebug("setDoubleRegister: reg={}, value={}", reg, value);
-	uint64_t temp = std::bit_cast<uint64_t>(value);
-	setRawLongRegister(reg, temp);
-	logger.fdebug("setDoubleRegister: reg={} value={} {}", reg, _registers[reg]->toString(), _registers[reg + 1]->toString());
+	setRawLongRegister(reg, std::bit_cast<uint64_t>(value));
 }
 
 double Frame::getDoubleRegister(uint32_t reg) const {
-	logger.fdebug("getDoubleRegister: reg={}", reg);
-	uint64_t value = getRawLongRegister(reg);
-	return std::bit_cast<double>(value);
+	return std::bit_cast<double>(getRawLongRegister(reg));
 }
 
 void Frame::setObjRegister(uint32_t reg, ObjectRef value) {
-	logger.fdebug("setObjRegister: reg={}, obj=<{}>", reg, value->toString());
-	if (reg >= _registers.size()) {
+	if (reg >= _nbRegisters) {
 		throw VmException("setObjRegister: reg={} out of bounds", reg);
 	}
-	_registers[reg] = value;
+	GC::writeBarrier(value);
+	_registers[reg] = 0;
+	_references[reg] = value;
 }
 
 ObjectRef Frame::getObjRegister(uint32_t reg) {
-	if (reg >= _registers.size()) {
+	if (reg >= _nbRegisters) {
 		throw VmException("getObjRegister: reg={} out of bounds", reg);
 	}
-	logger.fdebug("getObjRegister: reg={} => obj=<{}>", reg, _registers[reg]->toString());
-	return _registers[reg];
+	if (_references[reg] == nullptr) {
+		// primitive slot used as an object (const 0 as null, native arguments)
+		if (_registers[reg] == 0) {
+			return Object::makeNull();
+		}
+		return Object::make(static_cast<int32_t>(_registers[reg]));
+	}
+	return _references[reg];
+}
+
+bool Frame::isObjRegister(uint32_t reg) const {
+	if (reg >= _nbRegisters) {
+		throw VmException("isObjRegister: reg={} out of bounds", reg);
+	}
+	return _references[reg] != nullptr;
+}
+
+void Frame::copyRegister(uint32_t reg, const Frame& from_, uint32_t fromReg) {
+	if (reg >= _nbRegisters || fromReg >= from_._nbRegisters) {
+		throw VmException("copyRegister: reg={} <- {} out of bounds", reg, fromReg);
+	}
+	_registers[reg] = from_._registers[fromReg];
+	_references[reg] = from_._references[fromReg];
 }
 
 ObjectRef Frame::getException() const {
@@ -181,10 +174,20 @@ ObjectRef Frame::getException() const {
 }
 
 ObjectRef Frame::getReturnObject() const {
+	if (_objectReturn == nullptr) {
+		// primitive return value read as an object
+		if (_valueReturn == 0) {
+			return Object::makeNull();
+		}
+		return Object::make(_valueReturn);
+	}
 	return _objectReturn;
 }
 
 int32_t Frame::getReturnValue() const {
+	if (_objectReturn == nullptr) {
+		return static_cast<int32_t>(_valueReturn);
+	}
 	if (!_objectReturn->isNumberObject()) {
 		throw VmException("Return object is not an NumberObject");
 	}
@@ -192,6 +195,9 @@ int32_t Frame::getReturnValue() const {
 }
 
 int64_t Frame::getReturnDoubleValue() const {
+	if (_objectReturn == nullptr) {
+		return static_cast<int64_t>(_valueReturn);
+	}
 	if (!_objectReturn->isNumberObject()) {
 		throw VmException("Return object is not a isNumberObject");
 	}
@@ -204,27 +210,33 @@ void Frame::setReturnObject(ObjectRef ret_) {
 	_objectReturn = ret_;
 }
 void Frame::setReturnValue(int32_t ret_) {
-	_objectReturn = Object::make(ret_);
+	_valueReturn = static_cast<uint64_t>(static_cast<int64_t>(ret_));
+	_objectReturn = nullptr;
 }
 void Frame::setReturnDoubleValue(int64_t ret_) {
-	_objectReturn = Object::make(ret_);
-	logger.fdebug("setReturnDoubleValue: {:x} -> obj=<{}>", ret_, _objectReturn->toString());
+	_valueReturn = static_cast<uint64_t>(ret_);
+	_objectReturn = nullptr;
 }
 
 void Frame::debug() const {
-	logger.fdebug("method={} pc={}", _method.getName(), _pc);
-	for (size_t i = 0; i < _registers.size(); ++i) {
-		logger.fdebug("register[{}] = {}", i, _registers[i]->toString());
+	LOG_DEBUG("method={} pc={}", _method.getName(), _pc);
+	for (size_t i = 0; i < _nbRegisters; ++i) {
+		if (_references[i] == nullptr) {
+			LOG_DEBUG("register[{}] = {:#x}", i, _registers[i]);
+		} else {
+			LOG_DEBUG("register[{}] = {}", i, _references[i]->toString());
+		}
 	}
 }
 
 void Frame::visitReferences(const std::function<void(Object*)>& visitor_) const {
-	visitor_(_objectReturn);
+	if (_objectReturn) {
+		visitor_(_objectReturn);
+	}
 	visitor_(_exception);
-	for (const auto& reg : _registers) {
-		if (reg) {
-			visitor_(reg);
-			reg->visitReferences(visitor_);
+	for (uint32_t i = 0; i < _nbRegisters; ++i) {
+		if (_references[i]) {
+			visitor_(_references[i]);
 		}
 	}
 }
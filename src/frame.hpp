@@ -19,12 +19,10 @@
 #ifndef __FRAME_HPP__
 #define __FRAME_HPP__
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <functional>
-#include <memory>
-#include <stack>
-#include <vector>
 
 #include "object.hpp"
 
@@ -35,14 +33,35 @@ namespace sandvik {
 	 *
 	 *  The Frame class encapsulates the state of a method invocation,
 	 *  including local registers, program counter, and return values.
+	 *
+	 *  Frames are bump allocated in the contiguous stack of their thread (see JThread::newFrame), the registers
+	 *  of the method are stored inline right after the frame.
 	 */
 	class Frame {
 		public:
-			/** @brief Constructs a new Frame for the given method.
+			/** @brief Constructs a new Frame for the given method, in a stack slot of getFrameSize() bytes.
 			 *  @param method_ Reference to the Method associated with this frame.
+			 *  @param caller_ Frame below this one in the thread stack, nullptr for the first frame.
 			 */
-			explicit Frame(Method& method_);
+			explicit Frame(Method& method_, Frame* caller_);
 			~Frame() = default;
+			Frame(const Frame&) = delete;
+			Frame& operator=(const Frame&) = delete;
+
+			/** @brief Gets the size taken in the thread stack by a frame and its registers.
+			 *  @param nbRegisters_ Number of registers of the method.
+			 *  @return Size in bytes, multiple of the frame alignment.
+			 */
+			static constexpr size_t getFrameSize(uint32_t nbRegisters_) {
+				const size_t size = sizeof(Frame) + nbRegisters_ * (sizeof(ObjectRef) + sizeof(uint32_t));
+				return (size + alignof(Frame) - 1) & ~(alignof(Frame) - 1);
+			}
+			/** @brief Gets the frame below this one in the thread stack.
+			 *  @return Calling frame, nullptr for the first frame of the thread.
+			 */
+			inline Frame* getCaller() const {
+				return _caller;
+			}
 
 			/** @brief Gets the Dex index of the method
 			 *  @return Dex index.
@@ -96,10 +115,23 @@ namespace sandvik {
 			 */
 			void setObjRegister(uint32_t reg, ObjectRef value);
 			/** @brief Gets the Object register value.
+			 *
+			 *  A primitive slot read as an object is boxed into a NumberObject.
 			 *  @param reg Register index.
 			 *  @return Value of the register.
 			 */
 			ObjectRef getObjRegister(uint32_t reg);
+			/** @brief Checks if a register holds an object reference.
+			 *  @param reg Register index.
+			 *  @return True if the register holds an object, false if it holds a primitive value.
+			 */
+			bool isObjRegister(uint32_t reg) const;
+			/** @brief Copies a register (raw value and reference tag) from another frame.
+			 *  @param reg Destination register index.
+			 *  @param from_ Source frame.
+			 *  @param fromReg Source register index.
+			 */
+			void copyRegister(uint32_t reg, const Frame& from_, uint32_t fromReg);
 
 			/** @brief Gets the return Object value.
 			 *  @return Return Object.
@@ -141,11 +173,15 @@ namespace sandvik {
 			/** @brief Gets the program counter.
 			 *  @return Program counter.
 			 */
-			uint16_t pc() const;
+			inline uint16_t pc() const {
+				return _pc;
+			}
 			/** @brief Gets a reference to the program counter.
 			 *  @return Reference to the program counter.
 			 */
-			uint16_t& pc();
+			inline uint16_t& pc() {
+				return _pc;
+			}
 			/** @brief Sets the program counter.
 			 *  @param pc_ Program counter value to set.
 			 */
@@ -165,10 +201,11 @@ namespace sandvik {
 			void visitReferences(const std::function<void(Object*)>& visitor_) const;
 
 		protected:
-			/** @brief Increases the size of the register array.
-			 *  @param size_ New size of the register array.
+			/** @brief Gets the raw 32-bit register value.
+			 *  @param reg Register index.
+			 *  @return Value of the register.
 			 */
-			void increaseRegSize(uint32_t size_);
+			uint32_t getRawRegister(uint32_t reg) const;
 			/** @brief Gets the raw integer (64-bit) register value.
 			 *  @param reg Register index.
 			 *  @return Value of the register.
@@ -182,11 +219,17 @@ namespace sandvik {
 
 		private:
 			Method& _method;
-			std::vector<std::string> _args;
-
-			std::vector<ObjectRef> _registers;
+			Frame* _caller;
+			uint32_t _nbRegisters;
+			/** reference tags: object held by the register, nullptr for primitive slots (stored after the frame) */
+			ObjectRef* _references;
+			/** raw 32-bit register slots (stored after the reference tags) */
+			uint32_t* _registers;
 
 			uint16_t _pc = 0;
+			/** raw primitive return value */
+			uint64_t _valueReturn = 0;
+			/** object return value, nullptr when the return value is a primitive */
 			ObjectRef _objectReturn;
 			ObjectRef _exception;
 	};
@@ -19,7 +19,9 @@
 #include "gc.hpp"
 
 #include <algorithm>
+#include <cmath>
 
+#include "exceptions.hpp"
 #include "monitor.hpp"
 #include "object.hpp"
 #include "system/logger.hpp"
@@ -28,6 +30,11 @@
 using namespace sandvik;
 
 GC::GC() : Thread("GC") {
+	_heap.setRefillCallback([this](uint64_t bytes_) {
+		if (bytes_ > _heapTarget.load(std::memory_order_relaxed)) {
+			requestCollect();
+		}
+	});
 }
 
 GC::~GC() {
@@ -40,17 +47,28 @@ void GC::onStart() {
 	_done.store(false);
 }
 
+void GC::onStop() {
+	// the loop waits on the collection request, wake it so that run() can join it on restart
+	std::unique_lock lock(_mtx);
+	_done.store(true);
+	_gcRequested.store(true);
+	_cv.notify_all();
+}
+
 void GC::loop() {
 	{
 		std::unique_lock lock(_mtx);
 		// Wait until someone requests a GC
 		_cv.wait(lock, [this] { return _gcRequested.load(); });
-		_gcRequested.store(false);
 		if (_done.load()) {
+			_gcRequested.store(false);
 			return;
 		}
+		_collecting.store(true);
+		_gcRequested.store(false);
 	}
 	collect();
+	_collecting.store(false);
 }
 
 bool GC::done() {
@@ -58,15 +76,53 @@ bool GC::done() {
 }
 
 uint64_t GC::getTrackedObjectCount() const {
-	return _objects.size();
+	return _heap.getObjectCount();
+}
+
+uint64_t GC::getAllocatedBytes() const {
+	return _heap.getAllocatedBytes();
+}
+
+uint64_t GC::getHeapTarget() const {
+	return _heapTarget.load();
+}
+
+uint64_t GC::getMinHeapSize() const {
+	return _minHeapSize;
+}
+
+uint64_t GC::getMaxHeapSize() const {
+	return _maxHeapSize;
+}
+
+void GC::setHeapSize(uint64_t min_, uint64_t max_) {
+	_minHeapSize = min_;
+	_maxHeapSize = std::max(min_, max_);
+	_heapTarget.store(_minHeapSize);
 }
 
-uint64_t GC::getLimit() const {
-	return _limit;
+uint64_t GC::getTargetPause() const {
+	return _targetPause;
 }
 
-void GC::setLimit(uint64_t limit_) {
-	_limit = limit_;
+void GC::setTargetPause(uint64_t pause_) {
+	_targetPause = pause_;
+}
+
+bool GC::isConcurrent() const {
+	return _concurrent;
+}
+
+void GC::setConcurrent(bool concurrent_) {
+	_concurrent = concurrent_;
+}
+
+uint32_t GC::getMarkThreads() const {
+	return _marker.getThreadCount();
+}
+
+void GC::setMarkThreads(uint32_t threads_) {
+	_marker.setThreadCount(threads_);
 }
 
 void GC::manageVm(Vm* vm_) {
@@ -80,6 +136,7 @@ void GC::manageVm(Vm* vm_) {
 void GC::unmanageVm(Vm* vm_) {
 	std::erase(_vms, vm_);
 	if (_vms.empty()) {
+		reportPauses();
 		_done.store(true);
 		_gcRequested.store(true);
 		_cv.notify_all();
@@ -87,10 +144,14 @@ void GC::unmanageVm(Vm* vm_) {
 }
 
 void GC::release() {
-	_objects.clear();
+	_heap.release();
 }
 
 void GC::requestCollect() {
+	// debounce: the allocation path calls this on every refill until the collection is over
+	if (_gcRequested.load() || _collecting.load()) {
+		return;
+	}
 	std::unique_lock lock(_mtx);
 	_gcRequested.store(true);
 	_cv.notify_all();
@@ -101,42 +162,158 @@ uint64_t GC::getGcCycles() const {
 	return _cycles.load();
 }
 
-void GC::collect() {
-	// Stop-the-world: suspend all application threads
+uint64_t GC::getPauseCount() const {
+	std::lock_guard<std::mutex> lock(_pauseMutex);
+	return _pauses.size();
+}
+
+uint64_t GC::getPauseTime(double percentile_) const {
+	std::vector<uint64_t> pauses;
+	{
+		std::lock_guard<std::mutex> lock(_pauseMutex);
+		pauses = _pauses;
+	}
+	if (pauses.empty()) {
+		return 0;
+	}
+	// nearest rank
+	auto rank = static_cast<size_t>(std::ceil(std::clamp(percentile_, 0.0, 100.0) / 100.0 * pauses.size()));
+	auto nth = pauses.begin() + (rank > 0 ? rank - 1 : 0);
+	std::nth_element(pauses.begin(), nth, pauses.end());
+	return *nth / 1000;
+}
+
+void GC::reportPauses() const {
+	if (getPauseCount() == 0) {
+		return;
+	}
+	logger.finfo("GC: {} cycles, {} pauses, p50 {}us p90 {}us p99 {}us max {}us", getGcCycles(), getPauseCount(), getPauseTime(50), getPauseTime(90),
+	             getPauseTime(99), getPauseTime(100));
+}
+
+void GC::shade(Object* obj_) {
+	_marker.shade(obj_);
+}
+
+void GC::suspendAll() {
 	for (auto& vm : _vms) {
 		vm->suspend();
 	}
-	logger.fdebug("GC: Starting garbage collection cycle... ({} objects)", _objects.size());
+}
+
+void GC::adaptHeapTarget(std::chrono::nanoseconds gcTime_, uint64_t maxPause_) {
+	const auto now = std::chrono::steady_clock::now();
+	const auto elapsed = std::chrono::duration<double>(now - _lastCycleEnd).count();
+	const auto ratio = elapsed > 0 ? std::chrono::duration<double>(gcTime_).count() / elapsed : 1.0;
+	_lastCycleEnd = now;
+	if (_targetPause && maxPause_ > _targetPause) {
+		// a smaller heap means shorter cycles
+		_growth *= 0.8;
+	} else if (ratio > GC_TIME_RATIO) {
+		// collect less often
+		_growth *= 1.25;
+	} else if (ratio < GC_TIME_RATIO / 4) {
+		// mostly idle collector: give memory back
+		_growth *= 0.9;
+	}
+	_growth = std::clamp(_growth, MIN_GROWTH, MAX_GROWTH);
+	const auto live = _heap.getAllocatedBytes();
+	const auto target = std::clamp(static_cast<uint64_t>(static_cast<double>(live) * _growth), _minHeapSize, _maxHeapSize);
+	_heapTarget.store(target);
+	if (live > _maxHeapSize) {
+		logger.fwarning("GC: {} live bytes exceed the maximum heap size {}", live, _maxHeapSize);
+	}
+	LOG_DEBUG("GC: {} live bytes, gc time ratio {:.3f}, growth {:.2f}, heap target {} bytes", live, ratio, _growth, target);
+}
 
-	// Mark reachable objects:
+void GC::resumeAll(std::chrono::steady_clock::time_point start_) {
+	for (auto& vm : _vms) {
+		vm->resume();
+	}
+	auto pause = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+	std::lock_guard<std::mutex> lock(_pauseMutex);
+	_pauses.push_back(static_cast<uint64_t>(pause));
+}
+
+void GC::markRoots() {
 	Object::makeNull()->setMarked(true);  // ensure null object is always marked
 	//  scan each thread's stacks/frames
 	//  scan static fields in loaded classes
-	//  @todo : scan thread's local JNI handles table
 	//  @todo scan global JNI handles
 	for (auto& vm : _vms) {
-		vm->visitReferences([](Object* obj) { obj->setMarked(true); });
+		vm->visitReferences([this](Object* obj) { _marker.grey(obj); });
 	}
-
-	// Sweeping: free unmarked objects
-	std::erase_if(_objects, [](const std::unique_ptr<Object>& obj) { return !obj->isMarked(); });
-	// Clear marks for next GC for live objects
-	for (const auto& obj : _objects) {
-		obj->setMarked(false);
+	std::lock_guard<std::mutex> lock(_pinMutex);
+	for (const auto& [obj, count] : _pinned) {
+		_marker.grey(obj);
 	}
+}
 
-	logger.fdebug("GC: {} live objects", _objects.size());
-	// Resume the world
-	for (auto& vm : _vms) {
-		vm->resume();
+void GC::pin(Object* obj_) {
+	std::lock_guard<std::mutex> lock(_pinMutex);
+	++_pinned[obj_];
+}
+
+void GC::unpin(Object* obj_) {
+	std::lock_guard<std::mutex> lock(_pinMutex);
+	auto it = _pinned.find(obj_);
+	if (it == _pinned.end()) {
+		throw VmException("GC: unpin of an object that is not pinned");
+	}
+	if (--it->second == 0) {
+		_pinned.erase(it);
 	}
-	_cycles.fetch_add(1);
 }
 
-void GC::track(std::unique_ptr<Object> obj_) {
-	if (_objects.size() > _limit) {
-		requestCollect();
+size_t GC::getPinnedCount() const {
+	std::lock_guard<std::mutex> lock(_pinMutex);
+	return _pinned.size();
+}
+
+void GC::collect() {
+	// the previous sweep must be over before the marks are reset
+	_heap.finishSweep();
+
+	// Stop-the-world: suspend all application threads
+	const auto cycleStart = std::chrono::steady_clock::now();
+	const auto pauses = getPauseCount();
+	auto start = cycleStart;
+	suspendAll();
+	LOG_DEBUG("GC: Starting garbage collection cycle... ({} objects)", _heap.getObjectCount());
+
+	// Mark reachable objects, objects allocated from now on are marked
+	Object::beginMarkCycle();
+	markRoots();
+	uint64_t visited = 0;
+	if (_concurrent) {
+		// trace while the threads run, the write barrier greys the references they store
+		_marking.store(true);
+		resumeAll(start);
+		visited += _marker.drain();
+		// remark: roots are not covered by the write barrier, rescan them and finish the trace
+		start = std::chrono::steady_clock::now();
+		suspendAll();
+		markRoots();
 	}
-	std::unique_lock lock(_mtx);
-	_objects.push_back(std::move(obj_));
+	visited += _marker.drain();
+	_marking.store(false);
+
+	// Sweeping: queue the arenas, unmarked objects are freed lazily
+	_heap.startSweep();
+	resumeAll(start);
+
+	// sweep in the background, allocating threads sweep as well before growing the heap
+	_heap.finishSweep();
+	uint64_t maxPause = 0;
+	{
+		std::lock_guard<std::mutex> lock(_pauseMutex);
+		for (auto i = pauses; i < _pauses.size(); ++i) {
+			maxPause = std::max(maxPause, _pauses[i] / 1000);
+		}
+	}
+	adaptHeapTarget(std::chrono::steady_clock::now() - cycleStart, maxPause);
+	LOG_DEBUG("GC: {} objects, {} visited by {} marking threads, pause p50 {}us max {}us", _heap.getObjectCount(), visited,
+	          _marker.getThreadCount(), getPauseTime(50), getPauseTime(100));
+	_cycles.fetch_add(1);
 }
+
@@ -20,13 +20,18 @@
 #define __GARBAGE_COLLECTOR_HPP__
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <deque>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "heap.hpp"
+#include "marker.hpp"
 #include "system/singleton.hpp"
 #include "system/thread.hpp"
 
@@ -34,6 +39,16 @@ namespace sandvik {
 	class Vm;
 	class Object;
 	/** @brief Garbage Collector singleton class.
+	 *
+	 * Tracing mark-sweep collector. By default the world is stopped for the whole mark; in concurrent mode
+	 * it is only stopped to scan the roots and to remark, the heap is traced while the threads run and
+	 * the write barrier greys the references stored meanwhile. Objects allocated during a cycle are black.
+	 * The heap is swept lazily after the world is resumed.
+	 *
+	 * A collection is triggered when the allocated bytes exceed the heap target. After each cycle the target is
+	 * recomputed from the live bytes and a growth factor, bounded by the minimum and maximum heap sizes: the factor
+	 * grows when the collector takes more than GC_TIME_RATIO of the time, and shrinks when a pause exceeds the
+	 * target pause or when the collector is mostly idle.
 	 */
 	class GC : public Thread, public Singleton<GC> {
 		public:
@@ -51,31 +66,153 @@ namespace sandvik {
 			 * @return number of tracked objects
 			 */
 			uint64_t getTrackedObjectCount() const;
+			/** Get the managed heap
+			 * @return heap
+			 */
+			inline Heap& getHeap() {
+				return _heap;
+			}
 
 			/** Get the number of garbage collection cycles
 			 * @return cycles
 			 */
 			uint64_t getGcCycles() const;
 
-			/** Get the object count limit
-			 * @return object count limit
+			/** default minimum heap size in bytes */
+			static constexpr uint64_t DEFAULT_MIN_HEAP_SIZE = 16 * 1024 * 1024;
+			/** default maximum heap size in bytes */
+			static constexpr uint64_t DEFAULT_MAX_HEAP_SIZE = 1024 * 1024 * 1024;
+			/** fraction of the time the collector may use before the heap grows */
+			static constexpr double GC_TIME_RATIO = 0.05;
+			/** bounds of the heap target growth factor over the live bytes */
+			static constexpr double MIN_GROWTH = 1.5;
+			static constexpr double MAX_GROWTH = 4.0;
+
+			/** Get the number of bytes allocated in the managed heap
+			 * @return allocated bytes
+			 */
+			uint64_t getAllocatedBytes() const;
+			/** Get the heap target: allocated bytes which trigger the next collection
+			 * @return heap target in bytes
+			 */
+			uint64_t getHeapTarget() const;
+			/** Get the minimum heap size
+			 * @return size in bytes
+			 */
+			uint64_t getMinHeapSize() const;
+			/** Get the maximum heap size
+			 * @return size in bytes
+			 */
+			uint64_t getMaxHeapSize() const;
+			/** Set the heap size bounds, the heap target is reset to the minimum size
+			 * @param min_ minimum heap size in bytes (-Xms)
+			 * @param max_ maximum heap size in bytes (-Xmx)
+			 */
+			void setHeapSize(uint64_t min_, uint64_t max_);
+			/** Get the pause time goal
+			 * @return pause time in microseconds, 0 without goal
+			 */
+			uint64_t getTargetPause() const;
+			/** Set the pause time goal, the heap target shrinks when a pause exceeds it
+			 * @param pause_ pause time in microseconds, 0 without goal
+			 */
+			void setTargetPause(uint64_t pause_);
+
+			/** Check if the heap is marked concurrently with the running threads
+			 * @return true in concurrent mode
+			 */
+			bool isConcurrent() const;
+			/** Enable the concurrent mark
+			 * @param concurrent_ true to mark concurrently, false to stop the world for the whole mark
 			 */
-			uint64_t getLimit() const;
+			void setConcurrent(bool concurrent_);
 
-			/** Set the object count limit
-			 * @param limit_ object count limit
+			/** Get the number of marking threads
+			 * @return thread count
 			 */
-			void setLimit(uint64_t limit_);
+			uint32_t getMarkThreads() const;
+			/** Set the number of marking threads, the GC thread being one of them
+			 * @param threads_ thread count
+			 */
+			void setMarkThreads(uint32_t threads_);
+
+			/** Get the number of recorded stop-the-world pauses
+			 * @return pause count
+			 */
+			uint64_t getPauseCount() const;
+			/** Get a stop-the-world pause time percentile
+			 * @param percentile_ percentile in ]0, 100]
+			 * @return pause time in microseconds, 0 if no pause was recorded
+			 */
+			uint64_t getPauseTime(double percentile_) const;
+			/** log the pause time percentiles */
+			void reportPauses() const;
 
 			/** release all tracked objects */
 			void release();
 			/** request garbage collection */
 			void requestCollect();
 
-			/** track allocated object
-			 * @param obj_ object to track (take ownership)
+			/** allocate memory for an object in the managed heap
+			 * @param size_ object size in bytes
+			 * @return uninitialized memory, owned by the heap
+			 */
+			inline void* allocate(size_t size_) {
+				return _heap.allocate(size_);
+			}
+			/** give back memory of an object whose construction failed
+			 * @param ptr_ memory returned by allocate
+			 */
+			inline void abandon(void* ptr_) {
+				_heap.abandon(ptr_);
+			}
+			/** construct an object in the managed heap
+			 * @param args_ constructor arguments
+			 * @return tracked object
+			 */
+			template <typename T, typename... Args>
+			T* make(Args&&... args_) {
+				void* mem = allocate(sizeof(T));
+				try {
+					return new (mem) T(std::forward<Args>(args_)...);
+				} catch (...) {
+					abandon(mem);
+					throw;
+				}
+			}
+
+			/** Check if a concurrent mark is in progress
+			 * @return true while the write barrier is enabled
+			 */
+			static inline bool isMarking() {
+				return _marking.load(std::memory_order_relaxed);
+			}
+			/** write barrier, to call when a reference is stored in an object, an array or a register
+			 * @param value_ stored reference
+			 */
+			static inline void writeBarrier(Object* value_) {
+				if (isMarking()) [[unlikely]] {
+					getInstance().shade(value_);
+				}
+			}
+			/** grey an object stored by a running thread during a concurrent mark
+			 * @param obj_ object
 			 */
-			void track(std::unique_ptr<Object> obj_);
+			void shade(Object* obj_);
+
+			/** pin an object while native code holds a pointer into its storage (JNI array elements, critical regions).
+			 * The heap never moves objects, a pinned object is kept alive as a root until its last pin is released.
+			 * @param obj_ object, pins are counted
+			 */
+			void pin(Object* obj_);
+			/** release a pin taken with pin()
+			 * @param obj_ pinned object
+			 */
+			void unpin(Object* obj_);
+			/** Get the number of pinned objects
+			 * @return object count
+			 */
+			size_t getPinnedCount() const;
 
 		protected:
 			/** @brief thread loop function of the thread implemented by subclass. */
@@ -84,21 +221,51 @@ namespace sandvik {
 			bool done() override;
 			/** @brief hook called when run() is about to start a new thread. */
 			void onStart() override;
+			/** @brief hook called by stop(), wakes the loop waiting for a collection request. */
+			void onStop() override;
 
 		private:
 			/** perform garbage collection */
 			void collect();
+			/** stop all application threads */
+			void suspendAll();
+			/** resume all application threads, record the pause
+			 * @param start_ start of the pause
+			 */
+			void resumeAll(std::chrono::steady_clock::time_point start_);
+			/** grey the roots of the managed Vms */
+			void markRoots();
+			/** compute the heap target of the next cycle
+			 * @param gcTime_ duration of the cycle
+			 * @param maxPause_ longest pause of the cycle in microseconds
+			 */
+			void adaptHeapTarget(std::chrono::nanoseconds gcTime_, uint64_t maxPause_);
 
 			// tracked objects
-			std::deque<std::unique_ptr<Object>> _objects;
+			Heap _heap;
 			// Vms
 			std::vector<Vm*> _vms;
 
-			// object count limit before triggering GC
-			uint64_t _limit = 100000;
+			// heap sizing
+			uint64_t _minHeapSize = DEFAULT_MIN_HEAP_SIZE;
+			uint64_t _maxHeapSize = DEFAULT_MAX_HEAP_SIZE;
+			std::atomic<uint64_t> _heapTarget{DEFAULT_MIN_HEAP_SIZE};
+			double _growth = 2.0;
+			uint64_t _targetPause = 0;
+			std::chrono::steady_clock::time_point _lastCycleEnd = std::chrono::steady_clock::now();
+			bool _concurrent = false;
+			Marker _marker;
+			static inline std::atomic<bool> _marking{false};
+			// objects pinned by native code, with their pin count
+			mutable std::mutex _pinMutex;
+			std::unordered_map<Object*, uint32_t> _pinned;
+			// stop-the-world pause times in nanoseconds
+			mutable std::mutex _pauseMutex;
+			std::vector<uint64_t> _pauses;
 			std::mutex _mtx;
 			std::condition_variable _cv;
 			std::atomic<bool> _gcRequested{false};
+			std::atomic<bool> _collecting{false};
 			std::atomic<bool> _done{false};
 			std::atomic<uint64_t> _cycles{0};
 	};
@@ -0,0 +1,332 @@
+/*
+ * This file is part of Sandvik project.
+ * Copyright (C) 2025 Christophe Duvernois
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "heap.hpp"
+
+#include <algorithm>
+#include <new>
+
+#include "monitor.hpp"
+#include "object.hpp"
+#include "system/logger.hpp"
+
+using namespace sandvik;
+
+thread_local Heap::Tlab Heap::_tlab;
+
+Heap::Tlab::~Tlab() {
+	if (heap) {
+		heap->unregister(*this);
+	}
+}
+
+Heap::Arena::Arena(size_t size_) {
+	base = static_cast<uint8_t*>(::operator new(size_, std::align_val_t{ALIGNMENT}));
+	top = base;
+	limit = base + size_;
+	sweepEnd = base;
+}
+
+Heap::Arena::~Arena() {
+	::operator delete(base, std::align_val_t{ALIGNMENT});
+}
+
+Heap::~Heap() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	destroyAll();
+	for (auto* tlab : _tlabs) {
+		tlab->heap = nullptr;
+	}
+}
+
+void* Heap::allocateSlow(size_t cellSize_) {
+	void* ptr = nullptr;
+	uint64_t bytes = 0;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		ptr = refill(cellSize_);
+		bytes = countBytes();
+	}
+	if (_refillCallback) {
+		_refillCallback(bytes);
+	}
+	return ptr;
+}
+
+void* Heap::refill(size_t cellSize_) {
+	auto& tlab = _tlab;
+	if (tlab.heap != this) {
+		if (tlab.heap) {
+			tlab.heap->unregister(tlab);
+		}
+		tlab.heap = this;
+		_tlabs.push_back(&tlab);
+	}
+	if (cellSize_ > LARGE_OBJECT_SIZE) {
+		auto [start, end] = carve(cellSize_, cellSize_);
+		if (static_cast<size_t>(end - start) > cellSize_) {
+			setFree(start + cellSize_, end - start - cellSize_);
+		}
+		auto* cell = reinterpret_cast<Cell*>(start);
+		*cell = {static_cast<uint32_t>(cellSize_), CellState::LIVE};
+		++_objectCount;
+		_bytes += static_cast<int64_t>(cellSize_);
+		return cell + 1;
+	}
+	retire(tlab);
+	auto [start, end] = carve(cellSize_, TLAB_SIZE);
+	tlab.cursor = start;
+	tlab.end = end;
+	return bump(tlab, cellSize_);
+}
+
+std::pair<uint8_t*, uint8_t*> Heap::carve(size_t min_, size_t preferred_) {
+	auto takeHole = [this, min_]() -> std::pair<uint8_t*, uint8_t*> {
+		auto hole = std::ranges::find_if(_holes, [min_](const auto& hole_) { return static_cast<size_t>(hole_.second - hole_.first) >= min_; });
+		if (hole == _holes.end()) {
+			return {nullptr, nullptr};
+		}
+		auto region = *hole;
+		*hole = _holes.back();
+		_holes.pop_back();
+		return region;
+	};
+	// reuse a hole left by the sweep
+	if (auto region = takeHole(); region.first) {
+		return region;
+	}
+	if (min_ <= ARENA_SIZE && (_current == nullptr || static_cast<size_t>(_current->limit - _current->top) < min_)) {
+		// lazy sweep: reclaim queued arenas before growing the heap
+		while (!_unswept.empty()) {
+			auto* arena = _unswept.back();
+			_unswept.pop_back();
+			sweepArena(*arena);
+			if (auto region = takeHole(); region.first) {
+				return region;
+			}
+		}
+	}
+	if (min_ > ARENA_SIZE) {
+		// dedicated arena, the current one keeps serving TLABs
+		_arenas.push_back(std::make_unique<Arena>(min_));
+		auto& arena = *_arenas.back();
+		arena.top = arena.limit;
+		return {arena.base, arena.limit};
+	}
+	if (_current == nullptr || static_cast<size_t>(_current->limit - _current->top) < min_) {
+		if (_current && _current->top != _current->limit) {
+			// seal the tail of the arena so it stays walkable
+			setFree(_current->top, _current->limit - _current->top);
+			_current->top = _current->limit;
+		}
+		_arenas.push_back(std::make_unique<Arena>(ARENA_SIZE));
+		_current = _arenas.back().get();
+		LOG_DEBUG("Heap: new arena, {} arenas", _arenas.size());
+	}
+	auto* start = _current->top;
+	auto size = std::min<size_t>(std::max(min_, preferred_), _current->limit - start);
+	_current->top += size;
+	return {start, start + size};
+}
+
+void Heap::retire(Tlab& tlab_) {
+	// the unused part of the TLAB is already a free cell
+	_objectCount += tlab_.count.load(std::memory_order_relaxed);
+	_bytes += tlab_.bytes.load(std::memory_order_relaxed);
+	tlab_.count.store(0, std::memory_order_relaxed);
+	tlab_.bytes.store(0, std::memory_order_relaxed);
+	tlab_.cursor = nullptr;
+	tlab_.end = nullptr;
+}
+
+void Heap::unregister(Tlab& tlab_) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	retire(tlab_);
+	std::erase(_tlabs, &tlab_);
+	tlab_.heap = nullptr;
+}
+
+void Heap::abandon(void* ptr_) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto* cell = static_cast<Cell*>(ptr_) - 1;
+	cell->state = CellState::FREE;
+	--_objectCount;
+	_bytes -= cell->size;
+}
+
+uint64_t Heap::sweep() {
+	startSweep();
+	finishSweep();
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _sweepLive;
+}
+
+void Heap::startSweep() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (auto* tlab : _tlabs) {
+		retire(*tlab);
+	}
+	// holes are rebuilt by the sweep, no TLAB may be carved from an unswept region
+	_holes.clear();
+	_unswept.clear();
+	for (const auto& arena : _arenas) {
+		arena->sweepEnd = arena->top;
+		_unswept.push_back(arena.get());
+	}
+	_sweepLive = 0;
+}
+
+bool Heap::sweepStep() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (_unswept.empty()) {
+		return false;
+	}
+	auto* arena = _unswept.back();
+	_unswept.pop_back();
+	sweepArena(*arena);
+	if (_unswept.empty()) {
+		LOG_DEBUG("Heap: {} live objects, {} arenas, {} holes", _sweepLive, _arenas.size(), _holes.size());
+	}
+	return !_unswept.empty();
+}
+
+void Heap::finishSweep() {
+	while (sweepStep()) {
+	}
+}
+
+bool Heap::isSweeping() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return !_unswept.empty();
+}
+
+void Heap::sweepArena(Arena& arena_) {
+	uint64_t arenaLive = 0;
+	int64_t destroyed = 0;
+	int64_t destroyedBytes = 0;
+	uint8_t* freeStart = nullptr;
+	std::vector<std::pair<uint8_t*, uint8_t*>> holes;
+	for (auto* p = arena_.base; p < arena_.sweepEnd;) {
+		auto* cell = reinterpret_cast<Cell*>(p);
+		if (cell->state == CellState::LIVE) {
+			auto* obj = reinterpret_cast<Object*>(cell + 1);
+			if (obj->isMarked()) {
+				++arenaLive;
+				if (freeStart) {
+					holes.emplace_back(freeStart, p);
+					freeStart = nullptr;
+				}
+			} else {
+				obj->~Object();
+				cell->state = CellState::FREE;
+				++destroyed;
+				destroyedBytes += cell->size;
+			}
+		}
+		if (cell->state == CellState::FREE && freeStart == nullptr) {
+			freeStart = p;
+		}
+		p += cell->size;
+	}
+	_objectCount -= destroyed;
+	_bytes -= destroyedBytes;
+	_sweepLive += arenaLive;
+	// cells above sweepEnd were allocated after the sweep started
+	const bool untouched = arena_.top == arena_.sweepEnd;
+	if (arenaLive == 0 && untouched && &arena_ != _current) {
+		std::erase_if(_arenas, [&arena_](const std::unique_ptr<Arena>& arena) { return arena.get() == &arena_; });
+		return;
+	}
+	if (freeStart) {
+		if (untouched && &arena_ == _current) {
+			// give the free tail back to the bump region
+			arena_.top = freeStart;
+		} else {
+			holes.emplace_back(freeStart, arena_.sweepEnd);
+		}
+	}
+	for (const auto& [start, end] : holes) {
+		// merge the free run into a single cell
+		setFree(start, end - start);
+		if (static_cast<size_t>(end - start) >= MIN_HOLE_SIZE) {
+			_holes.emplace_back(start, end);
+		}
+	}
+}
+
+void Heap::release() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	destroyAll();
+}
+
+void Heap::destroyAll() {
+	for (auto* tlab : _tlabs) {
+		retire(*tlab);
+	}
+	for (const auto& arena : _arenas) {
+		for (auto* p = arena->base; p < arena->top;) {
+			auto* cell = reinterpret_cast<Cell*>(p);
+			if (cell->state == CellState::LIVE) {
+				reinterpret_cast<Object*>(cell + 1)->~Object();
+			}
+			p += cell->size;
+		}
+	}
+	_arenas.clear();
+	_holes.clear();
+	_unswept.clear();
+	_current = nullptr;
+	_objectCount = 0;
+	_bytes = 0;
+}
+
+void Heap::setRefillCallback(std::function<void(uint64_t)> callback_) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_refillCallback = std::move(callback_);
+}
+
+uint64_t Heap::getObjectCount() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return countObjects();
+}
+
+uint64_t Heap::countObjects() const {
+	int64_t count = _objectCount;
+	for (const auto* tlab : _tlabs) {
+		count += tlab->count.load(std::memory_order_relaxed);
+	}
+	return static_cast<uint64_t>(count);
+}
+
+uint64_t Heap::getAllocatedBytes() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return countBytes();
+}
+
+uint64_t Heap::countBytes() const {
+	int64_t bytes = _bytes + _externalBytes.load(std::memory_order_relaxed);
+	for (const auto* tlab : _tlabs) {
+		bytes += tlab->bytes.load(std::memory_order_relaxed);
+	}
+	return static_cast<uint64_t>(std::max<int64_t>(bytes, 0));
+}
+
+uint64_t Heap::getArenaCount() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _arenas.size();
+}
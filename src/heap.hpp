@@ -0,0 +1,204 @@
+/*
+ * This file is part of Sandvik project.
+ * Copyright (C) 2025 Christophe Duvernois
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __HEAP_HPP__
+#define __HEAP_HPP__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace sandvik {
+	class Object;
+	/** @brief Managed heap: objects are bump allocated in thread local allocation buffers (TLAB) carved from arenas.
+	 *
+	 * An arena is a large block split into cells. Each cell starts with a header giving its size and state, so
+	 * the sweep can walk an arena from its base to its top. A thread allocates by bumping the cursor of its TLAB;
+	 * the heap lock is only taken to refill the TLAB or to allocate a large object.
+	 * Objects never move. After a sweep, runs of free cells become holes which are handed out as TLABs again,
+	 * and arenas without live objects are released.
+	 * The sweep is lazy: startSweep() only queues the arenas, which are then swept one at a time by sweepStep()
+	 * or by the allocation path before it grows the heap. Objects allocated meanwhile are never in an unswept region.
+	 */
+	class Heap {
+		public:
+			/** alignment of every cell and object */
+			static constexpr size_t ALIGNMENT = 16;
+			/** size of an arena */
+			static constexpr size_t ARENA_SIZE = 4 * 1024 * 1024;
+			/** size of a TLAB carved from the top of an arena */
+			static constexpr size_t TLAB_SIZE = 32 * 1024;
+			/** allocations larger than this are made directly in an arena, under the heap lock */
+			static constexpr size_t LARGE_OBJECT_SIZE = TLAB_SIZE / 4;
+			/** free runs smaller than this are not reused until their neighbours die */
+			static constexpr size_t MIN_HOLE_SIZE = 256;
+
+			Heap() = default;
+			~Heap();
+			Heap(const Heap&) = delete;
+			Heap& operator=(const Heap&) = delete;
+
+			/** @brief Allocates memory for an object in the TLAB of the calling thread.
+			 * @param size_ object size in bytes
+			 * @return uninitialized memory aligned on ALIGNMENT
+			 */
+			inline void* allocate(size_t size_) {
+				const auto cellSize = cellSizeOf(size_);
+				auto& tlab = _tlab;
+				if (tlab.heap == this && static_cast<size_t>(tlab.end - tlab.cursor) >= cellSize && cellSize <= LARGE_OBJECT_SIZE) [[likely]] {
+					return bump(tlab, cellSize);
+				}
+				return allocateSlow(cellSize);
+			}
+			/** @brief Gives back memory returned by allocate() when the object construction failed.
+			 * @param ptr_ memory returned by allocate()
+			 */
+			void abandon(void* ptr_);
+
+			/** @brief Sweeps the whole heap: destroys the objects which are not marked.
+			 * Must be called while no thread allocates (stop-the-world).
+			 * @return number of live objects
+			 */
+			uint64_t sweep();
+			/** @brief Queues all arenas for a lazy sweep.
+			 * Must be called while no thread allocates (stop-the-world), after marking.
+			 */
+			void startSweep();
+			/** @brief Sweeps one queued arena, can be called while other threads allocate.
+			 * @return true if arenas remain to be swept
+			 */
+			bool sweepStep();
+			/** @brief Sweeps all queued arenas. */
+			void finishSweep();
+			/** @brief Checks if some arenas are not swept yet.
+			 * @return true if a lazy sweep is in progress
+			 */
+			bool isSweeping() const;
+			/** @brief Destroys all objects and releases all arenas. */
+			void release();
+
+			/** @brief Gets the number of allocated objects (live objects after a sweep).
+			 * @return object count
+			 */
+			uint64_t getObjectCount() const;
+			/** @brief Gets the number of bytes allocated: cells in the arenas and external storage of the objects.
+			 * @return allocated bytes
+			 */
+			uint64_t getAllocatedBytes() const;
+			/** @brief Accounts storage allocated by an object outside of its cell (array elements, ...).
+			 * Lock free, can be called from an object destructor during the sweep.
+			 * @param bytes_ bytes allocated, negative when released
+			 */
+			inline void addExternalBytes(int64_t bytes_) {
+				_externalBytes.fetch_add(bytes_, std::memory_order_relaxed);
+			}
+			/** @brief Sets the function called, without the heap lock, after a TLAB refill or a large allocation.
+			 * @param callback_ function receiving the number of allocated bytes (see getAllocatedBytes)
+			 */
+			void setRefillCallback(std::function<void(uint64_t)> callback_);
+			/** @brief Gets the number of arenas.
+			 * @return arena count
+			 */
+			uint64_t getArenaCount() const;
+
+		private:
+			enum class CellState : uint32_t { FREE = 0, LIVE = 1 };
+			/** header of a cell */
+			struct alignas(ALIGNMENT) Cell {
+					uint32_t size;
+					CellState state;
+			};
+			/** thread local allocation buffer, cells are allocated from cursor to end */
+			struct Tlab {
+					uint8_t* cursor = nullptr;
+					uint8_t* end = nullptr;
+					/** objects and bytes allocated since the TLAB was handed out, only written by the owner thread */
+					std::atomic<uint64_t> count = 0;
+					std::atomic<uint64_t> bytes = 0;
+					Heap* heap = nullptr;
+					~Tlab();
+			};
+			struct Arena {
+					explicit Arena(size_t size_);
+					~Arena();
+					uint8_t* base;
+					uint8_t* top;
+					uint8_t* limit;
+					/** top of the arena when the sweep started, cells above were allocated after marking */
+					uint8_t* sweepEnd;
+			};
+
+			static constexpr size_t cellSizeOf(size_t size_) {
+				return (sizeof(Cell) + size_ + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+			}
+			static inline void setFree(uint8_t* start_, size_t size_) {
+				*reinterpret_cast<Cell*>(start_) = {static_cast<uint32_t>(size_), CellState::FREE};
+			}
+			static inline void* bump(Tlab& tlab_, size_t cellSize_) {
+				auto* cell = reinterpret_cast<Cell*>(tlab_.cursor);
+				tlab_.cursor += cellSize_;
+				*cell = {static_cast<uint32_t>(cellSize_), CellState::LIVE};
+				// keep the rest of the TLAB walkable
+				if (tlab_.cursor != tlab_.end) {
+					setFree(tlab_.cursor, tlab_.end - tlab_.cursor);
+				}
+				tlab_.count.store(tlab_.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				tlab_.bytes.store(tlab_.bytes.load(std::memory_order_relaxed) + cellSize_, std::memory_order_relaxed);
+				return cell + 1;
+			}
+
+			void* allocateSlow(size_t cellSize_);
+			void* refill(size_t cellSize_);
+			uint64_t countObjects() const;
+			uint64_t countBytes() const;
+			/** carve a free region of at least min_ bytes, preferably preferred_ bytes (heap lock held) */
+			std::pair<uint8_t*, uint8_t*> carve(size_t min_, size_t preferred_);
+			/** detach a TLAB from the heap, its objects are accounted in the heap (heap lock held) */
+			void retire(Tlab& tlab_);
+			/** destroy the unmarked objects of an arena and collect its holes (heap lock held) */
+			void sweepArena(Arena& arena_);
+			void unregister(Tlab& tlab_);
+			void destroyAll();
+
+			static thread_local Tlab _tlab;
+
+			mutable std::mutex _mutex;
+			std::vector<std::unique_ptr<Arena>> _arenas;
+			/** arena the TLABs are carved from */
+			Arena* _current = nullptr;
+			/** free regions found by the last sweep */
+			std::vector<std::pair<uint8_t*, uint8_t*>> _holes;
+			std::vector<Tlab*> _tlabs;
+			/** arenas queued by startSweep() */
+			std::vector<Arena*> _unswept;
+			/** marked objects found by the current sweep */
+			uint64_t _sweepLive = 0;
+			/** objects and cell bytes not accounted in a TLAB */
+			int64_t _objectCount = 0;
+			int64_t _bytes = 0;
+			std::atomic<int64_t> _externalBytes = 0;
+			std::function<void(uint64_t)> _refillCallback;
+	};
+}  // namespace sandvik
+
+#endif  // __HEAP_HPP__
@@ -0,0 +1,57 @@
+/*
+ * This file is part of Sandvik project.
+ * Copyright (C) 2025 Christophe Duvernois
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "inlinecache.hpp"
+
+using namespace sandvik;
+
+void InlineCache::record(const Class* class_, Method* target_) {
+	if (_megamorphic.load(std::memory_order_relaxed)) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(_mutex);
+	const auto count = _count.load(std::memory_order_relaxed);
+	for (uint32_t i = 0; i < count; ++i) {
+		if (_entries[i].receiver == class_) {
+			// recorded by another thread
+			return;
+		}
+	}
+	if (count == SIZE) {
+		_megamorphic.store(true, std::memory_order_relaxed);
+		return;
+	}
+	_entries[count] = {class_, target_};
+	_count.store(count + 1, std::memory_order_release);
+}
+
+uint32_t InlineCache::size() const {
+	return _count.load(std::memory_order_acquire);
+}
+
+bool InlineCache::isMegamorphic() const {
+	return _megamorphic.load(std::memory_order_relaxed);
+}
+
+uint64_t InlineCache::hits() const {
+	return _hits.load(std::memory_order_relaxed);
+}
+
+uint64_t InlineCache::misses() const {
+	return _misses.load(std::memory_order_relaxed);
+}
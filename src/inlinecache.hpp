@@ -0,0 +1,112 @@
+/*
+ * This file is part of Sandvik project.
+ * Copyright (C) 2025 Christophe Duvernois
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __INLINE_CACHE_HPP__
+#define __INLINE_CACHE_HPP__
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace sandvik {
+	class Class;
+	class Method;
+	/**
+	 * @class InlineCache
+	 * @brief Inline cache of an invoke call site.
+	 *
+	 * Records the receiver classes seen by an invoke-virtual or invoke-interface instruction with the method they
+	 * dispatch to. A site with one receiver class is monomorphic, with up to SIZE classes polymorphic. Once full, the
+	 * site is megamorphic: new receiver classes are no longer recorded and are dispatched through the vtable.
+	 *
+	 * Lookups are lock free: an entry is written before it is published by incrementing the entry count, and is never
+	 * modified afterwards. Recording is serialized by a mutex, it only happens on a miss.
+	 *
+	 * Hits and misses are counted to tune the cache size. Configuring with --strip-cache-stats (__strip_cache_stats__)
+	 * compiles the counting out of the dispatch path, hits() and misses() then return 0.
+	 */
+	class InlineCache {
+		public:
+			/** maximum number of receiver classes of a polymorphic site */
+			static constexpr uint32_t SIZE = 4;
+
+			InlineCache() = default;
+			InlineCache(const InlineCache&) = delete;
+			InlineCache& operator=(const InlineCache&) = delete;
+
+			/** @brief Looks up the target method for a receiver class, counting a hit or a miss.
+			 * @param class_ receiver class
+			 * @return target method, nullptr on a miss
+			 */
+			inline Method* lookup(const Class* class_) {
+				const auto count = _count.load(std::memory_order_acquire);
+				for (uint32_t i = 0; i < count; ++i) {
+					if (_entries[i].receiver == class_) {
+						increment(_hits);
+						return _entries[i].target;
+					}
+				}
+				increment(_misses);
+				return nullptr;
+			}
+			/** @brief Records the target method of a receiver class, ignored if the site is megamorphic.
+			 * @param class_ receiver class
+			 * @param target_ method the receiver dispatches to
+			 */
+			void record(const Class* class_, Method* target_);
+
+			/** @brief Gets the number of receiver classes recorded.
+			 * @return number of entries
+			 */
+			uint32_t size() const;
+			/** @brief Checks if the site has seen more receiver classes than the cache can hold.
+			 * @return true if the site is megamorphic
+			 */
+			bool isMegamorphic() const;
+			/** @brief Gets the number of lookups that found their receiver class.
+			 * @return hit count
+			 */
+			uint64_t hits() const;
+			/** @brief Gets the number of lookups that missed.
+			 * @return miss count
+			 */
+			uint64_t misses() const;
+
+		private:
+			/** statistics only: a plain load/store avoids a locked instruction, concurrent increments may be lost */
+			static inline void increment(std::atomic<uint64_t>& counter_) {
+#ifndef __strip_cache_stats__
+				counter_.store(counter_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+#endif
+			}
+
+			struct Entry {
+					const Class* receiver = nullptr;
+					Method* target = nullptr;
+			};
+			std::array<Entry, SIZE> _entries;
+			std::atomic<uint32_t> _count = 0;
+			std::atomic<bool> _megamorphic = false;
+			std::atomic<uint64_t> _hits = 0;
+			std::atomic<uint64_t> _misses = 0;
+			std::mutex _mutex;
+	};
+}  // namespace sandvik
+
+#endif  // __INLINE_CACHE_HPP__
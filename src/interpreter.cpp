@@ -21,8 +21,10 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <functional>
-#include <regex>
+#include <utility>
 
 #include "array.hpp"
 #include "class.hpp"
@@ -34,8 +36,10 @@
 #include "jni.hpp"
 #include "jnihelper.hpp"
 #include "jthread.hpp"
+#include "loader/dex.hpp"
 #include "method.hpp"
 #include "native_call.hpp"
+#include "native_utils.hpp"
 #include "object.hpp"
 #include "system/logger.hpp"
 #include "trace.hpp"
@@ -45,6 +49,7 @@
 using namespace sandvik;
 
 Interpreter::Interpreter(JThread& rt_) : _rt(rt_) {
+#ifdef __legacy_dispatch__
 	_dispatch.resize(256, [](const uint8_t*) { throw VmException("Invalid instruction!"); });
 
 	_dispatch[0x00] = std::bind_front(&Interpreter::nop, this);
@@ -269,6 +274,7 @@ Interpreter::Interpreter(JThread& rt_) : _rt(rt_) {
 	_dispatch[0xE1] = std::bind_front(&Interpreter::shr_int_lit8, this);
 	_dispatch[0xE2] = std::bind_front(&Interpreter::ushr_int_lit8, this);
 	// 0xE3 ... 0xFF (unused)
+#endif
 }
 
 Interpreter::~Interpreter() {
@@ -292,11 +298,679 @@ Interpreter::~Interpreter() {
 #endif
 }
 
+void Interpreter::dispatch(const uint8_t* bytecode_) {
+	const uint8_t* operand_ = bytecode_ + 1;
+	switch (*bytecode_) {
+		case 0x00:
+			nop(operand_);
+			break;
+		case 0x01:
+			move(operand_);
+			break;
+		case 0x02:
+			move_from16(operand_);
+			break;
+		case 0x03:
+			move_16(operand_);
+			break;
+		case 0x04:
+			move_wide(operand_);
+			break;
+		case 0x05:
+			move_wide_from16(operand_);
+			break;
+		case 0x06:
+			move_wide16(operand_);
+			break;
+		case 0x07:
+			move_object(operand_);
+			break;
+		case 0x08:
+			move_object_from16(operand_);
+			break;
+		case 0x09:
+			move_object16(operand_);
+			break;
+		case 0x0A:
+			move_result(operand_);
+			break;
+		case 0x0B:
+			move_result_wide(operand_);
+			break;
+		case 0x0C:
+			move_result_object(operand_);
+			break;
+		case 0x0D:
+			move_exception(operand_);
+			break;
+		case 0x0E:
+			return_void(operand_);
+			break;
+		case 0x0F:
+			return_(operand_);
+			break;
+		case 0x10:
+			return_wide(operand_);
+			break;
+		case 0x11:
+			return_object(operand_);
+			break;
+		case 0x12:
+			const_4(operand_);
+			break;
+		case 0x13:
+			const_16(operand_);
+			break;
+		case 0x14:
+			const_(operand_);
+			break;
+		case 0x15:
+			const_high16(operand_);
+			break;
+		case 0x16:
+			const_wide_16(operand_);
+			break;
+		case 0x17:
+			const_wide_32(operand_);
+			break;
+		case 0x18:
+			const_wide(operand_);
+			break;
+		case 0x19:
+			const_wide_high16(operand_);
+			break;
+		case 0x1A:
+			const_string(operand_);
+			break;
+		case 0x1B:
+			const_string_jumbo(operand_);
+			break;
+		case 0x1C:
+			const_class(operand_);
+			break;
+		case 0x1D:
+			monitor_enter(operand_);
+			break;
+		case 0x1E:
+			monitor_exit(operand_);
+			break;
+		case 0x1F:
+			check_cast(operand_);
+			break;
+		case 0x20:
+			instance_of(operand_);
+			break;
+		case 0x21:
+			array_length(operand_);
+			break;
+		case 0x22:
+			new_instance(operand_);
+			break;
+		case 0x23:
+			new_array(operand_);
+			break;
+		case 0x24:
+			filled_new_array(operand_);
+			break;
+		case 0x25:
+			filled_new_array_range(operand_);
+			break;
+		case 0x26:
+			fill_array_data(operand_);
+			break;
+		case 0x27:
+			throw_(operand_);
+			break;
+		case 0x28:
+			goto_(operand_);
+			break;
+		case 0x29:
+			goto_16(operand_);
+			break;
+		case 0x2A:
+			goto_32(operand_);
+			break;
+		case 0x2B:
+			packed_switch(operand_);
+			break;
+		case 0x2C:
+			sparse_switch(operand_);
+			break;
+		case 0x2D:
+			cmpl_float(operand_);
+			break;
+		case 0x2E:
+			cmpg_float(operand_);
+			break;
+		case 0x2F:
+			cmpl_double(operand_);
+			break;
+		case 0x30:
+			cmpg_double(operand_);
+			break;
+		case 0x31:
+			cmp_long(operand_);
+			break;
+		case 0x32:
+			if_eq(operand_);
+			break;
+		case 0x33:
+			if_ne(operand_);
+			break;
+		case 0x34:
+			if_lt(operand_);
+			break;
+		case 0x35:
+			if_ge(operand_);
+			break;
+		case 0x36:
+			if_gt(operand_);
+			break;
+		case 0x37:
+			if_le(operand_);
+			break;
+		case 0x38:
+			if_eqz(operand_);
+			break;
+		case 0x39:
+			if_nez(operand_);
+			break;
+		case 0x3A:
+			if_ltz(operand_);
+			break;
+		case 0x3B:
+			if_gez(operand_);
+			break;
+		case 0x3C:
+			if_gtz(operand_);
+			break;
+		case 0x3D:
+			if_lez(operand_);
+			break;
+		// 0x3E ... 0x43 (unused)
+		case 0x44:
+			aget(operand_);
+			break;
+		case 0x45:
+			aget_wide(operand_);
+			break;
+		case 0x46:
+			aget_object(operand_);
+			break;
+		case 0x47:
+			aget_boolean(operand_);
+			break;
+		case 0x48:
+			aget_byte(operand_);
+			break;
+		case 0x49:
+			aget_char(operand_);
+			break;
+		case 0x4A:
+			aget_short(operand_);
+			break;
+		case 0x4B:
+			aput(operand_);
+			break;
+		case 0x4C:
+			aput_wide(operand_);
+			break;
+		case 0x4D:
+			aput_object(operand_);
+			break;
+		case 0x4E:
+			aput_boolean(operand_);
+			break;
+		case 0x4F:
+			aput_byte(operand_);
+			break;
+		case 0x50:
+			aput_char(operand_);
+			break;
+		case 0x51:
+			aput_short(operand_);
+			break;
+		case 0x52:
+			iget(operand_);
+			break;
+		case 0x53:
+			iget_wide(operand_);
+			break;
+		case 0x54:
+			iget_object(operand_);
+			break;
+		case 0x55:
+			iget_boolean(operand_);
+			break;
+		case 0x56:
+			iget_byte(operand_);
+			break;
+		case 0x57:
+			iget_char(operand_);
+			break;
+		case 0x58:
+			iget_short(operand_);
+			break;
+		case 0x59:
+			iput(operand_);
+			break;
+		case 0x5A:
+			iput_wide(operand_);
+			break;
+		case 0x5B:
+			iput_object(operand_);
+			break;
+		case 0x5C:
+			iput_boolean(operand_);
+			break;
+		case 0x5D:
+			iput_byte(operand_);
+			break;
+		case 0x5E:
+			iput_char(operand_);
+			break;
+		case 0x5F:
+			iput_short(operand_);
+			break;
+		case 0x60:
+			sget(operand_);
+			break;
+		case 0x61:
+			sget_wide(operand_);
+			break;
+		case 0x62:
+			sget_object(operand_);
+			break;
+		case 0x63:
+			sget_boolean(operand_);
+			break;
+		case 0x64:
+			sget_byte(operand_);
+			break;
+		case 0x65:
+			sget_char(operand_);
+			break;
+		case 0x66:
+			sget_short(operand_);
+			break;
+		case 0x67:
+			sput(operand_);
+			break;
+		case 0x68:
+			sput_wide(operand_);
+			break;
+		case 0x69:
+			sput_object(operand_);
+			break;
+		case 0x6A:
+			sput_boolean(operand_);
+			break;
+		case 0x6B:
+			sput_byte(operand_);
+			break;
+		case 0x6C:
+			sput_char(operand_);
+			break;
+		case 0x6D:
+			sput_short(operand_);
+			break;
+		case 0x6E:
+			invoke_virtual(operand_);
+			break;
+		case 0x6F:
+			invoke_super(operand_);
+			break;
+		case 0x70:
+			invoke_direct(operand_);
+			break;
+		case 0x71:
+			invoke_static(operand_);
+			break;
+		case 0x72:
+			invoke_interface(operand_);
+			break;
+		// 73 unused
+		case 0x74:
+			invoke_virtual_range(operand_);
+			break;
+		case 0x75:
+			invoke_super_range(operand_);
+			break;
+		case 0x76:
+			invoke_direct_range(operand_);
+			break;
+		case 0x77:
+			invoke_static_range(operand_);
+			break;
+		case 0x78:
+			invoke_interface_range(operand_);
+			break;
+		// 0x79 ... 0x7A (unused)
+		case 0x7B:
+			neg_int(operand_);
+			break;
+		case 0x7C:
+			not_int(operand_);
+			break;
+		case 0x7D:
+			neg_long(operand_);
+			break;
+		case 0x7E:
+			not_long(operand_);
+			break;
+		case 0x7F:
+			neg_float(operand_);
+			break;
+		case 0x80:
+			neg_double(operand_);
+			break;
+		case 0x81:
+			int_to_long(operand_);
+			break;
+		case 0x82:
+			int_to_float(operand_);
+			break;
+		case 0x83:
+			int_to_double(operand_);
+			break;
+		case 0x84:
+			long_to_int(operand_);
+			break;
+		case 0x85:
+			long_to_float(operand_);
+			break;
+		case 0x86:
+			long_to_double(operand_);
+			break;
+		case 0x87:
+			float_to_int(operand_);
+			break;
+		case 0x88:
+			float_to_long(operand_);
+			break;
+		case 0x89:
+			float_to_double(operand_);
+			break;
+		case 0x8A:
+			double_to_int(operand_);
+			break;
+		case 0x8B:
+			double_to_long(operand_);
+			break;
+		case 0x8C:
+			double_to_float(operand_);
+			break;
+		case 0x8D:
+			int_to_byte(operand_);
+			break;
+		case 0x8E:
+			int_to_char(operand_);
+			break;
+		case 0x8F:
+			int_to_short(operand_);
+			break;
+		case 0x90:
+			add_int(operand_);
+			break;
+		case 0x91:
+			sub_int(operand_);
+			break;
+		case 0x92:
+			mul_int(operand_);
+			break;
+		case 0x93:
+			div_int(operand_);
+			break;
+		case 0x94:
+			rem_int(operand_);
+			break;
+		case 0x95:
+			and_int(operand_);
+			break;
+		case 0x96:
+			or_int(operand_);
+			break;
+		case 0x97:
+			xor_int(operand_);
+			break;
+		case 0x98:
+			shl_int(operand_);
+			break;
+		case 0x99:
+			shr_int(operand_);
+			break;
+		case 0x9A:
+			ushr_int(operand_);
+			break;
+		case 0x9B:
+			add_long(operand_);
+			break;
+		case 0x9C:
+			sub_long(operand_);
+			break;
+		case 0x9D:
+			mul_long(operand_);
+			break;
+		case 0x9E:
+			div_long(operand_);
+			break;
+		case 0x9F:
+			rem_long(operand_);
+			break;
+		case 0xA0:
+			and_long(operand_);
+			break;
+		case 0xA1:
+			or_long(operand_);
+			break;
+		case 0xA2:
+			xor_long(operand_);
+			break;
+		case 0xA3:
+			shl_long(operand_);
+			break;
+		case 0xA4:
+			shr_long(operand_);
+			break;
+		case 0xA5:
+			ushr_long(operand_);
+			break;
+		case 0xA6:
+			add_float(operand_);
+			break;
+		case 0xA7:
+			sub_float(operand_);
+			break;
+		case 0xA8:
+			mul_float(operand_);
+			break;
+		case 0xA9:
+			div_float(operand_);
+			break;
+		case 0xAA:
+			rem_float(operand_);
+			break;
+		case 0xAB:
+			add_double(operand_);
+			break;
+		case 0xAC:
+			sub_double(operand_);
+			break;
+		case 0xAD:
+			mul_double(operand_);
+			break;
+		case 0xAE:
+			div_double(operand_);
+			break;
+		case 0xAF:
+			rem_double(operand_);
+			break;
+		case 0xB0:
+			add_int_2addr(operand_);
+			break;
+		case 0xB1:
+			sub_int_2addr(operand_);
+			break;
+		case 0xB2:
+			mul_int_2addr(operand_);
+			break;
+		case 0xB3:
+			div_int_2addr(operand_);
+			break;
+		case 0xB4:
+			rem_int_2addr(operand_);
+			break;
+		case 0xB5:
+			and_int_2addr(operand_);
+			break;
+		case 0xB6:
+			or_int_2addr(operand_);
+			break;
+		case 0xB7:
+			xor_int_2addr(operand_);
+			break;
+		case 0xB8:
+			shl_int_2addr(operand_);
+			break;
+		case 0xB9:
+			shr_int_2addr(operand_);
+			break;
+		case 0xBA:
+			ushr_int_2addr(operand_);
+			break;
+		case 0xBB:
+			add_long_2addr(operand_);
+			break;
+		case 0xBC:
+			sub_long_2addr(operand_);
+			break;
+		case 0xBD:
+			mul_long_2addr(operand_);
+			break;
+		case 0xBE:
+			div_long_2addr(operand_);
+			break;
+		case 0xBF:
+			rem_long_2addr(operand_);
+			break;
+		case 0xC0:
+			and_long_2addr(operand_);
+			break;
+		case 0xC1:
+			or_long_2addr(operand_);
+			break;
+		case 0xC2:
+			xor_long_2addr(operand_);
+			break;
+		case 0xC3:
+			shl_long_2addr(operand_);
+			break;
+		case 0xC4:
+			shr_long_2addr(operand_);
+			break;
+		case 0xC5:
+			ushr_long_2addr(operand_);
+			break;
+		case 0xC6:
+			add_float_2addr(operand_);
+			break;
+		case 0xC7:
+			sub_float_2addr(operand_);
+			break;
+		case 0xC8:
+			mul_float_2addr(operand_);
+			break;
+		case 0xC9:
+			div_float_2addr(operand_);
+			break;
+		case 0xCA:
+			rem_float_2addr(operand_);
+			break;
+		case 0xCB:
+			add_double_2addr(operand_);
+			break;
+		case 0xCC:
+			sub_double_2addr(operand_);
+			break;
+		case 0xCD:
+			mul_double_2addr(operand_);
+			break;
+		case 0xCE:
+			div_double_2addr(operand_);
+			break;
+		case 0xCF:
+			rem_double_2addr(operand_);
+			break;
+		case 0xD0:
+			add_int_lit16(operand_);
+			break;
+		case 0xD1:
+			rsub_int_lit16(operand_);
+			break;
+		case 0xD2:
+			mul_int_lit16(operand_);
+			break;
+		case 0xD3:
+			div_int_lit16(operand_);
+			break;
+		case 0xD4:
+			rem_int_lit16(operand_);
+			break;
+		case 0xD5:
+			and_int_lit16(operand_);
+			break;
+		case 0xD6:
+			or_int_lit16(operand_);
+			break;
+		case 0xD7:
+			xor_int_lit16(operand_);
+			break;
+		case 0xD8:
+			add_int_lit8(operand_);
+			break;
+		case 0xD9:
+			rsub_int_lit8(operand_);
+			break;
+		case 0xDA:
+			mul_int_lit8(operand_);
+			break;
+		case 0xDB:
+			div_int_lit8(operand_);
+			break;
+		case 0xDC:
+			rem_int_lit8(operand_);
+			break;
+		case 0xDD:
+			and_int_lit8(operand_);
+			break;
+		case 0xDE:
+			or_int_lit8(operand_);
+			break;
+		case 0xDF:
+			xor_int_lit8(operand_);
+			break;
+		case 0xE0:
+			shl_int_lit8(operand_);
+			break;
+		case 0xE1:
+			shr_int_lit8(operand_);
+			break;
+		case 0xE2:
+			ushr_int_lit8(operand_);
+			break;
+		// 0xE3 ... 0xFF (unused)
+		default:
+			throw VmException("Invalid instruction!");
+	}
+}
+
+#ifdef __legacy_dispatch__
 void Interpreter::execute() {
 	auto& frame = _rt.currentFrame();
+	_frame = &frame;
 	const auto& method = frame.getMethod();
 	auto code = method.getBytecode();
-	auto func = fmt::format("{}::{}{}", method.getClass().getFullname(), method.getName(), method.getSignature());
+	auto func = method.getFullname();
 	if (code == nullptr) {
 		throw VmException("Method {} has no bytecode!", func);
 	}
@@ -304,79 +978,305 @@ void Interpreter::execute() {
 		throw VmException("Current frame {} has invalid pc: {}", func, frame.pc());
 	}
 	auto bytecode = code + frame.pc();
-	trace.logInstruction(frame.pc(), func, bytecode);
+	if (trace.isInstructionTraceEnabled()) {
+		trace.logInstruction(frame.pc(), func, bytecode);
+	}
 	frame.pc()++;
 	_instcoverage[*bytecode]++;
 	try {
 		_dispatch[*bytecode](bytecode + 1);
 	} catch (JavaException& e) {
-		auto exctype = e.getExceptionType();
-		logger.fdebug("handling exception {} ({}) in method {}", exctype, e.what(), func);
-		auto exc = Object::make(_rt.getClassLoader().getOrLoad(exctype));
-		exc->setField("detailMessage", Object::make(_rt.getClassLoader(), e.getMessage()));
-		handleException(exc);
+		LOG_DEBUG("handling exception {} ({}) in method {}", e.getExceptionType(), e.what(), func);
+		raise(e);
+	}
+	if (_pendingException != nullptr) [[unlikely]] {
+		handleException(std::exchange(_pendingException, nullptr));
 	}
 }
+#else
+void Interpreter::execute() {
+	auto& frame = _rt.currentFrame();
+	_frame = &frame;
+	const auto& method = frame.getMethod();
+	const auto code = method.getBytecode();
+	const auto codeSize = method.getBytecodeSize();
+	const auto depth = _rt.stackDepth();
+	const auto func = method.getFullname();
+	auto& tracer = trace;
+	if (code == nullptr) {
+		throw VmException("Method {} has no bytecode!", func);
+	}
+	// the handlers move the pc of the frame, the loop reads it through a reference instead of the accessor
+	auto& pc = frame.pc();
+	try {
+		// run the current frame until a safepoint : invoke, return, exception or suspend/stop request
+		do {
+			if (pc >= codeSize) {
+				throw VmException("Current frame {} has invalid pc: {}", func, pc);
+			}
+			auto bytecode = code + pc;
+			if (tracer.isInstructionTraceEnabled()) [[unlikely]] {
+				tracer.logInstruction(pc, func, bytecode);
+			}
+			pc++;
+#ifdef __debug__
+			_instcoverage[*bytecode]++;
+#endif
+			dispatch(bytecode);
+		} while (_pendingException == nullptr && _rt.stackDepth() == depth && !_rt.isInterruptRequested());
+	} catch (JavaException& e) {
+		// exceptions thrown by natives and runtime helpers, opcode handlers raise them as pending exceptions
+		LOG_DEBUG("handling exception {} ({}) in method {}", e.getExceptionType(), e.what(), func);
+		raise(e);
+	}
+	if (_pendingException != nullptr) [[unlikely]] {
+		handleException(std::exchange(_pendingException, nullptr));
+	}
+}
+#endif
 
-void Interpreter::executeClinit(Class& class_) const {
-	auto hasInitializeMethod = class_.hasMethod("initializeSystemClass", "()V");
-	auto hasClinitMethod = class_.hasMethod("<clinit>", "()V");
-	if (!hasInitializeMethod && !hasClinitMethod) {
-		// Nothing to do
+void Interpreter::executeClinit(Class& class_) {
+	if (!class_.beginInitialization()) {
+		// initialized meanwhile by another thread, or recursive request from the initializer
 		return;
 	}
-	// Create a new thread to execute the <clinit> method
-	auto& thread = _rt.vm().newThread(fmt::format("{}.{}", class_.getFullname(), "<clinit>"));
-	if (hasInitializeMethod) {
-		// push new frame with initializeSystemClass method (should be executed after <clinit>)
-		auto& initializeSystemClass = class_.getMethod("initializeSystemClass", "()V");
-		thread.newFrame(initializeSystemClass);
+	try {
+		if (class_.hasSuperClass()) {
+			auto& superClass = class_.getSuperClass();
+			if (!superClass.isStaticInitialized()) {
+				executeClinit(superClass);
+			}
+		}
+		if (class_.hasMethod("<clinit>", "()V")) {
+			auto& clinitMethod = class_.getMethod("<clinit>", "()V");
+			if (clinitMethod.isNative()) {
+				throw VmException("Native <clinit> method for class {} is not supported!", class_.getFullname());
+			}
+			if (!clinitMethod.hasBytecode()) {
+				throw VmException("<clinit> method for class {} has no bytecode!", class_.getFullname());
+			}
+			executeNested(clinitMethod);
+		}
+		if (class_.hasMethod("initializeSystemClass", "()V")) {
+			// executed after <clinit>
+			executeNested(class_.getMethod("initializeSystemClass", "()V"));
+		}
+	} catch (const JavaException& e) {
+		class_.endInitialization(false);
+		auto& thrownClass = e.getThrowable() != nullptr ? e.getThrowable()->getClass() : _rt.vm().getThrowableClass(e.getExceptionType());
+		if (thrownClass.isInstanceOf(_rt.vm().getThrowableClass(Vm::Throwable::ERROR))) {
+			throw;
+		}
+		// the error wraps the exception thrown by the initializer
+		auto& errorClass = _rt.vm().getThrowableClass(Vm::Throwable::EXCEPTION_IN_INITIALIZER);
+		auto message = fmt::format("{} in {}.<clinit>: {}", e.getExceptionType(), class_.getFullname(), e.getMessage());
+		auto error = Object::make(errorClass);
+		error->setField("detailMessage", Object::make(_rt.getClassLoader(), message));
+		if (e.getThrowable() != nullptr) {
+			error->setField("exception", e.getThrowable());
+		}
+		throw JavaException(error, errorClass.getFullname(), message);
+	} catch (...) {
+		class_.endInitialization(false);
+		throw;
+	}
+	class_.endInitialization(true);
+}
+
+void Interpreter::executeNested(Method& method_) {
+	_rt.newFrame(method_);
+	executeNested();
+}
+
+void Interpreter::executeNested() {
+	// the nested run must not unwind the frames of the interrupted method
+	auto* frame = _frame;
+	const auto& method = _rt.currentFrame().getMethod();
+	auto baseDepth = std::exchange(_baseDepth, _rt.stackDepth() - 1);
+	try {
+		while (_rt.stackDepth() > _baseDepth) {
+			if (!_rt.safepoint()) {
+				throw VmException("Thread {} stopped while running {}", _rt.getName(), method.getFullname());
+			}
+			execute();
+		}
+	} catch (...) {
+		while (_rt.stackDepth() > _baseDepth) {
+			_rt.popFrame();
+		}
+		_baseDepth = baseDepth;
+		_frame = frame;
+		throw;
 	}
-	if (hasClinitMethod) {
-		// push new frame with <clinit> method
-		auto& clinitMethod = class_.getMethod("<clinit>", "()V");
-		if (clinitMethod.isNative()) {
-			throw VmException("Native <clinit> method for class {} is not supported!", class_.getFullname());
+	_baseDepth = baseDepth;
+	_frame = frame;
+}
+
+void Interpreter::executeCallback() {
+	auto& cls = _rt.currentFrame().getMethod().getClass();
+	if (!cls.isStaticInitialized()) {
+		try {
+			executeClinit(cls);
+		} catch (...) {
+			_rt.popFrame();
+			throw;
 		}
-		if (!clinitMethod.hasBytecode()) {
-			throw VmException("<clinit> method for class {} has no bytecode!", class_.getFullname());
+	}
+	executeNested();
+}
+
+Method* Interpreter::findVirtualTarget(Class& receiver_, uint16_t methodRef_) const {
+	// inline cache of the call site, the handler runs with pc on the operands of the invoke instruction
+	auto& cache = _frame->getMethod().getInlineCache(_frame->pc() >> 1);
+	if (auto* target = cache.lookup(&receiver_)) [[likely]] {
+		return target;
+	}
+	auto* target = resolveVirtualTarget(receiver_, methodRef_);
+	if (target) {
+		cache.record(&receiver_, target);
+	}
+	return target;
+}
+
+Method* Interpreter::resolveVirtualTarget(Class& receiver_, uint16_t methodRef_) const {
+	auto& classloader = _rt.getClassLoader();
+	if (const auto* base = classloader.resolveVirtualMethod(_frame->getDexIdx(), methodRef_)) [[likely]] {
+		auto& declaring = base->getClass();
+		auto index = base->getVtableIndex();
+		auto* target = declaring.isInterface() ? receiver_.getInterfaceMethod(declaring, index) : receiver_.getVirtualMethod(index);
+		if (target) [[likely]] {
+			return target;
 		}
-		thread.newFrame(clinitMethod);
 	}
-	thread.run(true);
-	thread.join();
+	// the reference does not resolve to a slot of the receiver (e.g. Object method called through an interface), match by name
+	const auto& [classname, methodname, signature] = classloader.findMethod(_frame->getDexIdx(), methodRef_);
+	return receiver_.findVirtualMethod(methodname, signature);
 }
 
-void Interpreter::executeNativeMethod(const Method& method_, const std::vector<ObjectRef>& args_) {
-	// Construct the JNI symbol name
-	std::string symbolName = "Java_" + std::regex_replace(method_.getClass().getFullname(), std::regex("\\."), "_") + "_" + method_.getName();
-	if (method_.isOverload()) {
-		symbolName += "__" + JNIHelper::mangleMethodSignature(method_.getSignature());
+const NativeBinding& Interpreter::bindNativeMethod(const Method& method_) {
+	const auto& desc = method_.getSignature();
+	auto close = desc.find(')');
+	if (close == std::string::npos) {
+		throw VmException("Invalid method descriptor: {}", desc);
+	}
+	// natives registered through JNI RegisterNatives, then the runtime table, then the JNI symbol of user libraries
+	std::string symbolName = "registered";
+	void* symbol = method_.getRegisteredNative();
+	if (!symbol) {
+		symbolName = "runtime";
+		symbol = native::findRuntimeNative(method_.getClass().getFullname(), method_.getName(), desc);
+	}
+	if (!symbol) {
+		std::string className = method_.getClass().getFullname();
+		std::replace(className.begin(), className.end(), '.', '_');
+		symbolName = "Java_" + className + "_" + method_.getName();
+		if (method_.isOverload()) {
+			symbolName += "__" + JNIHelper::mangleMethodSignature(desc);
+		}
+		symbol = _rt.vm().findNativeSymbol(symbolName);
 	}
-	logger.fdebug("call native jni function {}", symbolName);
-	void* symbol = _rt.vm().findNativeSymbol(symbolName);
 	if (!symbol) {
 		throw VmException("Native method {} is not available!", symbolName);
 	}
+	LOG_DEBUG("Binding {}.{}{} -> native function {}@{:#x}", method_.getClass().getFullname(), method_.getName(), desc, symbolName, (uintptr_t)symbol);
+	return method_.setNativeBinding(NativeCallHelper::bind(symbol, method_.arguments(), desc.substr(close + 1)));
+}
 
-	const auto& desc = method_.getSignature();
-	std::regex descriptorRegex(R"(\((.*?)\)(.*))");
-	std::smatch match;
-	if (!std::regex_match(desc, match, descriptorRegex)) {
-		throw VmException("Invalid method descriptor: {}", desc);
+void Interpreter::executeNativeMethod(const Method& method_, const std::vector<uint16_t>& regs_) {
+	const auto* binding = method_.getNativeBinding();
+	if (!binding) [[unlikely]] {
+		binding = &bindNativeMethod(method_);
 	}
-	std::string params = match[1];
-	std::string returnType = match[2];
-	logger.fdebug("Executing {}.{}{} -> native function {}@{:#x}", method_.getClass().getFullname(), method_.getName(), method_.getSignature(), symbolName,
-	              (uintptr_t)symbol);
-	ObjectRef staticClass = nullptr;
+	LOG_DEBUG("call native jni function {}", method_.getFullname());
+	auto& frame = *_frame;
+	size_t reg = 0;
+	jobject self = nullptr;
 	if (method_.isStatic()) {
-		staticClass = Object::make(method_.getClass());
+		self = (jobject)method_.getClass().getClassObject();
+	} else {
+		if (regs_.empty()) {
+			throw VmException("Missing this reference for native instance method {}", method_.getFullname());
+		}
+		self = (jobject)frame.getObjRegister(regs_[reg++]);
+	}
+	// arguments read in place from the registers, the references are kept alive by the frame
+	const auto& params = binding->paramTypes;
+	std::array<uint64_t, 16> stackArgs;
+	std::unique_ptr<uint64_t[]> heapArgs;
+	uint64_t* args = stackArgs.data();
+	if (params.size() > stackArgs.size()) [[unlikely]] {
+		heapArgs = std::make_unique<uint64_t[]>(params.size());
+		args = heapArgs.get();
+	}
+	for (size_t i = 0; i < params.size(); ++i) {
+		const bool wide = params[i] == 'J' || params[i] == 'D';
+		if (reg + (wide ? 2 : 1) > regs_.size()) {
+			throw VmException("Missing argument {} of native method {}", i, method_.getFullname());
+		}
+		switch (params[i]) {
+			case 'J':
+			case 'D':
+				args[i] = static_cast<uint64_t>(frame.getLongRegister(regs_[reg]));
+				reg += 2;
+				break;
+			case 'L':
+			case '[': {
+				const auto src = regs_[reg++];
+				// a primitive slot used as a reference holds null (const 0)
+				args[i] = (uintptr_t)(frame.isObjRegister(src) ? frame.getObjRegister(src) : Object::makeNull());
+				break;
+			}
+			default:
+				args[i] = static_cast<uint32_t>(frame.getIntRegister(regs_[reg++]));
+				break;
+		}
 	}
-	auto ret = NativeCallHelper::invoke(symbol, _rt.vm().getJNIEnv(), args_, returnType, params, method_.isStatic(), staticClass);
-	if (returnType != "V") {
-		_rt.currentFrame().setReturnObject(ret);
+	// objects created through JNI are roots until the native returns, nested java calls may collect meanwhile
+	auto localFrame = _rt.pushLocalFrame();
+	uint64_t ret = 0;
+	try {
+		ret = NativeCallHelper::invoke(*binding, _rt.vm().getJNIEnv(), self, std::span<const uint64_t>(args, params.size()));
+	} catch (...) {
+		_rt.popLocalFrame(localFrame);
+		throw;
+	}
+	_rt.popLocalFrame(localFrame);
+	switch (binding->returnType) {
+		case 'V':
+			break;
+		case 'L':
+		case '[': {
+			auto* obj = (ObjectRef)(uintptr_t)ret;
+			_rt.currentFrame().setReturnObject(obj != nullptr ? obj : Object::makeNull());
+			break;
+		}
+		case 'J':
+		case 'D':
+			_rt.currentFrame().setReturnDoubleValue(static_cast<int64_t>(ret));
+			break;
+		default:
+			_rt.currentFrame().setReturnValue(static_cast<int32_t>(ret));
+			break;
+	}
+}
+
+void Interpreter::raise(Vm::Throwable type_, const std::string& message_) {
+	raise(_rt.vm().getThrowableClass(type_), message_);
+}
+
+void Interpreter::raise(Class& class_, const std::string& message_) {
+	auto exc = Object::make(class_);
+	exc->setField("detailMessage", Object::make(_rt.getClassLoader(), message_));
+	_pendingException = exc;
+}
+
+void Interpreter::raise(const JavaException& exception_) {
+	if (auto* throwable = exception_.getThrowable()) {
+		// throwable crossing a nested run, rethrown as the same object
+		_pendingException = throwable;
+		return;
 	}
+	raise(_rt.vm().getThrowableClass(exception_.getExceptionType()), exception_.getMessage());
 }
 
 void Interpreter::handleException(ObjectRef exception_) {
@@ -384,14 +1284,13 @@ void Interpreter::handleException(ObjectRef exception_) {
 		throw VmException("throw operand is not an object!");
 	}
 
-	auto detailMessage = exception_->getField("detailMessage");
-	std::string msg = detailMessage->isString() ? detailMessage->str() : "";
-
 	while (true) {
-		if (_rt.stackDepth() == 0) {
-			// uncaught exception
-			logger.fdebug("Unhandled exception {} : {}", exception_->getClass().getFullname(), msg);
-			throw JavaException(exception_->getClass().getFullname(), msg);
+		if (_rt.stackDepth() == _baseDepth) {
+			// uncaught exception (or not caught by the method run nested)
+			auto detailMessage = exception_->getField("detailMessage");
+			std::string msg = detailMessage->isString() ? detailMessage->str() : "";
+			LOG_DEBUG("Unhandled exception {} : {}", exception_->getClass().getFullname(), msg);
+			throw JavaException(exception_, exception_->getClass().getFullname(), msg);
 		}
 		auto& frame = _rt.currentFrame();
 		// do not re-handle same exception inside the same frame
@@ -399,37 +1298,37 @@ void Interpreter::handleException(ObjectRef exception_) {
 			_rt.popFrame();
 			continue;
 		}
-		try {
-			const auto& method = frame.getMethod();
-			uint32_t catchAllAddrress = 0;
-			auto handlers = method.getExceptionHandler(frame.pc() - 1, catchAllAddrress);
-			for (auto& exc : handlers) {
-				const auto& exceptionType = _rt.getClassLoader().resolveClass(frame.getDexIdx(), exc.first);
+		if (const auto* range = frame.getMethod().findTryRange(frame.pc() - 1)) {
+			for (const auto& [typeIdx, address] : range->handlers) {
+				const Class* handlerType = nullptr;
+				try {
+					handlerType = &_rt.getClassLoader().resolveClass(frame.getDexIdx(), typeIdx);
+				} catch (const std::exception& e) {
+					// a catch clause on a class missing from the class path never matches
+					LOG_DEBUG("Exception handler type {} not resolved: {}", typeIdx, e.what());
+					continue;
+				}
+				const auto& exceptionType = *handlerType;
 				if (exceptionType.isInstanceOf(exception_)) {
-					logger.fdebug("Catch exception {} at {:x}", exceptionType.getName(), exc.second);
-					frame.pc() = exc.second << 1;
+					LOG_DEBUG("Catch exception {} at {:x}", exceptionType.getName(), address);
+					frame.pc() = address << 1;
 					frame.setException(exception_);
 					return;
 				}
 			}
-			if (catchAllAddrress != 0) {
-				logger.fdebug("Catch all exception at {:x}", catchAllAddrress);
-				frame.pc() = catchAllAddrress << 1;
+			if (range->catchAll != 0) {
+				LOG_DEBUG("Catch all exception at {:x}", range->catchAll);
+				frame.pc() = range->catchAll << 1;
 				frame.setException(exception_);
 				return;
 			}
-		} catch (const std::exception& e) {
-			logger.fdebug("Exception handling failed: {}", e.what());
 		}
 		// No handler found - propagate to caller
-		if (_rt.stackDepth() > 0) {
-			_rt.popFrame();
-		}
+		_rt.popFrame();
 	}
 }
 
-std::vector<ObjectRef> Interpreter::getInvokeMethodArgs(const uint8_t* operand_) const {
-	auto& frame = _rt.currentFrame();
+std::vector<uint16_t> Interpreter::getInvokeMethodRegs(const uint8_t* operand_) const {
 	const uint8_t vA = (operand_[0] >> 4) & 0x0F;  // Number of registers (A)
 	uint8_t vC = (vA > 0) ? operand_[3] & 0x0F : 0;
 	uint8_t vD = (vA > 0) ? (operand_[3] >> 4) & 0x0F : 0;
@@ -437,13 +1336,44 @@ std::vector<ObjectRef> Interpreter::getInvokeMethodArgs(const uint8_t* operand_)
 	uint8_t vF = (vA > 1) ? (operand_[4] >> 4) & 0x0F : 0;
 	uint8_t vG = (vA > 2) ? operand_[0] & 0x0F : 0;
 
-	std::vector<uint8_t> regs = {vC, vD, vE, vF, vG};
-	std::vector<ObjectRef> args{};
-	for (uint8_t i = 0; i < vA; ++i) {
-		auto obj = frame.getObjRegister(regs[i]);
-		args.push_back(obj);
+	std::vector<uint16_t> regs = {vC, vD, vE, vF, vG};
+	regs.resize(std::min<uint8_t>(vA, 5));
+	return regs;
+}
+
+std::vector<uint16_t> Interpreter::getInvokeMethodRangeRegs(const uint8_t* operand_) const {
+	const uint16_t startReg = *reinterpret_cast<const uint16_t*>(&operand_[3]);
+	const uint8_t regCount = operand_[0];
+	std::vector<uint16_t> regs(regCount);
+	for (uint8_t i = 0; i < regCount; ++i) {
+		regs[i] = startReg + i;
+	}
+	return regs;
+}
+
+std::vector<ObjectRef> Interpreter::getInvokeMethodArgs(const std::vector<uint16_t>& regs_) const {
+	auto& frame = *_frame;
+	std::vector<ObjectRef> args{};
+	args.reserve(regs_.size());
+	for (auto reg : regs_) {
+		args.push_back(frame.getObjRegister(reg));
+	}
+	return args;
+}
+
+void Interpreter::setInvokeMethodArgs(Frame& newframe_, const Frame& frame_, const std::vector<uint16_t>& regs_) const {
+	// When a method is invoked, the parameters to the method are placed into the last n registers.
+	uint32_t first = newframe_.getMethod().getNbRegisters() - regs_.size();
+	for (size_t i = 0; i < regs_.size(); ++i) {
+		newframe_.copyRegister(first + i, frame_, regs_[i]);
+	}
+}
+
+void Interpreter::logCall(const std::string& type_, const std::string& class_, const std::string& method_, const std::string& signature_,
+                          const std::vector<uint16_t>& regs_, bool static_) const {
+	if (trace.isCallTraceEnabled()) {
+		trace.logCall(type_, class_, method_, signature_, getInvokeMethodArgs(regs_), static_);
 	}
-	return args;
 }
 
 // nop
@@ -454,7 +1384,7 @@ void Interpreter::nop(const uint8_t* operand_) {
 void Interpreter::move(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	frame.setIntRegister(dest, frame.getIntRegister(src));
 	frame.pc()++;
 }
@@ -462,7 +1392,7 @@ void Interpreter::move(const uint8_t* operand_) {
 void Interpreter::move_from16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint16_t src = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	frame.setIntRegister(dest, frame.getIntRegister(src));
 	frame.pc() += 3;
 }
@@ -470,7 +1400,7 @@ void Interpreter::move_from16(const uint8_t* operand_) {
 void Interpreter::move_16(const uint8_t* operand_) {
 	uint16_t dest = *(const uint16_t*)&operand_[0];
 	uint16_t src = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	frame.setIntRegister(dest, frame.getIntRegister(src));
 	frame.pc() += 4;
 }
@@ -478,64 +1408,61 @@ void Interpreter::move_16(const uint8_t* operand_) {
 void Interpreter::move_wide(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
-	frame.setIntRegister(dest, frame.getIntRegister(src));
-	frame.setIntRegister(dest + 1, frame.getIntRegister(src + 1));
+	auto& frame = *_frame;
+	frame.setLongRegister(dest, frame.getLongRegister(src));
 	frame.pc()++;
 }
 // move-wide/from16 vAA, vBBBB
 void Interpreter::move_wide_from16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint16_t src = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
-	frame.setIntRegister(dest, frame.getIntRegister(src));
-	frame.setIntRegister(dest + 1, frame.getIntRegister(src + 1));
+	auto& frame = *_frame;
+	frame.setLongRegister(dest, frame.getLongRegister(src));
 	frame.pc() += 3;
 }
 // move-wide/16 vAAAA, vBBBB
 void Interpreter::move_wide16(const uint8_t* operand_) {
 	uint16_t dest = *(const uint16_t*)&operand_[0];
 	uint16_t src = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
-	frame.setIntRegister(dest, frame.getIntRegister(src));
-	frame.setIntRegister(dest + 1, frame.getIntRegister(src + 1));
+	auto& frame = *_frame;
+	frame.setLongRegister(dest, frame.getLongRegister(src));
 	frame.pc() += 4;
 }
 // move-object vA, vB
 void Interpreter::move_object(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
-	frame.setObjRegister(dest, frame.getObjRegister(src));
+	auto& frame = *_frame;
+	frame.copyRegister(dest, frame, src);
 	frame.pc()++;
 }
 // move-object/from16 vAA, vBBBB
 void Interpreter::move_object_from16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint16_t src = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
-	frame.setObjRegister(dest, frame.getObjRegister(src));
+	auto& frame = *_frame;
+	frame.copyRegister(dest, frame, src);
 	frame.pc() += 3;
 }
 // move-object/16 vAAAA, vBBBB
 void Interpreter::move_object16(const uint8_t* operand_) {
 	uint16_t dest = *(const uint16_t*)&operand_[0];
 	uint16_t src = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
-	frame.setObjRegister(dest, frame.getObjRegister(src));
+	auto& frame = *_frame;
+	frame.copyRegister(dest, frame, src);
 	frame.pc() += 4;
 }
 //  move-result vAA
 void Interpreter::move_result(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	frame.setIntRegister(dest, frame.getReturnValue());
 	frame.pc() += 1;
 }
 // move-result-wide vAA
 void Interpreter::move_result_wide(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto v = frame.getReturnDoubleValue();
 	frame.setLongRegister(dest, v);
 	frame.pc() += 1;
@@ -543,14 +1470,14 @@ void Interpreter::move_result_wide(const uint8_t* operand_) {
 // move-result-object vAA
 void Interpreter::move_result_object(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	frame.setObjRegister(dest, frame.getReturnObject());
 	frame.pc() += 1;
 }
 // move-exception vAA
 void Interpreter::move_exception(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	frame.setObjRegister(dest, frame.getException());
 	frame.pc() += 1;
 }
@@ -563,8 +1490,8 @@ void Interpreter::return_(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	auto ret = _rt.currentFrame().getIntRegister(dest);
 	_rt.popFrame();
-	if (_rt.end()) {
-		// main method return
+	if (_rt.stackDepth() == _baseDepth) {
+		// main method return, or end of a nested run: the frame below belongs to the caller
 		_rt.setReturnValue(ret);
 		return;
 	} else {
@@ -576,8 +1503,8 @@ void Interpreter::return_wide(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	auto ret = _rt.currentFrame().getLongRegister(dest);
 	_rt.popFrame();
-	if (_rt.end()) {
-		// main method return
+	if (_rt.stackDepth() == _baseDepth) {
+		// main method return, or end of a nested run: the frame below belongs to the caller
 		_rt.setReturnDoubleValue(ret);
 		return;
 	} else {
@@ -589,8 +1516,8 @@ void Interpreter::return_object(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	auto ret = _rt.currentFrame().getObjRegister(dest);
 	_rt.popFrame();
-	if (_rt.end()) {
-		// main method return
+	if (_rt.stackDepth() == _baseDepth) {
+		// main method return, or end of a nested run: the frame below belongs to the caller
 		_rt.setReturnObject(ret);
 		return;
 	} else {
@@ -604,7 +1531,7 @@ void Interpreter::const_4(const uint8_t* operand_) {
 	if (value & 0x08) {
 		value |= 0xF0;  // Sign extend the 4-bit value to 8 bits
 	}
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	frame.setIntRegister(dest, (int32_t)value);
 	frame.pc()++;
 }
@@ -612,7 +1539,7 @@ void Interpreter::const_4(const uint8_t* operand_) {
 void Interpreter::const_16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	int16_t value = static_cast<int16_t>(*(const uint16_t*)&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	frame.setIntRegister(dest, (int32_t)value);
 	frame.pc() += 3;
 }
@@ -620,7 +1547,7 @@ void Interpreter::const_16(const uint8_t* operand_) {
 void Interpreter::const_(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	int32_t value = *(const int32_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	frame.setIntRegister(dest, value);
 	frame.pc() += 5;
 }
@@ -628,7 +1555,7 @@ void Interpreter::const_(const uint8_t* operand_) {
 void Interpreter::const_high16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint32_t value = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	frame.setIntRegister(dest, value << 16);
 	frame.pc() += 3;
 }
@@ -636,7 +1563,7 @@ void Interpreter::const_high16(const uint8_t* operand_) {
 void Interpreter::const_wide_16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	int16_t value = static_cast<int16_t>(*(const uint16_t*)&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	frame.setLongRegister(dest, (int64_t)value);
 	frame.pc() += 3;
 }
@@ -644,7 +1571,7 @@ void Interpreter::const_wide_16(const uint8_t* operand_) {
 void Interpreter::const_wide_32(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	int32_t value = *(const int32_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	frame.setLongRegister(dest, value);
 	frame.pc() += 5;
 }
@@ -652,7 +1579,7 @@ void Interpreter::const_wide_32(const uint8_t* operand_) {
 void Interpreter::const_wide(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	int64_t value = *(const int64_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	frame.setLongRegister(dest, value);
 	frame.pc() += 9;
 }
@@ -660,7 +1587,7 @@ void Interpreter::const_wide(const uint8_t* operand_) {
 void Interpreter::const_wide_high16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint64_t value = static_cast<uint64_t>(*(const uint16_t*)&operand_[1]) << 48;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	frame.setLongRegister(dest, value);
 	frame.pc() += 3;
 }
@@ -668,27 +1595,26 @@ void Interpreter::const_wide_high16(const uint8_t* operand_) {
 void Interpreter::const_string(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint16_t stringIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
-	auto str = classloader.resolveString(frame.getDexIdx(), stringIndex);
-	frame.setObjRegister(dest, Object::make(classloader, str));
+	// literals are interned, every execution loads the same String object
+	frame.setObjRegister(dest, classloader.resolveStringObject(frame.getDexIdx(), stringIndex));
 	frame.pc() += 3;
 }
 // const-string/jumbo vAA, string@BBBBBBBB
 void Interpreter::const_string_jumbo(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint32_t stringIndex = *(const uint32_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
-	auto str = classloader.resolveString(frame.getDexIdx(), stringIndex);
-	frame.setObjRegister(dest, Object::make(classloader, str));
+	frame.setObjRegister(dest, classloader.resolveStringObject(frame.getDexIdx(), stringIndex));
 	frame.pc() += 5;
 }
 // const-class vAA, type@BBBB
 void Interpreter::const_class(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint16_t typeIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 	auto& cls = classloader.resolveClass(frame.getDexIdx(), typeIndex);
 	frame.setObjRegister(dest, Object::makeConstClass(classloader, cls));
@@ -697,24 +1623,26 @@ void Interpreter::const_class(const uint8_t* operand_) {
 // monitor-enter vAA
 void Interpreter::monitor_enter(const uint8_t* operand_) {
 	uint8_t reg = operand_[0];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto obj = frame.getObjRegister(reg);
 	if (obj->isNull()) {
-		throw NullPointerException("monitor_enter on null object");
+		raise(Vm::Throwable::NULL_POINTER, "monitor_enter on null object");
+		return;
 	}
 	obj->monitorEnter();
-	logger.fdebug("monitor enter on object {}", obj->toString());
+	LOG_DEBUG("monitor enter on object {}", obj->toString());
 	frame.pc()++;
 }
 // monitor-exit vAA
 void Interpreter::monitor_exit(const uint8_t* operand_) {
 	uint8_t reg = operand_[0];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto obj = frame.getObjRegister(reg);
 	if (obj->isNull()) {
-		throw NullPointerException("monitor_exit on null object");
+		raise(Vm::Throwable::NULL_POINTER, "monitor_exit on null object");
+		return;
 	}
-	logger.fdebug("monitor exit on object {}", obj->toString());
+	LOG_DEBUG("monitor exit on object {}", obj->toString());
 	obj->monitorExit();
 	frame.pc()++;
 }
@@ -722,31 +1650,34 @@ void Interpreter::monitor_exit(const uint8_t* operand_) {
 void Interpreter::check_cast(const uint8_t* operand_) {
 	uint8_t reg = operand_[0];
 	uint16_t typeIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto obj = frame.getObjRegister(reg);
 	if (obj->isNull()) {
-		throw NullPointerException("check_cast on null object");
+		raise(Vm::Throwable::NULL_POINTER, "check_cast on null object");
+		return;
 	}
 
 	auto& classloader = _rt.getClassLoader();
 	TYPES type = TYPES::UNKNOWN;
-	std::string type_name = classloader.resolveType(frame.getDexIdx(), typeIndex, type);
+	const auto& type_name = classloader.resolveType(frame.getDexIdx(), typeIndex, type);
 	switch (type) {
 		case TYPES::PRIMITIVE:
 			// Primitive types: no casting needed, always valid
-			logger.fdebug("@todo check-cast to primitive type {}", type_name);
+			LOG_DEBUG("@todo check-cast to primitive type {}", type_name);
 			break;
 		case TYPES::CLASS: {
 			auto& targetClass = classloader.resolveClass(frame.getDexIdx(), typeIndex);
 			if (!targetClass.isInstanceOf(obj)) {
-				throw ClassCastException(fmt::format("Cannot cast object to {}", targetClass.getName()));
+				raise(Vm::Throwable::CLASS_CAST, fmt::format("Cannot cast object to {}", targetClass.getName()));
+				return;
 			}
 			break;
 		}
 		case TYPES::ARRAY: {
 			auto array = static_cast<ArrayRef>(obj);
 			if (!array) {
-				throw ClassCastException("Object is not an array");
+				raise(Vm::Throwable::CLASS_CAST, "Object is not an array");
+				return;
 			}
 			size_t array_dims = 0;
 			size_t pos = 0;
@@ -755,10 +1686,11 @@ void Interpreter::check_cast(const uint8_t* operand_) {
 				pos++;
 			}
 			std::string element_type_name = type_name.substr(pos);
-			logger.fdebug("Array type: {} dimensions, element type {}", array_dims, element_type_name);
+			LOG_DEBUG("Array type: {} dimensions, element type {}", array_dims, element_type_name);
 			// check object has good dimensions
 			if (array->getDimensions() != array_dims) {
-				throw ClassCastException(fmt::format("Cannot cast array of {} dimensions to {}", array->getDimensions(), array_dims));
+				raise(Vm::Throwable::CLASS_CAST, fmt::format("Cannot cast array of {} dimensions to {}", array->getDimensions(), array_dims));
+				return;
 			}
 			// check if element type is class or primitive
 			if (element_type_name[0] == 'L') {
@@ -766,11 +1698,12 @@ void Interpreter::check_cast(const uint8_t* operand_) {
 				classname.pop_back();                          // remove ';'
 				auto& targetClass = classloader.getOrLoad(classname);
 				if (!targetClass.isInstanceOf(array->getClassType())) {
-					throw ClassCastException(fmt::format("Cannot cast array to {}", targetClass.getName()));
+					raise(Vm::Throwable::CLASS_CAST, fmt::format("Cannot cast array to {}", targetClass.getName()));
+					return;
 				}
 			} else {
 				// Primitive types: no casting needed, always valid
-				logger.fdebug("@todo check-cast to array of primitive type {}", element_type_name);
+				LOG_DEBUG("@todo check-cast to array of primitive type {}", element_type_name);
 			}
 			break;
 		}
@@ -784,7 +1717,7 @@ void Interpreter::instance_of(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
 	uint16_t typeIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto obj = frame.getObjRegister(src);
 	auto& classloader = _rt.getClassLoader();
 	auto& targetClass = classloader.resolveClass(frame.getDexIdx(), typeIndex);
@@ -795,10 +1728,11 @@ void Interpreter::instance_of(const uint8_t* operand_) {
 void Interpreter::array_length(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto obj = frame.getObjRegister(src);
 	if (obj->isNull()) {
-		throw NullPointerException("array_length on null object");
+		raise(Vm::Throwable::NULL_POINTER, "array_length on null object");
+		return;
 	}
 	uint32_t length = obj->getArrayLength();
 	frame.setIntRegister(dest, length);
@@ -808,18 +1742,19 @@ void Interpreter::array_length(const uint8_t* operand_) {
 void Interpreter::new_instance(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint16_t typeIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 	auto& cls = classloader.resolveClass(frame.getDexIdx(), typeIndex);
 
 	if (cls.isAbstract() || cls.isInterface()) {
-		throw InstantiationException(fmt::format("Cannot instantiate abstract class or interface: {}", cls.getName()));
+		raise(Vm::Throwable::INSTANTIATION, fmt::format("Cannot instantiate abstract class or interface: {}", cls.getName()));
+		return;
 	}
 	if (!cls.isStaticInitialized()) {
 		executeClinit(cls);
 	}
 
-	logger.fdebug("new {}", cls.getFullname());
+	LOG_DEBUG("new {}", cls.getFullname());
 	frame.setObjRegister(dest, Object::make(cls));
 	frame.pc() += 3;
 }
@@ -828,7 +1763,7 @@ void Interpreter::new_array(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
 	uint16_t typeIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
 	auto& classloader = _rt.getClassLoader();
 	auto arrayType = classloader.resolveArray(frame.getDexIdx(), typeIndex);
@@ -836,7 +1771,8 @@ void Interpreter::new_array(const uint8_t* operand_) {
 	// Get the array size from the source register
 	int32_t size = frame.getIntRegister(src);
 	if (size < 0) {
-		throw NegativeArraySizeException("new_array: Array size cannot be negative");
+		raise(Vm::Throwable::NEGATIVE_ARRAY_SIZE, "new_array: Array size cannot be negative");
+		return;
 	}
 	const auto& type = classloader.getOrLoad(arrayType[0].first);
 	auto arrayObj = Array::make(type, size);
@@ -845,10 +1781,10 @@ void Interpreter::new_array(const uint8_t* operand_) {
 }
 // filled-new-array {vD, vE, vF, vG, vA}, type@CCCC
 void Interpreter::filled_new_array(const uint8_t* operand_) {
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
-	auto args = getInvokeMethodArgs(operand_);
+	auto args = getInvokeMethodArgs(getInvokeMethodRegs(operand_));
 	uint8_t count = (operand_[0] >> 4) & 0x0F;
 	uint16_t typeIndex = *(const uint16_t*)&operand_[1];
 
@@ -877,7 +1813,7 @@ void Interpreter::filled_new_array_range(const uint8_t* operand_) {
 void Interpreter::fill_array_data(const uint8_t* operand_) {
 	uint8_t reg = operand_[0];
 	auto offset = *reinterpret_cast<const uint32_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto baseAddress = frame.pc() - 1;  // Adjust for the incremented PC
 	auto data = reinterpret_cast<const uint16_t*>(frame.getMethod().getBytecode() + baseAddress + (offset << 1));
 
@@ -892,18 +1828,27 @@ void Interpreter::fill_array_data(const uint8_t* operand_) {
 
 	auto arrayObj = frame.getObjRegister(reg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("fill_array_data on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "fill_array_data on null array object");
+		return;
 	}
 
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("fill_array_data: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "fill_array_data: Object is not an array");
+		return;
 	}
 
 	if (array->getArrayLength() != elementCount) {
-		throw ClassCastException("fill_array_data: Array length mismatch");
+		raise(Vm::Throwable::CLASS_CAST, "fill_array_data: Array length mismatch");
+		return;
 	}
 
+	if (array->isPrimitiveArray() && array->getDimensions() == 1 && array->getElementSize() == elementSize) {
+		// the payload has the layout of the typed storage
+		std::memcpy(array->getRawData(), arrayData, static_cast<size_t>(elementCount) * elementSize);
+		frame.pc() += 5;
+		return;
+	}
 	for (uint32_t i = 0; i < elementCount; ++i) {
 		switch (elementSize) {
 			case 1: {
@@ -931,7 +1876,8 @@ void Interpreter::fill_array_data(const uint8_t* operand_) {
 				break;
 			}
 			default:
-				throw ArrayStoreException(fmt::format("fill_array_data: Unsupported element size: {}", elementSize));
+				raise(Vm::Throwable::ARRAY_STORE, fmt::format("fill_array_data: Unsupported element size: {}", elementSize));
+				return;
 		}
 	}
 	frame.pc() += 5;
@@ -941,25 +1887,26 @@ void Interpreter::throw_(const uint8_t* operand_) {
 	uint8_t reg = operand_[0];
 	auto obj = _rt.currentFrame().getObjRegister(reg);
 	if (obj->isNull()) {
-		throw NullPointerException("throw on null object");
+		raise(Vm::Throwable::NULL_POINTER, "throw on null object");
+		return;
 	}
-	handleException(obj);
+	_pendingException = obj;
 }
 // goto +AA
 void Interpreter::goto_(const uint8_t* operand_) {
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int8_t offset = static_cast<int8_t>(operand_[0]);
 	frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
 }
 // goto/16 +AAAA
 void Interpreter::goto_16(const uint8_t* operand_) {
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int16_t offset = *reinterpret_cast<const int16_t*>(&operand_[1]);
 	frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
 }
 // goto/32 +AAAAAAAA
 void Interpreter::goto_32(const uint8_t* operand_) {
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t offset = *reinterpret_cast<const int32_t*>(&operand_[1]);
 	frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
 }
@@ -967,7 +1914,7 @@ void Interpreter::goto_32(const uint8_t* operand_) {
 void Interpreter::packed_switch(const uint8_t* operand_) {
 	uint8_t reg = operand_[0];
 	uint32_t offset = *reinterpret_cast<const uint32_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto baseAddress = frame.pc() - 1;  // Adjust for the incremented PC
 	auto switchData = reinterpret_cast<const uint16_t*>(frame.getMethod().getBytecode() + baseAddress + (offset << 1));
 
@@ -977,7 +1924,8 @@ void Interpreter::packed_switch(const uint8_t* operand_) {
 	}
 	int32_t size = switchData[1];
 	if (size <= 0) {
-		throw ArrayIndexOutOfBoundsException("packed-switch: Invalid size in switch data");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "packed-switch: Invalid size in switch data");
+		return;
 	}
 
 	auto base = *(const int32_t*)&switchData[2];
@@ -998,7 +1946,7 @@ void Interpreter::packed_switch(const uint8_t* operand_) {
 void Interpreter::sparse_switch(const uint8_t* operand_) {
 	uint8_t reg = operand_[0];
 	uint32_t offset = *reinterpret_cast<const uint32_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto baseAddress = frame.pc() - 1;  // Adjust for the incremented PC
 	auto switchData = reinterpret_cast<const uint16_t*>(frame.getMethod().getBytecode() + baseAddress + (offset << 1));
 
@@ -1008,7 +1956,8 @@ void Interpreter::sparse_switch(const uint8_t* operand_) {
 	}
 	int32_t size = switchData[1];
 	if (size <= 0) {
-		throw ArrayIndexOutOfBoundsException("sparse-switch: Invalid size in switch data");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "sparse-switch: Invalid size in switch data");
+		return;
 	}
 
 	auto keys = reinterpret_cast<const int32_t*>(&switchData[2]);
@@ -1031,7 +1980,7 @@ void Interpreter::cmpl_float(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float value1 = frame.getFloatRegister(src1);
 	float value2 = frame.getFloatRegister(src2);
 	int32_t result = (value1 < value2) ? -1 : (value1 == value2 ? 0 : 1);
@@ -1043,7 +1992,7 @@ void Interpreter::cmpg_float(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float value1 = frame.getFloatRegister(src1);
 	float value2 = frame.getFloatRegister(src2);
 	int32_t result = (value1 > value2) ? 1 : (value1 == value2 ? 0 : -1);
@@ -1055,7 +2004,7 @@ void Interpreter::cmpl_double(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double value1 = frame.getDoubleRegister(src1);
 	double value2 = frame.getDoubleRegister(src2);
 	int32_t result = (value1 < value2) ? -1 : (value1 == value2 ? 0 : 1);
@@ -1067,7 +2016,7 @@ void Interpreter::cmpg_double(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double value1 = frame.getDoubleRegister(src1);
 	double value2 = frame.getDoubleRegister(src2);
 	int32_t result = (value1 > value2) ? 1 : (value1 == value2 ? 0 : -1);
@@ -1079,7 +2028,7 @@ void Interpreter::cmp_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t value1 = frame.getLongRegister(src1);
 	int64_t value2 = frame.getLongRegister(src2);
 	int32_t result = (value1 < value2) ? -1 : (value1 == value2 ? 0 : 1);
@@ -1091,7 +2040,16 @@ void Interpreter::if_eq(const uint8_t* operand_) {
 	uint8_t regA = operand_[0] & 0x0F;
 	uint8_t regB = (operand_[0] >> 4) & 0x0F;
 	int16_t offset = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
+	if (!frame.isObjRegister(regA) && !frame.isObjRegister(regB)) {
+		// primitive comparison on raw registers
+		if (frame.getIntRegister(regA) == frame.getIntRegister(regB)) {
+			frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
+		} else {
+			frame.pc() += 3;
+		}
+		return;
+	}
 	// obj comparison as if eq could be used for object equality
 	auto objA = frame.getObjRegister(regA);
 	auto objB = frame.getObjRegister(regB);
@@ -1114,7 +2072,16 @@ void Interpreter::if_ne(const uint8_t* operand_) {
 	uint8_t regA = operand_[0] & 0x0F;
 	uint8_t regB = (operand_[0] >> 4) & 0x0F;
 	int16_t offset = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
+	if (!frame.isObjRegister(regA) && !frame.isObjRegister(regB)) {
+		// primitive comparison on raw registers
+		if (frame.getIntRegister(regA) != frame.getIntRegister(regB)) {
+			frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
+		} else {
+			frame.pc() += 3;
+		}
+		return;
+	}
 	// obj comparison as if ne could be used for object equality
 	auto objA = frame.getObjRegister(regA);
 	auto objB = frame.getObjRegister(regB);
@@ -1137,7 +2104,7 @@ void Interpreter::if_lt(const uint8_t* operand_) {
 	uint8_t regA = operand_[0] & 0x0F;
 	uint8_t regB = (operand_[0] >> 4) & 0x0F;
 	int16_t offset = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	if (frame.getIntRegister(regA) < frame.getIntRegister(regB)) {
 		frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
 	} else {
@@ -1149,7 +2116,7 @@ void Interpreter::if_ge(const uint8_t* operand_) {
 	uint8_t regA = operand_[0] & 0x0F;
 	uint8_t regB = (operand_[0] >> 4) & 0x0F;
 	int16_t offset = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	if (frame.getIntRegister(regA) >= frame.getIntRegister(regB)) {
 		frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
 	} else {
@@ -1161,7 +2128,7 @@ void Interpreter::if_gt(const uint8_t* operand_) {
 	uint8_t regA = operand_[0] & 0x0F;
 	uint8_t regB = (operand_[0] >> 4) & 0x0F;
 	int16_t offset = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	if (frame.getIntRegister(regA) > frame.getIntRegister(regB)) {
 		frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
 	} else {
@@ -1173,7 +2140,7 @@ void Interpreter::if_le(const uint8_t* operand_) {
 	uint8_t regA = operand_[0] & 0x0F;
 	uint8_t regB = (operand_[0] >> 4) & 0x0F;
 	int16_t offset = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	if (frame.getIntRegister(regA) <= frame.getIntRegister(regB)) {
 		frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
 	} else {
@@ -1184,7 +2151,16 @@ void Interpreter::if_le(const uint8_t* operand_) {
 void Interpreter::if_eqz(const uint8_t* operand_) {
 	uint8_t regA = operand_[0];
 	int16_t offset = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
+	if (!frame.isObjRegister(regA)) {
+		// primitive register
+		if (frame.getIntRegister(regA) == 0) {
+			frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
+		} else {
+			frame.pc() += 3;
+		}
+		return;
+	}
 	auto obj = frame.getObjRegister(regA);
 	if (obj->isNumberObject()) {
 		if (obj->getValue() == 0) {
@@ -1204,7 +2180,16 @@ void Interpreter::if_eqz(const uint8_t* operand_) {
 void Interpreter::if_nez(const uint8_t* operand_) {
 	uint8_t regA = operand_[0];
 	int16_t offset = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
+	if (!frame.isObjRegister(regA)) {
+		// primitive register
+		if (frame.getIntRegister(regA) != 0) {
+			frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
+		} else {
+			frame.pc() += 3;
+		}
+		return;
+	}
 	auto obj = frame.getObjRegister(regA);
 	if (obj->isNumberObject()) {
 		if (obj->getValue() != 0) {
@@ -1224,7 +2209,7 @@ void Interpreter::if_nez(const uint8_t* operand_) {
 void Interpreter::if_ltz(const uint8_t* operand_) {
 	uint8_t regA = operand_[0];
 	int16_t offset = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	if (frame.getIntRegister(regA) < 0) {
 		frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
 	} else {
@@ -1235,7 +2220,7 @@ void Interpreter::if_ltz(const uint8_t* operand_) {
 void Interpreter::if_gez(const uint8_t* operand_) {
 	uint8_t regA = operand_[0];
 	int16_t offset = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	if (frame.getIntRegister(regA) >= 0) {
 		frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
 	} else {
@@ -1246,7 +2231,7 @@ void Interpreter::if_gez(const uint8_t* operand_) {
 void Interpreter::if_gtz(const uint8_t* operand_) {
 	uint8_t regA = operand_[0];
 	int16_t offset = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	if (frame.getIntRegister(regA) > 0) {
 		frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
 	} else {
@@ -1257,7 +2242,7 @@ void Interpreter::if_gtz(const uint8_t* operand_) {
 void Interpreter::if_lez(const uint8_t* operand_) {
 	uint8_t regA = operand_[0];
 	int16_t offset = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	if (frame.getIntRegister(regA) <= 0) {
 		frame.pc() += (offset << 1) - 1;  // -1 because pc is incremented before.
 	} else {
@@ -1269,31 +2254,25 @@ void Interpreter::aget(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t arrayReg = operand_[1];
 	uint8_t indexReg = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
 	auto arrayObj = frame.getObjRegister(arrayReg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("aget on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "aget on null array object");
+		return;
 	}
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("aget: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "aget: Object is not an array");
+		return;
 	}
 
 	int32_t index = frame.getIntRegister(indexReg);
 	if (index < 0 || (uint32_t)index >= array->getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("aget: Array index out of bounds");
-	}
-	auto obj = array->getElement(index);
-	int32_t value = 0;
-	if (!obj->isNumberObject()) {
-		if (!obj->isNull()) {
-			throw VmException("aget: Array does not contain number");
-		}
-	} else {
-		value = obj->getValue();
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "aget: Array index out of bounds");
+		return;
 	}
-	frame.setIntRegister(dest, value);
+	frame.setIntRegister(dest, array->getPrimitive<int32_t>(index));
 	frame.pc() += 3;
 }
 // aget-wide vAA, vBB, vCC
@@ -1301,27 +2280,25 @@ void Interpreter::aget_wide(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t arrayReg = operand_[1];
 	uint8_t indexReg = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
 	auto arrayObj = frame.getObjRegister(arrayReg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("aget-wide on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "aget-wide on null array object");
+		return;
 	}
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("aget-wide: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "aget-wide: Object is not an array");
+		return;
 	}
 
 	int32_t index = frame.getIntRegister(indexReg);
 	if (index < 0 || (uint32_t)index >= array->getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("aget-wide: Array index out of bounds");
-	}
-	auto element = array->getElement(index);
-	if (!element->isNumberObject()) {
-		throw VmException("aget-wide: Array element is not a number object");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "aget-wide: Array index out of bounds");
+		return;
 	}
-	int64_t value = element->getLongValue();
-	frame.setLongRegister(dest, value);
+	frame.setLongRegister(dest, array->getPrimitive<int64_t>(index));
 	frame.pc() += 3;
 }
 // aget-object vAA, vBB, vCC
@@ -1329,20 +2306,23 @@ void Interpreter::aget_object(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t arrayReg = operand_[1];
 	uint8_t indexReg = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
 	auto arrayObj = frame.getObjRegister(arrayReg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("aget-object on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "aget-object on null array object");
+		return;
 	}
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("aget-object: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "aget-object: Object is not an array");
+		return;
 	}
 
 	int32_t index = frame.getIntRegister(indexReg);
 	if (index < 0 || (uint32_t)index >= array->getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("aget-object: Array index out of bounds");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "aget-object: Array index out of bounds");
+		return;
 	}
 	auto value = array->getElement(index);
 	frame.setObjRegister(dest, value);
@@ -1353,27 +2333,25 @@ void Interpreter::aget_boolean(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t arrayReg = operand_[1];
 	uint8_t indexReg = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
 	auto arrayObj = frame.getObjRegister(arrayReg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("aget-boolean on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "aget-boolean on null array object");
+		return;
 	}
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("aget-boolean: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "aget-boolean: Object is not an array");
+		return;
 	}
 
 	int32_t index = frame.getIntRegister(indexReg);
 	if (index < 0 || (uint32_t)index >= array->getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("aget-boolean: Array index out of bounds");
-	}
-	auto element = array->getElement(index);
-	if (!element->isNumberObject()) {
-		throw VmException("aget-boolean: Array element is not a number object");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "aget-boolean: Array index out of bounds");
+		return;
 	}
-	bool value = element->getValue() != 0;
-	frame.setIntRegister(dest, value);
+	frame.setIntRegister(dest, array->getPrimitive<uint8_t>(index));
 	frame.pc() += 3;
 }
 // aget-byte vAA, vBB, vCC
@@ -1381,27 +2359,25 @@ void Interpreter::aget_byte(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t arrayReg = operand_[1];
 	uint8_t indexReg = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
 	auto arrayObj = frame.getObjRegister(arrayReg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("aget-byte on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "aget-byte on null array object");
+		return;
 	}
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("aget-byte: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "aget-byte: Object is not an array");
+		return;
 	}
 
 	int32_t index = frame.getIntRegister(indexReg);
 	if (index < 0 || (uint32_t)index >= array->getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("aget-byte: Array index out of bounds");
-	}
-	auto element = array->getElement(index);
-	if (!element->isNumberObject()) {
-		throw VmException("aget-byte: Array element is not a number object");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "aget-byte: Array index out of bounds");
+		return;
 	}
-	int8_t value = static_cast<int8_t>(element->getValue());
-	frame.setIntRegister(dest, value);
+	frame.setIntRegister(dest, array->getPrimitive<int8_t>(index));
 	frame.pc() += 3;
 }
 // aget-char vAA, vBB, vCC
@@ -1409,27 +2385,25 @@ void Interpreter::aget_char(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t arrayReg = operand_[1];
 	uint8_t indexReg = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
 	auto arrayObj = frame.getObjRegister(arrayReg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("aget-char on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "aget-char on null array object");
+		return;
 	}
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("aget-char: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "aget-char: Object is not an array");
+		return;
 	}
 
 	int32_t index = frame.getIntRegister(indexReg);
 	if (index < 0 || (uint32_t)index >= array->getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("aget-char: Array index out of bounds");
-	}
-	auto element = array->getElement(index);
-	if (!element->isNumberObject()) {
-		throw VmException("aget-char: Array element is not a number object");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "aget-char: Array index out of bounds");
+		return;
 	}
-	uint16_t value = static_cast<uint16_t>(element->getValue());
-	frame.setIntRegister(dest, value);
+	frame.setIntRegister(dest, array->getPrimitive<uint16_t>(index));
 	frame.pc() += 3;
 }
 // aget-short vAA, vBB, vCC
@@ -1437,27 +2411,25 @@ void Interpreter::aget_short(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t arrayReg = operand_[1];
 	uint8_t indexReg = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
 	auto arrayObj = frame.getObjRegister(arrayReg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("aget-short on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "aget-short on null array object");
+		return;
 	}
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("aget-short: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "aget-short: Object is not an array");
+		return;
 	}
 
 	int32_t index = frame.getIntRegister(indexReg);
 	if (index < 0 || (uint32_t)index >= array->getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("aget-short: Array index out of bounds");
-	}
-	auto element = array->getElement(index);
-	if (!element->isNumberObject()) {
-		throw VmException("aget-short: Array element is not a number object");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "aget-short: Array index out of bounds");
+		return;
 	}
-	int16_t value = static_cast<int16_t>(element->getValue());
-	frame.setIntRegister(dest, value);
+	frame.setIntRegister(dest, array->getPrimitive<int16_t>(index));
 	frame.pc() += 3;
 }
 // aput vAA, vBB, vCC
@@ -1465,25 +2437,28 @@ void Interpreter::aput(const uint8_t* operand_) {
 	uint8_t valueReg = operand_[0];
 	uint8_t arrayReg = operand_[1];
 	uint8_t indexReg = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
-	logger.fdebug("aput: valueReg: {}, arrayReg: {}, indexReg: {}", valueReg, arrayReg, indexReg);
+	LOG_DEBUG("aput: valueReg: {}, arrayReg: {}, indexReg: {}", valueReg, arrayReg, indexReg);
 
 	auto arrayObj = frame.getObjRegister(arrayReg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("aput on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "aput on null array object");
+		return;
 	}
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("aput: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "aput: Object is not an array");
+		return;
 	}
 
 	int32_t index = frame.getIntRegister(indexReg);
 	int32_t value = frame.getIntRegister(valueReg);
 	if (index < 0 || (uint32_t)index >= array->getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("aput: Array index out of bounds");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "aput: Array index out of bounds");
+		return;
 	}
-	array->setElement(index, Object::make(value));
+	array->setPrimitive<int32_t>(index, value);
 	frame.pc() += 3;
 }
 // aput-wide vAA, vBB, vCC
@@ -1491,23 +2466,25 @@ void Interpreter::aput_wide(const uint8_t* operand_) {
 	uint8_t valueReg = operand_[0];
 	uint8_t arrayReg = operand_[1];
 	uint8_t indexReg = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
 	auto arrayObj = frame.getObjRegister(arrayReg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("aput-wide on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "aput-wide on null array object");
+		return;
 	}
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("aput-wide: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "aput-wide: Object is not an array");
+		return;
 	}
 
 	int32_t index = frame.getIntRegister(indexReg);
 	if (index < 0 || (uint32_t)index >= array->getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("aput-wide: Array index out of bounds");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "aput-wide: Array index out of bounds");
+		return;
 	}
-	auto value = frame.getLongRegister(valueReg);
-	array->setElement(index, Object::make(value));
+	array->setPrimitive<int64_t>(index, frame.getLongRegister(valueReg));
 	frame.pc() += 3;
 }
 // aput-object vAA, vBB, vCC
@@ -1515,21 +2492,24 @@ void Interpreter::aput_object(const uint8_t* operand_) {
 	uint8_t valueReg = operand_[0];
 	uint8_t arrayReg = operand_[1];
 	uint8_t indexReg = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
 	auto arrayObj = frame.getObjRegister(arrayReg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("aput-object on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "aput-object on null array object");
+		return;
 	}
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("aput-object: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "aput-object: Object is not an array");
+		return;
 	}
 
 	int32_t index = frame.getIntRegister(indexReg);
 	auto value = frame.getObjRegister(valueReg);
 	if (index < 0 || (uint32_t)index >= array->getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("aput-object: Array index out of bounds");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "aput-object: Array index out of bounds");
+		return;
 	}
 	array->setElement(index, value);
 	frame.pc() += 3;
@@ -1539,23 +2519,26 @@ void Interpreter::aput_boolean(const uint8_t* operand_) {
 	uint8_t valueReg = operand_[0];
 	uint8_t arrayReg = operand_[1];
 	uint8_t indexReg = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
 	auto arrayObj = frame.getObjRegister(arrayReg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("aput-boolean on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "aput-boolean on null array object");
+		return;
 	}
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("aput-boolean: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "aput-boolean: Object is not an array");
+		return;
 	}
 
 	int32_t index = frame.getIntRegister(indexReg);
-	bool value = frame.getIntRegister(valueReg) != 0;
+	uint8_t value = frame.getIntRegister(valueReg) != 0;
 	if (index < 0 || (uint32_t)index >= array->getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("aput-boolean: Array index out of bounds");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "aput-boolean: Array index out of bounds");
+		return;
 	}
-	array->setElement(index, Object::make(value));
+	array->setPrimitive<uint8_t>(index, value);
 	frame.pc() += 3;
 }
 // aput-byte vAA, vBB, vCC
@@ -1563,23 +2546,26 @@ void Interpreter::aput_byte(const uint8_t* operand_) {
 	uint8_t valueReg = operand_[0];
 	uint8_t arrayReg = operand_[1];
 	uint8_t indexReg = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
 	auto arrayObj = frame.getObjRegister(arrayReg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("aput-byte on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "aput-byte on null array object");
+		return;
 	}
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("aput-byte: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "aput-byte: Object is not an array");
+		return;
 	}
 
 	int32_t index = frame.getIntRegister(indexReg);
 	int8_t value = static_cast<int8_t>(frame.getIntRegister(valueReg));
 	if (index < 0 || (uint32_t)index >= array->getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("aput-byte: Array index out of bounds");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "aput-byte: Array index out of bounds");
+		return;
 	}
-	array->setElement(index, Object::make(value));
+	array->setPrimitive<int8_t>(index, value);
 	frame.pc() += 3;
 }
 // aput-char vAA, vBB, vCC
@@ -1587,23 +2573,26 @@ void Interpreter::aput_char(const uint8_t* operand_) {
 	uint8_t valueReg = operand_[0];
 	uint8_t arrayReg = operand_[1];
 	uint8_t indexReg = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
 	auto arrayObj = frame.getObjRegister(arrayReg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("aput-char on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "aput-char on null array object");
+		return;
 	}
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("aput-char: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "aput-char: Object is not an array");
+		return;
 	}
 
 	int32_t index = frame.getIntRegister(indexReg);
 	uint16_t value = static_cast<uint16_t>(frame.getIntRegister(valueReg));
 	if (index < 0 || (uint32_t)index >= array->getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("aput-char: Array index out of bounds");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "aput-char: Array index out of bounds");
+		return;
 	}
-	array->setElement(index, Object::make(value));
+	array->setPrimitive<uint16_t>(index, value);
 	frame.pc() += 3;
 }
 // aput-short vAA, vBB, vCC
@@ -1611,23 +2600,26 @@ void Interpreter::aput_short(const uint8_t* operand_) {
 	uint8_t valueReg = operand_[0];
 	uint8_t arrayReg = operand_[1];
 	uint8_t indexReg = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 
 	auto arrayObj = frame.getObjRegister(arrayReg);
 	if (arrayObj->isNull()) {
-		throw NullPointerException("aput-short on null array object");
+		raise(Vm::Throwable::NULL_POINTER, "aput-short on null array object");
+		return;
 	}
 	auto array = static_cast<ArrayRef>(arrayObj);
 	if (!array) {
-		throw ClassCastException("aput-short: Object is not an array");
+		raise(Vm::Throwable::CLASS_CAST, "aput-short: Object is not an array");
+		return;
 	}
 
 	int32_t index = frame.getIntRegister(indexReg);
 	int16_t value = static_cast<int16_t>(frame.getIntRegister(valueReg));
 	if (index < 0 || (uint32_t)index >= array->getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("aput-short: Array index out of bounds");
+		raise(Vm::Throwable::ARRAY_INDEX_OUT_OF_BOUNDS, "aput-short: Array index out of bounds");
+		return;
 	}
-	array->setElement(index, Object::make(value));
+	array->setPrimitive<int16_t>(index, value);
 	frame.pc() += 3;
 }
 // iget vA, vB, field@CCCC
@@ -1635,12 +2627,13 @@ void Interpreter::iget(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t objReg = (operand_[0] >> 4) & 0x0F;
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto obj = frame.getObjRegister(objReg);
 	if (obj->isNull()) {
-		throw NullPointerException("iget on null object");
+		raise(Vm::Throwable::NULL_POINTER, "iget on null object");
+		return;
 	}
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -1648,12 +2641,8 @@ void Interpreter::iget(const uint8_t* operand_) {
 		throw VmException("iget: Field {} type mismatch, expected int but got {}", field.getName(), field.getType());
 	}
 
-	auto fieldObj = obj->getField(field.getName());
-	if (!fieldObj || !fieldObj->isNumberObject()) {
-		throw VmException("iget: Field {} is not a number object", field.getName());
-	}
-	int32_t value = fieldObj->getValue();
-	logger.fdebug("iget {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	int32_t value = static_cast<int32_t>(obj->getFieldValue(field.getSlot()));
+	LOG_DEBUG("iget {}.{}={}", field.getClass().getFullname(), field.getName(), value);
 	frame.setIntRegister(dest, value);
 	frame.pc() += 3;
 }
@@ -1662,25 +2651,21 @@ void Interpreter::iget_wide(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t objReg = (operand_[0] >> 4) & 0x0F;
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto obj = frame.getObjRegister(objReg);
 	if (obj->isNull()) {
-		throw NullPointerException("iget_wide on null object");
+		raise(Vm::Throwable::NULL_POINTER, "iget_wide on null object");
+		return;
 	}
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
 	if (field.getType() != "J" && field.getType() != "D") {
 		throw VmException("iget_wide: Field {} type mismatch, expected long or double but got {}", field.getName(), field.getType());
 	}
-	auto fieldObj = obj->getField(field.getName());
-	if (!fieldObj || !fieldObj->isNumberObject()) {
-		throw VmException("iget_wide: Field {} is not a number object", field.getName());
-	}
-
-	auto value = fieldObj->getLongValue();
-	logger.fdebug("iget_wide {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	auto value = static_cast<int64_t>(obj->getFieldValue(field.getSlot()));
+	LOG_DEBUG("iget_wide {}.{}={}", field.getClass().getFullname(), field.getName(), value);
 	frame.setLongRegister(dest, value);
 	frame.pc() += 3;
 }
@@ -1689,12 +2674,13 @@ void Interpreter::iget_object(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t objReg = (operand_[0] >> 4) & 0x0F;
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto obj = frame.getObjRegister(objReg);
 	if (obj->isNull()) {
-		throw NullPointerException("iget_object on null object");
+		raise(Vm::Throwable::NULL_POINTER, "iget_object on null object");
+		return;
 	}
 
 	// class should have been loaded if trying to access an instance field. resolveField should not fail.
@@ -1703,8 +2689,8 @@ void Interpreter::iget_object(const uint8_t* operand_) {
 		throw VmException("iget_object: Field {} type mismatch, expected object or array but got {}", field.getName(), field.getType());
 	}
 
-	auto fieldObj = obj->getField(field.getName());
-	logger.fdebug("iget_object {}.{}={}", field.getClass().getFullname(), field.getName(), fieldObj ? fieldObj->toString() : "null");
+	auto fieldObj = obj->getFieldObject(field.getSlot());
+	LOG_DEBUG("iget_object {}.{}={}", field.getClass().getFullname(), field.getName(), fieldObj ? fieldObj->toString() : "null");
 	frame.setObjRegister(dest, fieldObj);
 	frame.pc() += 3;
 }
@@ -1713,12 +2699,13 @@ void Interpreter::iget_boolean(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t objReg = (operand_[0] >> 4) & 0x0F;
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto obj = frame.getObjRegister(objReg);
 	if (obj->isNull()) {
-		throw NullPointerException("iget_boolean on null object");
+		raise(Vm::Throwable::NULL_POINTER, "iget_boolean on null object");
+		return;
 	}
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -1726,12 +2713,8 @@ void Interpreter::iget_boolean(const uint8_t* operand_) {
 		throw VmException("iget_boolean: Field {} type mismatch, expected boolean but got {}", field.getName(), field.getType());
 	}
 
-	auto fieldObj = obj->getField(field.getName());
-	if (!fieldObj || !fieldObj->isNumberObject()) {
-		throw VmException("iget_boolean: Field {} is not a number object", field.getName());
-	}
-	bool value = static_cast<bool>(fieldObj->getValue());
-	logger.fdebug("iget_boolean {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	bool value = static_cast<bool>(static_cast<int32_t>(obj->getFieldValue(field.getSlot())));
+	LOG_DEBUG("iget_boolean {}.{}={}", field.getClass().getFullname(), field.getName(), value);
 	frame.setIntRegister(dest, value);
 	frame.pc() += 3;
 }
@@ -1740,12 +2723,13 @@ void Interpreter::iget_byte(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t objReg = (operand_[0] >> 4) & 0x0F;
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto obj = frame.getObjRegister(objReg);
 	if (obj->isNull()) {
-		throw NullPointerException("iget_byte on null object");
+		raise(Vm::Throwable::NULL_POINTER, "iget_byte on null object");
+		return;
 	}
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -1753,12 +2737,8 @@ void Interpreter::iget_byte(const uint8_t* operand_) {
 		throw VmException("iget_byte: Field {} type mismatch, expected byte but got {}", field.getName(), field.getType());
 	}
 
-	auto fieldObj = obj->getField(field.getName());
-	if (!fieldObj || !fieldObj->isNumberObject()) {
-		throw VmException("iget_byte: Field {} is not a number object", field.getName());
-	}
-	int8_t value = static_cast<int8_t>(fieldObj->getValue());
-	logger.fdebug("iget_byte {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	int8_t value = static_cast<int8_t>(obj->getFieldValue(field.getSlot()));
+	LOG_DEBUG("iget_byte {}.{}={}", field.getClass().getFullname(), field.getName(), value);
 	frame.setIntRegister(dest, value);
 	frame.pc() += 3;
 }
@@ -1767,12 +2747,13 @@ void Interpreter::iget_char(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t objReg = (operand_[0] >> 4) & 0x0F;
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto obj = frame.getObjRegister(objReg);
 	if (obj->isNull()) {
-		throw NullPointerException("iget_char on null object");
+		raise(Vm::Throwable::NULL_POINTER, "iget_char on null object");
+		return;
 	}
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -1780,12 +2761,8 @@ void Interpreter::iget_char(const uint8_t* operand_) {
 		throw VmException("iget_char: Field {} type mismatch, expected char but got {}", field.getName(), field.getType());
 	}
 
-	auto fieldObj = obj->getField(field.getName());
-	if (!fieldObj || !fieldObj->isNumberObject()) {
-		throw VmException("iget_byte: Field {} is not a number object", field.getName());
-	}
-	uint16_t value = static_cast<uint16_t>(fieldObj->getValue());
-	logger.fdebug("iget_char {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	uint16_t value = static_cast<uint16_t>(obj->getFieldValue(field.getSlot()));
+	LOG_DEBUG("iget_char {}.{}={}", field.getClass().getFullname(), field.getName(), value);
 	frame.setIntRegister(dest, value);
 	frame.pc() += 3;
 }
@@ -1794,12 +2771,13 @@ void Interpreter::iget_short(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t objReg = (operand_[0] >> 4) & 0x0F;
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto obj = frame.getObjRegister(objReg);
 	if (obj->isNull()) {
-		throw NullPointerException("iget_short on null object");
+		raise(Vm::Throwable::NULL_POINTER, "iget_short on null object");
+		return;
 	}
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -1807,12 +2785,8 @@ void Interpreter::iget_short(const uint8_t* operand_) {
 		throw VmException("iget_short: Field {} type mismatch, expected short but got {}", field.getName(), field.getType());
 	}
 
-	auto fieldObj = obj->getField(field.getName());
-	if (!fieldObj || !fieldObj->isNumberObject()) {
-		throw VmException("iget_byte: Field {} is not a number object", field.getName());
-	}
-	int16_t value = static_cast<int16_t>(fieldObj->getValue());
-	logger.fdebug("iget_short {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	int16_t value = static_cast<int16_t>(obj->getFieldValue(field.getSlot()));
+	LOG_DEBUG("iget_short {}.{}={}", field.getClass().getFullname(), field.getName(), value);
 	frame.setIntRegister(dest, value);
 	frame.pc() += 3;
 }
@@ -1821,12 +2795,13 @@ void Interpreter::iput(const uint8_t* operand_) {
 	uint8_t src = operand_[0] & 0x0F;
 	uint8_t objReg = (operand_[0] >> 4) & 0x0F;
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto obj = frame.getObjRegister(objReg);
 	if (obj->isNull()) {
-		throw NullPointerException("iput on null object");
+		raise(Vm::Throwable::NULL_POINTER, "iput on null object");
+		return;
 	}
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -1834,8 +2809,8 @@ void Interpreter::iput(const uint8_t* operand_) {
 		throw VmException("iput: Field {} type mismatch, expected int but got {}", field.getName(), field.getType());
 	}
 	int32_t value = frame.getIntRegister(src);
-	logger.fdebug("iput {}.{}={}", field.getClass().getFullname(), field.getName(), value);
-	obj->setField(field.getName(), Object::make(value));
+	LOG_DEBUG("iput {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	obj->setFieldValue(field.getSlot(), static_cast<uint64_t>(value));
 	frame.pc() += 3;
 }
 // iput-wide vA, vB, field@CCCC
@@ -1843,12 +2818,13 @@ void Interpreter::iput_wide(const uint8_t* operand_) {
 	uint8_t src = operand_[0] & 0x0F;
 	uint8_t objReg = (operand_[0] >> 4) & 0x0F;
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto obj = frame.getObjRegister(objReg);
 	if (obj->isNull()) {
-		throw NullPointerException("iput_wide on null object");
+		raise(Vm::Throwable::NULL_POINTER, "iput_wide on null object");
+		return;
 	}
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -1861,8 +2837,8 @@ void Interpreter::iput_wide(const uint8_t* operand_) {
 	}
 
 	int64_t value = frame.getLongRegister(src);
-	logger.fdebug("iput_wide {}.{}={}", field.getClass().getFullname(), field.getName(), value);
-	obj->setField(field.getName(), Object::make(value));
+	LOG_DEBUG("iput_wide {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	obj->setFieldValue(field.getSlot(), static_cast<uint64_t>(value));
 	frame.pc() += 3;
 }
 // iput-object vA, vB, field@CCCC
@@ -1870,12 +2846,13 @@ void Interpreter::iput_object(const uint8_t* operand_) {
 	uint8_t src = operand_[0] & 0x0F;
 	uint8_t objReg = (operand_[0] >> 4) & 0x0F;
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto obj = frame.getObjRegister(objReg);
 	if (obj->isNull()) {
-		throw NullPointerException("iput_object on null object");
+		raise(Vm::Throwable::NULL_POINTER, "iput_object on null object");
+		return;
 	}
 
 	// class should have been loaded if trying to access an instance field. resolveField should not fail.
@@ -1889,8 +2866,8 @@ void Interpreter::iput_object(const uint8_t* operand_) {
 	}
 
 	auto value = frame.getObjRegister(src);
-	logger.fdebug("iput_object {}.{}={}", field.getClass().getFullname(), field.getName(), value->toString());
-	obj->setField(field.getName(), value);
+	LOG_DEBUG("iput_object {}.{}={}", field.getClass().getFullname(), field.getName(), value->toString());
+	obj->setFieldObject(field.getSlot(), value);
 	frame.pc() += 3;
 }
 // iput-boolean vA, vB, field@CCCC
@@ -1898,12 +2875,13 @@ void Interpreter::iput_boolean(const uint8_t* operand_) {
 	uint8_t src = operand_[0] & 0x0F;
 	uint8_t objReg = (operand_[0] >> 4) & 0x0F;
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto obj = frame.getObjRegister(objReg);
 	if (obj->isNull()) {
-		throw NullPointerException("iput_boolean on null object");
+		raise(Vm::Throwable::NULL_POINTER, "iput_boolean on null object");
+		return;
 	}
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -1912,8 +2890,8 @@ void Interpreter::iput_boolean(const uint8_t* operand_) {
 	}
 
 	bool value = frame.getIntRegister(src) != 0;
-	logger.fdebug("iput_boolean {}.{}={}", field.getClass().getFullname(), field.getName(), value);
-	obj->setField(field.getName(), Object::make(value));
+	LOG_DEBUG("iput_boolean {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	obj->setFieldValue(field.getSlot(), static_cast<uint64_t>(value));
 	frame.pc() += 3;
 }
 // iput-byte vA, vB, field@CCCC
@@ -1921,12 +2899,13 @@ void Interpreter::iput_byte(const uint8_t* operand_) {
 	uint8_t src = operand_[0] & 0x0F;
 	uint8_t objReg = (operand_[0] >> 4) & 0x0F;
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto obj = frame.getObjRegister(objReg);
 	if (obj->isNull()) {
-		throw NullPointerException("iput_byte on null object");
+		raise(Vm::Throwable::NULL_POINTER, "iput_byte on null object");
+		return;
 	}
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -1935,8 +2914,8 @@ void Interpreter::iput_byte(const uint8_t* operand_) {
 	}
 
 	int8_t value = static_cast<int8_t>(frame.getIntRegister(src));
-	logger.fdebug("iput_byte {}.{}={}", field.getClass().getFullname(), field.getName(), value);
-	obj->setField(field.getName(), Object::make(value));
+	LOG_DEBUG("iput_byte {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	obj->setFieldValue(field.getSlot(), static_cast<uint64_t>(value));
 	frame.pc() += 3;
 }
 // iput-char vA, vB, field@CCCC
@@ -1944,12 +2923,13 @@ void Interpreter::iput_char(const uint8_t* operand_) {
 	uint8_t src = operand_[0] & 0x0F;
 	uint8_t objReg = (operand_[0] >> 4) & 0x0F;
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto obj = frame.getObjRegister(objReg);
 	if (obj->isNull()) {
-		throw NullPointerException("iput_char on null object");
+		raise(Vm::Throwable::NULL_POINTER, "iput_char on null object");
+		return;
 	}
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -1958,8 +2938,8 @@ void Interpreter::iput_char(const uint8_t* operand_) {
 	}
 
 	uint16_t value = static_cast<uint16_t>(frame.getIntRegister(src));
-	logger.fdebug("iput_char {}.{}={}", field.getClass().getFullname(), field.getName(), value);
-	obj->setField(field.getName(), Object::make(value));
+	LOG_DEBUG("iput_char {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	obj->setFieldValue(field.getSlot(), static_cast<uint64_t>(value));
 	frame.pc() += 3;
 }
 // iput-short vA, vB, field@CCCC
@@ -1967,12 +2947,13 @@ void Interpreter::iput_short(const uint8_t* operand_) {
 	uint8_t src = operand_[0] & 0x0F;
 	uint8_t objReg = (operand_[0] >> 4) & 0x0F;
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto obj = frame.getObjRegister(objReg);
 	if (obj->isNull()) {
-		throw NullPointerException("iput_short on null object");
+		raise(Vm::Throwable::NULL_POINTER, "iput_short on null object");
+		return;
 	}
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -1981,15 +2962,15 @@ void Interpreter::iput_short(const uint8_t* operand_) {
 	}
 
 	int16_t value = static_cast<int16_t>(frame.getIntRegister(src));
-	logger.fdebug("iput_short {}.{}={}", field.getClass().getFullname(), field.getName(), value);
-	obj->setField(field.getName(), Object::make(value));
+	LOG_DEBUG("iput_short {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	obj->setFieldValue(field.getSlot(), static_cast<uint64_t>(value));
 	frame.pc() += 3;
 }
 // sget vA, field@BBBB
 void Interpreter::sget(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -2012,7 +2993,7 @@ void Interpreter::sget(const uint8_t* operand_) {
 void Interpreter::sget_wide(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -2035,11 +3016,11 @@ void Interpreter::sget_wide(const uint8_t* operand_) {
 void Interpreter::sget_object(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
-	logger.fdebug("sget_object: Resolving field {}", field.str());
+	LOG_DEBUG("sget_object: Resolving field {}", field.str());
 	if (!field.isStatic()) {
 		throw VmException("sget_object: Cannot use sget_object on a non-static field");
 	}
@@ -2059,7 +3040,7 @@ void Interpreter::sget_object(const uint8_t* operand_) {
 void Interpreter::sget_boolean(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -2082,7 +3063,7 @@ void Interpreter::sget_boolean(const uint8_t* operand_) {
 void Interpreter::sget_byte(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -2105,7 +3086,7 @@ void Interpreter::sget_byte(const uint8_t* operand_) {
 void Interpreter::sget_char(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -2128,7 +3109,7 @@ void Interpreter::sget_char(const uint8_t* operand_) {
 void Interpreter::sget_short(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	const auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -2151,7 +3132,7 @@ void Interpreter::sget_short(const uint8_t* operand_) {
 void Interpreter::sput(const uint8_t* operand_) {
 	uint8_t src = operand_[0];
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -2162,8 +3143,13 @@ void Interpreter::sput(const uint8_t* operand_) {
 		throw VmException("sput: Field {} type mismatch, expected int but got {}", field.getName(), field.getType());
 	}
 
+	// static field access, class instance may not be instantiated yet
+	auto& clazz = field.getClass();
+	if (!clazz.isStaticInitialized()) {
+		executeClinit(clazz);
+	}
 	int32_t value = frame.getIntRegister(src);
-	logger.fdebug("sput {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	LOG_DEBUG("sput {}.{}={}", field.getClass().getFullname(), field.getName(), value);
 	field.setIntValue(value);
 	frame.pc() += 3;
 }
@@ -2171,7 +3157,7 @@ void Interpreter::sput(const uint8_t* operand_) {
 void Interpreter::sput_wide(const uint8_t* operand_) {
 	uint8_t src = operand_[0];
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -2182,8 +3168,13 @@ void Interpreter::sput_wide(const uint8_t* operand_) {
 		throw VmException("sput_wide: Field {} type mismatch, expected long or double but got {}", field.getName(), field.getType());
 	}
 
+	// static field access, class instance may not be instantiated yet
+	auto& clazz = field.getClass();
+	if (!clazz.isStaticInitialized()) {
+		executeClinit(clazz);
+	}
 	int64_t value = frame.getLongRegister(src);
-	logger.fdebug("sput_wide {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	LOG_DEBUG("sput_wide {}.{}={}", field.getClass().getFullname(), field.getName(), value);
 	field.setLongValue(value);
 	frame.pc() += 3;
 }
@@ -2191,11 +3182,10 @@ void Interpreter::sput_wide(const uint8_t* operand_) {
 void Interpreter::sput_object(const uint8_t* operand_) {
 	uint8_t src = operand_[0];
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
-	std::string classname, fieldname;
-	auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex, classname, fieldname);
+	auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
 	if (!field.isStatic()) {
 		throw VmException("sput_object: Cannot use sput_object on a non-static field");
 	}
@@ -2224,7 +3214,7 @@ void Interpreter::sput_object(const uint8_t* operand_) {
 void Interpreter::sput_boolean(const uint8_t* operand_) {
 	uint8_t src = operand_[0];
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -2235,8 +3225,13 @@ void Interpreter::sput_boolean(const uint8_t* operand_) {
 		throw VmException("sput_boolean: Field {} type mismatch, expected boolean but got {}", field.getName(), field.getType());
 	}
 
+	// static field access, class instance may not be instantiated yet
+	auto& clazz = field.getClass();
+	if (!clazz.isStaticInitialized()) {
+		executeClinit(clazz);
+	}
 	bool value = frame.getIntRegister(src) != 0;
-	logger.fdebug("sput_boolean {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	LOG_DEBUG("sput_boolean {}.{}={}", field.getClass().getFullname(), field.getName(), value);
 	field.setIntValue(value);
 	frame.pc() += 3;
 }
@@ -2244,7 +3239,7 @@ void Interpreter::sput_boolean(const uint8_t* operand_) {
 void Interpreter::sput_byte(const uint8_t* operand_) {
 	uint8_t src = operand_[0];
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -2255,8 +3250,13 @@ void Interpreter::sput_byte(const uint8_t* operand_) {
 		throw VmException("sput_byte: Field {} type mismatch, expected byte but got {}", field.getName(), field.getType());
 	}
 
+	// static field access, class instance may not be instantiated yet
+	auto& clazz = field.getClass();
+	if (!clazz.isStaticInitialized()) {
+		executeClinit(clazz);
+	}
 	int8_t value = static_cast<int8_t>(frame.getIntRegister(src));
-	logger.fdebug("sput_byte {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	LOG_DEBUG("sput_byte {}.{}={}", field.getClass().getFullname(), field.getName(), value);
 	field.setIntValue(value);
 	frame.pc() += 3;
 }
@@ -2264,7 +3264,7 @@ void Interpreter::sput_byte(const uint8_t* operand_) {
 void Interpreter::sput_char(const uint8_t* operand_) {
 	uint8_t src = operand_[0];
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -2275,8 +3275,13 @@ void Interpreter::sput_char(const uint8_t* operand_) {
 		throw VmException("sput_char: Field {} type mismatch, expected char but got {}", field.getName(), field.getType());
 	}
 
+	// static field access, class instance may not be instantiated yet
+	auto& clazz = field.getClass();
+	if (!clazz.isStaticInitialized()) {
+		executeClinit(clazz);
+	}
 	uint16_t value = static_cast<uint16_t>(frame.getIntRegister(src));
-	logger.fdebug("sput_char {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	LOG_DEBUG("sput_char {}.{}={}", field.getClass().getFullname(), field.getName(), value);
 	field.setIntValue(value);
 	frame.pc() += 3;
 }
@@ -2284,7 +3289,7 @@ void Interpreter::sput_char(const uint8_t* operand_) {
 void Interpreter::sput_short(const uint8_t* operand_) {
 	uint8_t src = operand_[0];
 	uint16_t fieldIndex = *(const uint16_t*)&operand_[1];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto& field = classloader.resolveField(frame.getDexIdx(), fieldIndex);
@@ -2295,78 +3300,55 @@ void Interpreter::sput_short(const uint8_t* operand_) {
 		throw VmException("sput_short: Field {} type mismatch, expected short but got {}", field.getName(), field.getType());
 	}
 
+	// static field access, class instance may not be instantiated yet
+	auto& clazz = field.getClass();
+	if (!clazz.isStaticInitialized()) {
+		executeClinit(clazz);
+	}
 	int16_t value = static_cast<int16_t>(frame.getIntRegister(src));
-	logger.fdebug("sput_short {}.{}={}", field.getClass().getFullname(), field.getName(), value);
+	LOG_DEBUG("sput_short {}.{}={}", field.getClass().getFullname(), field.getName(), value);
 	field.setIntValue(value);
 	frame.pc() += 3;
 }
 // invoke-virtual {vD, vE, vF, vG, vA}, meth@CCCC
 void Interpreter::invoke_virtual(const uint8_t* operand_) {
-	auto& classloader = _rt.getClassLoader();
-	auto& frame = _rt.currentFrame();
-	uint16_t methodRef = *(const uint16_t*)&operand_[1];
+	const uint16_t methodRef = *reinterpret_cast<const uint16_t*>(&operand_[1]);
+	auto& frame = *_frame;
 
-	auto args = getInvokeMethodArgs(operand_);
-	auto this_ptr = args[0];
+	auto regs = getInvokeMethodRegs(operand_);
+	auto this_ptr = frame.getObjRegister(regs[0]);
 	if (this_ptr->isNull()) {
-		throw NullPointerException("invoke-virtual on null object");
+		raise(Vm::Throwable::NULL_POINTER, "invoke-virtual on null object");
+		return;
 	}
 	if (!this_ptr->isClass()) {
 		throw VmException("invoke-virtual: this pointer is not an ObjectClass, got {}", this_ptr->toString());
 	}
-	Class* instance = &this_ptr->getClass();
-	if (!instance->isStaticInitialized()) {
-		executeClinit(*instance);
+	auto& instance = this_ptr->getClass();
+	if (!instance.isStaticInitialized()) {
+		executeClinit(instance);
 	}
 
-	std::string classname, methodname, signature;
-	classloader.findMethod(frame.getDexIdx(), methodRef, classname, methodname, signature);
-
-	Method* vmethod = nullptr;
-	while (true) {
-		try {
-			vmethod = &instance->getMethod(methodname, signature);
-			if (!vmethod->isVirtual()) {
-				// throw exception here to go up the superclass chain
-				throw VmException();
-			}
-			break;  // Method found, exit loop
-		} catch (std::exception& e) {
-			logger.fdebug("invoke-virtual: method {}->{}{} not found, trying superclass", instance->getFullname(), methodname, signature);
-			if (instance->hasSuperClass()) {
-				// If the method is not found in the current class, try the superclass
-				instance = &classloader.getOrLoad(instance->getSuperClassname());
-				if (!instance->isStaticInitialized()) {
-					executeClinit(*instance);
-				}
-			} else {
-				// If no superclass, break the loop
-				break;
-			}
-		}
+	auto* vmethod = findVirtualTarget(instance, methodRef);
+	if (vmethod == nullptr) [[unlikely]] {
+		const auto& [classname, methodname, signature] = _rt.getClassLoader().findMethod(frame.getDexIdx(), methodRef);
+		throw VmException("invoke-virtual: call method {}->{}{} not found", instance.getFullname(), methodname, signature);
 	}
-	if (vmethod) {
-		if (!vmethod->isVirtual()) {
-			logger.ferror("invoke-virtual: method {}->{}{} is not virtual", this_ptr->getClass().getFullname(), methodname, signature);
-		}
-		trace.logCall("invoke-virtual", instance->getFullname(), methodname, signature, args, vmethod->isStatic());
-		if (vmethod->isNative()) {
-			executeNativeMethod(*vmethod, args);
+	auto& cls = vmethod->getClass();
+	if (!cls.isStaticInitialized()) {
+		executeClinit(cls);
+	}
+	logCall("invoke-virtual", cls.getFullname(), vmethod->getName(), vmethod->getSignature(), regs, vmethod->isStatic());
+	if (vmethod->isNative()) {
+		executeNativeMethod(*vmethod, regs);
+	} else {
+		if (vmethod->hasBytecode()) {
+			auto& newframe = _rt.newFrame(*vmethod);
+			setInvokeMethodArgs(newframe, frame, regs);
 		} else {
-			if (vmethod->hasBytecode()) {
-				auto& newframe = _rt.newFrame(*vmethod);
-				// When a method is invoked, the parameters to the method are placed into the last n registers.
-				for (size_t i = 0; i < args.size(); ++i) {
-					uint32_t regIdx = vmethod->getNbRegisters() - args.size() + i;
-					newframe.setObjRegister(regIdx, args[i]);
-				}
-			} else {
-				vmethod->execute(frame, args);
-			}
+			auto args = getInvokeMethodArgs(regs);
+			vmethod->execute(frame, args);
 		}
-	} else {
-		// If no method found, throw an error
-		throw VmException(fmt::format("invoke-virtual: call method {}->{}{} not found", this_ptr->getClass().getFullname(), methodname, signature));
 	}
 
 	frame.pc() += 5;
@@ -2374,48 +3356,38 @@ void Interpreter::invoke_virtual(const uint8_t* operand_) {
 // invoke-super {vD, vE, vF, vG, vA}, meth@CCCC
 void Interpreter::invoke_super(const uint8_t* operand_) {
 	auto& classloader = _rt.getClassLoader();
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	uint16_t methodRef = *(const uint16_t*)&operand_[1];
 
-	std::string classname, methodname, signature;
-	classloader.findMethod(frame.getDexIdx(), methodRef, classname, methodname, signature);
-
-	auto instance = &classloader.getOrLoad(classname);
-	Method* vmethod = nullptr;
-	while (true) {
-		try {
-			vmethod = &instance->getMethod(methodname, signature);
-			break;  // Method found, exit loop
-		} catch (std::exception& e) {
-			logger.fdebug("invoke-supper: method {}->{}{} not found, trying superclass", classname, methodname, signature);
-			if (instance->hasSuperClass()) {
-				// If the method is not found in the current class, try the superclass
-				instance = &classloader.getOrLoad(instance->getSuperClassname());
-				if (!instance->isStaticInitialized()) {
-					executeClinit(*instance);
-				}
-			} else {
-				// If no superclass, break the loop
-				break;
-			}
+	// the method reference names the super class: its vtable entry is the super implementation
+	Method* vmethod = classloader.resolveVirtualMethod(frame.getDexIdx(), methodRef);
+	if (vmethod == nullptr) [[unlikely]] {
+		const auto& [classname, methodname, signature] = classloader.findMethod(frame.getDexIdx(), methodRef);
+		Class* current = &classloader.getOrLoad(classname);
+		while (current && (vmethod = current->findMethod(methodname, signature)) == nullptr) {
+			current = current->hasSuperClass() ? &current->getSuperClass() : nullptr;
 		}
+		if (vmethod == nullptr) {
+			throw VmException("invoke-super: call method {}->{}{} not found", classname, methodname, signature);
+		}
+	}
+	auto& cls = vmethod->getClass();
+	if (!cls.isStaticInitialized()) {
+		executeClinit(cls);
 	}
 
-	auto args = getInvokeMethodArgs(operand_);
-	trace.logCall("invoke-super", instance->getFullname(), methodname, signature, args, vmethod->isStatic());
+	auto regs = getInvokeMethodRegs(operand_);
+	logCall("invoke-super", cls.getFullname(), vmethod->getName(), vmethod->getSignature(), regs, vmethod->isStatic());
 	if (vmethod->isNative()) {
-		executeNativeMethod(*vmethod, args);
+		executeNativeMethod(*vmethod, regs);
 	} else {
 		if (vmethod->getBytecode() == nullptr) {
+			auto args = getInvokeMethodArgs(regs);
 			vmethod->execute(frame, args);
 		} else {
 			auto& newframe = _rt.newFrame(*vmethod);
 			// set args on new frame
-			// When a method is invoked, the parameters to the method are placed into the last n registers.
-			for (size_t i = 0; i < args.size(); ++i) {
-				uint32_t regIdx = vmethod->getNbRegisters() - args.size() + i;
-				newframe.setObjRegister(regIdx, args[i]);
-			}
+			setInvokeMethodArgs(newframe, frame, regs);
 		}
 	}
 	frame.pc() += 5;
@@ -2423,7 +3395,7 @@ void Interpreter::invoke_super(const uint8_t* operand_) {
 // invoke-direct {vD, vE, vF, vG, vA}, meth@CCCC
 void Interpreter::invoke_direct(const uint8_t* operand_) {
 	auto& classloader = _rt.getClassLoader();
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	uint16_t methodRef = *(const uint16_t*)&operand_[1];
 	auto& method = classloader.resolveMethod(frame.getDexIdx(), methodRef);
 	auto& cls = method.getClass();
@@ -2431,25 +3403,22 @@ void Interpreter::invoke_direct(const uint8_t* operand_) {
 		executeClinit(cls);
 	}
 
-	auto args = getInvokeMethodArgs(operand_);
+	auto regs = getInvokeMethodRegs(operand_);
 	if (method.isStatic()) {
-		trace.logCall("invoke-static", method.getClass().getFullname(), method.getName(), method.getSignature(), args, method.isStatic());
+		logCall("invoke-static", method.getClass().getFullname(), method.getName(), method.getSignature(), regs, method.isStatic());
 	} else {
-		trace.logCall("invoke-direct", method.getClass().getFullname(), method.getName(), method.getSignature(), args, method.isStatic());
+		logCall("invoke-direct", method.getClass().getFullname(), method.getName(), method.getSignature(), regs, method.isStatic());
 	}
 	if (method.isNative()) {
-		executeNativeMethod(method, args);
+		executeNativeMethod(method, regs);
 	} else {
 		if (method.getBytecode() == nullptr) {
+			auto args = getInvokeMethodArgs(regs);
 			method.execute(frame, args);
 		} else {
 			auto& newframe = _rt.newFrame(method);
 			// set args on new frame
-			// When a method is invoked, the parameters to the method are placed into the last n registers.
-			for (size_t i = 0; i < args.size(); ++i) {
-				uint32_t regIdx = method.getNbRegisters() - args.size() + i;
-				newframe.setObjRegister(regIdx, args[i]);
-			}
+			setInvokeMethodArgs(newframe, frame, regs);
 		}
 	}
 	frame.pc() += 5;
@@ -2460,144 +3429,86 @@ void Interpreter::invoke_static(const uint8_t* operand_) {
 }
 // invoke-interface {vD, vE, vF, vG, vA}, meth@CCCC
 void Interpreter::invoke_interface(const uint8_t* operand_) {
-	auto& classloader = _rt.getClassLoader();
-	auto& frame = _rt.currentFrame();
+	const uint16_t methodRef = *reinterpret_cast<const uint16_t*>(&operand_[1]);
+	auto& frame = *_frame;
 
-	uint16_t methodRef = *(const uint16_t*)&operand_[1];
-	auto args = getInvokeMethodArgs(operand_);
-	auto this_ptr = args[0];
+	auto regs = getInvokeMethodRegs(operand_);
+	auto this_ptr = frame.getObjRegister(regs[0]);
 	if (this_ptr->isNull()) {
-		throw NullPointerException("invoke_interface on null object");
+		raise(Vm::Throwable::NULL_POINTER, "invoke-interface on null object");
+		return;
 	}
 	if (!this_ptr->isClass()) {
 		throw VmException("invoke-interface: this pointer is not an ObjectClass, got {}", this_ptr->toString());
 	}
-	Class* instance = &this_ptr->getClass();
-	if (!instance->isStaticInitialized()) {
-		executeClinit(*instance);
+	auto& instance = this_ptr->getClass();
+	if (!instance.isStaticInitialized()) {
+		executeClinit(instance);
 	}
 
-	std::string ifclassname, methodname, signature;
-	classloader.findMethod(frame.getDexIdx(), methodRef, ifclassname, methodname, signature);
-
-	logger.fdebug("invoke-interface {}->{}{} for class {}", ifclassname, methodname, signature, instance->getFullname());
-
-	Method* vmethod = nullptr;
-	Class* current = instance;
-	while (current) {
-		try {
-			vmethod = &current->getMethod(methodname, signature);
-			break;  // Method found, exit loop
-		} catch (...) {
-			// not found in this class
-			if (current->hasSuperClass()) {
-				current = &classloader.getOrLoad(current->getSuperClassname());
-				if (!current->isStaticInitialized()) {
-					executeClinit(*current);
-				}
-			} else {
-				current = nullptr;
-			}
-		}
+	auto* vmethod = findVirtualTarget(instance, methodRef);
+	if (vmethod == nullptr) [[unlikely]] {
+		const auto& [classname, methodname, signature] = _rt.getClassLoader().findMethod(frame.getDexIdx(), methodRef);
+		throw VmException("invoke-interface: call method {}->{}{} not found", instance.getFullname(), methodname, signature);
 	}
-	if (vmethod) {
-		if (!vmethod->isVirtual()) {
-			logger.ferror("invoke-interface: {}->{}{} not virtual", ifclassname, methodname, signature);
-		}
-		trace.logCall("invoke-interface", ifclassname, methodname, signature, args, vmethod->isStatic());
-		if (vmethod->isNative()) {
-			executeNativeMethod(*vmethod, args);
-		} else {
+	auto& cls = vmethod->getClass();
+	if (!cls.isStaticInitialized()) {
+		executeClinit(cls);
+	}
+	logCall("invoke-interface", cls.getFullname(), vmethod->getName(), vmethod->getSignature(), regs, vmethod->isStatic());
+	if (vmethod->isNative()) {
+		executeNativeMethod(*vmethod, regs);
+	} else {
+		if (vmethod->hasBytecode()) {
 			auto& newframe = _rt.newFrame(*vmethod);
-			// When a method is invoked, the parameters to the method are placed into the last n registers.
-			for (size_t i = 0; i < args.size(); ++i) {
-				uint32_t regIdx = vmethod->getNbRegisters() - args.size() + i;
-				newframe.setObjRegister(regIdx, args[i]);
-			}
+			setInvokeMethodArgs(newframe, frame, regs);
+		} else {
+			auto args = getInvokeMethodArgs(regs);
+			vmethod->execute(frame, args);
 		}
-	} else {
-		// If no method found, throw an error
-		throw VmException("invoke-interface: call method {}->{}{} not found for instance {}", ifclassname, methodname, signature, instance->getFullname());
 	}
+
 	frame.pc() += 5;
 }
 // invoke-virtual/range {vCCCC .. vNNNN}, meth@BBBB
 void Interpreter::invoke_virtual_range(const uint8_t* operand_) {
 	const uint16_t methodRef = *reinterpret_cast<const uint16_t*>(&operand_[1]);
-	const uint16_t startReg = *reinterpret_cast<const uint16_t*>(&operand_[3]);
-	const uint8_t regCount = operand_[0];
-
-	auto& frame = _rt.currentFrame();
-	auto& classloader = _rt.getClassLoader();
-
-	std::vector<ObjectRef> args;
-	for (uint8_t i = 0; i < regCount; ++i) {
-		args.push_back(frame.getObjRegister(startReg + i));
-	}
+	auto& frame = *_frame;
 
-	auto this_ptr = args[0];
+	auto regs = getInvokeMethodRangeRegs(operand_);
+	auto this_ptr = frame.getObjRegister(regs[0]);
 	if (this_ptr->isNull()) {
-		throw NullPointerException("invoke-virtual/range on null object");
+		raise(Vm::Throwable::NULL_POINTER, "invoke-virtual/range on null object");
+		return;
 	}
 	if (!this_ptr->isClass()) {
 		throw VmException("invoke-virtual/range: this pointer is not an ObjectClass, got {}", this_ptr->toString());
 	}
-	Class* instance = &this_ptr->getClass();
-	if (!instance->isStaticInitialized()) {
-		executeClinit(*instance);
+	auto& instance = this_ptr->getClass();
+	if (!instance.isStaticInitialized()) {
+		executeClinit(instance);
 	}
 
-	std::string classname, methodname, signature;
-	classloader.findMethod(frame.getDexIdx(), methodRef, classname, methodname, signature);
-
-	Method* vmethod = nullptr;
-	while (true) {
-		try {
-			vmethod = &instance->getMethod(methodname, signature);
-			if (!vmethod->isVirtual()) {
-				// throw exception here to go up the superclass chain
-				throw VmException();
-			}
-			break;  // Method found, exit loop
-		} catch (std::exception& e) {
-			logger.fdebug("invoke-virtual/range: method {}->{}{} not found, trying superclass", instance->getFullname(), methodname, signature);
-			if (instance->hasSuperClass()) {
-				// If the method is not found in the current class, try the superclass
-				instance = &classloader.getOrLoad(instance->getSuperClassname());
-				if (!instance->isStaticInitialized()) {
-					executeClinit(*instance);
-				}
-			} else {
-				// If no superclass, break the loop
-				break;
-			}
-		}
+	auto* vmethod = findVirtualTarget(instance, methodRef);
+	if (vmethod == nullptr) [[unlikely]] {
+		const auto& [classname, methodname, signature] = _rt.getClassLoader().findMethod(frame.getDexIdx(), methodRef);
+		throw VmException("invoke-virtual/range: call method {}->{}{} not found", instance.getFullname(), methodname, signature);
 	}
-	if (vmethod) {
-		if (vmethod->isStatic()) {
-			throw VmException("invoke-virtual/range: method {}->{}{} is static", this_ptr->getClass().getFullname(), methodname, signature);
-		}
-		if (!vmethod->isVirtual()) {
-			logger.ferror("invoke-virtual/range: method {}->{}{} is not virtual", this_ptr->getClass().getFullname(), methodname, signature);
-		}
-		trace.logCall("invoke-virtual/range", instance->getFullname(), methodname, signature, args, vmethod->isStatic());
-		if (vmethod->isNative()) {
-			executeNativeMethod(*vmethod, args);
+	auto& cls = vmethod->getClass();
+	if (!cls.isStaticInitialized()) {
+		executeClinit(cls);
+	}
+	logCall("invoke-virtual/range", cls.getFullname(), vmethod->getName(), vmethod->getSignature(), regs, vmethod->isStatic());
+	if (vmethod->isNative()) {
+		executeNativeMethod(*vmethod, regs);
+	} else {
+		if (vmethod->hasBytecode()) {
+			auto& newframe = _rt.newFrame(*vmethod);
+			setInvokeMethodArgs(newframe, frame, regs);
 		} else {
-			if (vmethod->hasBytecode()) {
-				auto& newframe = _rt.newFrame(*vmethod);
-				// When a method is invoked, the parameters to the method are placed into the last n registers.
-				for (size_t i = 0; i < args.size(); ++i) {
-					uint32_t regIdx = vmethod->getNbRegisters() - args.size() + i;
-					newframe.setObjRegister(regIdx, args[i]);
-				}
-			} else {
-				vmethod->execute(frame, args);
-			}
+			auto args = getInvokeMethodArgs(regs);
+			vmethod->execute(frame, args);
 		}
-	} else {
-		// If no method found, throw an error
-		throw VmException(fmt::format("invoke-virtual/range: call method {}->{}{} not found", this_ptr->getClass().getFullname(), methodname, signature));
 	}
 
 	frame.pc() += 5;
@@ -2609,10 +3520,8 @@ void Interpreter::invoke_super_range(const uint8_t* operand_) {
 // invoke-direct/range {vCCCC .. vNNNN}, meth@BBBB
 void Interpreter::invoke_direct_range(const uint8_t* operand_) {
 	const uint16_t methodRef = *reinterpret_cast<const uint16_t*>(&operand_[1]);
-	const uint16_t startReg = *reinterpret_cast<const uint16_t*>(&operand_[3]);
-	const uint8_t regCount = operand_[0];
 
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	auto& classloader = _rt.getClassLoader();
 
 	auto& method = classloader.resolveMethod(frame.getDexIdx(), methodRef);
@@ -2622,26 +3531,21 @@ void Interpreter::invoke_direct_range(const uint8_t* operand_) {
 		executeClinit(cls);
 	}
 
-	std::vector<ObjectRef> args;
-	for (uint8_t i = 0; i < regCount; ++i) {
-		args.push_back(frame.getObjRegister(startReg + i));
-	}
-
+	auto regs = getInvokeMethodRangeRegs(operand_);
 	if (method.isStatic()) {
-		trace.logCall("invoke-static/range", cls.getFullname(), method.getName(), method.getSignature(), args, method.isStatic());
+		logCall("invoke-static/range", cls.getFullname(), method.getName(), method.getSignature(), regs, method.isStatic());
 	} else {
-		trace.logCall("invoke-direct/range", cls.getFullname(), method.getName(), method.getSignature(), args, method.isStatic());
+		logCall("invoke-direct/range", cls.getFullname(), method.getName(), method.getSignature(), regs, method.isStatic());
 	}
 	if (method.isNative()) {
-		executeNativeMethod(method, args);
+		executeNativeMethod(method, regs);
 	} else {
 		if (method.getBytecode() == nullptr) {
+			auto args = getInvokeMethodArgs(regs);
 			method.execute(frame, args);
 		} else {
 			auto& newframe = _rt.newFrame(method);
-			for (uint8_t i = 0; i < regCount; ++i) {
-				newframe.setObjRegister(method.getNbRegisters() - regCount + i, frame.getObjRegister(startReg + i));
-			}
+			setInvokeMethodArgs(newframe, frame, regs);
 		}
 	}
 
@@ -2654,69 +3558,42 @@ void Interpreter::invoke_static_range(const uint8_t* operand_) {
 // invoke-interface/range {vCCCC .. vNNNN}, meth@BBBB
 void Interpreter::invoke_interface_range(const uint8_t* operand_) {
 	const uint16_t methodRef = *reinterpret_cast<const uint16_t*>(&operand_[1]);
-	const uint16_t startReg = *reinterpret_cast<const uint16_t*>(&operand_[3]);
-	const uint8_t regCount = operand_[0];
-
-	auto& frame = _rt.currentFrame();
-	auto& classloader = _rt.getClassLoader();
-
-	std::vector<ObjectRef> args;
-	for (uint8_t i = 0; i < regCount; ++i) {
-		args.push_back(frame.getObjRegister(startReg + i));
-	}
+	auto& frame = *_frame;
 
-	auto this_ptr = args[0];
+	auto regs = getInvokeMethodRangeRegs(operand_);
+	auto this_ptr = frame.getObjRegister(regs[0]);
 	if (this_ptr->isNull()) {
-		throw NullPointerException("invoke-virtual/range on null object");
+		raise(Vm::Throwable::NULL_POINTER, "invoke-interface/range on null object");
+		return;
 	}
 	if (!this_ptr->isClass()) {
-		throw VmException("invoke-virtual/range: this pointer is not an ObjectClass, got {}", this_ptr->toString());
+		throw VmException("invoke-interface/range: this pointer is not an ObjectClass, got {}", this_ptr->toString());
 	}
-	Class* instance = &this_ptr->getClass();
-	if (!instance->isStaticInitialized()) {
-		executeClinit(*instance);
+	auto& instance = this_ptr->getClass();
+	if (!instance.isStaticInitialized()) {
+		executeClinit(instance);
 	}
 
-	std::string ifclassname, methodname, signature;
-	classloader.findMethod(frame.getDexIdx(), methodRef, ifclassname, methodname, signature);
-
-	Method* vmethod = nullptr;
-	Class* current = instance;
-	while (current) {
-		try {
-			vmethod = &current->getMethod(methodname, signature);
-			break;  // Method found, exit loop
-		} catch (...) {
-			// not found in this class
-			if (current->hasSuperClass()) {
-				current = &classloader.getOrLoad(current->getSuperClassname());
-				if (!current->isStaticInitialized()) {
-					executeClinit(*current);
-				}
-			} else {
-				current = nullptr;
-			}
-		}
+	auto* vmethod = findVirtualTarget(instance, methodRef);
+	if (vmethod == nullptr) [[unlikely]] {
+		const auto& [classname, methodname, signature] = _rt.getClassLoader().findMethod(frame.getDexIdx(), methodRef);
+		throw VmException("invoke-interface/range: call method {}->{}{} not found", instance.getFullname(), methodname, signature);
 	}
-	if (vmethod) {
-		if (!vmethod->isVirtual()) {
-			logger.ferror("invoke-interface/range: {}->{}{} not virtual", ifclassname, methodname, signature);
-		}
-		trace.logCall("invoke-interface/range", ifclassname, methodname, signature, args, vmethod->isStatic());
-		if (vmethod->isNative()) {
-			executeNativeMethod(*vmethod, args);
-		} else {
+	auto& cls = vmethod->getClass();
+	if (!cls.isStaticInitialized()) {
+		executeClinit(cls);
+	}
+	logCall("invoke-interface/range", cls.getFullname(), vmethod->getName(), vmethod->getSignature(), regs, vmethod->isStatic());
+	if (vmethod->isNative()) {
+		executeNativeMethod(*vmethod, regs);
+	} else {
+		if (vmethod->hasBytecode()) {
 			auto& newframe = _rt.newFrame(*vmethod);
-			// When a method is invoked, the parameters to the method are placed into the last n registers.
-			for (size_t i = 0; i < args.size(); ++i) {
-				uint32_t regIdx = vmethod->getNbRegisters() - args.size() + i;
-				newframe.setObjRegister(regIdx, args[i]);
-			}
+			setInvokeMethodArgs(newframe, frame, regs);
+		} else {
+			auto args = getInvokeMethodArgs(regs);
+			vmethod->execute(frame, args);
 		}
-	} else {
-		// If no method found, throw an error
-		throw VmException("invoke-interface/range: call method {}->{}{} not found for instance {}", ifclassname, methodname, signature,
-		                  instance->getFullname());
 	}
 
 	frame.pc() += 5;
@@ -2725,7 +3602,7 @@ void Interpreter::invoke_interface_range(const uint8_t* operand_) {
 void Interpreter::neg_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t value = frame.getIntRegister(src);
 	frame.setIntRegister(dest, -value);
 	frame.pc()++;
@@ -2734,7 +3611,7 @@ void Interpreter::neg_int(const uint8_t* operand_) {
 void Interpreter::not_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	uint32_t value = frame.getIntRegister(src);
 	frame.setIntRegister(dest, ~value);
 	frame.pc()++;
@@ -2743,7 +3620,7 @@ void Interpreter::not_int(const uint8_t* operand_) {
 void Interpreter::neg_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t value = frame.getLongRegister(src);
 	frame.setLongRegister(dest, -value);
 	frame.pc()++;
@@ -2752,7 +3629,7 @@ void Interpreter::neg_long(const uint8_t* operand_) {
 void Interpreter::not_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	uint64_t value = frame.getLongRegister(src);
 	frame.setLongRegister(dest, ~value);
 	frame.pc()++;
@@ -2761,7 +3638,7 @@ void Interpreter::not_long(const uint8_t* operand_) {
 void Interpreter::neg_float(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float value = frame.getFloatRegister(src);
 	frame.setFloatRegister(dest, -value);
 	frame.pc()++;
@@ -2770,7 +3647,7 @@ void Interpreter::neg_float(const uint8_t* operand_) {
 void Interpreter::neg_double(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double value = frame.getDoubleRegister(src);
 	frame.setDoubleRegister(dest, -value);
 	frame.pc()++;
@@ -2779,7 +3656,7 @@ void Interpreter::neg_double(const uint8_t* operand_) {
 void Interpreter::int_to_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t value = frame.getIntRegister(src);
 	frame.setLongRegister(dest, static_cast<int64_t>(value));
 	frame.pc()++;
@@ -2788,7 +3665,7 @@ void Interpreter::int_to_long(const uint8_t* operand_) {
 void Interpreter::int_to_float(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t value = frame.getIntRegister(src);
 	frame.setFloatRegister(dest, static_cast<float>(value));
 	frame.pc()++;
@@ -2797,7 +3674,7 @@ void Interpreter::int_to_float(const uint8_t* operand_) {
 void Interpreter::int_to_double(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t value = frame.getIntRegister(src);
 	frame.setDoubleRegister(dest, static_cast<double>(value));
 	frame.pc()++;
@@ -2806,7 +3683,7 @@ void Interpreter::int_to_double(const uint8_t* operand_) {
 void Interpreter::long_to_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t value = frame.getLongRegister(src);
 	frame.setIntRegister(dest, static_cast<int32_t>(value));
 	frame.pc()++;
@@ -2815,7 +3692,7 @@ void Interpreter::long_to_int(const uint8_t* operand_) {
 void Interpreter::long_to_float(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t value = frame.getLongRegister(src);
 	frame.setFloatRegister(dest, static_cast<float>(value));
 	frame.pc()++;
@@ -2824,7 +3701,7 @@ void Interpreter::long_to_float(const uint8_t* operand_) {
 void Interpreter::long_to_double(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t value = frame.getLongRegister(src);
 	frame.setDoubleRegister(dest, static_cast<double>(value));
 	frame.pc()++;
@@ -2833,7 +3710,7 @@ void Interpreter::long_to_double(const uint8_t* operand_) {
 void Interpreter::float_to_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float value = frame.getFloatRegister(src);
 	frame.setIntRegister(dest, static_cast<int32_t>(value));
 	frame.pc()++;
@@ -2842,7 +3719,7 @@ void Interpreter::float_to_int(const uint8_t* operand_) {
 void Interpreter::float_to_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float value = frame.getFloatRegister(src);
 	frame.setLongRegister(dest, static_cast<int64_t>(value));
 	frame.pc()++;
@@ -2851,7 +3728,7 @@ void Interpreter::float_to_long(const uint8_t* operand_) {
 void Interpreter::float_to_double(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float value = frame.getFloatRegister(src);
 	frame.setDoubleRegister(dest, static_cast<double>(value));
 	frame.pc()++;
@@ -2860,7 +3737,7 @@ void Interpreter::float_to_double(const uint8_t* operand_) {
 void Interpreter::double_to_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double value = frame.getDoubleRegister(src);
 	frame.setIntRegister(dest, static_cast<int32_t>(value));
 	frame.pc()++;
@@ -2869,7 +3746,7 @@ void Interpreter::double_to_int(const uint8_t* operand_) {
 void Interpreter::double_to_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double value = frame.getDoubleRegister(src);
 	frame.setLongRegister(dest, static_cast<int64_t>(value));
 	frame.pc()++;
@@ -2878,7 +3755,7 @@ void Interpreter::double_to_long(const uint8_t* operand_) {
 void Interpreter::double_to_float(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double value = frame.getDoubleRegister(src);
 	frame.setFloatRegister(dest, static_cast<float>(value));
 	frame.pc()++;
@@ -2887,7 +3764,7 @@ void Interpreter::double_to_float(const uint8_t* operand_) {
 void Interpreter::int_to_byte(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t value = frame.getIntRegister(src);
 	frame.setIntRegister(dest, static_cast<int8_t>(value));
 	frame.pc()++;
@@ -2896,7 +3773,7 @@ void Interpreter::int_to_byte(const uint8_t* operand_) {
 void Interpreter::int_to_char(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t value = frame.getIntRegister(src);
 	frame.setIntRegister(dest, static_cast<uint16_t>(value));
 	frame.pc()++;
@@ -2905,7 +3782,7 @@ void Interpreter::int_to_char(const uint8_t* operand_) {
 void Interpreter::int_to_short(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t value = frame.getIntRegister(src);
 	frame.setIntRegister(dest, static_cast<int16_t>(value));
 	frame.pc()++;
@@ -2915,7 +3792,7 @@ void Interpreter::add_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src1) + frame.getIntRegister(src2);
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -2925,7 +3802,7 @@ void Interpreter::sub_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src1) - frame.getIntRegister(src2);
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -2935,7 +3812,7 @@ void Interpreter::mul_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src1) * frame.getIntRegister(src2);
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -2945,10 +3822,11 @@ void Interpreter::div_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t divisor = frame.getIntRegister(src2);
 	if (divisor == 0) {
-		throw ArithmeticException("Division by zero in div-int");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in div-int");
+		return;
 	}
 	int32_t result = frame.getIntRegister(src1) / divisor;
 	frame.setIntRegister(dest, result);
@@ -2959,10 +3837,11 @@ void Interpreter::rem_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t divisor = frame.getIntRegister(src2);
 	if (divisor == 0) {
-		throw ArithmeticException("Division by zero in rem-int");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in rem-int");
+		return;
 	}
 	int32_t result = frame.getIntRegister(src1) % divisor;
 	frame.setIntRegister(dest, result);
@@ -2973,7 +3852,7 @@ void Interpreter::and_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src1) & frame.getIntRegister(src2);
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -2983,7 +3862,7 @@ void Interpreter::or_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src1) | frame.getIntRegister(src2);
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -2993,7 +3872,7 @@ void Interpreter::xor_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src1) ^ frame.getIntRegister(src2);
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3003,7 +3882,7 @@ void Interpreter::shl_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src1) << frame.getIntRegister(src2);
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3013,7 +3892,7 @@ void Interpreter::shr_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src1) >> frame.getIntRegister(src2);
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3023,7 +3902,7 @@ void Interpreter::ushr_int(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	uint32_t value = static_cast<uint32_t>(frame.getIntRegister(src1));
 	uint32_t result = value >> frame.getIntRegister(src2);
 	frame.setIntRegister(dest, result);
@@ -3034,7 +3913,7 @@ void Interpreter::add_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(src1) + frame.getLongRegister(src2);
 	frame.setLongRegister(dest, result);
 	frame.pc() += 3;
@@ -3044,7 +3923,7 @@ void Interpreter::sub_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(src1) - frame.getLongRegister(src2);
 	frame.setLongRegister(dest, result);
 	frame.pc() += 3;
@@ -3054,7 +3933,7 @@ void Interpreter::mul_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(src1) * frame.getLongRegister(src2);
 	frame.setLongRegister(dest, result);
 	frame.pc() += 3;
@@ -3064,10 +3943,11 @@ void Interpreter::div_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t divisor = frame.getLongRegister(src2);
 	if (divisor == 0) {
-		throw ArithmeticException("Division by zero in div-long");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in div-long");
+		return;
 	}
 	int64_t result = frame.getLongRegister(src1) / divisor;
 	frame.setLongRegister(dest, result);
@@ -3078,10 +3958,11 @@ void Interpreter::rem_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t divisor = frame.getLongRegister(src2);
 	if (divisor == 0) {
-		throw ArithmeticException("Division by zero in rem-long");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in rem-long");
+		return;
 	}
 	int64_t result = frame.getLongRegister(src1) % divisor;
 	frame.setLongRegister(dest, result);
@@ -3092,7 +3973,7 @@ void Interpreter::and_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(src1) & frame.getLongRegister(src2);
 	frame.setLongRegister(dest, result);
 	frame.pc() += 3;
@@ -3102,7 +3983,7 @@ void Interpreter::or_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(src1) | frame.getLongRegister(src2);
 	frame.setLongRegister(dest, result);
 	frame.pc() += 3;
@@ -3112,7 +3993,7 @@ void Interpreter::xor_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(src1) ^ frame.getLongRegister(src2);
 	frame.setLongRegister(dest, result);
 	frame.pc() += 3;
@@ -3122,7 +4003,7 @@ void Interpreter::shl_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(src1) << frame.getIntRegister(src2);
 	frame.setLongRegister(dest, result);
 	frame.pc() += 3;
@@ -3132,7 +4013,7 @@ void Interpreter::shr_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(src1) >> frame.getIntRegister(src2);
 	frame.setLongRegister(dest, result);
 	frame.pc() += 3;
@@ -3142,7 +4023,7 @@ void Interpreter::ushr_long(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	uint64_t value = static_cast<uint64_t>(frame.getLongRegister(src1));
 	uint64_t result = value >> frame.getIntRegister(src2);
 	frame.setLongRegister(dest, result);
@@ -3153,7 +4034,7 @@ void Interpreter::add_float(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float result = frame.getFloatRegister(src1) + frame.getFloatRegister(src2);
 	frame.setFloatRegister(dest, result);
 	frame.pc() += 3;
@@ -3163,7 +4044,7 @@ void Interpreter::sub_float(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float result = frame.getFloatRegister(src1) - frame.getFloatRegister(src2);
 	frame.setFloatRegister(dest, result);
 	frame.pc() += 3;
@@ -3173,7 +4054,7 @@ void Interpreter::mul_float(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float result = frame.getFloatRegister(src1) * frame.getFloatRegister(src2);
 	frame.setFloatRegister(dest, result);
 	frame.pc() += 3;
@@ -3183,10 +4064,11 @@ void Interpreter::div_float(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float divisor = frame.getFloatRegister(src2);
 	if (divisor == 0.0f) {
-		throw ArithmeticException("Division by zero in div-float");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in div-float");
+		return;
 	}
 	float result = frame.getFloatRegister(src1) / divisor;
 	frame.setFloatRegister(dest, result);
@@ -3197,10 +4079,11 @@ void Interpreter::rem_float(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float divisor = frame.getFloatRegister(src2);
 	if (divisor == 0.0f) {
-		throw ArithmeticException("Division by zero in rem-float");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in rem-float");
+		return;
 	}
 	float result = std::fmod(frame.getFloatRegister(src1), divisor);
 	frame.setFloatRegister(dest, result);
@@ -3211,7 +4094,7 @@ void Interpreter::add_double(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double result = frame.getDoubleRegister(src1) + frame.getDoubleRegister(src2);
 	frame.setDoubleRegister(dest, result);
 	frame.pc() += 3;
@@ -3221,7 +4104,7 @@ void Interpreter::sub_double(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double result = frame.getDoubleRegister(src1) - frame.getDoubleRegister(src2);
 	frame.setDoubleRegister(dest, result);
 	frame.pc() += 3;
@@ -3231,7 +4114,7 @@ void Interpreter::mul_double(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double result = frame.getDoubleRegister(src1) * frame.getDoubleRegister(src2);
 	frame.setDoubleRegister(dest, result);
 	frame.pc() += 3;
@@ -3241,10 +4124,11 @@ void Interpreter::div_double(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double divisor = frame.getDoubleRegister(src2);
 	if (divisor == 0.0) {
-		throw ArithmeticException("Division by zero in div-double");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in div-double");
+		return;
 	}
 	double result = frame.getDoubleRegister(src1) / divisor;
 	frame.setDoubleRegister(dest, result);
@@ -3255,10 +4139,11 @@ void Interpreter::rem_double(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src1 = operand_[1];
 	uint8_t src2 = operand_[2];
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double divisor = frame.getDoubleRegister(src2);
 	if (divisor == 0.0) {
-		throw ArithmeticException("Division by zero in rem-double");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in rem-double");
+		return;
 	}
 	double result = std::fmod(frame.getDoubleRegister(src1), divisor);
 	frame.setDoubleRegister(dest, result);
@@ -3268,7 +4153,7 @@ void Interpreter::rem_double(const uint8_t* operand_) {
 void Interpreter::add_int_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(dest) + frame.getIntRegister(src);
 	frame.setIntRegister(dest, result);
 	frame.pc()++;
@@ -3277,7 +4162,7 @@ void Interpreter::add_int_2addr(const uint8_t* operand_) {
 void Interpreter::sub_int_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(dest) - frame.getIntRegister(src);
 	frame.setIntRegister(dest, result);
 	frame.pc()++;
@@ -3286,7 +4171,7 @@ void Interpreter::sub_int_2addr(const uint8_t* operand_) {
 void Interpreter::mul_int_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(dest) * frame.getIntRegister(src);
 	frame.setIntRegister(dest, result);
 	frame.pc()++;
@@ -3295,10 +4180,11 @@ void Interpreter::mul_int_2addr(const uint8_t* operand_) {
 void Interpreter::div_int_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t divisor = frame.getIntRegister(src);
 	if (divisor == 0) {
-		throw ArithmeticException("Division by zero in div-int/2addr");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in div-int/2addr");
+		return;
 	}
 	int32_t result = frame.getIntRegister(dest) / divisor;
 	frame.setIntRegister(dest, result);
@@ -3308,10 +4194,11 @@ void Interpreter::div_int_2addr(const uint8_t* operand_) {
 void Interpreter::rem_int_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t divisor = frame.getIntRegister(src);
 	if (divisor == 0) {
-		throw ArithmeticException("Division by zero in rem-int/2addr");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in rem-int/2addr");
+		return;
 	}
 	int32_t result = frame.getIntRegister(dest) % divisor;
 	frame.setIntRegister(dest, result);
@@ -3321,7 +4208,7 @@ void Interpreter::rem_int_2addr(const uint8_t* operand_) {
 void Interpreter::and_int_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(dest) & frame.getIntRegister(src);
 	frame.setIntRegister(dest, result);
 	frame.pc()++;
@@ -3330,7 +4217,7 @@ void Interpreter::and_int_2addr(const uint8_t* operand_) {
 void Interpreter::or_int_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(dest) | frame.getIntRegister(src);
 	frame.setIntRegister(dest, result);
 	frame.pc()++;
@@ -3339,7 +4226,7 @@ void Interpreter::or_int_2addr(const uint8_t* operand_) {
 void Interpreter::xor_int_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(dest) ^ frame.getIntRegister(src);
 	frame.setIntRegister(dest, result);
 	frame.pc()++;
@@ -3348,7 +4235,7 @@ void Interpreter::xor_int_2addr(const uint8_t* operand_) {
 void Interpreter::shl_int_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(dest) << frame.getIntRegister(src);
 	frame.setIntRegister(dest, result);
 	frame.pc()++;
@@ -3357,7 +4244,7 @@ void Interpreter::shl_int_2addr(const uint8_t* operand_) {
 void Interpreter::shr_int_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(dest) >> frame.getIntRegister(src);
 	frame.setIntRegister(dest, result);
 	frame.pc()++;
@@ -3366,7 +4253,7 @@ void Interpreter::shr_int_2addr(const uint8_t* operand_) {
 void Interpreter::ushr_int_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	uint32_t value = static_cast<uint32_t>(frame.getIntRegister(dest));
 	uint32_t result = value >> frame.getIntRegister(src);
 	frame.setIntRegister(dest, result);
@@ -3376,7 +4263,7 @@ void Interpreter::ushr_int_2addr(const uint8_t* operand_) {
 void Interpreter::add_long_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(dest) + frame.getLongRegister(src);
 	frame.setLongRegister(dest, result);
 	frame.pc()++;
@@ -3385,7 +4272,7 @@ void Interpreter::add_long_2addr(const uint8_t* operand_) {
 void Interpreter::sub_long_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(dest) - frame.getLongRegister(src);
 	frame.setLongRegister(dest, result);
 	frame.pc()++;
@@ -3394,7 +4281,7 @@ void Interpreter::sub_long_2addr(const uint8_t* operand_) {
 void Interpreter::mul_long_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(dest) * frame.getLongRegister(src);
 	frame.setLongRegister(dest, result);
 	frame.pc()++;
@@ -3403,10 +4290,11 @@ void Interpreter::mul_long_2addr(const uint8_t* operand_) {
 void Interpreter::div_long_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t divisor = frame.getLongRegister(src);
 	if (divisor == 0) {
-		throw ArithmeticException("Division by zero in div-long/2addr");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in div-long/2addr");
+		return;
 	}
 	int64_t result = frame.getLongRegister(dest) / divisor;
 	frame.setLongRegister(dest, result);
@@ -3416,10 +4304,11 @@ void Interpreter::div_long_2addr(const uint8_t* operand_) {
 void Interpreter::rem_long_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t divisor = frame.getLongRegister(src);
 	if (divisor == 0) {
-		throw ArithmeticException("Division by zero in rem-long/2addr");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in rem-long/2addr");
+		return;
 	}
 	int64_t result = frame.getLongRegister(dest) % divisor;
 	frame.setLongRegister(dest, result);
@@ -3429,7 +4318,7 @@ void Interpreter::rem_long_2addr(const uint8_t* operand_) {
 void Interpreter::and_long_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(dest) & frame.getLongRegister(src);
 	frame.setLongRegister(dest, result);
 	frame.pc()++;
@@ -3438,7 +4327,7 @@ void Interpreter::and_long_2addr(const uint8_t* operand_) {
 void Interpreter::or_long_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(dest) | frame.getLongRegister(src);
 	frame.setLongRegister(dest, result);
 	frame.pc()++;
@@ -3447,7 +4336,7 @@ void Interpreter::or_long_2addr(const uint8_t* operand_) {
 void Interpreter::xor_long_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(dest) ^ frame.getLongRegister(src);
 	frame.setLongRegister(dest, result);
 	frame.pc()++;
@@ -3456,7 +4345,7 @@ void Interpreter::xor_long_2addr(const uint8_t* operand_) {
 void Interpreter::shl_long_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(dest) << frame.getIntRegister(src);
 	frame.setLongRegister(dest, result);
 	frame.pc()++;
@@ -3465,7 +4354,7 @@ void Interpreter::shl_long_2addr(const uint8_t* operand_) {
 void Interpreter::shr_long_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int64_t result = frame.getLongRegister(dest) >> frame.getIntRegister(src);
 	frame.setLongRegister(dest, result);
 	frame.pc()++;
@@ -3474,7 +4363,7 @@ void Interpreter::shr_long_2addr(const uint8_t* operand_) {
 void Interpreter::ushr_long_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	uint64_t value = static_cast<uint64_t>(frame.getLongRegister(dest));
 	uint64_t result = value >> frame.getIntRegister(src);
 	frame.setLongRegister(dest, result);
@@ -3484,7 +4373,7 @@ void Interpreter::ushr_long_2addr(const uint8_t* operand_) {
 void Interpreter::add_float_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float result = frame.getFloatRegister(dest) + frame.getFloatRegister(src);
 	frame.setFloatRegister(dest, result);
 	frame.pc()++;
@@ -3493,7 +4382,7 @@ void Interpreter::add_float_2addr(const uint8_t* operand_) {
 void Interpreter::sub_float_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float result = frame.getFloatRegister(dest) - frame.getFloatRegister(src);
 	frame.setFloatRegister(dest, result);
 	frame.pc()++;
@@ -3502,7 +4391,7 @@ void Interpreter::sub_float_2addr(const uint8_t* operand_) {
 void Interpreter::mul_float_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float result = frame.getFloatRegister(dest) * frame.getFloatRegister(src);
 	frame.setFloatRegister(dest, result);
 	frame.pc()++;
@@ -3511,10 +4400,11 @@ void Interpreter::mul_float_2addr(const uint8_t* operand_) {
 void Interpreter::div_float_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float divisor = frame.getFloatRegister(src);
 	if (divisor == 0.0f) {
-		throw ArithmeticException("Division by zero in div-float/2addr");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in div-float/2addr");
+		return;
 	}
 	float result = frame.getFloatRegister(dest) / divisor;
 	frame.setFloatRegister(dest, result);
@@ -3524,10 +4414,11 @@ void Interpreter::div_float_2addr(const uint8_t* operand_) {
 void Interpreter::rem_float_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	float divisor = frame.getFloatRegister(src);
 	if (divisor == 0.0f) {
-		throw ArithmeticException("Division by zero in rem-float/2addr");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in rem-float/2addr");
+		return;
 	}
 	float result = std::fmod(frame.getFloatRegister(dest), divisor);
 	frame.setFloatRegister(dest, result);
@@ -3537,7 +4428,7 @@ void Interpreter::rem_float_2addr(const uint8_t* operand_) {
 void Interpreter::add_double_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double result = frame.getDoubleRegister(dest) + frame.getDoubleRegister(src);
 	frame.setDoubleRegister(dest, result);
 	frame.pc()++;
@@ -3546,7 +4437,7 @@ void Interpreter::add_double_2addr(const uint8_t* operand_) {
 void Interpreter::sub_double_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double result = frame.getDoubleRegister(dest) - frame.getDoubleRegister(src);
 	frame.setDoubleRegister(dest, result);
 	frame.pc()++;
@@ -3555,7 +4446,7 @@ void Interpreter::sub_double_2addr(const uint8_t* operand_) {
 void Interpreter::mul_double_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double result = frame.getDoubleRegister(dest) * frame.getDoubleRegister(src);
 	frame.setDoubleRegister(dest, result);
 	frame.pc()++;
@@ -3564,10 +4455,11 @@ void Interpreter::mul_double_2addr(const uint8_t* operand_) {
 void Interpreter::div_double_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double divisor = frame.getDoubleRegister(src);
 	if (divisor == 0.0) {
-		throw ArithmeticException("Division by zero in div-double/2addr");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in div-double/2addr");
+		return;
 	}
 	double result = frame.getDoubleRegister(dest) / divisor;
 	frame.setDoubleRegister(dest, result);
@@ -3577,10 +4469,11 @@ void Interpreter::div_double_2addr(const uint8_t* operand_) {
 void Interpreter::rem_double_2addr(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	double divisor = frame.getDoubleRegister(src);
 	if (divisor == 0.0) {
-		throw ArithmeticException("Division by zero in rem-double/2addr");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in rem-double/2addr");
+		return;
 	}
 	double result = std::fmod(frame.getDoubleRegister(dest), divisor);
 	frame.setDoubleRegister(dest, result);
@@ -3591,7 +4484,7 @@ void Interpreter::add_int_lit16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
 	int16_t literal = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src) + literal;
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3601,7 +4494,7 @@ void Interpreter::rsub_int_lit16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
 	int16_t literal = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = literal - frame.getIntRegister(src);
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3611,7 +4504,7 @@ void Interpreter::mul_int_lit16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
 	int16_t literal = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src) * literal;
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3621,9 +4514,10 @@ void Interpreter::div_int_lit16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
 	int16_t literal = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	if (literal == 0) {
-		throw ArithmeticException("Division by zero in div-int/lit16");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in div-int/lit16");
+		return;
 	}
 	int32_t result = frame.getIntRegister(src) / literal;
 	frame.setIntRegister(dest, result);
@@ -3634,9 +4528,10 @@ void Interpreter::rem_int_lit16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
 	int16_t literal = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	if (literal == 0) {
-		throw ArithmeticException("Division by zero in rem-int/lit16");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in rem-int/lit16");
+		return;
 	}
 	int32_t result = frame.getIntRegister(src) % literal;
 	frame.setIntRegister(dest, result);
@@ -3647,7 +4542,7 @@ void Interpreter::and_int_lit16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
 	int16_t literal = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src) & literal;
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3657,7 +4552,7 @@ void Interpreter::or_int_lit16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
 	int16_t literal = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src) | literal;
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3667,7 +4562,7 @@ void Interpreter::xor_int_lit16(const uint8_t* operand_) {
 	uint8_t dest = operand_[0] & 0x0F;
 	uint8_t src = (operand_[0] >> 4) & 0x0F;
 	int16_t literal = *reinterpret_cast<const int16_t*>(&operand_[1]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src) ^ literal;
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3677,7 +4572,7 @@ void Interpreter::add_int_lit8(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src = operand_[1];
 	int8_t literal = static_cast<int8_t>(operand_[2]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src) + literal;
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3687,7 +4582,7 @@ void Interpreter::rsub_int_lit8(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src = operand_[1];
 	int8_t literal = static_cast<int8_t>(operand_[2]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = literal - frame.getIntRegister(src);
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3697,7 +4592,7 @@ void Interpreter::mul_int_lit8(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src = operand_[1];
 	int8_t literal = static_cast<int8_t>(operand_[2]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src) * literal;
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3707,9 +4602,10 @@ void Interpreter::div_int_lit8(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src = operand_[1];
 	int8_t literal = static_cast<int8_t>(operand_[2]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	if (literal == 0) {
-		throw ArithmeticException("Division by zero in div-int/lit8");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in div-int/lit8");
+		return;
 	}
 	int32_t result = frame.getIntRegister(src) / literal;
 	frame.setIntRegister(dest, result);
@@ -3720,9 +4616,10 @@ void Interpreter::rem_int_lit8(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src = operand_[1];
 	int8_t literal = static_cast<int8_t>(operand_[2]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	if (literal == 0) {
-		throw ArithmeticException("Division by zero in rem-int/lit8");
+		raise(Vm::Throwable::ARITHMETIC, "Division by zero in rem-int/lit8");
+		return;
 	}
 	int32_t result = frame.getIntRegister(src) % literal;
 	frame.setIntRegister(dest, result);
@@ -3733,7 +4630,7 @@ void Interpreter::and_int_lit8(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src = operand_[1];
 	int8_t literal = static_cast<int8_t>(operand_[2]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src) & literal;
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3743,7 +4640,7 @@ void Interpreter::or_int_lit8(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src = operand_[1];
 	int8_t literal = static_cast<int8_t>(operand_[2]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src) | literal;
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3753,7 +4650,7 @@ void Interpreter::xor_int_lit8(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src = operand_[1];
 	int8_t literal = static_cast<int8_t>(operand_[2]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src) ^ literal;
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3763,7 +4660,7 @@ void Interpreter::shl_int_lit8(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src = operand_[1];
 	int8_t literal = static_cast<int8_t>(operand_[2]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src) << literal;
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3773,7 +4670,7 @@ void Interpreter::shr_int_lit8(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src = operand_[1];
 	int8_t literal = static_cast<int8_t>(operand_[2]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	int32_t result = frame.getIntRegister(src) >> literal;
 	frame.setIntRegister(dest, result);
 	frame.pc() += 3;
@@ -3783,7 +4680,7 @@ void Interpreter::ushr_int_lit8(const uint8_t* operand_) {
 	uint8_t dest = operand_[0];
 	uint8_t src = operand_[1];
 	int8_t literal = static_cast<int8_t>(operand_[2]);
-	auto& frame = _rt.currentFrame();
+	auto& frame = *_frame;
 	uint32_t value = static_cast<uint32_t>(frame.getIntRegister(src));
 	uint32_t result = value >> literal;
 	frame.setIntRegister(dest, result);
@@ -28,11 +28,15 @@
 #include <vector>
 
 #include "object.hpp"
+#include "vm.hpp"
 
 namespace sandvik {
 	class Method;
 	class Class;
+	class Frame;
 	class JThread;
+	class JavaException;
+	struct NativeBinding;
 	/** @brief Interpreter class
 	 */
 	class Interpreter {
@@ -43,8 +47,34 @@ namespace sandvik {
 			explicit Interpreter(JThread& rt_);
 			~Interpreter();
 
-			/** @brief executes current thread opcode. */
+			/** @brief executes current thread opcodes.
+			 *
+			 * The default dispatch runs the current frame until a safepoint (invoke, return,
+			 * exception or suspend/stop request). With __legacy_dispatch__ a single opcode is
+			 * executed per call.
+			 */
 			void execute();
+			/** @brief calls a method from native code (JNI Call<Type>Method) on the current thread.
+			 *
+			 * The frame of the method, pushed by the caller with its arguments set, is run until it returns,
+			 * nested in the frames of the calling native method. The class of the method is initialized first.
+			 * The return value is stored in the return slot of the thread, the frame below it is left untouched.
+			 * @throws JavaException if the method does not catch an exception
+			 */
+			void executeCallback();
+			/** @brief gets the exception pending on the thread.
+			 * Set by an opcode handler, or by native code through JNI until the native method returns.
+			 * @return pending exception, nullptr if there is none
+			 */
+			inline ObjectRef getPendingException() const {
+				return _pendingException;
+			}
+			/** @brief sets the exception pending on the thread, it is thrown once the running opcode returns.
+			 * @param exception_ throwable object, nullptr clears the pending exception
+			 */
+			inline void setPendingException(ObjectRef exception_) {
+				_pendingException = exception_;
+			}
 
 		private:
 			/** Opcode method declarations */
@@ -485,15 +515,100 @@ namespace sandvik {
 			// ushr-int/lit8 vAA, vBB, #+CC
 			void ushr_int_lit8(const uint8_t* operand_);
 
+#ifdef __legacy_dispatch__
 			std::vector<std::function<void(const uint8_t* operand_)>> _dispatch;
+#endif
+			/** decode and execute one opcode
+			 * @param bytecode_ opcode address
+			 */
+			void dispatch(const uint8_t* bytecode_);
 
+			/** raise a java exception from an opcode handler: the exception is left pending and the frames are unwound
+			 * by execute() once the handler returns, the handler must return right after
+			 * @param type_ exception raised by the interpreter
+			 * @param message_ detail message
+			 */
+			void raise(Vm::Throwable type_, const std::string& message_);
+			/** raise a java exception of the given class
+			 * @param class_ exception class
+			 * @param message_ detail message
+			 */
+			void raise(Class& class_, const std::string& message_);
+			/** raise a java exception thrown as a C++ exception by a native or a runtime helper
+			 * @param exception_ exception, its throwable object is raised as is when it carries one
+			 */
+			void raise(const JavaException& exception_);
+			/** unwind the frames up to the handler of the exception, through the try ranges of each method */
 			void handleException(ObjectRef exception_);
-			void executeClinit(Class& class_) const;
-			void executeNativeMethod(const Method& method_, const std::vector<ObjectRef>& args_);
+			/** run the static initializers of a class and its super classes on the current thread (JLS 12.4.2)
+			 * @param class_ class to initialize
+			 */
+			void executeClinit(Class& class_);
+			/** run a method on the current thread until it returns, the frames below it are left untouched
+			 * @param method_ method to run
+			 */
+			void executeNested(Method& method_);
+			/** run the frame on top of the stack until it returns, the frames below it are left untouched */
+			void executeNested();
+			/** call a native method with its arguments read from the invoke registers, primitives are passed unboxed
+			 * @param method_ native method
+			 * @param regs_ registers of the invoke instruction, this first for an instance method
+			 */
+			void executeNativeMethod(const Method& method_, const std::vector<uint16_t>& regs_);
+			/** resolve the native function of a method and prepare its call interface, done once per method */
+			const NativeBinding& bindNativeMethod(const Method& method_);
+			/** find the implementation called by invoke-virtual or invoke-interface, through the inline cache of the call site
+			 * @param receiver_ class of the receiver object
+			 * @param methodRef_ method index of the invoke instruction
+			 * @return implementation, nullptr if not found
+			 */
+			Method* findVirtualTarget(Class& receiver_, uint16_t methodRef_) const;
+			/** find the implementation called by invoke-virtual or invoke-interface through the vtable or itable of the receiver
+			 * @param receiver_ class of the receiver object
+			 * @param methodRef_ method index of the invoke instruction
+			 * @return implementation, nullptr if not found
+			 */
+			Method* resolveVirtualTarget(Class& receiver_, uint16_t methodRef_) const;
 
-			std::vector<ObjectRef> getInvokeMethodArgs(const uint8_t* operand_) const;
+			/** get argument registers of an invoke instruction {vC, vD, vE, vF, vG}
+			 * @param operand_ instruction operands
+			 * @return argument registers
+			 */
+			std::vector<uint16_t> getInvokeMethodRegs(const uint8_t* operand_) const;
+			/** get argument registers of an invoke range instruction {vCCCC .. vNNNN}
+			 * @param operand_ instruction operands
+			 * @return argument registers
+			 */
+			std::vector<uint16_t> getInvokeMethodRangeRegs(const uint8_t* operand_) const;
+			/** get boxed arguments for native/builtin methods
+			 * @param regs_ argument registers of the current frame
+			 * @return arguments objects
+			 */
+			std::vector<ObjectRef> getInvokeMethodArgs(const std::vector<uint16_t>& regs_) const;
+			/** copy raw argument registers into the last n registers of the invoked method frame
+			 * @param newframe_ invoked method frame
+			 * @param frame_ caller frame
+			 * @param regs_ argument registers of the caller frame
+			 */
+			void setInvokeMethodArgs(Frame& newframe_, const Frame& frame_, const std::vector<uint16_t>& regs_) const;
+			/** log call trace entry, arguments are boxed only if call trace is enabled
+			 * @param type_ invoke type
+			 * @param class_ class name
+			 * @param method_ method name
+			 * @param signature_ signature
+			 * @param regs_ argument registers of the current frame
+			 * @param static_ method is static
+			 */
+			void logCall(const std::string& type_, const std::string& class_, const std::string& method_, const std::string& signature_,
+			             const std::vector<uint16_t>& regs_, bool static_) const;
 
 			JThread& _rt;
+			/** frame being executed */
+			Frame* _frame = nullptr;
+			/** exception raised by the last executed opcode, handled before the next one */
+			ObjectRef _pendingException = nullptr;
+			/** stack depth of the interrupted frames while a method runs nested, exceptions do not unwind below it */
+			uint64_t _baseDepth = 0;
 			std::map<uint8_t, uint64_t> _instcoverage;
 	};
 }  // namespace sandvik
@@ -22,7 +22,9 @@
 
 #include <fmt/format.h>
 
+#include <bit>
 #include <stdexcept>
+#include <type_traits>
 
 #include "jni/jni.h"
 
@@ -32,6 +34,7 @@
 #include "exceptions.hpp"
 #include "field.hpp"
 #include "frame.hpp"
+#include "gc.hpp"
 #include "interpreter.hpp"
 #include "jthread.hpp"
 #include "method.hpp"
@@ -42,6 +45,293 @@
 
 using namespace sandvik;
 
+namespace {
+	/** Registers an object created for native code in the local reference frame of the calling thread.
+	 * It stays reachable until the native method returns, even if a nested java call reaches a safepoint.
+	 */
+	jobject localRef(ObjectRef obj_) {
+		if (auto *thread = JThread::current()) {
+			thread->addLocalRef(obj_);
+		}
+		return (jobject)obj_;
+	}
+
+	/** Element type of the arrays accessed through the JNI type T */
+	template <typename T>
+	constexpr Array::ElementType elementType() {
+		if constexpr (std::is_same_v<T, jboolean>) {
+			return Array::ElementType::BOOLEAN;
+		} else if constexpr (std::is_same_v<T, jbyte>) {
+			return Array::ElementType::BYTE;
+		} else if constexpr (std::is_same_v<T, jchar>) {
+			return Array::ElementType::CHAR;
+		} else if constexpr (std::is_same_v<T, jshort>) {
+			return Array::ElementType::SHORT;
+		} else if constexpr (std::is_same_v<T, jint>) {
+			return Array::ElementType::INT;
+		} else if constexpr (std::is_same_v<T, jlong>) {
+			return Array::ElementType::LONG;
+		} else if constexpr (std::is_same_v<T, jfloat>) {
+			return Array::ElementType::FLOAT;
+		} else {
+			static_assert(std::is_same_v<T, jdouble>, "not a JNI primitive type");
+			return Array::ElementType::DOUBLE;
+		}
+	}
+
+	/** Checks that a JNI array argument stores elements of type T, a same size is not enough (int and float, byte and boolean...) */
+	template <typename T>
+	Array *primitiveArray(const char *name_, jarray array_) {
+		auto arr = native::getArray(array_);
+		if (arr->getElementType() != elementType<T>() || arr->getDimensions() != 1) {
+			throw ClassCastException(fmt::format("{}: array element type mismatch", name_));
+		}
+		return arr;
+	}
+
+	/** Checks a Get/Set<Type>ArrayRegion request and returns the first element of the region in the typed storage */
+	template <typename T>
+	T *arrayRegion(const char *name_, jarray array_, jsize start_, jsize len_, const void *buf_) {
+		auto arr = primitiveArray<T>(name_, array_);
+		if (start_ < 0 || len_ < 0 || (uint32_t)start_ + (uint32_t)len_ > arr->getArrayLength()) {
+			throw ArrayIndexOutOfBoundsException(fmt::format("{}: invalid start/len", name_));
+		}
+		if (!buf_ && len_ > 0) {
+			throw NullPointerException(fmt::format("{}: buf is null", name_));
+		}
+		return reinterpret_cast<T *>(arr->getRawData()) + start_;
+	}
+
+	template <typename T>
+	void getArrayRegion(const char *name_, jarray array_, jsize start_, jsize len_, T *buf_) {
+		auto data = arrayRegion<T>(name_, array_, start_, len_, buf_);
+		if (len_ > 0) {
+			memcpy(buf_, data, len_ * sizeof(T));
+		}
+	}
+
+	template <typename T>
+	void setArrayRegion(const char *name_, jarray array_, jsize start_, jsize len_, const T *buf_) {
+		auto data = arrayRegion<T>(name_, array_, start_, len_, buf_);
+		if (len_ > 0) {
+			memcpy(data, buf_, len_ * sizeof(T));
+		}
+	}
+
+	/** Pins the array and returns its typed storage, the elements are never copied */
+	template <typename T>
+	T *arrayElements(const char *name_, jarray array_, jboolean *isCopy_) {
+		auto arr = primitiveArray<T>(name_, array_);
+		GC::getInstance().pin(arr);
+		if (isCopy_) {
+			*isCopy_ = JNI_FALSE;
+		}
+		return reinterpret_cast<T *>(arr->getRawData());
+	}
+
+	/** Releases the pin of arrayElements or GetPrimitiveArrayCritical, JNI_COMMIT keeps the array pinned */
+	void releaseArrayElements(jarray array_, jint mode_) {
+		if (mode_ != JNI_COMMIT) {
+			GC::getInstance().unpin(native::getArray(array_));
+		}
+	}
+
+	/** Dispatch of a Call<Type>Method function */
+	enum class CallKind { VIRTUAL, NONVIRTUAL, STATIC };
+
+	/** Reads the next argument of a Call<Type>Method or Call<Type>MethodV call, promoted by the C variadic call */
+	jvalue nextArgument(va_list &args_, char type_) {
+		jvalue value{};
+		switch (type_) {
+			case 'Z':
+				value.z = (jboolean)va_arg(args_, int);
+				break;
+			case 'B':
+				value.b = (jbyte)va_arg(args_, int);
+				break;
+			case 'C':
+				value.c = (jchar)va_arg(args_, int);
+				break;
+			case 'S':
+				value.s = (jshort)va_arg(args_, int);
+				break;
+			case 'I':
+				value.i = va_arg(args_, jint);
+				break;
+			case 'J':
+				value.j = va_arg(args_, jlong);
+				break;
+			case 'F':
+				value.f = (jfloat)va_arg(args_, double);
+				break;
+			case 'D':
+				value.d = va_arg(args_, jdouble);
+				break;
+			default:
+				value.l = va_arg(args_, jobject);
+				break;
+		}
+		return value;
+	}
+
+	/** Makes an exception thrown by the VM pending on the calling thread, native code sees it through ExceptionOccurred */
+	void setPendingException(JNIEnv *env_, const JavaException &exception_) {
+		auto &vm = static_cast<NativeInterface *>(env_)->getVm();
+		auto *throwable = exception_.getThrowable();
+		if (throwable == nullptr) {
+			throwable = Object::make(vm.getThrowableClass(exception_.getExceptionType()));
+			throwable->setField("detailMessage", Object::make(vm.getClassLoader(), exception_.getMessage()));
+		}
+		vm.currentThread().setPendingException(throwable);
+	}
+
+	/** Calls a java method from native code, nested on the calling thread.
+	 * The arguments are read by next_ for each parameter type and copied in the last registers of the frame.
+	 * @return Return value of the method, following its return type.
+	 * @throws JavaException if the method does not catch an exception
+	 */
+	template <typename NextArgument>
+	jvalue runMethod(JNIEnv *env_, const char *name_, CallKind kind_, jobject obj_, jmethodID methodID_, NextArgument &&next_) {
+		if (methodID_ == nullptr) {
+			throw NullPointerException(fmt::format("{}: methodID is null", name_));
+		}
+		auto *method = (Method *)methodID_;
+		Object *self = nullptr;
+		if (kind_ == CallKind::STATIC) {
+			if (!method->isStatic()) {
+				throw NoSuchMethodError(fmt::format("{}: method {} is not static", name_, method->getFullname()));
+			}
+		} else {
+			if (obj_ == nullptr) {
+				throw NullPointerException(fmt::format("{} on null object", name_));
+			}
+			self = native::getObject(obj_);
+			if (kind_ == CallKind::VIRTUAL && method->isVirtual() && method->getVtableIndex() != Method::NO_VTABLE_INDEX) {
+				// implementation of the receiver class, through its vtable or itable
+				auto &receiver = self->getClass();
+				auto &declaring = method->getClass();
+				auto *target = declaring.isInterface() ? receiver.getInterfaceMethod(declaring, method->getVtableIndex())
+				                                       : receiver.getVirtualMethod(method->getVtableIndex());
+				if (target == nullptr) {
+					throw NoSuchMethodError(fmt::format("{}: method {} not implemented by class {}", name_, method->getFullname(), receiver.getFullname()));
+				}
+				method = target;
+			}
+		}
+		if (!method->hasBytecode()) {
+			throw VmException("{}: method {} has no bytecode", name_, method->getFullname());
+		}
+		// this first, long and double arguments take two registers
+		uint32_t ins = self != nullptr ? 1 : 0;
+		for (const auto &arg : method->arguments()) {
+			ins += (arg[0] == 'J' || arg[0] == 'D') ? 2 : 1;
+		}
+		auto &thread = static_cast<NativeInterface *>(env_)->getVm().currentThread();
+		auto &frame = thread.newFrame(*method);
+		auto reg = method->getNbRegisters() - ins;
+		if (self != nullptr) {
+			frame.setObjRegister(reg++, self);
+		}
+		for (const auto &arg : method->arguments()) {
+			auto value = next_(arg[0]);
+			switch (arg[0]) {
+				case 'Z':
+					frame.setIntRegister(reg++, value.z);
+					break;
+				case 'B':
+					frame.setIntRegister(reg++, value.b);
+					break;
+				case 'C':
+					frame.setIntRegister(reg++, value.c);
+					break;
+				case 'S':
+					frame.setIntRegister(reg++, value.s);
+					break;
+				case 'I':
+					frame.setIntRegister(reg++, value.i);
+					break;
+				case 'J':
+					frame.setLongRegister(reg, value.j);
+					reg += 2;
+					break;
+				case 'F':
+					frame.setFloatRegister(reg++, value.f);
+					break;
+				case 'D':
+					frame.setDoubleRegister(reg, value.d);
+					reg += 2;
+					break;
+				default:
+					frame.setObjRegister(reg++, value.l != nullptr ? native::getObject(value.l) : Object::makeNull());
+					break;
+			}
+		}
+		thread.executeCallback();
+
+		// the return value is stored in the return slot of the thread, the frame of the calling native is left untouched
+		jvalue result{};
+		const auto &signature = method->getSignature();
+		switch (signature[signature.find(')') + 1]) {
+			case 'V':
+				break;
+			case 'Z':
+				result.z = (jboolean)thread.getReturnValue();
+				break;
+			case 'B':
+				result.b = (jbyte)thread.getReturnValue();
+				break;
+			case 'C':
+				result.c = (jchar)thread.getReturnValue();
+				break;
+			case 'S':
+				result.s = (jshort)thread.getReturnValue();
+				break;
+			case 'I':
+				result.i = thread.getReturnValue();
+				break;
+			case 'F':
+				result.f = std::bit_cast<jfloat>(thread.getReturnValue());
+				break;
+			case 'J':
+				result.j = thread.getReturnDoubleValue();
+				break;
+			case 'D':
+				result.d = std::bit_cast<jdouble>(thread.getReturnDoubleValue());
+				break;
+			default:
+				result.l = localRef(thread.getReturnObject());
+				break;
+		}
+		return result;
+	}
+
+	/** JNI boundary of the Call<Type>Method functions: a java exception does not unwind the native frames,
+	 * it is left pending on the thread and a zero value is returned.
+	 */
+	template <typename NextArgument>
+	jvalue invokeMethod(JNIEnv *env_, const char *name_, CallKind kind_, jobject obj_, jmethodID methodID_, NextArgument &&next_) {
+		auto &thread = static_cast<NativeInterface *>(env_)->getVm().currentThread();
+		if (thread.getPendingException() != nullptr) {
+			// native code must handle the pending exception before calling java again
+			return jvalue{};
+		}
+		try {
+			return runMethod(env_, name_, kind_, obj_, methodID_, std::forward<NextArgument>(next_));
+		} catch (const JavaException &e) {
+			setPendingException(env_, e);
+		}
+		return jvalue{};
+	}
+
+	jvalue callMethod(JNIEnv *env_, const char *name_, CallKind kind_, jobject obj_, jmethodID methodID_, va_list &args_) {
+		return invokeMethod(env_, name_, kind_, obj_, methodID_, [&args_](char type_) { return nextArgument(args_, type_); });
+	}
+
+	jvalue callMethod(JNIEnv *env_, const char *name_, CallKind kind_, jobject obj_, jmethodID methodID_, const jvalue *args_) {
+		return invokeMethod(env_, name_, kind_, obj_, methodID_, [&args_](char) { return *args_++; });
+	}
+}  // namespace
+
 SandvikVM::SandvikVM(Vm &vm_) : _vm(vm_) {
 	_interface = std::make_unique<JNIInvokeInterface_>();
 	_interface->reserved0 = nullptr;
@@ -366,7 +656,7 @@ jclass NativeInterface::FindClass(JNIEnv *env, const char *name) {
 	NativeInterface *this_ptr = static_cast<NativeInterface *>(env);
 	ClassLoader &classloader = this_ptr->getClassLoader();
 	Class &cls = classloader.getOrLoad(name);
-	return (jclass)Object::make(cls);
+	return (jclass)cls.getClassObject();
 }
 
 jmethodID NativeInterface::FromReflectedMethod(JNIEnv *env, jobject method) {
@@ -389,26 +679,41 @@ jobject NativeInterface::ToReflectedField(JNIEnv *env, jclass cls, jfieldID fiel
 }
 
 jint NativeInterface::Throw(JNIEnv *env, jthrowable obj) {
-	logger.fwarning("JNI Throw: throwing exception not implemented");
-	auto o = native::getObject(obj);
-	logger.fwarning("JNI Throw: throwing exception object {} not implemented", o->toString());
+	if (obj == nullptr) {
+		return JNI_ERR;
+	}
+	static_cast<NativeInterface *>(env)->getVm().currentThread().setPendingException(native::getObject(obj));
 	return JNI_OK;
 }
 
 jint NativeInterface::ThrowNew(JNIEnv *env, jclass clazz, const char *msg) {
-	logger.fwarning("JNI ThrowNew: throwing exception not implemented");
+	if (clazz == nullptr) {
+		return JNI_ERR;
+	}
 	auto clsObj = native::getObject(clazz);
-	logger.fwarning("JNI Throw: throwing exception object {}({}) not implemented", clsObj->toString(), msg ? msg : "null");
+	if (!clsObj->isClass()) {
+		return JNI_ERR;
+	}
+	auto &vm = static_cast<NativeInterface *>(env)->getVm();
+	auto exception = Object::make(clsObj->getClass());
+	if (msg != nullptr) {
+		exception->setField("detailMessage", Object::make(vm.getClassLoader(), msg));
+	}
+	vm.currentThread().setPendingException(exception);
 	return JNI_OK;
 }
 jthrowable NativeInterface::ExceptionOccurred(JNIEnv *env) {
-	throw VmException("ExceptionOccurred not implemented");
+	return (jthrowable)localRef(static_cast<NativeInterface *>(env)->getVm().currentThread().getPendingException());
 }
 void NativeInterface::ExceptionDescribe(JNIEnv *env) {
-	throw VmException("ExceptionDescribe not implemented");
+	auto exception = static_cast<NativeInterface *>(env)->getVm().currentThread().getPendingException();
+	if (exception != nullptr) {
+		auto detailMessage = exception->getField("detailMessage");
+		logger.ferror("Pending exception {}: {}", exception->getClass().getFullname(), detailMessage->isString() ? detailMessage->str() : "");
+	}
 }
 void NativeInterface::ExceptionClear(JNIEnv *env) {
-	logger.fwarning("ExceptionClear not implemented");
+	static_cast<NativeInterface *>(env)->getVm().currentThread().setPendingException(nullptr);
 }
 void NativeInterface::FatalError(JNIEnv *env, const char *msg) {
 	throw VmException("FatalError not implemented");
@@ -489,298 +794,357 @@ jmethodID NativeInterface::GetMethodID(JNIEnv *env, jclass clazz, const char *na
 	try {
 		auto &cls = clsObj->getClass();
 		auto &method = cls.getMethod(name, sig);
-		return (jmethodID)(uintptr_t)method.getIndex();
+		return (jmethodID)&method;
 	} catch (const std::invalid_argument &) {
 		return nullptr;
 	}
 }
 
-JThread &NativeInterface::__CallObjectMethod(JNIEnv *env, jobject obj, jmethodID methodID, va_list &args) {
-	if (obj == nullptr) {
-		throw NullPointerException("CallIntMethod on null object");
-	}
-	auto jenv = static_cast<NativeInterface *>(env);
-	auto &vm = jenv->getVm();
-	auto jobj = native::getObject(obj);
-	// Find the method in the object's class
-	Class &clazz = jobj->getClass();
-	if (!clazz.hasMethod((uint32_t)(uintptr_t)methodID)) {
-		throw NoSuchMethodException(fmt::format("CallIntMethod: methodID {} not found in class {}", (size_t)methodID, clazz.getName()));
-	}
-	Method &method = clazz.getMethod((uint32_t)(uintptr_t)methodID);
-	// Call the method
-	auto &thread = vm.newThread(fmt::format("{}.{}", clazz.getFullname(), method.getName()));
-	auto &frame = thread.newFrame(method);
-	auto sig = method.getSignature();
-
-	// @todo: check that the return type is 'I' (int)
-	auto regidx = method.getNbRegisters() - 1 - method.getNbArguments();
-	frame.setObjRegister(regidx++, jobj);  // this
-	// Set method arguments in the frame registers
-	for (auto arg : method.arguments()) {
-		switch (arg[0]) {
-			case 'Z':  // boolean
-			case 'B':  // byte
-			case 'C':  // char
-			case 'S':  // short
-			case 'I':  // int
-				frame.setObjRegister(regidx++, Object::make((int32_t)va_arg(args, int)));
-				break;
-			case 'J':  // long
-				// frame.setObjRegister(nbRegisters, (int64_t)va_arg(args, int64_t));
-				logger.fwarning("CallIntMethod: long arguments not yet supported");
-				break;
-			case 'F':  // float
-				// frame.setObjRegister(nbRegisters, (float)va_arg(args, float));
-				logger.fwarning("CallIntMethod: float arguments not yet supported");
-				break;
-			case 'D':  // double
-				// frame.setObjRegister(nbRegisters, (double)va_arg(args, double));
-				logger.fwarning("CallIntMethod: double arguments not yet supported");
-				break;
-			case 'L':  // object
-			case '[':  // array
-			{
-				logger.fwarning("CallIntMethod: object/array arguments not yet supported");
-				break;
-			}
-			default:
-				throw VmException(fmt::format("CallIntMethod: unknown argument type '{}'", arg));
-		}
-	}
-	thread.run(true);
-	// Get the return value
-	return thread;
-}
-
 jobject NativeInterface::CallObjectMethod(JNIEnv *env, jobject obj, jmethodID methodID, ...) {
 	va_list args;
 	va_start(args, methodID);
-	const auto &result = __CallObjectMethod(env, obj, methodID, args);
+	auto result = callMethod(env, "CallObjectMethod", CallKind::VIRTUAL, obj, methodID, args);
 	va_end(args);
-	return (jobject)(result.getReturnObject());
+	return result.l;
 }
 jobject NativeInterface::CallObjectMethodV(JNIEnv *env, jobject obj, jmethodID methodID, va_list args) {
-	throw VmException("CallObjectMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallObjectMethodV", CallKind::VIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.l;
 }
 jobject NativeInterface::CallObjectMethodA(JNIEnv *env, jobject obj, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallObjectMethodA not implemented");
+	return callMethod(env, "CallObjectMethodA", CallKind::VIRTUAL, obj, methodID, args).l;
 }
 jboolean NativeInterface::CallBooleanMethod(JNIEnv *env, jobject obj, jmethodID methodID, ...) {
 	va_list args;
 	va_start(args, methodID);
-	const auto &result = __CallObjectMethod(env, obj, methodID, args);
+	auto result = callMethod(env, "CallBooleanMethod", CallKind::VIRTUAL, obj, methodID, args);
 	va_end(args);
-	return (jboolean)result.getReturnValue();
+	return result.z;
 }
 jboolean NativeInterface::CallBooleanMethodV(JNIEnv *env, jobject obj, jmethodID methodID, va_list args) {
-	throw VmException("CallBooleanMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallBooleanMethodV", CallKind::VIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.z;
 }
 jboolean NativeInterface::CallBooleanMethodA(JNIEnv *env, jobject obj, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallBooleanMethodA not implemented");
+	return callMethod(env, "CallBooleanMethodA", CallKind::VIRTUAL, obj, methodID, args).z;
 }
 jbyte NativeInterface::CallByteMethod(JNIEnv *env, jobject obj, jmethodID methodID, ...) {
 	va_list args;
 	va_start(args, methodID);
-	const auto &result = __CallObjectMethod(env, obj, methodID, args);
+	auto result = callMethod(env, "CallByteMethod", CallKind::VIRTUAL, obj, methodID, args);
 	va_end(args);
-	return (jbyte)result.getReturnValue();
+	return result.b;
 }
 jbyte NativeInterface::CallByteMethodV(JNIEnv *env, jobject obj, jmethodID methodID, va_list args) {
-	throw VmException("CallByteMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallByteMethodV", CallKind::VIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.b;
 }
 jbyte NativeInterface::CallByteMethodA(JNIEnv *env, jobject obj, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallByteMethodA not implemented");
+	return callMethod(env, "CallByteMethodA", CallKind::VIRTUAL, obj, methodID, args).b;
 }
 jchar NativeInterface::CallCharMethod(JNIEnv *env, jobject obj, jmethodID methodID, ...) {
 	va_list args;
 	va_start(args, methodID);
-	const auto &result = __CallObjectMethod(env, obj, methodID, args);
+	auto result = callMethod(env, "CallCharMethod", CallKind::VIRTUAL, obj, methodID, args);
 	va_end(args);
-	return (jchar)result.getReturnValue();
+	return result.c;
 }
 jchar NativeInterface::CallCharMethodV(JNIEnv *env, jobject obj, jmethodID methodID, va_list args) {
-	throw VmException("CallCharMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallCharMethodV", CallKind::VIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.c;
 }
 jchar NativeInterface::CallCharMethodA(JNIEnv *env, jobject obj, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallCharMethodA not implemented");
+	return callMethod(env, "CallCharMethodA", CallKind::VIRTUAL, obj, methodID, args).c;
 }
 jshort NativeInterface::CallShortMethod(JNIEnv *env, jobject obj, jmethodID methodID, ...) {
 	va_list args;
 	va_start(args, methodID);
-	const auto &result = __CallObjectMethod(env, obj, methodID, args);
+	auto result = callMethod(env, "CallShortMethod", CallKind::VIRTUAL, obj, methodID, args);
 	va_end(args);
-	return (jshort)result.getReturnValue();
+	return result.s;
 }
 jshort NativeInterface::CallShortMethodV(JNIEnv *env, jobject obj, jmethodID methodID, va_list args) {
-	throw VmException("CallShortMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallShortMethodV", CallKind::VIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.s;
 }
 jshort NativeInterface::CallShortMethodA(JNIEnv *env, jobject obj, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallShortMethodA not implemented");
+	return callMethod(env, "CallShortMethodA", CallKind::VIRTUAL, obj, methodID, args).s;
 }
 jint NativeInterface::CallIntMethod(JNIEnv *env, jobject obj, jmethodID methodID, ...) {
 	va_list args;
 	va_start(args, methodID);
-	const auto &result = __CallObjectMethod(env, obj, methodID, args);
+	auto result = callMethod(env, "CallIntMethod", CallKind::VIRTUAL, obj, methodID, args);
 	va_end(args);
-	return result.getReturnValue();
+	return result.i;
 }
 jint NativeInterface::CallIntMethodV(JNIEnv *env, jobject obj, jmethodID methodID, va_list args) {
-	throw VmException("CallIntMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallIntMethodV", CallKind::VIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.i;
 }
 jint NativeInterface::CallIntMethodA(JNIEnv *env, jobject obj, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallIntMethodA not implemented");
+	return callMethod(env, "CallIntMethodA", CallKind::VIRTUAL, obj, methodID, args).i;
 }
 jlong NativeInterface::CallLongMethod(JNIEnv *env, jobject obj, jmethodID methodID, ...) {
 	va_list args;
 	va_start(args, methodID);
-	const auto &result = __CallObjectMethod(env, obj, methodID, args);
+	auto result = callMethod(env, "CallLongMethod", CallKind::VIRTUAL, obj, methodID, args);
 	va_end(args);
-	return (jlong)result.getReturnDoubleValue();
+	return result.j;
 }
 jlong NativeInterface::CallLongMethodV(JNIEnv *env, jobject obj, jmethodID methodID, va_list args) {
-	throw VmException("CallLongMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallLongMethodV", CallKind::VIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.j;
 }
 jlong NativeInterface::CallLongMethodA(JNIEnv *env, jobject obj, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallLongMethodA not implemented");
+	return callMethod(env, "CallLongMethodA", CallKind::VIRTUAL, obj, methodID, args).j;
 }
 jfloat NativeInterface::CallFloatMethod(JNIEnv *env, jobject obj, jmethodID methodID, ...) {
 	va_list args;
 	va_start(args, methodID);
-	const auto &result = __CallObjectMethod(env, obj, methodID, args);
+	auto result = callMethod(env, "CallFloatMethod", CallKind::VIRTUAL, obj, methodID, args);
 	va_end(args);
-	return (jfloat)result.getReturnValue();
+	return result.f;
 }
 jfloat NativeInterface::CallFloatMethodV(JNIEnv *env, jobject obj, jmethodID methodID, va_list args) {
-	throw VmException("CallFloatMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallFloatMethodV", CallKind::VIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.f;
 }
 jfloat NativeInterface::CallFloatMethodA(JNIEnv *env, jobject obj, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallFloatMethodA not implemented");
+	return callMethod(env, "CallFloatMethodA", CallKind::VIRTUAL, obj, methodID, args).f;
 }
 jdouble NativeInterface::CallDoubleMethod(JNIEnv *env, jobject obj, jmethodID methodID, ...) {
 	va_list args;
 	va_start(args, methodID);
-	const auto &result = __CallObjectMethod(env, obj, methodID, args);
+	auto result = callMethod(env, "CallDoubleMethod", CallKind::VIRTUAL, obj, methodID, args);
 	va_end(args);
-	return (jdouble)result.getReturnDoubleValue();
+	return result.d;
 }
 jdouble NativeInterface::CallDoubleMethodV(JNIEnv *env, jobject obj, jmethodID methodID, va_list args) {
-	throw VmException("CallDoubleMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallDoubleMethodV", CallKind::VIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.d;
 }
 jdouble NativeInterface::CallDoubleMethodA(JNIEnv *env, jobject obj, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallDoubleMethodA not implemented");
+	return callMethod(env, "CallDoubleMethodA", CallKind::VIRTUAL, obj, methodID, args).d;
 }
 void NativeInterface::CallVoidMethod(JNIEnv *env, jobject obj, jmethodID methodID, ...) {
 	va_list args;
 	va_start(args, methodID);
-	__CallObjectMethod(env, obj, methodID, args);
+	callMethod(env, "CallVoidMethod", CallKind::VIRTUAL, obj, methodID, args);
 	va_end(args);
 }
 void NativeInterface::CallVoidMethodV(JNIEnv *env, jobject obj, jmethodID methodID, va_list args) {
-	throw VmException("CallVoidMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	callMethod(env, "CallVoidMethodV", CallKind::VIRTUAL, obj, methodID, copy);
+	va_end(copy);
 }
 void NativeInterface::CallVoidMethodA(JNIEnv *env, jobject obj, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallVoidMethodA not implemented");
+	callMethod(env, "CallVoidMethodA", CallKind::VIRTUAL, obj, methodID, args);
 }
 
 jobject NativeInterface::CallNonvirtualObjectMethod(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallNonvirtualObjectMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallNonvirtualObjectMethod", CallKind::NONVIRTUAL, obj, methodID, args);
+	va_end(args);
+	return result.l;
 }
 jobject NativeInterface::CallNonvirtualObjectMethodV(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallNonvirtualObjectMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallNonvirtualObjectMethodV", CallKind::NONVIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.l;
 }
 jobject NativeInterface::CallNonvirtualObjectMethodA(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallNonvirtualObjectMethodA not implemented");
+	return callMethod(env, "CallNonvirtualObjectMethodA", CallKind::NONVIRTUAL, obj, methodID, args).l;
 }
 
 jboolean NativeInterface::CallNonvirtualBooleanMethod(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallNonvirtualBooleanMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallNonvirtualBooleanMethod", CallKind::NONVIRTUAL, obj, methodID, args);
+	va_end(args);
+	return result.z;
 }
 jboolean NativeInterface::CallNonvirtualBooleanMethodV(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallNonvirtualBooleanMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallNonvirtualBooleanMethodV", CallKind::NONVIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.z;
 }
 jboolean NativeInterface::CallNonvirtualBooleanMethodA(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallNonvirtualBooleanMethodA not implemented");
+	return callMethod(env, "CallNonvirtualBooleanMethodA", CallKind::NONVIRTUAL, obj, methodID, args).z;
 }
 
 jbyte NativeInterface::CallNonvirtualByteMethod(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallNonvirtualByteMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallNonvirtualByteMethod", CallKind::NONVIRTUAL, obj, methodID, args);
+	va_end(args);
+	return result.b;
 }
 jbyte NativeInterface::CallNonvirtualByteMethodV(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallNonvirtualByteMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallNonvirtualByteMethodV", CallKind::NONVIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.b;
 }
 jbyte NativeInterface::CallNonvirtualByteMethodA(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallNonvirtualByteMethodA not implemented");
+	return callMethod(env, "CallNonvirtualByteMethodA", CallKind::NONVIRTUAL, obj, methodID, args).b;
 }
 
 jchar NativeInterface::CallNonvirtualCharMethod(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallNonvirtualCharMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallNonvirtualCharMethod", CallKind::NONVIRTUAL, obj, methodID, args);
+	va_end(args);
+	return result.c;
 }
 jchar NativeInterface::CallNonvirtualCharMethodV(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallNonvirtualCharMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallNonvirtualCharMethodV", CallKind::NONVIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.c;
 }
 jchar NativeInterface::CallNonvirtualCharMethodA(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallNonvirtualCharMethodA not implemented");
+	return callMethod(env, "CallNonvirtualCharMethodA", CallKind::NONVIRTUAL, obj, methodID, args).c;
 }
 
 jshort NativeInterface::CallNonvirtualShortMethod(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallNonvirtualShortMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallNonvirtualShortMethod", CallKind::NONVIRTUAL, obj, methodID, args);
+	va_end(args);
+	return result.s;
 }
 jshort NativeInterface::CallNonvirtualShortMethodV(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallNonvirtualShortMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallNonvirtualShortMethodV", CallKind::NONVIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.s;
 }
 jshort NativeInterface::CallNonvirtualShortMethodA(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallNonvirtualShortMethodA not implemented");
+	return callMethod(env, "CallNonvirtualShortMethodA", CallKind::NONVIRTUAL, obj, methodID, args).s;
 }
 
 jint NativeInterface::CallNonvirtualIntMethod(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallNonvirtualIntMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallNonvirtualIntMethod", CallKind::NONVIRTUAL, obj, methodID, args);
+	va_end(args);
+	return result.i;
 }
 jint NativeInterface::CallNonvirtualIntMethodV(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallNonvirtualIntMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallNonvirtualIntMethodV", CallKind::NONVIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.i;
 }
 jint NativeInterface::CallNonvirtualIntMethodA(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallNonvirtualIntMethodA not implemented");
+	return callMethod(env, "CallNonvirtualIntMethodA", CallKind::NONVIRTUAL, obj, methodID, args).i;
 }
 
 jlong NativeInterface::CallNonvirtualLongMethod(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallNonvirtualLongMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallNonvirtualLongMethod", CallKind::NONVIRTUAL, obj, methodID, args);
+	va_end(args);
+	return result.j;
 }
 jlong NativeInterface::CallNonvirtualLongMethodV(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallNonvirtualLongMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallNonvirtualLongMethodV", CallKind::NONVIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.j;
 }
 jlong NativeInterface::CallNonvirtualLongMethodA(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallNonvirtualLongMethodA not implemented");
+	return callMethod(env, "CallNonvirtualLongMethodA", CallKind::NONVIRTUAL, obj, methodID, args).j;
 }
 
 jfloat NativeInterface::CallNonvirtualFloatMethod(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallNonvirtualFloatMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallNonvirtualFloatMethod", CallKind::NONVIRTUAL, obj, methodID, args);
+	va_end(args);
+	return result.f;
 }
 jfloat NativeInterface::CallNonvirtualFloatMethodV(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallNonvirtualFloatMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallNonvirtualFloatMethodV", CallKind::NONVIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.f;
 }
 jfloat NativeInterface::CallNonvirtualFloatMethodA(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallNonvirtualFloatMethodA not implemented");
+	return callMethod(env, "CallNonvirtualFloatMethodA", CallKind::NONVIRTUAL, obj, methodID, args).f;
 }
 
 jdouble NativeInterface::CallNonvirtualDoubleMethod(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallNonvirtualDoubleMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallNonvirtualDoubleMethod", CallKind::NONVIRTUAL, obj, methodID, args);
+	va_end(args);
+	return result.d;
 }
 jdouble NativeInterface::CallNonvirtualDoubleMethodV(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallNonvirtualDoubleMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallNonvirtualDoubleMethodV", CallKind::NONVIRTUAL, obj, methodID, copy);
+	va_end(copy);
+	return result.d;
 }
 jdouble NativeInterface::CallNonvirtualDoubleMethodA(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallNonvirtualDoubleMethodA not implemented");
+	return callMethod(env, "CallNonvirtualDoubleMethodA", CallKind::NONVIRTUAL, obj, methodID, args).d;
 }
 
 void NativeInterface::CallNonvirtualVoidMethod(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallNonvirtualVoidMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	callMethod(env, "CallNonvirtualVoidMethod", CallKind::NONVIRTUAL, obj, methodID, args);
+	va_end(args);
 }
 void NativeInterface::CallNonvirtualVoidMethodV(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallNonvirtualVoidMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	callMethod(env, "CallNonvirtualVoidMethodV", CallKind::NONVIRTUAL, obj, methodID, copy);
+	va_end(copy);
 }
 void NativeInterface::CallNonvirtualVoidMethodA(JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallNonvirtualVoidMethodA not implemented");
+	callMethod(env, "CallNonvirtualVoidMethodA", CallKind::NONVIRTUAL, obj, methodID, args);
 }
 jfieldID NativeInterface::GetFieldID(JNIEnv *env, jclass clazz, const char *name, const char *sig) {
 	auto clsObj = native::getObject(clazz);
@@ -808,7 +1172,7 @@ jobject NativeInterface::GetObjectField(JNIEnv *env, jobject obj, jfieldID field
 	if (field.getType()[0] != 'L' && field.getType()[0] != '[') {
 		throw ClassCastException("GetObjectField: field is not an object or array");
 	}
-	return (jobject)jobj->getField(field.getName());
+	return (jobject)jobj->getFieldObject(field.getSlot());
 }
 
 jboolean NativeInterface::GetBooleanField(JNIEnv *env, jobject obj, jfieldID fieldID) {
@@ -821,7 +1185,7 @@ jboolean NativeInterface::GetBooleanField(JNIEnv *env, jobject obj, jfieldID fie
 	if (field.getType() != "Z") {
 		throw ClassCastException("GetBooleanField: field is not boolean");
 	}
-	return (jboolean)jobj->getField(field.getName())->getValue();
+	return (jboolean)jobj->getFieldValue(field.getSlot());
 }
 
 jbyte NativeInterface::GetByteField(JNIEnv *env, jobject obj, jfieldID fieldID) {
@@ -834,7 +1198,7 @@ jbyte NativeInterface::GetByteField(JNIEnv *env, jobject obj, jfieldID fieldID)
 	if (field.getType() != "B") {
 		throw ClassCastException("GetByteField: field is not byte");
 	}
-	return (jbyte)jobj->getField(field.getName())->getValue();
+	return (jbyte)jobj->getFieldValue(field.getSlot());
 }
 
 jchar NativeInterface::GetCharField(JNIEnv *env, jobject obj, jfieldID fieldID) {
@@ -847,7 +1211,7 @@ jchar NativeInterface::GetCharField(JNIEnv *env, jobject obj, jfieldID fieldID)
 	if (field.getType() != "C") {
 		throw ClassCastException("GetCharField: field is not char");
 	}
-	return (jchar)jobj->getField(field.getName())->getValue();
+	return (jchar)jobj->getFieldValue(field.getSlot());
 }
 
 jshort NativeInterface::GetShortField(JNIEnv *env, jobject obj, jfieldID fieldID) {
@@ -860,7 +1224,7 @@ jshort NativeInterface::GetShortField(JNIEnv *env, jobject obj, jfieldID fieldID
 	if (field.getType() != "S") {
 		throw ClassCastException("GetShortField: field is not short");
 	}
-	return (jshort)jobj->getField(field.getName())->getValue();
+	return (jshort)jobj->getFieldValue(field.getSlot());
 }
 
 jint NativeInterface::GetIntField(JNIEnv *env, jobject obj, jfieldID fieldID) {
@@ -873,7 +1237,7 @@ jint NativeInterface::GetIntField(JNIEnv *env, jobject obj, jfieldID fieldID) {
 	if (field.getType() != "I") {
 		throw ClassCastException("GetIntField: field is not int");
 	}
-	return (jint)jobj->getField(field.getName())->getValue();
+	return (jint)jobj->getFieldValue(field.getSlot());
 }
 
 jlong NativeInterface::GetLongField(JNIEnv *env, jobject obj, jfieldID fieldID) {
@@ -886,7 +1250,7 @@ jlong NativeInterface::GetLongField(JNIEnv *env, jobject obj, jfieldID fieldID)
 	if (field.getType() != "J") {
 		throw ClassCastException("GetLongField: field is not long");
 	}
-	return (jlong)jobj->getField(field.getName())->getLongValue();
+	return (jlong)jobj->getFieldValue(field.getSlot());
 }
 
 jfloat NativeInterface::GetFloatField(JNIEnv *env, jobject obj, jfieldID fieldID) {
@@ -899,7 +1263,7 @@ jfloat NativeInterface::GetFloatField(JNIEnv *env, jobject obj, jfieldID fieldID
 	if (field.getType() != "F") {
 		throw ClassCastException("GetFloatField: field is not float");
 	}
-	uint32_t value = jobj->getField(field.getName())->getValue();
+	uint32_t value = static_cast<uint32_t>(jobj->getFieldValue(field.getSlot()));
 	return (jfloat) * (float *)&value;
 }
 
@@ -913,7 +1277,7 @@ jdouble NativeInterface::GetDoubleField(JNIEnv *env, jobject obj, jfieldID field
 	if (field.getType() != "D") {
 		throw ClassCastException("GetDoubleField: field is not double");
 	}
-	uint64_t value = jobj->getField(field.getName())->getLongValue();
+	uint64_t value = jobj->getFieldValue(field.getSlot());
 	return (jdouble) * (double *)&value;
 }
 
@@ -924,7 +1288,7 @@ void NativeInterface::SetObjectField(JNIEnv *env, jobject obj, jfieldID fieldID,
 		throw NoSuchFieldException(fmt::format("SetObjectField: fieldID {} not found in class {}", (size_t)fieldID, clazz.getName()));
 	}
 	auto &field = clazz.getField((uint32_t)(uintptr_t)fieldID);
-	jobj->setField(field.getName(), native::getObject(val));
+	jobj->setFieldObject(field.getSlot(), native::getObject(val));
 }
 
 void NativeInterface::SetBooleanField(JNIEnv *env, jobject obj, jfieldID fieldID, jboolean val) {
@@ -937,7 +1301,7 @@ void NativeInterface::SetBooleanField(JNIEnv *env, jobject obj, jfieldID fieldID
 	if (field.getType() != "Z") {
 		throw ClassCastException("SetBooleanField: field is not boolean");
 	}
-	jobj->setField(field.getName(), Object::make(val));
+	jobj->setFieldValue(field.getSlot(), static_cast<uint64_t>(val));
 }
 
 void NativeInterface::SetByteField(JNIEnv *env, jobject obj, jfieldID fieldID, jbyte val) {
@@ -950,7 +1314,7 @@ void NativeInterface::SetByteField(JNIEnv *env, jobject obj, jfieldID fieldID, j
 	if (field.getType() != "B") {
 		throw ClassCastException("SetByteField: field is not byte");
 	}
-	jobj->setField(field.getName(), Object::make(val));
+	jobj->setFieldValue(field.getSlot(), static_cast<uint64_t>(val));
 }
 
 void NativeInterface::SetCharField(JNIEnv *env, jobject obj, jfieldID fieldID, jchar val) {
@@ -963,7 +1327,7 @@ void NativeInterface::SetCharField(JNIEnv *env, jobject obj, jfieldID fieldID, j
 	if (field.getType() != "C") {
 		throw ClassCastException("SetCharField: field is not char");
 	}
-	jobj->setField(field.getName(), Object::make(val));
+	jobj->setFieldValue(field.getSlot(), static_cast<uint64_t>(val));
 }
 
 void NativeInterface::SetShortField(JNIEnv *env, jobject obj, jfieldID fieldID, jshort val) {
@@ -976,7 +1340,7 @@ void NativeInterface::SetShortField(JNIEnv *env, jobject obj, jfieldID fieldID,
 	if (field.getType() != "S") {
 		throw ClassCastException("SetShortField: field is not short");
 	}
-	jobj->setField(field.getName(), Object::make(val));
+	jobj->setFieldValue(field.getSlot(), static_cast<uint64_t>(val));
 }
 void NativeInterface::SetIntField(JNIEnv *env, jobject obj, jfieldID fieldID, jint val) {
 	auto jobj = native::getObject(obj);
@@ -988,7 +1352,7 @@ void NativeInterface::SetIntField(JNIEnv *env, jobject obj, jfieldID fieldID, ji
 	if (field.getType() != "I") {
 		throw ClassCastException("SetIntField: field is not int");
 	}
-	jobj->setField(field.getName(), Object::make(val));
+	jobj->setFieldValue(field.getSlot(), static_cast<uint64_t>(val));
 }
 void NativeInterface::SetLongField(JNIEnv *env, jobject obj, jfieldID fieldID, jlong val) {
 	auto jobj = native::getObject(obj);
@@ -1000,7 +1364,7 @@ void NativeInterface::SetLongField(JNIEnv *env, jobject obj, jfieldID fieldID, j
 	if (field.getType() != "J") {
 		throw ClassCastException("SetLongField: field is not long");
 	}
-	jobj->setField(field.getName(), Object::make(val));
+	jobj->setFieldValue(field.getSlot(), static_cast<uint64_t>(val));
 }
 
 void NativeInterface::SetFloatField(JNIEnv *env, jobject obj, jfieldID fieldID, jfloat val) {
@@ -1014,7 +1378,7 @@ void NativeInterface::SetFloatField(JNIEnv *env, jobject obj, jfieldID fieldID,
 		throw ClassCastException("SetFloatField: field is not float");
 	}
 	uint32_t value = *((uint32_t *)&val);
-	jobj->setField(field.getName(), Object::make(value));
+	jobj->setFieldValue(field.getSlot(), value);
 }
 
 void NativeInterface::SetDoubleField(JNIEnv *env, jobject obj, jfieldID fieldID, jdouble val) {
@@ -1028,7 +1392,7 @@ void NativeInterface::SetDoubleField(JNIEnv *env, jobject obj, jfieldID fieldID,
 		throw ClassCastException("SetDoubleField: field is not double");
 	}
 	uint64_t value = *((uint64_t *)&val);
-	jobj->setField(field.getName(), Object::make(value));
+	jobj->setFieldValue(field.getSlot(), value);
 }
 
 jmethodID NativeInterface::GetStaticMethodID(JNIEnv *env, jclass clazz, const char *name, const char *sig) {
@@ -1045,110 +1409,188 @@ jmethodID NativeInterface::GetStaticMethodID(JNIEnv *env, jclass clazz, const ch
 		if (!method.isStatic()) {
 			throw NoSuchMethodException(fmt::format("GetStaticMethodID: method '{}' with signature '{}' is not static in class {}", name, sig, cls.getName()));
 		}
-		return (jmethodID)(uintptr_t)method.getIndex();
+		return (jmethodID)&method;
 	} catch (const std::invalid_argument &) {
 		return nullptr;
 	}
 }
 
 jobject NativeInterface::CallStaticObjectMethod(JNIEnv *env, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallStaticObjectMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallStaticObjectMethod", CallKind::STATIC, nullptr, methodID, args);
+	va_end(args);
+	return result.l;
 }
 jobject NativeInterface::CallStaticObjectMethodV(JNIEnv *env, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallStaticObjectMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallStaticObjectMethodV", CallKind::STATIC, nullptr, methodID, copy);
+	va_end(copy);
+	return result.l;
 }
 jobject NativeInterface::CallStaticObjectMethodA(JNIEnv *env, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallStaticObjectMethodA not implemented");
+	return callMethod(env, "CallStaticObjectMethodA", CallKind::STATIC, nullptr, methodID, args).l;
 }
 
 jboolean NativeInterface::CallStaticBooleanMethod(JNIEnv *env, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallStaticBooleanMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallStaticBooleanMethod", CallKind::STATIC, nullptr, methodID, args);
+	va_end(args);
+	return result.z;
 }
 jboolean NativeInterface::CallStaticBooleanMethodV(JNIEnv *env, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallStaticBooleanMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallStaticBooleanMethodV", CallKind::STATIC, nullptr, methodID, copy);
+	va_end(copy);
+	return result.z;
 }
 jboolean NativeInterface::CallStaticBooleanMethodA(JNIEnv *env, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallStaticBooleanMethodA not implemented");
+	return callMethod(env, "CallStaticBooleanMethodA", CallKind::STATIC, nullptr, methodID, args).z;
 }
 
 jbyte NativeInterface::CallStaticByteMethod(JNIEnv *env, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallStaticByteMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallStaticByteMethod", CallKind::STATIC, nullptr, methodID, args);
+	va_end(args);
+	return result.b;
 }
 jbyte NativeInterface::CallStaticByteMethodV(JNIEnv *env, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallStaticByteMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallStaticByteMethodV", CallKind::STATIC, nullptr, methodID, copy);
+	va_end(copy);
+	return result.b;
 }
 jbyte NativeInterface::CallStaticByteMethodA(JNIEnv *env, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallStaticByteMethodA not implemented");
+	return callMethod(env, "CallStaticByteMethodA", CallKind::STATIC, nullptr, methodID, args).b;
 }
 
 jchar NativeInterface::CallStaticCharMethod(JNIEnv *env, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallStaticCharMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallStaticCharMethod", CallKind::STATIC, nullptr, methodID, args);
+	va_end(args);
+	return result.c;
 }
 jchar NativeInterface::CallStaticCharMethodV(JNIEnv *env, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallStaticCharMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallStaticCharMethodV", CallKind::STATIC, nullptr, methodID, copy);
+	va_end(copy);
+	return result.c;
 }
 jchar NativeInterface::CallStaticCharMethodA(JNIEnv *env, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallStaticCharMethodA not implemented");
+	return callMethod(env, "CallStaticCharMethodA", CallKind::STATIC, nullptr, methodID, args).c;
 }
 
 jshort NativeInterface::CallStaticShortMethod(JNIEnv *env, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallStaticShortMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallStaticShortMethod", CallKind::STATIC, nullptr, methodID, args);
+	va_end(args);
+	return result.s;
 }
 jshort NativeInterface::CallStaticShortMethodV(JNIEnv *env, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallStaticShortMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallStaticShortMethodV", CallKind::STATIC, nullptr, methodID, copy);
+	va_end(copy);
+	return result.s;
 }
 jshort NativeInterface::CallStaticShortMethodA(JNIEnv *env, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallStaticShortMethodA not implemented");
+	return callMethod(env, "CallStaticShortMethodA", CallKind::STATIC, nullptr, methodID, args).s;
 }
 
 jint NativeInterface::CallStaticIntMethod(JNIEnv *env, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallStaticIntMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallStaticIntMethod", CallKind::STATIC, nullptr, methodID, args);
+	va_end(args);
+	return result.i;
 }
 jint NativeInterface::CallStaticIntMethodV(JNIEnv *env, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallStaticIntMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallStaticIntMethodV", CallKind::STATIC, nullptr, methodID, copy);
+	va_end(copy);
+	return result.i;
 }
 jint NativeInterface::CallStaticIntMethodA(JNIEnv *env, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallStaticIntMethodA not implemented");
+	return callMethod(env, "CallStaticIntMethodA", CallKind::STATIC, nullptr, methodID, args).i;
 }
 
 jlong NativeInterface::CallStaticLongMethod(JNIEnv *env, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallStaticLongMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallStaticLongMethod", CallKind::STATIC, nullptr, methodID, args);
+	va_end(args);
+	return result.j;
 }
 jlong NativeInterface::CallStaticLongMethodV(JNIEnv *env, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallStaticLongMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallStaticLongMethodV", CallKind::STATIC, nullptr, methodID, copy);
+	va_end(copy);
+	return result.j;
 }
 jlong NativeInterface::CallStaticLongMethodA(JNIEnv *env, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallStaticLongMethodA not implemented");
+	return callMethod(env, "CallStaticLongMethodA", CallKind::STATIC, nullptr, methodID, args).j;
 }
 
 jfloat NativeInterface::CallStaticFloatMethod(JNIEnv *env, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallStaticFloatMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallStaticFloatMethod", CallKind::STATIC, nullptr, methodID, args);
+	va_end(args);
+	return result.f;
 }
 jfloat NativeInterface::CallStaticFloatMethodV(JNIEnv *env, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallStaticFloatMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallStaticFloatMethodV", CallKind::STATIC, nullptr, methodID, copy);
+	va_end(copy);
+	return result.f;
 }
 jfloat NativeInterface::CallStaticFloatMethodA(JNIEnv *env, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallStaticFloatMethodA not implemented");
+	return callMethod(env, "CallStaticFloatMethodA", CallKind::STATIC, nullptr, methodID, args).f;
 }
 
 jdouble NativeInterface::CallStaticDoubleMethod(JNIEnv *env, jclass clazz, jmethodID methodID, ...) {
-	throw VmException("CallStaticDoubleMethod not implemented");
+	va_list args;
+	va_start(args, methodID);
+	auto result = callMethod(env, "CallStaticDoubleMethod", CallKind::STATIC, nullptr, methodID, args);
+	va_end(args);
+	return result.d;
 }
 jdouble NativeInterface::CallStaticDoubleMethodV(JNIEnv *env, jclass clazz, jmethodID methodID, va_list args) {
-	throw VmException("CallStaticDoubleMethodV not implemented");
+	va_list copy;
+	va_copy(copy, args);
+	auto result = callMethod(env, "CallStaticDoubleMethodV", CallKind::STATIC, nullptr, methodID, copy);
+	va_end(copy);
+	return result.d;
 }
 jdouble NativeInterface::CallStaticDoubleMethodA(JNIEnv *env, jclass clazz, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallStaticDoubleMethodA not implemented");
+	return callMethod(env, "CallStaticDoubleMethodA", CallKind::STATIC, nullptr, methodID, args).d;
 }
 
-void NativeInterface::CallStaticVoidMethod(JNIEnv *env, jclass cls, jmethodID methodID, ...) {
-	throw VmException("CallStaticVoidMethod not implemented");
+void NativeInterface::CallStaticVoidMethod(JNIEnv *env, jclass clazz, jmethodID methodID, ...) {
+	va_list args;
+	va_start(args, methodID);
+	callMethod(env, "CallStaticVoidMethod", CallKind::STATIC, nullptr, methodID, args);
+	va_end(args);
 }
-void NativeInterface::CallStaticVoidMethodV(JNIEnv *env, jclass cls, jmethodID methodID, va_list args) {
-	throw VmException("CallStaticVoidMethodV not implemented");
+void NativeInterface::CallStaticVoidMethodV(JNIEnv *env, jclass clazz, jmethodID methodID, va_list args) {
+	va_list copy;
+	va_copy(copy, args);
+	callMethod(env, "CallStaticVoidMethodV", CallKind::STATIC, nullptr, methodID, copy);
+	va_end(copy);
 }
-void NativeInterface::CallStaticVoidMethodA(JNIEnv *env, jclass cls, jmethodID methodID, const jvalue *args) {
-	throw VmException("CallStaticVoidMethodA not implemented");
+void NativeInterface::CallStaticVoidMethodA(JNIEnv *env, jclass clazz, jmethodID methodID, const jvalue *args) {
+	callMethod(env, "CallStaticVoidMethodA", CallKind::STATIC, nullptr, methodID, args);
 }
 
 jfieldID NativeInterface::GetStaticFieldID(JNIEnv *env, jclass clazz, const char *name, const char *sig) {
@@ -1490,10 +1932,10 @@ const char *NativeInterface::GetStringUTFChars(JNIEnv *env, jstring str, jboolea
 	if (!obj->isString()) {
 		throw ClassCastException("Not a string");
 	}
-	logger.fdebug("env->GetStringUTFChars {}", obj->toString());
-	char *utf = new char[obj->str().length() + 1];
-	std::strncpy(utf, obj->str().c_str(), obj->str().length());
-	utf[obj->str().length()] = '\0';  // Null-terminate the string
+	LOG_DEBUG("env->GetStringUTFChars {}", obj->toString());
+	auto value = obj->str();
+	char *utf = new char[value.length() + 1];
+	std::memcpy(utf, value.c_str(), value.length() + 1);
 	if (isCopy != nullptr) {
 		*isCopy = JNI_FALSE;  // Assuming we don't need to copy the string
 	}
@@ -1504,7 +1946,7 @@ void NativeInterface::ReleaseStringUTFChars(JNIEnv *env, jstring str, const char
 	if (obj == nullptr) {
 		throw NullPointerException("ReleaseStringUTFChars on null object");
 	}
-	logger.fdebug("env->ReleaseStringUTFChars {}", obj->toString());
+	LOG_DEBUG("env->ReleaseStringUTFChars {}", obj->toString());
 	if (chars) {
 		// If we allocated memory for chars, we should delete it
 		delete[] chars;
@@ -1530,182 +1972,156 @@ jbooleanArray NativeInterface::NewBooleanArray(JNIEnv *env, jsize len) {
 	ClassLoader &classloader = jenv->getClassLoader();
 	const auto &type = classloader.getOrLoad("boolean");
 	auto arrayObj = Array::make(type, len);
-	return (jbooleanArray)(jobject)(arrayObj);
+	return (jbooleanArray)localRef(arrayObj);
 }
 jbyteArray NativeInterface::NewByteArray(JNIEnv *env, jsize len) {
 	auto jenv = static_cast<NativeInterface *>(env);
 	ClassLoader &classloader = jenv->getClassLoader();
 	const auto &type = classloader.getOrLoad("byte");
 	auto arrayObj = Array::make(type, len);
-	return (jbyteArray)(jobject)(arrayObj);
+	return (jbyteArray)localRef(arrayObj);
 }
 jcharArray NativeInterface::NewCharArray(JNIEnv *env, jsize len) {
 	auto jenv = static_cast<NativeInterface *>(env);
 	ClassLoader &classloader = jenv->getClassLoader();
 	const auto &type = classloader.getOrLoad("char");
 	auto arrayObj = Array::make(type, len);
-	return (jcharArray)(jobject)(arrayObj);
+	return (jcharArray)localRef(arrayObj);
 }
 jshortArray NativeInterface::NewShortArray(JNIEnv *env, jsize len) {
 	auto jenv = static_cast<NativeInterface *>(env);
 	ClassLoader &classloader = jenv->getClassLoader();
 	const auto &type = classloader.getOrLoad("short");
 	auto arrayObj = Array::make(type, len);
-	return (jshortArray)(jobject)(arrayObj);
+	return (jshortArray)localRef(arrayObj);
 }
 jintArray NativeInterface::NewIntArray(JNIEnv *env, jsize len) {
 	auto jenv = static_cast<NativeInterface *>(env);
 	ClassLoader &classloader = jenv->getClassLoader();
 	const auto &type = classloader.getOrLoad("int");
 	auto arrayObj = Array::make(type, len);
-	return (jintArray)(jobject)(arrayObj);
+	return (jintArray)localRef(arrayObj);
 }
 jlongArray NativeInterface::NewLongArray(JNIEnv *env, jsize len) {
 	auto jenv = static_cast<NativeInterface *>(env);
 	ClassLoader &classloader = jenv->getClassLoader();
 	const auto &type = classloader.getOrLoad("long");
 	auto arrayObj = Array::make(type, len);
-	return (jlongArray)(jobject)(arrayObj);
+	return (jlongArray)localRef(arrayObj);
 }
 jfloatArray NativeInterface::NewFloatArray(JNIEnv *env, jsize len) {
 	auto jenv = static_cast<NativeInterface *>(env);
 	ClassLoader &classloader = jenv->getClassLoader();
 	const auto &type = classloader.getOrLoad("float");
 	auto arrayObj = Array::make(type, len);
-	return (jfloatArray)(jobject)(arrayObj);
+	return (jfloatArray)localRef(arrayObj);
 }
 jdoubleArray NativeInterface::NewDoubleArray(JNIEnv *env, jsize len) {
 	auto jenv = static_cast<NativeInterface *>(env);
 	ClassLoader &classloader = jenv->getClassLoader();
 	const auto &type = classloader.getOrLoad("double");
 	auto arrayObj = Array::make(type, len);
-	return (jdoubleArray)(jobject)(arrayObj);
+	return (jdoubleArray)localRef(arrayObj);
 }
 
 jboolean *NativeInterface::GetBooleanArrayElements(JNIEnv *env, jbooleanArray array, jboolean *isCopy) {
-	throw VmException("GetBooleanArrayElements not implemented");
+	return arrayElements<jboolean>("GetBooleanArrayElements", array, isCopy);
 }
 jbyte *NativeInterface::GetByteArrayElements(JNIEnv *env, jbyteArray array, jboolean *isCopy) {
-	throw VmException("GetByteArrayElements not implemented");
+	return arrayElements<jbyte>("GetByteArrayElements", array, isCopy);
 }
 jchar *NativeInterface::GetCharArrayElements(JNIEnv *env, jcharArray array, jboolean *isCopy) {
-	throw VmException("GetCharArrayElements not implemented");
+	return arrayElements<jchar>("GetCharArrayElements", array, isCopy);
 }
 jshort *NativeInterface::GetShortArrayElements(JNIEnv *env, jshortArray array, jboolean *isCopy) {
-	throw VmException("GetShortArrayElements not implemented");
+	return arrayElements<jshort>("GetShortArrayElements", array, isCopy);
 }
 jint *NativeInterface::GetIntArrayElements(JNIEnv *env, jintArray array, jboolean *isCopy) {
-	throw VmException("GetIntArrayElements not implemented");
+	return arrayElements<jint>("GetIntArrayElements", array, isCopy);
 }
 jlong *NativeInterface::GetLongArrayElements(JNIEnv *env, jlongArray array, jboolean *isCopy) {
-	throw VmException("GetLongArrayElements not implemented");
+	return arrayElements<jlong>("GetLongArrayElements", array, isCopy);
 }
 jfloat *NativeInterface::GetFloatArrayElements(JNIEnv *env, jfloatArray array, jboolean *isCopy) {
-	throw VmException("GetFloatArrayElements not implemented");
+	return arrayElements<jfloat>("GetFloatArrayElements", array, isCopy);
 }
 jdouble *NativeInterface::GetDoubleArrayElements(JNIEnv *env, jdoubleArray array, jboolean *isCopy) {
-	throw VmException("GetDoubleArrayElements not implemented");
+	return arrayElements<jdouble>("GetDoubleArrayElements", array, isCopy);
 }
 
 void NativeInterface::ReleaseBooleanArrayElements(JNIEnv *env, jbooleanArray array, jboolean *elems, jint mode) {
-	throw VmException("ReleaseBooleanArrayElements not implemented");
+	releaseArrayElements(array, mode);
 }
 void NativeInterface::ReleaseByteArrayElements(JNIEnv *env, jbyteArray array, jbyte *elems, jint mode) {
-	throw VmException("ReleaseByteArrayElements not implemented");
+	releaseArrayElements(array, mode);
 }
 void NativeInterface::ReleaseCharArrayElements(JNIEnv *env, jcharArray array, jchar *elems, jint mode) {
-	throw VmException("ReleaseCharArrayElements not implemented");
+	releaseArrayElements(array, mode);
 }
 void NativeInterface::ReleaseShortArrayElements(JNIEnv *env, jshortArray array, jshort *elems, jint mode) {
-	throw VmException("ReleaseShortArrayElements not implemented");
+	releaseArrayElements(array, mode);
 }
 void NativeInterface::ReleaseIntArrayElements(JNIEnv *env, jintArray array, jint *elems, jint mode) {
-	throw VmException("ReleaseIntArrayElements not implemented");
+	releaseArrayElements(array, mode);
 }
 void NativeInterface::ReleaseLongArrayElements(JNIEnv *env, jlongArray array, jlong *elems, jint mode) {
-	throw VmException("ReleaseLongArrayElements not implemented");
+	releaseArrayElements(array, mode);
 }
 void NativeInterface::ReleaseFloatArrayElements(JNIEnv *env, jfloatArray array, jfloat *elems, jint mode) {
-	throw VmException("ReleaseFloatArrayElements not implemented");
+	releaseArrayElements(array, mode);
 }
 void NativeInterface::ReleaseDoubleArrayElements(JNIEnv *env, jdoubleArray array, jdouble *elems, jint mode) {
-	throw VmException("ReleaseDoubleArrayElements not implemented");
+	releaseArrayElements(array, mode);
 }
-void NativeInterface::GetBooleanArrayRegion(JNIEnv *env, jbooleanArray array, jsize start, jsize l, jboolean *buf) {
-	throw VmException("GetBooleanArrayRegion not implemented");
+void NativeInterface::GetBooleanArrayRegion(JNIEnv *env, jbooleanArray array, jsize start, jsize len, jboolean *buf) {
+	getArrayRegion("GetBooleanArrayRegion", array, start, len, buf);
 }
 void NativeInterface::GetByteArrayRegion(JNIEnv *env, jbyteArray array, jsize start, jsize len, jbyte *buf) {
-	throw VmException("GetByteArrayRegion not implemented");
+	getArrayRegion("GetByteArrayRegion", array, start, len, buf);
 }
 void NativeInterface::GetCharArrayRegion(JNIEnv *env, jcharArray array, jsize start, jsize len, jchar *buf) {
-	auto arrObj = native::getObject(array);
-	if (!arrObj || !arrObj->isArray()) {
-		throw ClassCastException("GetCharArrayRegion: not an array");
-	}
-	Array &arr = static_cast<Array &>(*arrObj);
-	if (start < 0 || len < 0 || (uint32_t)(start + len) > arr.getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("GetCharArrayRegion: invalid start/len");
-	}
-	if (!buf) {
-		throw NullPointerException("GetCharArrayRegion: buf is null");
-	}
-	for (jsize i = 0; i < len; ++i) {
-		buf[i] = (jchar)arr.getElement(start + i)->getValue();
-	}
+	getArrayRegion("GetCharArrayRegion", array, start, len, buf);
 }
 void NativeInterface::GetShortArrayRegion(JNIEnv *env, jshortArray array, jsize start, jsize len, jshort *buf) {
-	throw VmException("GetShortArrayRegion not implemented");
+	getArrayRegion("GetShortArrayRegion", array, start, len, buf);
 }
 void NativeInterface::GetIntArrayRegion(JNIEnv *env, jintArray array, jsize start, jsize len, jint *buf) {
-	throw VmException("GetIntArrayRegion not implemented");
+	getArrayRegion("GetIntArrayRegion", array, start, len, buf);
 }
 void NativeInterface::GetLongArrayRegion(JNIEnv *env, jlongArray array, jsize start, jsize len, jlong *buf) {
-	throw VmException("GetLongArrayRegion not implemented");
+	getArrayRegion("GetLongArrayRegion", array, start, len, buf);
 }
 void NativeInterface::GetFloatArrayRegion(JNIEnv *env, jfloatArray array, jsize start, jsize len, jfloat *buf) {
-	throw VmException("GetFloatArrayRegion not implemented");
+	getArrayRegion("GetFloatArrayRegion", array, start, len, buf);
 }
 void NativeInterface::GetDoubleArrayRegion(JNIEnv *env, jdoubleArray array, jsize start, jsize len, jdouble *buf) {
-	throw VmException("GetDoubleArrayRegion not implemented");
+	getArrayRegion("GetDoubleArrayRegion", array, start, len, buf);
 }
 
-void NativeInterface::SetBooleanArrayRegion(JNIEnv *env, jbooleanArray array, jsize start, jsize l, const jboolean *buf) {
-	throw VmException("SetBooleanArrayRegion not implemented");
+void NativeInterface::SetBooleanArrayRegion(JNIEnv *env, jbooleanArray array, jsize start, jsize len, const jboolean *buf) {
+	setArrayRegion("SetBooleanArrayRegion", array, start, len, buf);
 }
 void NativeInterface::SetByteArrayRegion(JNIEnv *env, jbyteArray array, jsize start, jsize len, const jbyte *buf) {
-	throw VmException("SetByteArrayRegion not implemented");
+	setArrayRegion("SetByteArrayRegion", array, start, len, buf);
 }
 void NativeInterface::SetCharArrayRegion(JNIEnv *env, jcharArray array, jsize start, jsize len, const jchar *buf) {
-	auto arrObj = native::getObject(array);
-	if (!arrObj->isArray()) {
-		throw ClassCastException("SetCharArrayRegion: not an array");
-	}
-	Array &arr = static_cast<Array &>(*arrObj);
-	if (start < 0 || len < 0 || (uint32_t)(start + len) > arr.getArrayLength()) {
-		throw ArrayIndexOutOfBoundsException("SetCharArrayRegion: invalid start/len");
-	}
-	if (!buf) {
-		throw NullPointerException("SetCharArrayRegion: buf is null");
-	}
-	for (jsize i = 0; i < len; ++i) {
-		arr.setElement(start + i, Object::make((uint64_t)buf[i]));
-	}
+	setArrayRegion("SetCharArrayRegion", array, start, len, buf);
 }
 
 void NativeInterface::SetShortArrayRegion(JNIEnv *env, jshortArray array, jsize start, jsize len, const jshort *buf) {
-	throw VmException("SetShortArrayRegion not implemented");
+	setArrayRegion("SetShortArrayRegion", array, start, len, buf);
 }
 void NativeInterface::SetIntArrayRegion(JNIEnv *env, jintArray array, jsize start, jsize len, const jint *buf) {
-	throw VmException("SetIntArrayRegion not implemented");
+	setArrayRegion("SetIntArrayRegion", array, start, len, buf);
 }
 void NativeInterface::SetLongArrayRegion(JNIEnv *env, jlongArray array, jsize start, jsize len, const jlong *buf) {
-	throw VmException("SetLongArrayRegion not implemented");
+	setArrayRegion("SetLongArrayRegion", array, start, len, buf);
 }
 void NativeInterface::SetFloatArrayRegion(JNIEnv *env, jfloatArray array, jsize start, jsize len, const jfloat *buf) {
-	throw VmException("SetFloatArrayRegion not implemented");
+	setArrayRegion("SetFloatArrayRegion", array, start, len, buf);
 }
 void NativeInterface::SetDoubleArrayRegion(JNIEnv *env, jdoubleArray array, jsize start, jsize len, const jdouble *buf) {
-	throw VmException("SetDoubleArrayRegion not implemented");
+	setArrayRegion("SetDoubleArrayRegion", array, start, len, buf);
 }
 jint NativeInterface::RegisterNatives(JNIEnv *env, jclass clazz, const JNINativeMethod *methods, jint nMethods) {
 	if (env == nullptr) {
@@ -1714,9 +2130,24 @@ jint NativeInterface::RegisterNatives(JNIEnv *env, jclass clazz, const JNINative
 	if (methods == nullptr) {
 		throw std::invalid_argument("methods cannot be null");
 	}
+	auto clsObj = native::getObject(clazz);
+	if (!clsObj || !clsObj->isClass()) {
+		throw ClassCastException("RegisterNatives: class is not a class object");
+	}
+	auto &cls = clsObj->getClass();
 	for (int i = 0; i < nMethods; i++) {
 		const JNINativeMethod *method = &methods[i];
-		logger.fdebug("JNI: RegisterNatives {}{} -> {}", method->name, method->signature, method->fnPtr);
+		LOG_DEBUG("JNI: RegisterNatives {}{} -> {}", method->name, method->signature, method->fnPtr);
+		Method *target = nullptr;
+		try {
+			target = &cls.getMethod(method->name, method->signature);
+		} catch (const std::invalid_argument &) {
+		}
+		if (target == nullptr || !target->isNative()) {
+			throw NoSuchMethodError(fmt::format("RegisterNatives: no native method {}.{}{}", cls.getFullname(), method->name, method->signature));
+		}
+		// methods already bound keep their binding, registration applies to the next resolution
+		target->registerNative(method->fnPtr);
 	}
 	return JNI_OK;
 }
@@ -1725,10 +2156,18 @@ jint NativeInterface::UnregisterNatives(JNIEnv *env, jclass clazz) {
 }
 
 jint NativeInterface::MonitorEnter(JNIEnv *env, jobject obj) {
-	throw VmException("MonitorEnter not implemented");
+	if (obj == nullptr) {
+		throw NullPointerException("MonitorEnter on null object");
+	}
+	native::getObject(obj)->monitorEnter();
+	return JNI_OK;
 }
 jint NativeInterface::MonitorExit(JNIEnv *env, jobject obj) {
-	throw VmException("MonitorExit not implemented");
+	if (obj == nullptr) {
+		throw NullPointerException("MonitorExit on null object");
+	}
+	native::getObject(obj)->monitorExit();
+	return JNI_OK;
 }
 
 jint NativeInterface::GetJavaVM(JNIEnv *env, JavaVM **vm) {
@@ -1748,10 +2187,19 @@ void NativeInterface::GetStringUTFRegion(JNIEnv *env, jstring str, jsize start,
 }
 
 void *NativeInterface::GetPrimitiveArrayCritical(JNIEnv *env, jarray array, jboolean *isCopy) {
-	throw VmException("GetPrimitiveArrayCritical not implemented");
+	auto arr = native::getArray(array);
+	if (!arr->isPrimitiveArray() || arr->getDimensions() != 1) {
+		// the rows of a multi-dimensional array are references, not contiguous primitive storage
+		throw ClassCastException("GetPrimitiveArrayCritical: not a one-dimensional primitive array");
+	}
+	GC::getInstance().pin(arr);
+	if (isCopy) {
+		*isCopy = JNI_FALSE;
+	}
+	return arr->getRawData();
 }
 void NativeInterface::ReleasePrimitiveArrayCritical(JNIEnv *env, jarray array, void *carray, jint mode) {
-	throw VmException("ReleasePrimitiveArrayCritical not implemented");
+	releaseArrayElements(array, mode);
 }
 
 const jchar *NativeInterface::GetStringCritical(JNIEnv *env, jstring string, jboolean *isCopy) {
@@ -1771,8 +2219,7 @@ void NativeInterface::DeleteWeakGlobalRef(JNIEnv *env, jweak ref) {
 }
 
 jboolean NativeInterface::ExceptionCheck(JNIEnv *env) {
-	logger.fwarning("ExceptionCheck not implemented");
-	return JNI_TRUE;
+	return static_cast<NativeInterface *>(env)->getVm().currentThread().getPendingException() != nullptr ? JNI_TRUE : JNI_FALSE;
 }
 
 jobject NativeInterface::NewDirectByteBuffer(JNIEnv *env, void *address, jlong capacity) {
@@ -21,6 +21,9 @@
 #include <fmt/color.h>
 #include <fmt/format.h>
 
+#include <new>
+#include <type_traits>
+
 #include "class.hpp"
 #include "classloader.hpp"
 #include "exceptions.hpp"
@@ -33,24 +36,54 @@
 
 using namespace sandvik;
 
-JThread::JThread(Vm& vm_, ClassLoader& classloader_, const std::string& name_)
-    : Thread(name_), _vm(vm_), _classloader(classloader_), _interpreter(std::make_unique<Interpreter>(*this)), _objectReturn(Object::makeNull()) {
+namespace {
+	/** Java thread running on the OS thread */
+	thread_local JThread* currentThread = nullptr;
+}  // namespace
+
+JThread::JThread(Vm& vm_, ClassLoader& classloader_, uint64_t id_, const std::string& name_)
+    : Thread(name_),
+      _vm(vm_),
+      _classloader(classloader_),
+      _id(id_),
+      _interpreter(std::make_unique<Interpreter>(*this)),
+      _objectReturn(Object::makeNull()),
+      _stackSize(vm_.getStackSize()),
+      _stack(std::make_unique_for_overwrite<std::byte[]>(_stackSize)),
+      _stackTop(_stack.get()) {
 	_thisThread = Object::make(_classloader.getOrLoad("java/lang/Thread"));
 	_thisThread->setField("name", Object::make(_classloader, name_));
 	_thisThread->setField("priority", Object::make(5));  // normal priority
-}
-
-JThread::JThread(Vm& vm_, ClassLoader& classloader_, ObjectRef thread_)
-    : Thread(thread_->getField("name")->str()), _vm(vm_), _classloader(classloader_), _interpreter(std::make_unique<Interpreter>(*this)), _thisThread(thread_) {
+	_thisThread->setField("eetop", Object::make(_id));
+}
+
+JThread::JThread(Vm& vm_, ClassLoader& classloader_, uint64_t id_, ObjectRef thread_)
+    : Thread(thread_->getField("name")->str()),
+      _vm(vm_),
+      _classloader(classloader_),
+      _id(id_),
+      _interpreter(std::make_unique<Interpreter>(*this)),
+      _thisThread(thread_),
+      _stackSize(vm_.getStackSize()),
+      _stack(std::make_unique_for_overwrite<std::byte[]>(_stackSize)),
+      _stackTop(_stack.get()) {
+	_thisThread->setField("eetop", Object::make(_id));
 	auto target = _thisThread->getField("target");
 	if (target == nullptr || target == Object::makeNull()) {
 		throw VmException("Thread object has no target Runnable");
 	}
-	logger.fdebug("Runnable '{}' ", target->toString());
+	LOG_DEBUG("Runnable '{}' ", target->toString());
 	auto& clazz = target->getClass();
-	auto& method = clazz.getMethod("run", "()V");
-	Frame& frame = newFrame(method);
-	frame.setObjRegister(method.getNbRegisters() - 1, target);
+	auto* method = clazz.findVirtualMethod("run", "()V");
+	if (method == nullptr) {
+		throw VmException("Runnable {} has no run method", clazz.getFullname());
+	}
+	Frame& frame = newFrame(*method);
+	frame.setObjRegister(method->getNbRegisters() - 1, target);
+}
+
+JThread* JThread::current() {
+	return currentThread;
 }
 
 Vm& JThread::vm() const {
@@ -62,36 +95,52 @@ ClassLoader& JThread::getClassLoader() const {
 }
 
 bool JThread::end() const {
-	return _stack.empty();
-}
-
-uint64_t JThread::stackDepth() const {
-	return _stack.size();
+	return _currentFrame == nullptr;
 }
 
 Frame& JThread::newFrame(Method& method_) {
-	if (method_.getName() == "<clinit>") {
-		auto& clazz = method_.getClass();
-		if (!clazz.isStaticInitialized()) {
-			// method clinit has been pushed on the stack and will be executed, mark the class as initialized
-			clazz.setStaticInitialized();
-		} else {
-			logger.fwarning("Class {} already initialized", clazz.getFullname());
-		}
+	const auto size = Frame::getFrameSize(method_.getNbRegisters());
+	if (size > static_cast<size_t>(_stack.get() + _stackSize - _stackTop)) [[unlikely]] {
+		throw StackOverflowError(fmt::format("stack size of {} bytes exceeded at depth {} calling {}", _stackSize, _stackDepth, method_.getFullname()));
 	}
-	_stack.push_back(std::make_unique<Frame>(method_));
-	return *(_stack.back().get());
+	auto* frame = new (_stackTop) Frame(method_, _currentFrame);
+	_stackTop += size;
+	_currentFrame = frame;
+	++_stackDepth;
+	return *frame;
 }
 
 void JThread::popFrame() {
-	_stack.pop_back();
+	// frames are trivially destructible, popping only moves the top of the stack back
+	static_assert(std::is_trivially_destructible_v<Frame>);
+	_stackTop = reinterpret_cast<std::byte*>(_currentFrame);
+	_currentFrame = _currentFrame->getCaller();
+	--_stackDepth;
+}
+
+void JThread::clearStack() {
+	_stackTop = _stack.get();
+	_currentFrame = nullptr;
+	_stackDepth = 0;
+}
+
+void JThread::executeCallback() {
+	_interpreter->executeCallback();
+}
+
+ObjectRef JThread::getPendingException() const {
+	return _interpreter->getPendingException();
+}
+
+void JThread::setPendingException(ObjectRef exception_) {
+	_interpreter->setPendingException(exception_);
 }
 
 Frame& JThread::currentFrame() const {
-	if (_stack.empty()) {
+	if (_currentFrame == nullptr) [[unlikely]] {
 		throw VmException("No current frame");
 	}
-	return *(_stack.back().get());
+	return *_currentFrame;
 }
 
 void JThread::loop() {
@@ -102,7 +151,7 @@ void JThread::loop() {
 		// terminate the whole VM on unhandled exception in thread
 		_vm.stop();
 		// clear the stack, call to end() will be true
-		_stack.clear();
+		clearStack();
 	} catch (const JavaException& e) {
 		if (e.getMessage().empty()) {
 			logger.ferror("Unhandled Java exception of type {}", e.getExceptionType());
@@ -112,12 +161,20 @@ void JThread::loop() {
 		// terminate the whole VM on unhandled exception in thread
 		_vm.stop();
 		// clear the stack, call to end() will be true
-		_stack.clear();
+		clearStack();
 	}
 }
 
 bool JThread::done() {
-	return _stack.empty() || !_vm.isRunning();
+	return _currentFrame == nullptr || !_vm.isRunning();
+}
+
+void JThread::onEnter() {
+	currentThread = this;
+}
+
+void JThread::onExit() {
+	currentThread = nullptr;
 }
 
 ObjectRef JThread::getThreadObject() const {
@@ -129,17 +186,11 @@ ObjectRef JThread::getReturnObject() const {
 }
 
 int32_t JThread::getReturnValue() const {
-	if (!_objectReturn->isNumberObject()) {
-		throw VmException("Return object is not an NumberObject");
-	}
-	return _objectReturn->getValue();
+	return static_cast<int32_t>(_valueReturn);
 }
 
 int64_t JThread::getReturnDoubleValue() const {
-	if (!_objectReturn->isNumberObject()) {
-		throw VmException("Return object is not a isNumberObject");
-	}
-	return _objectReturn->getLongValue();
+	return static_cast<int64_t>(_valueReturn);
 }
 
 void JThread::setReturnObject(ObjectRef ret_) {
@@ -147,17 +198,34 @@ void JThread::setReturnObject(ObjectRef ret_) {
 }
 
 void JThread::setReturnValue(int32_t ret_) {
-	_objectReturn = Object::make(ret_);
+	_valueReturn = static_cast<uint64_t>(static_cast<int64_t>(ret_));
+	_objectReturn = Object::makeNull();
 }
 
 void JThread::setReturnDoubleValue(int64_t ret_) {
-	_objectReturn = Object::make(ret_);
+	_valueReturn = static_cast<uint64_t>(ret_);
+	_objectReturn = Object::makeNull();
+}
+
+void JThread::popLocalFrame(size_t mark_) {
+	_localRefs.resize(mark_);
+}
+
+ObjectRef JThread::addLocalRef(ObjectRef obj_) {
+	if (obj_ != nullptr) {
+		_localRefs.push_back(obj_);
+	}
+	return obj_;
 }
 
 void JThread::visitReferences(const std::function<void(Object*)>& visitor_) const {
 	visitor_(_thisThread);
 	visitor_(_objectReturn);
-	for (const auto& frame : _stack) {
+	visitor_(_interpreter->getPendingException());
+	for (auto* ref : _localRefs) {
+		visitor_(ref);
+	}
+	for (auto* frame = _currentFrame; frame != nullptr; frame = frame->getCaller()) {
 		frame->visitReferences(visitor_);
 	}
 }
@@ -19,6 +19,7 @@
 #ifndef __JAVA_THREAD_HPP__
 #define __JAVA_THREAD_HPP__
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <thread>
@@ -39,15 +40,28 @@ namespace sandvik {
 			/** @brief Constructs a new Java thread.
 			 * @param vm_ Reference to the VM instance
 			 * @param classloader_ Reference to the class loader
+			 * @param id_ Identifier of the thread in the VM
 			 * @param name_ Name of the thread
 			 */
-			explicit JThread(Vm& vm_, ClassLoader& classloader_, const std::string& name_);
+			explicit JThread(Vm& vm_, ClassLoader& classloader_, uint64_t id_, const std::string& name_);
 			/** @brief Constructs a new Java thread with an existing thread object.
 			 * @param vm_ Reference to the VM instance
 			 * @param classloader_ Reference to the class loader
+			 * @param id_ Identifier of the thread in the VM
 			 * @param thread_ Shared pointer to the Java Thread object
 			 */
-			explicit JThread(Vm& vm_, ClassLoader& classloader_, ObjectRef thread_);
+			explicit JThread(Vm& vm_, ClassLoader& classloader_, uint64_t id_, ObjectRef thread_);
+
+			/** @brief Gets the Java thread running on the calling OS thread.
+			 * @return Pointer to the thread, nullptr if the calling thread is not a Java thread
+			 */
+			static JThread* current();
+			/** @brief Gets the identifier of the thread in the VM, also stored in the eetop field of the thread object.
+			 * @return Thread identifier
+			 */
+			inline uint64_t getThreadId() const {
+				return _id;
+			}
 
 			/** @brief Gets the VM instance.
 			 * @return Reference to the VM instance
@@ -63,8 +77,10 @@ namespace sandvik {
 			bool end() const;
 
 			/** @brief Creates a new frame for the specified method.
+			 * The frame and its registers are bump allocated on top of the thread stack.
 			 * @param method_ Reference to the method
 			 * @return Reference to the created frame
+			 * @throws StackOverflowError if the frame does not fit in the thread stack
 			 */
 			Frame& newFrame(Method& method_);
 			/** @brief Pops the current frame from the stack. */
@@ -76,7 +92,22 @@ namespace sandvik {
 			/** @brief Gets the current stack depth.
 			 * @return Current stack depth
 			 */
-			uint64_t stackDepth() const;
+			inline uint64_t stackDepth() const {
+				return _stackDepth;
+			}
+			/** @brief Runs the frame on top of the stack until it returns, nested in the frames below it.
+			 * Used by native code to call back java methods on the calling thread (JNI Call<Type>Method).
+			 * The return value is stored in the return slot of the thread.
+			 */
+			void executeCallback();
+			/** @brief Gets the exception pending on the thread (JNI ExceptionOccurred).
+			 * @return Pending exception, nullptr if there is none
+			 */
+			ObjectRef getPendingException() const;
+			/** @brief Sets the exception pending on the thread (JNI Throw), thrown when the native method returns.
+			 * @param exception_ Throwable object, nullptr clears the pending exception
+			 */
+			void setPendingException(ObjectRef exception_);
 
 			/** @brief Gets the thread object.
 			 * @return Shared pointer to the thread object
@@ -107,6 +138,24 @@ namespace sandvik {
 			 */
 			void setReturnDoubleValue(int64_t ret_);
 
+			/** @brief Opens a local reference frame for a native method call.
+			 * The objects referenced only by native code (boxed arguments, objects created through JNI) are garbage collection
+			 * roots until the frame is closed, nested java calls may reach a safepoint meanwhile.
+			 * @return Mark of the frame, to pass to popLocalFrame()
+			 */
+			inline size_t pushLocalFrame() const {
+				return _localRefs.size();
+			}
+			/** @brief Closes a local reference frame, the references added since it was opened are released.
+			 * @param mark_ Mark returned by pushLocalFrame()
+			 */
+			void popLocalFrame(size_t mark_);
+			/** @brief Adds a local reference to the current local reference frame.
+			 * @param obj_ Referenced object
+			 * @return The object
+			 */
+			ObjectRef addLocalRef(ObjectRef obj_);
+
 			/** Visit outgoing references
 			 * @param visitor_ function to call for each referenced object
 			 */
@@ -117,15 +166,35 @@ namespace sandvik {
 			void loop() override;
 			/** @brief thread loop end condition. */
 			bool done() override;
+			/** @brief makes the thread the current thread of the OS thread running it. */
+			void onEnter() override;
+			/** @brief clears the current thread of the OS thread. */
+			void onExit() override;
 
 		private:
+			/** @brief drops all the frames of the stack. */
+			void clearStack();
+
 			Vm& _vm;
 			ClassLoader& _classloader;
+			const uint64_t _id;
 			std::unique_ptr<Interpreter> _interpreter;
 
-			std::vector<std::unique_ptr<Frame>> _stack;
 			ObjectRef _objectReturn;
+			/** raw primitive return value of a native call */
+			uint64_t _valueReturn = 0;
 			ObjectRef _thisThread;
+			/** local references of the native calls in progress */
+			std::vector<ObjectRef> _localRefs;
+
+			/** contiguous stack of the thread, holding the frames and their registers */
+			const size_t _stackSize;
+			std::unique_ptr<std::byte[]> _stack;
+			/** first free byte of the stack */
+			std::byte* _stackTop;
+			/** frame on top of the stack, nullptr if the stack is empty */
+			Frame* _currentFrame = nullptr;
+			uint64_t _stackDepth = 0;
 	};
 }  // namespace sandvik
 
@@ -57,7 +57,7 @@ Apk::Apk(const std::string& path_, std::vector<std::unique_ptr<Dex>>& dexs_) : _
 		throw VmException("No DEX files found in APK: {}", _path);
 	}
 	for (const auto& file : dexFiles) {
-		logger.fdebug("Loading DEX file from APK: {}", file);
+		LOG_DEBUG("Loading DEX file from APK: {}", file);
 		uint64_t size = 0;
 		auto buffer = _zipReader->extractToMemory(file, size);
 		if (!buffer) {
@@ -181,7 +181,7 @@ std::string Apk::findMainActivity() const {
 										mainActivity = activityName;
 									}
 
-									logger.fdebug("APK main activity: {}", mainActivity);
+									LOG_DEBUG("APK main activity: {}", mainActivity);
 									return mainActivity;
 								}
 							}
@@ -61,6 +61,7 @@ void Dex::load(const std::string& path) {
 		if (!_dex) {
 			throw DexLoaderException("Failed to parse DEX file: " + path);
 		}
+		initCaches();
 	} catch (const std::exception& e) {
 		throw DexLoaderException(std::string("LIEF error: ") + e.what());
 	}
@@ -76,11 +77,27 @@ void Dex::load(std::vector<uint8_t>& buffer) {
 		if (!_dex) {
 			throw DexLoaderException("Failed to parse DEX from moved buffer");
 		}
+		initCaches();
 	} catch (const std::exception& e) {
 		throw DexLoaderException(std::string("LIEF error: ") + e.what());
 	}
 }
 
+void Dex::initCaches() {
+	const auto methods = _dex->methods().size();
+	const auto types = _dex->types().size();
+	_methodRefs.assign(methods);
+	_classNames.assign(types);
+	_types.assign(types);
+	_strings.assign(_dex->strings().size());
+	// atomics are not copyable, the entries are value initialized to nullptr
+	_resolved.methods = std::vector<std::atomic<Method*>>(methods);
+	_resolved.virtualMethods = std::vector<std::atomic<Method*>>(methods);
+	_resolved.fields = std::vector<std::atomic<Field*>>(_dex->fields().size());
+	_resolved.classes = std::vector<std::atomic<Class*>>(types);
+	_resolved.strings = std::vector<std::atomic<Object*>>(_dex->strings().size());
+}
+
 bool Dex::is_loaded() const noexcept {
 	return _dex != nullptr;
 }
@@ -110,10 +127,15 @@ std::unique_ptr<::sandvik::Class> Dex::findClass(ClassLoader& classloader_, cons
 	throw DexLoaderException(fmt::format("Class '{}' not found in DEX file", name));
 }
 
-void Dex::resolveMethod(uint16_t idx, std::string& class_, std::string& method_, std::string& sig_) const {
+const MethodRef& Dex::resolveMethod(uint16_t idx) {
 	if (!_dex) {
 		throw DexLoaderException("No DEX file loaded");
 	}
+	if (idx < _methodRefs.size()) [[likely]] {
+		if (const auto* ref = _methodRefs.get(idx)) {
+			return *ref;
+		}
+	}
 
 	try {
 		const auto& methods = _dex->methods();
@@ -124,18 +146,21 @@ void Dex::resolveMethod(uint16_t idx, std::string& class_, std::string& method_,
 		std::advance(it, idx);
 		const auto& method = *it;
 
-		class_ = method.cls()->pretty_name();
-		method_ = method.name();
-		sig_ = get_method_descriptor(method);
+		return _methodRefs.publish(idx, MethodRef{method.cls()->pretty_name(), method.name(), get_method_descriptor(method)});
 	} catch (const std::exception& e) {
 		throw DexLoaderException(fmt::format("Failed to resolve method at index {}: {}", idx, e.what()));
 	}
 }
 
-void Dex::resolveClass(uint16_t idx, std::string& class_) const {
+const std::string& Dex::resolveClass(uint16_t idx) {
 	if (!_dex) {
 		throw DexLoaderException("No DEX file loaded");
 	}
+	if (idx < _classNames.size()) [[likely]] {
+		if (const auto* name = _classNames.get(idx)) {
+			return *name;
+		}
+	}
 
 	try {
 		// Get the type_id item first
@@ -149,12 +174,10 @@ void Dex::resolveClass(uint16_t idx, std::string& class_) const {
 
 		switch (type.type()) {
 			case LIEF::DEX::Type::TYPES::CLASS:
-				class_ = type.cls().pretty_name();
-				return;
+				return _classNames.publish(idx, type.cls().pretty_name());
 			case LIEF::DEX::Type::TYPES::PRIMITIVE:
 			case LIEF::DEX::Type::TYPES::ARRAY:
-				class_ = get_type_descriptor(type);
-				return;
+				return _classNames.publish(idx, get_type_descriptor(type));
 			case LIEF::DEX::Type::TYPES::UNKNOWN:
 			default:
 				throw DexLoaderException(fmt::format("Unknown type at index {}", idx));
@@ -183,7 +206,7 @@ void Dex::resolveField(uint16_t idx, std::string& class_, std::string& field_) c
 	}
 }
 
-std::string Dex::resolveType(uint16_t idx, TYPES& type_) {
+const std::string& Dex::resolveType(uint16_t idx, TYPES& type_) {
 	if (!_dex) {
 		throw DexLoaderException("No DEX file loaded");
 	}
@@ -192,31 +215,40 @@ std::string Dex::resolveType(uint16_t idx, TYPES& type_) {
 	if (idx >= type_items.size()) {
 		throw DexLoaderException(fmt::format("Type index {} out of range", idx));
 	}
+	const auto* resolved = _types.get(idx);
+	if (!resolved) {
+		// Get the specific type
+		const auto& type = type_items[idx];
 
-	// Get the specific type
-	const auto& type = type_items[idx];
-
-	switch (type.type()) {
-		case LIEF::DEX::Type::TYPES::CLASS:
-			type_ = TYPES::CLASS;
-			return type.cls().pretty_name();
-		case LIEF::DEX::Type::TYPES::PRIMITIVE:
-			type_ = TYPES::PRIMITIVE;
-			return get_primitive_type(get_type_descriptor(type));
-		case LIEF::DEX::Type::TYPES::ARRAY:
-			type_ = TYPES::ARRAY;
-			return get_type_descriptor(type);
-		case LIEF::DEX::Type::TYPES::UNKNOWN:
-		default:
-			type_ = TYPES::UNKNOWN;
-			return "<unknown>";
+		switch (type.type()) {
+			case LIEF::DEX::Type::TYPES::CLASS:
+				resolved = &_types.publish(idx, {type.cls().pretty_name(), TYPES::CLASS});
+				break;
+			case LIEF::DEX::Type::TYPES::PRIMITIVE:
+				resolved = &_types.publish(idx, {get_primitive_type(get_type_descriptor(type)), TYPES::PRIMITIVE});
+				break;
+			case LIEF::DEX::Type::TYPES::ARRAY:
+				resolved = &_types.publish(idx, {get_type_descriptor(type), TYPES::ARRAY});
+				break;
+			case LIEF::DEX::Type::TYPES::UNKNOWN:
+			default:
+				resolved = &_types.publish(idx, {"<unknown>", TYPES::UNKNOWN});
+				break;
+		}
 	}
+	type_ = resolved->second;
+	return resolved->first;
 }
 
-std::string Dex::resolveString(uint16_t idx) {
+const std::string& Dex::resolveString(uint32_t idx) {
 	if (!_dex) {
 		throw DexLoaderException("No DEX file loaded");
 	}
+	if (idx < _strings.size()) [[likely]] {
+		if (const auto* str = _strings.get(idx)) {
+			return *str;
+		}
+	}
 
 	try {
 		const auto& strings = _dex->strings();
@@ -226,7 +258,7 @@ std::string Dex::resolveString(uint16_t idx) {
 
 		auto it = strings.begin();
 		std::advance(it, idx);
-		return *it;
+		return _strings.publish(idx, *it);
 	} catch (const std::exception& e) {
 		throw DexLoaderException(fmt::format("Failed to resolve string at index {}: {}", idx, e.what()));
 	}
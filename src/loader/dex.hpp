@@ -19,6 +19,7 @@
 #ifndef __DEX_LOADER_HPP__
 #define __DEX_LOADER_HPP__
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
@@ -34,7 +35,99 @@ namespace LIEF {
 namespace sandvik {
 	class ClassLoader;
 	class Class;
+	class Method;
+	class Field;
+	class Object;
 	enum class TYPES;
+	/** @brief Symbolic method reference of a dex file */
+	struct MethodRef {
+			/** class name of the method */
+			std::string classname;
+			/** method name */
+			std::string name;
+			/** method signature */
+			std::string signature;
+	};
+	/** @brief Runtime entities resolved from the ids of a dex file.
+	 *
+	 * Indexed by dex id and filled lazily by the class loader on first resolution. Entries are published with a release
+	 * store and read with an acquire load; threads resolving the same id concurrently store the same entity. String
+	 * objects are published with a compare and swap instead, so that a literal keeps a single identity.
+	 */
+	struct ResolutionCache {
+			/** resolved methods, by method id */
+			std::vector<std::atomic<Method*>> methods;
+			/** resolved vtable or interface methods used for dispatch, by method id */
+			std::vector<std::atomic<Method*>> virtualMethods;
+			/** resolved fields, by field id */
+			std::vector<std::atomic<Field*>> fields;
+			/** resolved classes, by type id */
+			std::vector<std::atomic<Class*>> classes;
+			/** String objects of the literals, by string id, visited as GC roots */
+			std::vector<std::atomic<Object*>> strings;
+	};
+	/** @brief Symbolic values decoded from the ids of a dex file, filled lazily.
+	 *
+	 * A value is decoded without lock and published with a compare and swap: the thread losing the race drops its copy
+	 * and uses the published one. A published value is never modified, references to it stay valid with the cache.
+	 */
+	template <typename T>
+	class SymbolCache {
+		public:
+			SymbolCache() = default;
+			~SymbolCache() {
+				clear();
+			}
+			SymbolCache(const SymbolCache&) = delete;
+			SymbolCache& operator=(const SymbolCache&) = delete;
+
+			/** @brief Drops the values and sizes the cache.
+			 * @param size_ number of ids
+			 */
+			void assign(size_t size_) {
+				clear();
+				_entries = std::make_unique<std::atomic<T*>[]>(size_);
+				_size = size_;
+			}
+			/** @brief Gets the published value of an id.
+			 * @param idx_ id, must be lower than the size of the cache
+			 * @return value, nullptr if not decoded yet
+			 */
+			inline const T* get(size_t idx_) const {
+				return _entries[idx_].load(std::memory_order_acquire);
+			}
+			/** @brief Publishes the value of an id, unless another thread did it first.
+			 * @param idx_ id, must be lower than the size of the cache
+			 * @param value_ decoded value
+			 * @return the published value
+			 */
+			const T& publish(size_t idx_, T value_) {
+				auto entry = std::make_unique<T>(std::move(value_));
+				T* expected = nullptr;
+				if (_entries[idx_].compare_exchange_strong(expected, entry.get(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+					return *entry.release();
+				}
+				return *expected;
+			}
+			/** @brief Gets the number of ids.
+			 * @return size of the cache
+			 */
+			inline size_t size() const {
+				return _size;
+			}
+
+		private:
+			void clear() {
+				for (size_t i = 0; i < _size; ++i) {
+					delete _entries[i].load(std::memory_order_relaxed);
+				}
+				_entries.reset();
+				_size = 0;
+			}
+
+			std::unique_ptr<std::atomic<T*>[]> _entries;
+			size_t _size = 0;
+	};
 	/**
 	 * @brief Dex file loader.
 	 *
@@ -92,44 +185,59 @@ namespace sandvik {
 			 * @return Unique pointer to the Class object if found, nullptr otherwise
 			 */
 			std::unique_ptr<Class> findClass(ClassLoader& classloader_, const std::string& name) const;
-			/** @brief Resolves a method by its index.
+			/** @brief Resolves a method by its index (cached).
 			 * @param idx Index of the method to resolve
-			 * @param class_ class name
-			 * @param method_ method name
-			 * @param sig_ method signature
+			 * @return method class name, name and signature
 			 */
-			void resolveMethod(uint16_t idx, std::string& class_, std::string& method_, std::string& sig_) const;
-			/** @brief Resolves a class by its index.
+			const MethodRef& resolveMethod(uint16_t idx);
+			/** @brief Resolves a class by its index (cached).
 			 * @param idx Index of the class to resolve
-			 * @param class_ class name
+			 * @return class name
 			 */
-			void resolveClass(uint16_t idx, std::string& class_) const;
+			const std::string& resolveClass(uint16_t idx);
 			/** @brief Resolves a field by its index.
 			 * @param idx Index of the field to resolve
 			 * @param class_ class name
 			 * @param field_ field name
 			 */
 			void resolveField(uint16_t idx, std::string& class_, std::string& field_) const;
-			/** @brief Resolves a type by its index.
+			/** @brief Resolves a type by its index (cached).
 			 * @param idx Index of the type to resolve
 			 * @param type_ Reference to the TYPES enum to store the resolved type
 			 * @return Resolved type as a string
 			 */
-			std::string resolveType(uint16_t idx, TYPES& type_);
-			/** @brief Resolves a string by its index.
+			const std::string& resolveType(uint16_t idx, TYPES& type_);
+			/** @brief Resolves a string by its index (cached).
 			 * @param idx Index of the string to resolve
 			 * @return Resolved string
 			 */
-			std::string resolveString(uint16_t idx);
+			const std::string& resolveString(uint32_t idx);
 			/** @brief Resolves an array type by its index.
 			 * @param idx Index of the array type to resolve
 			 * @return the resolved array type information (descriptor, dimension)
 			 */
 			std::vector<std::pair<std::string, uint32_t>> resolveArray(uint16_t idx);
 
+			/** @brief Gets the runtime entities resolved from this dex file.
+			 * @return Reference to the resolution cache
+			 */
+			inline ResolutionCache& getResolutionCache() {
+				return _resolved;
+			}
+
 		private:
+			/** size the resolution caches once the dex file is parsed */
+			void initCaches();
+
 			std::string _path;
 			std::unique_ptr<const LIEF::DEX::File> _dex;
+
+			/** symbolic resolution caches, indexed by dex id */
+			SymbolCache<MethodRef> _methodRefs;
+			SymbolCache<std::string> _classNames;
+			SymbolCache<std::pair<std::string, TYPES>> _types;
+			SymbolCache<std::string> _strings;
+			ResolutionCache _resolved;
 	};
 }  // namespace sandvik
 #endif  // __DEX_LOADER_HPP__
\ No newline at end of file
@@ -20,9 +20,13 @@
 
 #include <args.hxx>
 
+#include <algorithm>
+#include <string>
+
 #include "class.hpp"
 #include "classloader.hpp"
 #include "disassembler.hpp"
+#include "gc.hpp"
 #include "jni.hpp"
 #include "loader/apk.hpp"
 #include "loader/dex.hpp"
@@ -34,6 +38,30 @@
 
 using namespace sandvik;
 
+namespace {
+	/** parse a memory size with an optional k, m or g suffix, 0 if invalid */
+	uint64_t parseSize(const std::string& size_) {
+		size_t end = 0;
+		uint64_t value = 0;
+		try {
+			value = std::stoull(size_, &end);
+		} catch (const std::exception&) {
+			return 0;
+		}
+		const auto suffix = size_.substr(end);
+		if (suffix.empty()) {
+			return value;
+		} else if (suffix == "k" || suffix == "K") {
+			return value << 10;
+		} else if (suffix == "m" || suffix == "M") {
+			return value << 20;
+		} else if (suffix == "g" || suffix == "G") {
+			return value << 30;
+		}
+		return 0;
+	}
+}  // namespace
+
 int main(int argc, char** argv) {
 	args::ArgumentParser parser("sandvik", "Dalvik virtual machine");
 	args::HelpFlag help(parser, "help", "Display available options", {'h', "help"});
@@ -47,6 +75,12 @@ int main(int argc, char** argv) {
 	args::Flag displayThread(parser, "thread", "Display thread name in logs", {'t', "display-thread"});
 	args::Flag instructiontrace(parser, "instruction", "Instruction trace", {'i', "instructions"});
 	args::Flag calltrace(parser, "calltrace", "Call trace", {'c', "calltrace"});
+	args::Flag concurrentGc(parser, "concurrent-gc", "Mark the heap concurrently, stop the world only for root scanning and remark", {"concurrent-gc"});
+	args::ValueFlag<uint32_t> gcThreads(parser, "threads", "Number of garbage collector marking threads", {"gc-threads"}, 1);
+	args::ValueFlag<std::string> heapMin(parser, "size", "Initial and minimum heap size (e.g. 64m)", {"Xms"}, "");
+	args::ValueFlag<std::string> heapMax(parser, "size", "Maximum heap size (e.g. 1g)", {"Xmx"}, "");
+	args::ValueFlag<std::string> stackSize(parser, "size", "Stack size of each thread (e.g. 512k)", {"Xss"}, "");
+	args::ValueFlag<uint32_t> gcTargetPause(parser, "ms", "Pause time goal in milliseconds, the heap shrinks when it is exceeded", {"gc-target-pause"}, 0);
 	args::ValueFlagList<std::string> dexFiles(parser, "file", "Specify the DEX files to load", {"dex"});
 	args::ValueFlagList<std::string> jarFiles(parser, "file", "Specify the Jar files to load", {"jar"});
 	args::ValueFlag<std::string> apkFile(parser, "file", "Specify the APK file to load", {"apk"}, "");
@@ -111,6 +145,19 @@ int main(int argc, char** argv) {
 
 	trace.enableInstructionTrace(args::get(instructiontrace));
 	trace.enableCallTrace(args::get(calltrace));
+	GC::getInstance().setConcurrent(args::get(concurrentGc));
+	GC::getInstance().setMarkThreads(args::get(gcThreads));
+	GC::getInstance().setTargetPause(static_cast<uint64_t>(args::get(gcTargetPause)) * 1000);
+	{
+		auto minHeap = heapMin ? parseSize(args::get(heapMin)) : GC::DEFAULT_MIN_HEAP_SIZE;
+		auto maxHeap = heapMax ? parseSize(args::get(heapMax)) : std::max(GC::DEFAULT_MAX_HEAP_SIZE, minHeap);
+		if (minHeap == 0 || maxHeap == 0 || minHeap > maxHeap) {
+			std::cerr << "Invalid heap size: --Xms " << args::get(heapMin) << " --Xmx " << args::get(heapMax) << std::endl << std::endl;
+			std::cerr << parser;
+			return 1;
+		}
+		GC::getInstance().setHeapSize(minHeap, maxHeap);
+	}
 
 	if (args::get(mainClass).empty() && args::get(apkFile).empty()) {
 		std::cerr << "Main class not specified" << std::endl << std::endl;
@@ -118,7 +165,15 @@ int main(int argc, char** argv) {
 		return 1;
 	}
 
+	auto threadStackSize = stackSize ? parseSize(args::get(stackSize)) : Vm::DEFAULT_STACK_SIZE;
+	if (threadStackSize == 0) {
+		std::cerr << "Invalid stack size: --Xss " << args::get(stackSize) << std::endl << std::endl;
+		std::cerr << parser;
+		return 1;
+	}
+
 	Vm vm;
+	vm.setStackSize(threadStackSize);
 	// load runtime
 	vm.loadRt(args::get(runTime));
 	// load dex files
@@ -0,0 +1,158 @@
+/*
+ * This file is part of Sandvik project.
+ * Copyright (C) 2025 Christophe Duvernois
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "marker.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#include "object.hpp"
+
+using namespace sandvik;
+
+Marker::Marker() {
+	setThreadCount(1);
+}
+
+void Marker::setThreadCount(uint32_t threads_) {
+	_workers.clear();
+	for (uint32_t i = 0; i < std::max(threads_, 1u); ++i) {
+		_workers.push_back(std::make_unique<Worker>());
+	}
+}
+
+uint32_t Marker::getThreadCount() const {
+	return static_cast<uint32_t>(_workers.size());
+}
+
+void Marker::grey(Object* obj_) {
+	if (obj_ && obj_->mark()) {
+		_roots.push_back(obj_);
+	}
+}
+
+void Marker::shade(Object* obj_) {
+	if (obj_ && obj_->mark()) {
+		std::lock_guard<std::mutex> lock(_barrierMutex);
+		_barrier.push_back(obj_);
+		_barrierSize.store(_barrier.size(), std::memory_order_release);
+	}
+}
+
+uint64_t Marker::drain() {
+	// deal the roots out to the workers
+	for (size_t i = 0; i < _roots.size(); ++i) {
+		_workers[i % _workers.size()]->local.push_back(_roots[i]);
+	}
+	_roots.clear();
+	_idle.store(0);
+	_visited.store(0);
+	std::vector<std::thread> threads;
+	for (uint32_t i = 1; i < _workers.size(); ++i) {
+		threads.emplace_back(&Marker::work, this, i);
+	}
+	work(0);
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	return _visited.load();
+}
+
+void Marker::work(uint32_t index_) {
+	auto& self = *_workers[index_];
+	const std::function<void(Object*)> visitor = [&self](Object* obj) {
+		if (obj && obj->mark()) {
+			self.local.push_back(obj);
+		}
+	};
+	uint64_t visited = 0;
+	while (true) {
+		while (!self.local.empty()) {
+			auto* obj = self.local.back();
+			self.local.pop_back();
+			obj->visitReferences(visitor);
+			++visited;
+			if (self.local.size() > SHARE_THRESHOLD && self.sharedSize.load(std::memory_order_relaxed) == 0) {
+				share(self);
+			}
+		}
+		if (refill(index_)) {
+			continue;
+		}
+		// idle: the trace is over once every worker is idle, a worker only publishes objects while it is busy
+		_idle.fetch_add(1);
+		bool resumed = false;
+		while (_idle.load() < _workers.size()) {
+			if (hasWork()) {
+				_idle.fetch_sub(1);
+				resumed = true;
+				break;
+			}
+			std::this_thread::yield();
+		}
+		if (!resumed) {
+			break;
+		}
+	}
+	_visited.fetch_add(visited);
+}
+
+void Marker::share(Worker& worker_) {
+	const auto half = worker_.local.size() / 2;
+	std::lock_guard<std::mutex> lock(worker_.mutex);
+	worker_.shared.insert(worker_.shared.end(), worker_.local.begin(), worker_.local.begin() + half);
+	worker_.local.erase(worker_.local.begin(), worker_.local.begin() + half);
+	worker_.sharedSize.store(worker_.shared.size(), std::memory_order_release);
+}
+
+bool Marker::refill(uint32_t index_) {
+	auto& self = *_workers[index_];
+	// take back the own shared stack, then steal half of another one
+	for (size_t i = 0; i < _workers.size(); ++i) {
+		auto& victim = *_workers[(index_ + i) % _workers.size()];
+		if (victim.sharedSize.load(std::memory_order_acquire) == 0) {
+			continue;
+		}
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (victim.shared.empty()) {
+			continue;
+		}
+		const auto count = &victim == &self ? victim.shared.size() : (victim.shared.size() + 1) / 2;
+		self.local.insert(self.local.end(), victim.shared.end() - count, victim.shared.end());
+		victim.shared.resize(victim.shared.size() - count);
+		victim.sharedSize.store(victim.shared.size(), std::memory_order_release);
+		return true;
+	}
+	if (_barrierSize.load(std::memory_order_acquire) != 0) {
+		std::lock_guard<std::mutex> lock(_barrierMutex);
+		if (!_barrier.empty()) {
+			std::swap(self.local, _barrier);
+			_barrierSize.store(0, std::memory_order_release);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool Marker::hasWork() const {
+	if (_barrierSize.load(std::memory_order_acquire) != 0) {
+		return true;
+	}
+	return std::ranges::any_of(_workers, [](const auto& worker_) { return worker_->sharedSize.load(std::memory_order_acquire) != 0; });
+}
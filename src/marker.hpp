@@ -0,0 +1,98 @@
+/*
+ * This file is part of Sandvik project.
+ * Copyright (C) 2025 Christophe Duvernois
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __MARKER_HPP__
+#define __MARKER_HPP__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sandvik {
+	class Object;
+	/**
+	 * @class Marker
+	 * @brief Parallel marking engine of the garbage collector.
+	 *
+	 * Traces the object graph from grey objects with an explicit mark stack per worker thread, so deep graphs do not
+	 * recurse on the native stack. Marks are set atomically (Object::mark), an object is visited by the worker which
+	 * marked it. A worker keeps its stack private and publishes part of it in a shared stack when it grows; idle
+	 * workers steal half of a shared stack. The trace ends when all workers are idle and no shared stack is left.
+	 */
+	class Marker {
+		public:
+			/** a worker publishes half of its stack beyond this size */
+			static constexpr size_t SHARE_THRESHOLD = 64;
+
+			Marker();
+			Marker(const Marker&) = delete;
+			Marker& operator=(const Marker&) = delete;
+
+			/** @brief Sets the number of marking threads, the calling thread being one of them. Must not be called during a drain.
+			 * @param threads_ thread count, at least 1
+			 */
+			void setThreadCount(uint32_t threads_);
+			/** @brief Gets the number of marking threads.
+			 * @return thread count
+			 */
+			uint32_t getThreadCount() const;
+
+			/** @brief Marks a root and queues it for the next drain. Must not be called during a drain.
+			 * @param obj_ root object, may be null
+			 */
+			void grey(Object* obj_);
+			/** @brief Marks an object stored by a running thread and queues it, can be called during a drain.
+			 * @param obj_ object, may be null
+			 */
+			void shade(Object* obj_);
+			/** @brief Traces the queued objects until everything reachable from them is marked.
+			 * @return number of objects visited
+			 */
+			uint64_t drain();
+
+		private:
+			struct Worker {
+					/** private mark stack */
+					std::vector<Object*> local;
+					/** stack other workers can steal from */
+					std::mutex mutex;
+					std::vector<Object*> shared;
+					std::atomic<size_t> sharedSize = 0;
+			};
+			void work(uint32_t index_);
+			/** move the oldest half of the private stack to the shared stack */
+			void share(Worker& worker_);
+			/** refill an empty private stack from its shared stack, another worker or the barrier buffer */
+			bool refill(uint32_t index_);
+			/** check if an idle worker could find objects to visit */
+			bool hasWork() const;
+
+			std::vector<std::unique_ptr<Worker>> _workers;
+			std::vector<Object*> _roots;
+			std::atomic<uint32_t> _idle = 0;
+			std::atomic<uint64_t> _visited = 0;
+			/** objects shaded by the write barrier */
+			std::mutex _barrierMutex;
+			std::vector<Object*> _barrier;
+			std::atomic<size_t> _barrierSize = 0;
+	};
+}  // namespace sandvik
+
+#endif  // __MARKER_HPP__
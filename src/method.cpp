@@ -18,25 +18,30 @@
 
 #include "method.hpp"
 
+#include <fmt/format.h>
+
 #include <LIEF/DEX/CodeInfo.hpp>
 #include <LIEF/DEX/Method.hpp>
 #include <LIEF/DEX/enums.hpp>
+#include <algorithm>
 #include <sstream>
 
 #include "class.hpp"
 #include "exceptions.hpp"
 #include "frame.hpp"
+#include "native_call.hpp"
 #include "system/logger.hpp"
 #include "utils.hpp"
 
 using namespace sandvik;
 
 Method::Method(Class& class_, const std::string& name_, const std::string& signature_, uint32_t index_)
-    : _class(class_), _name(name_), _signature(signature_), _index(index_) {
+    : _class(class_), _name(name_), _signature(signature_), _fullname(fmt::format("{}::{}{}", class_.getFullname(), name_, signature_)), _index(index_) {
 	parseArgumentTypes();
 }
 
-Method::Method(Class& class_, const LIEF::DEX::Method& method_) : _class(class_), _name(method_.name()), _signature(get_method_descriptor(method_)) {
+Method::Method(Class& class_, const LIEF::DEX::Method& method_)
+    : _class(class_), _name(method_.name()), _signature(get_method_descriptor(method_)), _fullname(fmt::format("{}::{}{}", class_.getFullname(), _name, _signature)) {
 	_nbRegisters = method_.code_info().nb_registers();
 	_index = method_.index();
 	_bytecode = method_.bytecode();
@@ -49,11 +54,14 @@ Method::Method(Class& class_, const LIEF::DEX::Method& method_) : _class(class_)
 	_isVirtual = method_.is_virtual();
 
 	for (const auto& exc : method_.code_info().exceptions()) {
-		_trycatch_items.push_back({exc.start_addr, exc.insn_count, exc.handlers, exc.catch_all_addr});
+		_tryRanges.push_back({exc.start_addr, exc.start_addr + exc.insn_count, exc.handlers, exc.catch_all_addr});
 	}
+	std::sort(_tryRanges.begin(), _tryRanges.end(), [](const TryRange& a_, const TryRange& b_) { return a_.start < b_.start; });
 	parseArgumentTypes();
 }
 
+Method::~Method() = default;
+
 void Method::parseArgumentTypes() {
 	_argsType.clear();
 	auto start = _signature.find('(');
@@ -91,7 +99,7 @@ void Method::parseArgumentTypes() {
 Class& Method::getClass() const {
 	return _class;
 }
-std::string Method::getName() const {
+const std::string& Method::getName() const {
 	return _name;
 }
 
@@ -99,10 +107,14 @@ uint32_t Method::getNbArguments() const {
 	return static_cast<uint32_t>(_argsType.size());
 }
 
-std::string Method::getSignature() const {
+const std::string& Method::getSignature() const {
 	return _signature;
 }
 
+std::string_view Method::getFullname() const {
+	return _fullname;
+}
+
 uint32_t Method::getNbRegisters() const {
 	return _nbRegisters;
 }
@@ -111,18 +123,15 @@ uint32_t Method::getIndex() const {
 	return _index;
 }
 
-std::vector<std::pair<uint32_t, uint32_t>> Method::getExceptionHandler(uint16_t pc_, uint32_t& catchAllAddr_) const {
-	uint16_t pc = pc_ >> 1;
-	logger.fdebug("getExceptionHandler: pc={:x} size={}", pc, _trycatch_items.size());
-	for (const auto& exc : _trycatch_items) {
-		logger.fdebug("{}: Exception handler: start_addr: {:x}, insn_count: {:x}, catch_all_addr: {:x}", getName(), exc.start_addr, exc.insn_count,
-		              exc.catch_all_addr);
-		if (pc >= exc.start_addr && pc < exc.start_addr + exc.insn_count) {
-			catchAllAddr_ = exc.catch_all_addr;
-			return exc.handlers;
-		}
+const Method::TryRange* Method::findTryRange(uint32_t pc_) const {
+	// try blocks are expressed in 16-bit code units
+	uint32_t pc = pc_ >> 1;
+	auto it = std::upper_bound(_tryRanges.begin(), _tryRanges.end(), pc, [](uint32_t value_, const TryRange& range_) { return value_ < range_.start; });
+	if (it == _tryRanges.begin()) {
+		return nullptr;
 	}
-	throw VmException("No exception handler found for pc: {}", pc_);
+	--it;
+	return pc < it->end ? &*it : nullptr;
 }
 
 bool Method::hasBytecode() const {
@@ -173,6 +182,44 @@ bool Method::isVirtual() const {
 	return _isVirtual;
 }
 
+InlineCache& Method::createInlineCache(uint32_t pc_) {
+	std::lock_guard<std::mutex> lock(_inlineCacheMutex);
+	const auto codeUnits = (_bytecode.size() + 1) / 2;
+	if (pc_ >= codeUnits) {
+		throw VmException("Method {}: no call site at code unit {}", _fullname, pc_);
+	}
+	if (!_inlineCacheTable) {
+		_inlineCacheTable = std::make_unique<std::atomic<InlineCache*>[]>(codeUnits);
+		_inlineCacheSlots.store(_inlineCacheTable.get(), std::memory_order_release);
+	}
+	auto& slot = _inlineCacheTable[pc_];
+	if (auto* cache = slot.load(std::memory_order_relaxed)) {
+		return *cache;
+	}
+	auto& cache = _inlineCaches[pc_];
+	cache = std::make_unique<InlineCache>();
+	slot.store(cache.get(), std::memory_order_release);
+	return *cache;
+}
+
+const NativeBinding& Method::setNativeBinding(std::unique_ptr<NativeBinding> binding_) const {
+	NativeBinding* expected = nullptr;
+	auto* binding = binding_.get();
+	if (_nativeBinding.compare_exchange_strong(expected, binding, std::memory_order_acq_rel)) {
+		_nativeBindingStorage = std::move(binding_);
+		return *binding;
+	}
+	// another thread bound the method first
+	return *expected;
+}
+
+void Method::visitInlineCaches(const std::function<void(uint32_t, const InlineCache&)>& visitor_) const {
+	std::lock_guard<std::mutex> lock(_inlineCacheMutex);
+	for (const auto& [pc, cache] : _inlineCaches) {
+		visitor_(pc, *cache);
+	}
+}
+
 bool Method::isOverload() const {
 	return _class.isMethodOverloaded(getName());
 }
@@ -19,12 +19,17 @@
 #ifndef __METHOD_HPP__
 #define __METHOD_HPP__
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "inlinecache.hpp"
 #include "object.hpp"
 
 namespace LIEF {
@@ -36,6 +41,7 @@ namespace LIEF {
 namespace sandvik {
 	class Frame;
 	class Class;
+	struct NativeBinding;
 	/** @brief Access flags for methods. */
 	enum ACCESS_FLAGS {
 		ACC_UNKNOWN = 0x0,
@@ -74,7 +80,7 @@ namespace sandvik {
 			 * @param method_ Reference to the LIEF DEX Method object.
 			 */
 			Method(Class& class_, const LIEF::DEX::Method& method_);
-			virtual ~Method() = default;
+			virtual ~Method();
 
 			/** @brief Gets the class of the method.
 			 * @return Reference to the Class object.
@@ -83,11 +89,15 @@ namespace sandvik {
 			/** @brief Gets the name of the method.
 			 * @return Name of the method.
 			 */
-			std::string getName() const;
+			const std::string& getName() const;
 			/** @brief Gets the signature of the method.
 			 * @return Signature of the method.
 			 */
-			std::string getSignature() const;
+			const std::string& getSignature() const;
+			/** @brief Gets the display name of the method (class::name signature), computed once at creation.
+			 * @return Full name of the method.
+			 */
+			std::string_view getFullname() const;
 			/** @brief Gets the number of arguments of the method.
 			 * @return Number of arguments.
 			 */
@@ -112,12 +122,30 @@ namespace sandvik {
 			 * @return Index of the method.
 			 */
 			uint32_t getIndex() const;
-			/** @brief Gets the exception handler for the specified program counter.
-			 * @param pc_ Program counter.
-			 * @param catchAllAddr_ Reference to store the catch-all address.
-			 * @return Vector of pairs representing the exception handlers (type_idx, handler_offset).
+			/** @brief Gets the vtable index of a virtual method, assigned when its class is linked.
+			 * For an interface method, the index is in the method table of its interface.
+			 * @return vtable index, NO_VTABLE_INDEX if the method is not in a vtable.
+			 */
+			inline uint32_t getVtableIndex() const {
+				return _vtableIndex;
+			}
+			/** vtable index of a method which is not dispatched through a vtable */
+			static constexpr uint32_t NO_VTABLE_INDEX = UINT32_MAX;
+			/** @brief Try block of the method, code units in [start, end) are protected by its handlers */
+			struct TryRange {
+					uint32_t start;
+					uint32_t end;
+					/** type_idx, handler address */
+					std::vector<std::pair<uint32_t, uint32_t>> handlers;
+					/** catch all handler address, 0 if none */
+					uint32_t catchAll;
+			};
+			/** @brief Finds the try block protecting the specified program counter.
+			 * Try blocks are sorted when the method is loaded, the lookup is a binary search.
+			 * @param pc_ Program counter (offset in the bytecode).
+			 * @return Try block, nullptr if the program counter is not protected.
 			 */
-			std::vector<std::pair<uint32_t, uint32_t>> getExceptionHandler(uint16_t pc_, uint32_t& catchAllAddr_) const;
+			const TryRange* findTryRange(uint32_t pc_) const;
 
 			/** @brief Checks if the method has bytecode.
 			 * @return True if the method has bytecode, false otherwise.
@@ -183,34 +211,85 @@ namespace sandvik {
 			 */
 			void execute(Frame& frame_, std::vector<ObjectRef>& registers_);
 
+			/** @brief Gets the inline cache of an invoke instruction of the method, created on first use.
+			 * @param pc_ Code unit index of the invoke instruction.
+			 * @return Reference to the inline cache of the call site.
+			 */
+			inline InlineCache& getInlineCache(uint32_t pc_) {
+				if (auto* slots = _inlineCacheSlots.load(std::memory_order_acquire)) [[likely]] {
+					if (auto* cache = slots[pc_].load(std::memory_order_acquire)) [[likely]] {
+						return *cache;
+					}
+				}
+				return createInlineCache(pc_);
+			}
+			/** @brief Visits the inline caches of the method.
+			 * @param visitor_ Function called with the code unit index of each call site and its inline cache.
+			 */
+			void visitInlineCaches(const std::function<void(uint32_t, const InlineCache&)>& visitor_) const;
+
+			/** @brief Gets the native function registered for the method (JNI RegisterNatives).
+			 * @return Function pointer, nullptr if none was registered.
+			 */
+			inline void* getRegisteredNative() const {
+				return _registeredNative.load(std::memory_order_acquire);
+			}
+			/** @brief Registers the native function of a native method, used when the method is bound on its first call.
+			 * @param function_ Native function.
+			 */
+			inline void registerNative(void* function_) {
+				_registeredNative.store(function_, std::memory_order_release);
+			}
+			/** @brief Gets the native binding of a native method.
+			 * @return Binding resolved on the first call, nullptr before.
+			 */
+			inline const NativeBinding* getNativeBinding() const {
+				return _nativeBinding.load(std::memory_order_acquire);
+			}
+			/** @brief Sets the native binding of a native method, the first binding set is kept.
+			 * @param binding_ Resolved native function and its prepared call interface.
+			 * @return Reference to the binding of the method.
+			 */
+			const NativeBinding& setNativeBinding(std::unique_ptr<NativeBinding> binding_) const;
+
 			/** @brief Debug method to print method information. */
 			void debug() const;
 
 		private:
 			void parseArgumentTypes();
+			InlineCache& createInlineCache(uint32_t pc_);
 
 			Class& _class;
 			std::string _name;
 			std::string _signature;
+			std::string _fullname;
 			uint32_t _index;
 			uint32_t _nbRegisters = 0;
 			std::vector<uint8_t> _bytecode;
 			uint64_t _accessFlags = 0;
 			bool _isVirtual = false;
+			uint32_t _vtableIndex = NO_VTABLE_INDEX;
 
-			struct trycatch_item {
-					uint32_t start_addr;
-					uint32_t insn_count;
-					// holds type_idx, handler_offset
-					std::vector<std::pair<uint32_t, uint32_t>> handlers;
-					uint32_t catch_all_addr;
-			};
-			std::vector<trycatch_item> _trycatch_items;
+			/** try blocks sorted by start address */
+			std::vector<TryRange> _tryRanges;
 			std::vector<std::string> _argsType;
 
 			std::function<void(Frame&, std::vector<ObjectRef>&)> _function;
 
+			/** inline caches of the call sites, the slot table indexed by code unit gives lock free lookups */
+			std::atomic<std::atomic<InlineCache*>*> _inlineCacheSlots = nullptr;
+			std::unique_ptr<std::atomic<InlineCache*>[]> _inlineCacheTable;
+			std::map<uint32_t, std::unique_ptr<InlineCache>> _inlineCaches;
+			mutable std::mutex _inlineCacheMutex;
+
+			/** native function registered through JNI */
+			std::atomic<void*> _registeredNative = nullptr;
+			/** native binding, set once by the first call of a native method */
+			mutable std::atomic<NativeBinding*> _nativeBinding = nullptr;
+			mutable std::unique_ptr<NativeBinding> _nativeBindingStorage;
+
 			friend class ClassBuilder;
+			friend class Class;
 	};
 }  // namespace sandvik
 
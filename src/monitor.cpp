@@ -22,7 +22,7 @@ using namespace sandvik;
 
 void Monitor::enter() {
 	std::unique_lock lock(_mutex);
-	auto self = std::this_thread::get_id();
+	auto self = currentThreadId();
 
 	// Reentrant acquire
 	if (_owner == self) {
@@ -31,7 +31,7 @@ void Monitor::enter() {
 	}
 
 	// Wait until monitor is free
-	_condition.wait(lock, [this]() { return _owner == std::thread::id(); });
+	_condition.wait(lock, [this]() { return _owner == NO_OWNER; });
 
 	_owner = self;
 	_recursion = 1;
@@ -39,7 +39,7 @@ void Monitor::enter() {
 
 void Monitor::exit() {
 	std::unique_lock lock(_mutex);
-	auto self = std::this_thread::get_id();
+	auto self = currentThreadId();
 
 	if (_owner != self) {
 		throw std::runtime_error("IllegalMonitorStateException: current thread does not own the monitor");
@@ -48,7 +48,7 @@ void Monitor::exit() {
 	_recursion--;
 
 	if (_recursion == 0) {
-		_owner = std::thread::id();
+		_owner = NO_OWNER;
 		_condition.notify_one();
 	}
 }
@@ -59,7 +59,7 @@ void Monitor::check() const {
 	while (true) {
 		{
 			std::unique_lock lock(_mutex);
-			if (_owner == std::thread::id() || _owner == std::this_thread::get_id()) {
+			if (_owner == NO_OWNER || _owner == currentThreadId()) {
 				return;
 			}
 		}
@@ -70,7 +70,7 @@ void Monitor::check() const {
 
 bool Monitor::wait(uint64_t timeout_ms) {
 	std::unique_lock<std::mutex> lock(_mutex);
-	auto self = std::this_thread::get_id();
+	auto self = currentThreadId();
 
 	// must own the monitor
 	if (_owner != self) {
@@ -81,7 +81,7 @@ bool Monitor::wait(uint64_t timeout_ms) {
 	uint32_t saved_recursion = _recursion;
 
 	// fully release the monitor
-	_owner = std::thread::id();
+	_owner = NO_OWNER;
 	_recursion = 0;
 
 	// wake one entering thread (entry set)
@@ -98,7 +98,7 @@ bool Monitor::wait(uint64_t timeout_ms) {
 	}
 
 	// re-acquire the monitor (entry set)
-	_condition.wait(lock, [this]() { return _owner == std::thread::id(); });
+	_condition.wait(lock, [this]() { return _owner == NO_OWNER; });
 
 	// restore ownership + recursion
 	_owner = self;
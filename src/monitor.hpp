@@ -19,7 +19,9 @@
 #ifndef __MONITOR_HPP__
 #define __MONITOR_HPP__
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
 #include <thread>
 
@@ -31,6 +33,12 @@ namespace sandvik {
 	class Monitor {
 		public:
 			Monitor() = default;
+			/** @brief Creates a monitor already owned by a thread (inflation of a thin lock).
+			 * @param owner_ id of the owner thread (see currentThreadId)
+			 * @param recursion_ number of times the owner entered the monitor
+			 */
+			Monitor(uint32_t owner_, uint32_t recursion_) : _owner(owner_), _recursion(recursion_) {
+			}
 			virtual ~Monitor() = default;
 
 			Monitor(const Monitor&) = delete;
@@ -60,11 +68,22 @@ namespace sandvik {
 			/** @brief Wakes up all threads that are waiting on this monitor. */
 			void notifyAll();
 
+			/** @brief Gets the id of the calling thread, a small non zero integer used as lock owner.
+			 * @return thread id
+			 */
+			static inline uint32_t currentThreadId() {
+				static std::atomic<uint32_t> next{1};
+				thread_local const uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+				return id;
+			}
+			/** id of no thread */
+			static constexpr uint32_t NO_OWNER = 0;
+
 		private:
 			mutable std::mutex _mutex;
 			std::condition_variable _condition;       // used for monitor-enter/exit coordination
 			std::condition_variable _wait_condition;  // used for wait/notify
-			std::thread::id _owner;                   // Tracks the thread that owns the monitor
+			uint32_t _owner = NO_OWNER;               // Tracks the thread that owns the monitor
 			uint32_t _recursion = 0;
 	};
 }  // namespace sandvik
@@ -91,3 +91,12 @@ extern "C" {
 		__PrintStream__write(fd, s + "\n");
 	}
 }
+
+namespace {
+	const sandvik::native::Registration registration("java.io.PrintStream", {
+		{"print", "(Ljava/lang/String;)V", (void*)&Java_java_io_PrintStream_print__Ljava_lang_String_2},
+		{"println", "(Ljava/lang/String;)V", (void*)&Java_java_io_PrintStream_println__Ljava_lang_String_2},
+		{"println", "()V", (void*)&Java_java_io_PrintStream_println__},
+		{"println", "(Ljava/lang/Object;)V", (void*)&Java_java_io_PrintStream_println__Ljava_lang_Object_2},
+	});
+}  // namespace
@@ -44,7 +44,7 @@ extern "C" {
 		auto objstr = sandvik::native::getString(name);
 		auto& classloader = jenv->getClassLoader();
 		auto& objclass = classloader.getOrLoad(objstr->str());
-		logger.debug(fmt::format("Class.forName: Loaded class {}", objclass.getFullname()));
+		LOG_DEBUG("Class.forName: Loaded class {}", objclass.getFullname());
 		auto& clazz = classloader.getOrLoad("java/lang/Class");
 		auto classObj = sandvik::Object::make(clazz);
 		classObj->setField("internal", sandvik::Object::make(objclass));
@@ -57,7 +57,7 @@ extern "C" {
 		auto& classloader = jenv->getClassLoader();
 
 		auto internalClass = classObj->getField("internal");
-		logger.debug(fmt::format("Class.getDeclaredConstructor: Getting constructor for class {}", internalClass->toString()));
+		LOG_DEBUG("Class.getDeclaredConstructor: Getting constructor for class {}", internalClass->toString());
 
 		// Create a java.lang.reflect.Constructor object
 		auto& ctorClass = classloader.getOrLoad("java/lang/reflect/Constructor");
@@ -78,12 +78,12 @@ extern "C" {
 		std::string fieldName = fieldNameObj->str();
 
 		auto& classloader = jenv->getClassLoader();
-		logger.debug(fmt::format("Class.getField: Getting field '{}' for class {}", fieldName, ptr->toString()));
+		LOG_DEBUG("Class.getField: Getting field '{}' for class {}", fieldName, ptr->toString());
 
 		try {
 			ptr->getField(fieldName);
 		} catch (const std::exception& e) {
-			logger.debug(fmt::format("{} Class.getField: Created missing field '{}' in class {}", e.what(), fieldName, ptr->toString()));
+			LOG_DEBUG("{} Class.getField: Created missing field '{}' in class {}", e.what(), fieldName, ptr->toString());
 			ptr->setField(fieldName, sandvik::Object::make(0));
 		}
 
@@ -104,11 +104,21 @@ extern "C" {
 		std::string primName = nameObj->str();
 
 		auto& classloader = jenv->getClassLoader();
-		logger.debug(fmt::format("Class.getPrimitiveClass: looking up primitive '{}'", primName));
+		LOG_DEBUG("Class.getPrimitiveClass: looking up primitive '{}'", primName);
 
 		// Obtain the internal class representation and wrap it in a java.lang.Class instance.
 		auto& primClass = classloader.getOrLoad(primName);
 		auto classObj = sandvik::Object::makeConstClass(classloader, primClass);
 		return (jobject)classObj;
 	}
-}
\ No newline at end of file
+}
+
+namespace {
+	const sandvik::native::Registration registration("java.lang.Class", {
+		{"getName", "()Ljava/lang/String;", (void*)&Java_java_lang_Class_getName},
+		{"forName", "(Ljava/lang/String;)Ljava/lang/Class;", (void*)&Java_java_lang_Class_forName},
+		{"getDeclaredConstructor", "([Ljava/lang/Class;)Ljava/lang/reflect/Constructor;", (void*)&Java_java_lang_Class_getDeclaredConstructor},
+		{"getField", "(Ljava/lang/String;)Ljava/lang/reflect/Field;", (void*)&Java_java_lang_Class_getField},
+		{"getPrimitiveClass", "(Ljava/lang/String;)Ljava/lang/Class;", (void*)&Java_java_lang_Class_getPrimitiveClass},
+	});
+}  // namespace
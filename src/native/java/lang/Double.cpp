@@ -22,6 +22,7 @@
 #include "class.hpp"
 #include "field.hpp"
 #include "jni.hpp"
+#include "native_utils.hpp"
 #include "object.hpp"
 #include "system/logger.hpp"
 
@@ -37,4 +38,12 @@ extern "C" {
 		// Convert the raw long bit representation to a double value
 		return std::bit_cast<jdouble>(value);
 	}
-}
\ No newline at end of file
+}
+
+namespace {
+	const sandvik::native::Registration registration("java.lang.Double", {
+		{"isNaN", "(D)Z", (void*)&Java_java_lang_Double_isNaN__D},
+		{"doubleToRawLongBits", "(D)J", (void*)&Java_java_lang_Double_doubleToRawLongBits},
+		{"longBitsToDouble", "(J)D", (void*)&Java_java_lang_Double_longBitsToDouble},
+	});
+}  // namespace
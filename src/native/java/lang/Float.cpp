@@ -22,6 +22,7 @@
 #include "class.hpp"
 #include "field.hpp"
 #include "jni.hpp"
+#include "native_utils.hpp"
 #include "object.hpp"
 #include "system/logger.hpp"
 
@@ -30,4 +31,10 @@ extern "C" {
 		// Convert the float value to its raw integer bit representation
 		return std::bit_cast<jint>(value);
 	}
-}
\ No newline at end of file
+}
+
+namespace {
+	const sandvik::native::Registration registration("java.lang.Float", {
+		{"floatToRawIntBits", "(F)I", (void*)&Java_java_lang_Float_floatToRawIntBits},
+	});
+}  // namespace
@@ -38,4 +38,10 @@ extern "C" {
 			throw sandvik::NumberFormatException(fmt::format("Failed to parse '{}' to integer value with radix {}: {}", objstr->str(), radix, e.what()));
 		}
 	}
-}
\ No newline at end of file
+}
+
+namespace {
+	const sandvik::native::Registration registration("java.lang.Integer", {
+		{"parseInt", "(Ljava/lang/String;I)I", (void*)&Java_java_lang_Integer_parseInt__Ljava_lang_String_2I},
+	});
+}  // namespace
@@ -81,3 +81,14 @@ extern "C" {
 		this_ptr->wait(static_cast<uint64_t>(timeout));
 	}
 }
+
+namespace {
+	const sandvik::native::Registration registration("java.lang.Object", {
+		{"registerNatives", "()V", (void*)&Java_java_lang_Object_registerNatives},
+		{"clone", "()Ljava/lang/Object;", (void*)&Java_java_lang_Object_clone},
+		{"getClass", "()Ljava/lang/Class;", (void*)&Java_java_lang_Object_getClass},
+		{"notify", "()V", (void*)&Java_java_lang_Object_notify},
+		{"notifyAll", "()V", (void*)&Java_java_lang_Object_notifyAll},
+		{"wait", "(J)V", (void*)&Java_java_lang_Object_wait__J},
+	});
+}  // namespace
@@ -19,6 +19,8 @@
 #include <fmt/format.h>
 #include <jni/jni.h>
 
+#include <algorithm>
+
 #include "array.hpp"
 #include "class.hpp"
 #include "classloader.hpp"
@@ -33,42 +35,87 @@ extern "C" {
 	JNIEXPORT void JNICALL Java_java_lang_String_initialize__Ljava_lang_String_2(JNIEnv* env, jobject obj, jobject other) {
 		auto this_ptr = sandvik::native::getString(obj);
 		auto other_ptr = sandvik::native::getString(other);
-		this_ptr->setString(this_ptr->str() + other_ptr->str());
+		auto this_chars = this_ptr->chars();
+		if (this_chars.size() == 0) {
+			this_ptr->setString(other_ptr->chars());
+		} else {
+			auto joined = this_ptr->str16() + other_ptr->str16();
+			this_ptr->setString(sandvik::StringChars{{}, joined});
+		}
 	}
 
 	JNIEXPORT jboolean JNICALL Java_java_lang_String_equals(JNIEnv* env, jobject obj, jobject other) {
 		auto this_ptr = sandvik::native::getString(obj);
-		auto other_ptr = sandvik::native::getString(other);
-		// Get the actual string values
-		auto this_str = this_ptr->str();
-		auto other_str = other_ptr->str();
-		// Compare the strings for equality
-		return this_str == other_str ? JNI_TRUE : JNI_FALSE;
+		auto other_ptr = (sandvik::Object*)other;
+		if (other_ptr == nullptr || !other_ptr->isString()) {
+			return JNI_FALSE;
+		}
+		return *this_ptr == *other_ptr ? JNI_TRUE : JNI_FALSE;
 	}
 
 	JNIEXPORT jobject JNICALL Java_java_lang_String_substring__I(JNIEnv* env, jobject obj, jint beginIndex) {
 		auto jenv = sandvik::native::getNativeInterface(env);
 		sandvik::ClassLoader& classloader = jenv->getClassLoader();
-		auto this_ptr = sandvik::native::getString(obj);
-		auto str = this_ptr->str();
+		auto chars = sandvik::native::getString(obj)->chars();
 
-		if (beginIndex < 0 || static_cast<size_t>(beginIndex) > str.size()) {
+		if (beginIndex < 0 || static_cast<size_t>(beginIndex) > chars.size()) {
 			throw sandvik::StringIndexOutOfBoundsException("beginIndex out of range");
 		}
+		if (beginIndex == 0) {
+			return obj;
+		}
+		return (jobject)sandvik::Object::makeString(classloader, chars.substr(beginIndex, chars.size() - beginIndex));
+	}
 
-		auto substr = str.substr(beginIndex);
-		auto strObj = sandvik::Object::make(classloader, substr);
-		return (jobject)strObj;
+	JNIEXPORT jobject JNICALL Java_java_lang_String_substring__II(JNIEnv* env, jobject obj, jint beginIndex, jint endIndex) {
+		auto jenv = sandvik::native::getNativeInterface(env);
+		sandvik::ClassLoader& classloader = jenv->getClassLoader();
+		auto chars = sandvik::native::getString(obj)->chars();
+		auto len = static_cast<jint>(chars.size());
+
+		if (beginIndex < 0 || endIndex > len || beginIndex > endIndex) {
+			throw sandvik::StringIndexOutOfBoundsException("beginIndex/endIndex out of range");
+		}
+		if (beginIndex == 0 && endIndex == len) {
+			return obj;
+		}
+		return (jobject)sandvik::Object::makeString(classloader, chars.substr(beginIndex, endIndex - beginIndex));
 	}
 
 	JNIEXPORT jint JNICALL Java_java_lang_String_hashCode(JNIEnv* env, jobject obj) {
-		auto this_ptr = sandvik::native::getString(obj);
-		const auto& str = this_ptr->str();
-		jint hash = 0;
-		for (char c : str) {
-			hash = 31 * hash + static_cast<unsigned char>(c);
+		return sandvik::native::getString(obj)->stringHash();
+	}
+
+	JNIEXPORT jint JNICALL Java_java_lang_String_indexOf__II(JNIEnv* env, jobject obj, jint ch, jint fromIndex) {
+		auto chars = sandvik::native::getString(obj)->chars();
+		auto len = static_cast<jint>(chars.size());
+		fromIndex = std::max(fromIndex, 0);
+		if (ch >= 0x10000) {
+			// supplementary code point, search its surrogate pair
+			if (ch > 0x10FFFF) {
+				return -1;
+			}
+			auto hi = static_cast<char16_t>(0xD800 + ((ch - 0x10000) >> 10));
+			auto lo = static_cast<char16_t>(0xDC00 + ((ch - 0x10000) & 0x3FF));
+			for (jint i = fromIndex; i + 1 < len; ++i) {
+				if (chars[i] == hi && chars[i + 1] == lo) {
+					return i;
+				}
+			}
+			return -1;
+		}
+		if (fromIndex >= len || ch < 0) {
+			return -1;
 		}
-		return hash;
+		if (chars.isCompact()) {
+			if (ch > 0xFF) {
+				return -1;
+			}
+			auto pos = chars.latin1.find(static_cast<char>(ch), fromIndex);
+			return pos == std::string_view::npos ? -1 : static_cast<jint>(pos);
+		}
+		auto pos = chars.utf16.find(static_cast<char16_t>(ch), fromIndex);
+		return pos == std::u16string_view::npos ? -1 : static_cast<jint>(pos);
 	}
 
 	JNIEXPORT jobject JNICALL Java_java_lang_String_intern(JNIEnv* env, jobject obj) {
@@ -76,36 +123,27 @@ extern "C" {
 		sandvik::ClassLoader& classloader = jenv->getClassLoader();
 		auto this_ptr = sandvik::native::getString(obj);
 
-		auto strObj = sandvik::Object::make(classloader, this_ptr->str());
+		auto strObj = sandvik::Object::makeString(classloader, this_ptr->chars());
 		return (jobject)strObj;
 	}
 
 	JNIEXPORT jcharArray JNICALL Java_java_lang_String_toCharArray(JNIEnv* env, jobject obj) {
-		auto this_ptr = sandvik::native::getString(obj);
-		const auto& str = this_ptr->str();
-		jsize len = static_cast<jsize>(str.size());
+		auto chars = sandvik::native::getString(obj)->chars();
+		jsize len = static_cast<jsize>(chars.size());
 
 		jcharArray arr = env->NewCharArray(len);
 		if (arr == nullptr) {
 			throw sandvik::OutOfMemoryError("Failed to allocate char array");
 		}
-
-		if (len > 0) {
-			std::vector<jchar> buf;
-			buf.reserve(len);
-			for (unsigned char c : str) {
-				buf.push_back(static_cast<jchar>(c));
-			}
-			env->SetCharArrayRegion(arr, 0, len, buf.data());
+		auto array = sandvik::native::getArray(arr);
+		for (jsize i = 0; i < len; ++i) {
+			array->setPrimitive<uint16_t>(i, chars[i]);
 		}
-
 		return arr;
 	}
 
 	JNIEXPORT jint JNICALL Java_java_lang_String_length(JNIEnv* env, jobject obj) {
-		auto this_ptr = sandvik::native::getString(obj);
-		const auto& str = this_ptr->str();
-		return static_cast<jint>(str.size());
+		return static_cast<jint>(sandvik::native::getString(obj)->chars().size());
 	}
 
 	JNIEXPORT void JNICALL Java_java_lang_String_initialize___3CII(JNIEnv* env, jobject obj, jcharArray chars, jint offset, jint count) {
@@ -118,30 +156,18 @@ extern "C" {
 			throw sandvik::StringIndexOutOfBoundsException("offset/count out of range");
 		}
 
-		if (count == 0) {
-			this_ptr->setString(std::string());
-			return;
+		std::u16string s(static_cast<size_t>(count), u'\0');
+		for (jint i = 0; i < count; ++i) {
+			s[static_cast<size_t>(i)] = array->getPrimitive<uint16_t>(offset + i);
 		}
-
-		std::vector<jchar> buf(static_cast<size_t>(count));
-		env->GetCharArrayRegion(chars, offset, count, buf.data());
-
-		std::string s;
-		s.reserve(static_cast<size_t>(count));
-		for (jsize i = 0; i < count; ++i) {
-			s.push_back(static_cast<char>(static_cast<unsigned char>(buf[static_cast<size_t>(i)] & 0xFF)));
-		}
-		this_ptr->setString(std::move(s));
+		this_ptr->setString(sandvik::StringChars{{}, s});
 	}
 
 	JNIEXPORT void JNICALL Java_java_lang_String_getChars__II_3CI(JNIEnv* env, jobject obj, jint srcBegin, jint srcEnd, jcharArray dst, jint dstBegin) {
-		logger.ferror("String.getChars(srcBegin={}, srcEnd={}, dst={}, dstBegin={})", srcBegin, srcEnd, (void*)dst, dstBegin);
-		auto this_ptr = sandvik::native::getString(obj);
-		const auto& str = this_ptr->str();
-		logger.ferror("String value: '{}'", str);
+		auto chars = sandvik::native::getString(obj)->chars();
 
 		// Validate source indices
-		if (srcBegin < 0 || srcEnd < 0 || srcBegin > srcEnd || srcEnd > (jint)str.size()) {
+		if (srcBegin < 0 || srcEnd < 0 || srcBegin > srcEnd || srcEnd > (jint)chars.size()) {
 			throw sandvik::StringIndexOutOfBoundsException("srcBegin/srcEnd out of range");
 		}
 		// Validate destination array
@@ -150,37 +176,30 @@ extern "C" {
 		}
 
 		auto copyLen = srcEnd - srcBegin;
-		auto dstLen = env->GetArrayLength(dst);
+		auto array = sandvik::native::getArray(dst);
+		auto dstLen = static_cast<jint>(array->getArrayLength());
 		if (dstBegin < 0 || copyLen > dstLen - dstBegin) {
 			throw sandvik::IndexOutOfBoundsException("destination index out of range");
 		}
-
-		if (copyLen > 0) {
-			std::vector<jchar> buf;
-			buf.reserve(copyLen);
-			for (jsize i = 0; i < copyLen; ++i) {
-				buf.push_back(static_cast<jchar>(static_cast<unsigned char>(str[static_cast<size_t>(srcBegin + i)])));
-			}
-			env->SetCharArrayRegion(dst, dstBegin, copyLen, buf.data());
+		for (jint i = 0; i < copyLen; ++i) {
+			array->setPrimitive<uint16_t>(dstBegin + i, chars[srcBegin + i]);
 		}
 	}
 
 	JNIEXPORT jint JNICALL Java_java_lang_String_codePointAt(JNIEnv* env, jobject obj, jint index) {
-		auto this_ptr = sandvik::native::getString(obj);
-		const auto& str = this_ptr->str();
-		auto len = static_cast<jsize>(str.size());
+		auto chars = sandvik::native::getString(obj)->chars();
+		auto len = static_cast<jsize>(chars.size());
 
 		if (index < 0 || index >= len) {
 			throw sandvik::StringIndexOutOfBoundsException("index out of range");
 		}
 
-		// Retrieve jchar value stored in the native string (stored as low byte)
-		auto ch = static_cast<jchar>(static_cast<unsigned char>(str[static_cast<size_t>(index)]));
+		auto ch = chars[index];
 
 		// If high surrogate and next char is low surrogate, compose supplementary code point
 		if (ch >= 0xD800 && ch <= 0xDBFF) {
 			if (index + 1 < len) {
-				auto ch2 = static_cast<jchar>(static_cast<unsigned char>(str[static_cast<size_t>(index + 1)]));
+				auto ch2 = chars[index + 1];
 				if (ch2 >= 0xDC00 && ch2 <= 0xDFFF) {
 					jint hi = static_cast<jint>(ch) - 0xD800;
 					jint lo = static_cast<jint>(ch2) - 0xDC00;
@@ -193,28 +212,24 @@ extern "C" {
 	}
 
 	JNIEXPORT jchar JNICALL Java_java_lang_String_charAt(JNIEnv* env, jobject obj, jint index) {
-		auto this_ptr = sandvik::native::getString(obj);
-		const auto& str = this_ptr->str();
-		if (index < 0 || index >= static_cast<jsize>(str.size())) {
+		auto chars = sandvik::native::getString(obj)->chars();
+		if (index < 0 || index >= static_cast<jsize>(chars.size())) {
 			throw sandvik::StringIndexOutOfBoundsException("index out of range");
 		}
-
-		return static_cast<jchar>(static_cast<unsigned char>(str[static_cast<size_t>(index)]));
+		return static_cast<jchar>(chars[index]);
 	}
 
 	JNIEXPORT jobject JNICALL Java_java_lang_String_subSequence(JNIEnv* env, jobject obj, jint beginIndex, jint endIndex) {
 		auto jenv = sandvik::native::getNativeInterface(env);
 		sandvik::ClassLoader& classloader = jenv->getClassLoader();
-		auto this_ptr = sandvik::native::getString(obj);
-		const auto& str = this_ptr->str();
-		auto len = static_cast<jsize>(str.size());
+		auto chars = sandvik::native::getString(obj)->chars();
+		auto len = static_cast<jsize>(chars.size());
 
 		if (beginIndex < 0 || endIndex < 0 || beginIndex > endIndex || endIndex > len) {
 			throw sandvik::StringIndexOutOfBoundsException("beginIndex/endIndex out of range");
 		}
 
-		auto substr = str.substr(static_cast<size_t>(beginIndex), static_cast<size_t>(endIndex - beginIndex));
-		auto strObj = sandvik::Object::make(classloader, substr);
+		auto strObj = sandvik::Object::makeString(classloader, chars.substr(beginIndex, endIndex - beginIndex));
 		return (jobject)strObj;
 	}
 
@@ -222,4 +237,24 @@ extern "C" {
 		// java.lang.String.toString() simply returns this
 		return static_cast<jstring>(obj);
 	}
-}
\ No newline at end of file
+}
+
+namespace {
+	const sandvik::native::Registration registration("java.lang.String", {
+		{"initialize", "(Ljava/lang/String;)V", (void*)&Java_java_lang_String_initialize__Ljava_lang_String_2},
+		{"equals", "(Ljava/lang/Object;)Z", (void*)&Java_java_lang_String_equals},
+		{"substring", "(I)Ljava/lang/String;", (void*)&Java_java_lang_String_substring__I},
+		{"substring", "(II)Ljava/lang/String;", (void*)&Java_java_lang_String_substring__II},
+		{"hashCode", "()I", (void*)&Java_java_lang_String_hashCode},
+		{"indexOf", "(II)I", (void*)&Java_java_lang_String_indexOf__II},
+		{"intern", "()Ljava/lang/String;", (void*)&Java_java_lang_String_intern},
+		{"toCharArray", "()[C", (void*)&Java_java_lang_String_toCharArray},
+		{"length", "()I", (void*)&Java_java_lang_String_length},
+		{"initialize", "([CII)V", (void*)&Java_java_lang_String_initialize___3CII},
+		{"getChars", "(II[CI)V", (void*)&Java_java_lang_String_getChars__II_3CI},
+		{"codePointAt", "(I)I", (void*)&Java_java_lang_String_codePointAt},
+		{"charAt", "(I)C", (void*)&Java_java_lang_String_charAt},
+		{"subSequence", "(II)Ljava/lang/CharSequence;", (void*)&Java_java_lang_String_subSequence},
+		{"toString", "()Ljava/lang/String;", (void*)&Java_java_lang_String_toString},
+	});
+}  // namespace
@@ -169,4 +169,17 @@ extern "C" {
 		}
 		return obj;
 	}
-}
\ No newline at end of file
+}
+
+namespace {
+	const sandvik::native::Registration registration("java.lang.StringBuilder", {
+		{"append", "(Ljava/lang/String;)Ljava/lang/StringBuilder;", (void*)&Java_java_lang_StringBuilder_append__Ljava_lang_String_2},
+		{"append", "(I)Ljava/lang/StringBuilder;", (void*)&Java_java_lang_StringBuilder_append__I},
+		{"append", "(F)Ljava/lang/StringBuilder;", (void*)&Java_java_lang_StringBuilder_append__F},
+		{"append", "(D)Ljava/lang/StringBuilder;", (void*)&Java_java_lang_StringBuilder_append__D},
+		{"append", "(J)Ljava/lang/StringBuilder;", (void*)&Java_java_lang_StringBuilder_append__J},
+		{"toString", "()Ljava/lang/String;", (void*)&Java_java_lang_StringBuilder_toString},
+		{"append", "(C)Ljava/lang/StringBuilder;", (void*)&Java_java_lang_StringBuilder_append__C},
+		{"append", "(Z)Ljava/lang/StringBuilder;", (void*)&Java_java_lang_StringBuilder_append__Z},
+	});
+}  // namespace
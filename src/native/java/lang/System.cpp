@@ -19,6 +19,7 @@
 #include <fmt/format.h>
 #include <jni/jni.h>
 
+#include "array.hpp"
 #include "class.hpp"
 #include "classloader.hpp"
 #include "exceptions.hpp"
@@ -59,6 +60,18 @@ extern "C" {
 		return object->identityHashCode();
 	}
 
+	JNIEXPORT void JNICALL Java_java_lang_System_arraycopy(JNIEnv* env, jobject, jobject src, jint srcPos, jobject dst, jint dstPos, jint length) {
+		if (!src || !dst) {
+			throw sandvik::NullPointerException("java.lang.System.arraycopy: src or dst is null");
+		}
+		auto* srcObj = sandvik::native::getObject(src);
+		auto* dstObj = sandvik::native::getObject(dst);
+		if (!srcObj->isArray() || !dstObj->isArray()) {
+			throw sandvik::ArrayStoreException("java.lang.System.arraycopy: src and dst must be arrays");
+		}
+		sandvik::Array::copy(*static_cast<sandvik::ArrayRef>(srcObj), srcPos, *static_cast<sandvik::ArrayRef>(dstObj), dstPos, length);
+	}
+
 	JNIEXPORT jobject JNICALL Java_java_lang_System_getProperty(JNIEnv* env, jobject, jstring key) {
 		if (!key) {
 			throw sandvik::NullPointerException("java.lang.System.getProperty: key is null");
@@ -74,4 +87,14 @@ extern "C" {
 			return nullptr;
 		}
 	}
-}
\ No newline at end of file
+}
+
+namespace {
+	const sandvik::native::Registration registration("java.lang.System", {
+		{"initializeStream", "()V", (void*)&Java_java_lang_System_initializeStream},
+		{"loadLibrary", "(Ljava/lang/String;)V", (void*)&Java_java_lang_System_loadLibrary},
+		{"identityHashCode", "(Ljava/lang/Object;)I", (void*)&Java_java_lang_System_identityHashCode},
+		{"arraycopy", "(Ljava/lang/Object;ILjava/lang/Object;II)V", (void*)&Java_java_lang_System_arraycopy},
+		{"getProperty", "(Ljava/lang/String;)Ljava/lang/String;", (void*)&Java_java_lang_System_getProperty},
+	});
+}  // namespace
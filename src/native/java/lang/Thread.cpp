@@ -51,8 +51,8 @@ extern "C" {
 	JNIEXPORT void JNICALL Java_java_lang_Thread_start0(JNIEnv* env, jobject obj) {
 		auto jenv = sandvik::native::getNativeInterface(env);
 		auto& vm = jenv->getVm();
-		auto& thread = vm.newThread(sandvik::native::getObject(obj));
-		thread.run();
+		auto thread = vm.newThread(sandvik::native::getObject(obj));
+		thread->run();
 	}
 
 	JNIEXPORT void JNICALL Java_java_lang_Thread_sleep__J(JNIEnv* env, jclass /*clazz*/, jlong millis) {
@@ -69,10 +69,25 @@ extern "C" {
 		auto jenv = sandvik::native::getNativeInterface(env);
 		auto& vm = jenv->getVm();
 		auto tobj = sandvik::native::getObject(obj);
-		auto tname = tobj->getField("name")->str();
-		logger.fdebug("Joining thread '{}' for {} milliseconds", tname, millis);
-		auto& target = vm.getThread(tname);
-		target.join();
+		// eetop holds the identifier of the VM thread, 0 if the thread has not been started
+		auto id = (uint64_t)tobj->getField("eetop")->getLongValue();
+		LOG_DEBUG("Joining thread {} for {} milliseconds", id, millis);
+		auto target = vm.getThread(id);
+		if (target == nullptr) {
+			// not started or terminated and reclaimed
+			return;
+		}
+		target->join();
 		// @todo: timeout handling not implemented yet
 	}
 }
+
+namespace {
+	const sandvik::native::Registration registration("java.lang.Thread", {
+		{"registerNatives", "()V", (void*)&Java_java_lang_Thread_registerNatives},
+		{"currentThread", "()Ljava/lang/Thread;", (void*)&Java_java_lang_Thread_currentThread},
+		{"start0", "()V", (void*)&Java_java_lang_Thread_start0},
+		{"sleep", "(J)V", (void*)&Java_java_lang_Thread_sleep__J},
+		{"join", "(J)V", (void*)&Java_java_lang_Thread_join__J},
+	});
+}  // namespace
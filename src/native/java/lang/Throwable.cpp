@@ -22,6 +22,7 @@
 #include "class.hpp"
 #include "field.hpp"
 #include "jni.hpp"
+#include "native_utils.hpp"
 #include "object.hpp"
 #include "system/logger.hpp"
 
@@ -31,4 +32,10 @@ extern "C" {
 		// For now, just return 0 to indicate success.
 		return 0;
 	}
-}
\ No newline at end of file
+}
+
+namespace {
+	const sandvik::native::Registration registration("java.lang.Throwable", {
+		{"fillInStackTrace", "(I)Ljava/lang/Throwable;", (void*)&Java_java_lang_Throwable_fillInStackTrace__I},
+	});
+}  // namespace
@@ -36,17 +36,17 @@ extern "C" {
 		auto obj = sandvik::native::getObject(classObj);
 		auto dimArray = (sandvik::Array*)sandvik::native::getObject(dimsArr);
 
-		logger.fdebug("Creating multi-dimensional array of type: {}", obj->getClassType().getFullname());
+		LOG_DEBUG("Creating multi-dimensional array of type: {}", obj->getClassType().getFullname());
 
 		// Get dimensions from dimsArr (assume it's a Java int array)
 		std::vector<uint32_t> dimensions;
-		logger.fdebug("Array dimensions: {}", dimArray->getArrayLength());
+		LOG_DEBUG("Array dimensions: {}", dimArray->getArrayLength());
 		for (size_t i = 0; i < dimArray->getArrayLength(); ++i) {
 			auto element = dimArray->getElement(i);
 			if (!element->isNumberObject()) {
 				throw sandvik::VmException("Dimension at index {} is not a NumberObject", i);
 			}
-			logger.fdebug(" - dim[{}] = {}", i, element->getValue());
+			LOG_DEBUG(" - dim[{}] = {}", i, element->getValue());
 			dimensions.push_back(element->getValue());
 		}
 
@@ -57,3 +57,9 @@ extern "C" {
 		return (jobject)arrObj;
 	}
 }
+
+namespace {
+	const sandvik::native::Registration registration("java.lang.reflect.Array", {
+		{"multiNewArray", "(Ljava/lang/Class;[I)Ljava/lang/Object;", (void*)&Java_java_lang_reflect_Array_multiNewArray},
+	});
+}  // namespace
@@ -31,11 +31,17 @@
 extern "C" {
 	JNIEXPORT jobject JNICALL Java_java_lang_reflect_Constructor_newInstance(JNIEnv* env, jobject ctorObj, jobjectArray args) {
 		auto ctor = sandvik::native::getObject(ctorObj);
-		logger.debug(fmt::format("Constructor.newInstance: declaringClass = {}", ctor->toString()));
+		LOG_DEBUG("Constructor.newInstance: declaringClass = {}", ctor->toString());
 		auto declaringClass = ctor->getField("declaringClass");
-		logger.debug(fmt::format("Constructor.newInstance: declaringClass = {}", declaringClass->toString()));
+		LOG_DEBUG("Constructor.newInstance: declaringClass = {}", declaringClass->toString());
 		auto instance = sandvik::Object::make(declaringClass->getClass());
-		logger.debug(fmt::format("Constructor.newInstance: Created instance of class {}", instance->toString()));
+		LOG_DEBUG("Constructor.newInstance: Created instance of class {}", instance->toString());
 		return (jobject)instance;
 	}
-}
\ No newline at end of file
+}
+
+namespace {
+	const sandvik::native::Registration registration("java.lang.reflect.Constructor", {
+		{"newInstance", "([Ljava/lang/Object;)Ljava/lang/Object;", (void*)&Java_java_lang_reflect_Constructor_newInstance},
+	});
+}  // namespace
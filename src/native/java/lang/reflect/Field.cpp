@@ -41,4 +41,10 @@ extern "C" {
 		// Return the value as a jobject
 		return (jobject)value;
 	}
-}
\ No newline at end of file
+}
+
+namespace {
+	const sandvik::native::Registration registration("java.lang.reflect.Field", {
+		{"get", "(Ljava/lang/Object;)Ljava/lang/Object;", (void*)&Java_java_lang_reflect_Field_get},
+	});
+}  // namespace
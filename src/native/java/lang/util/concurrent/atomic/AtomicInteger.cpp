@@ -29,57 +29,75 @@
 #include "system/logger.hpp"
 #include "vm.hpp"
 
+namespace {
+	/** sign extend an int value to the field slot storage */
+	uint64_t toSlot(jint value_) {
+		return static_cast<uint64_t>(static_cast<int64_t>(value_));
+	}
+	/** compare the low 32 bits only, add operations may carry into the upper bits of the slot */
+	bool compareAndSet(std::atomic_ref<uint64_t> value_, jint expect_, jint update_) {
+		auto current = value_.load();
+		while (static_cast<jint>(current) == expect_) {
+			if (value_.compare_exchange_weak(current, toSlot(update_))) {
+				return true;
+			}
+		}
+		return false;
+	}
+	jint getAndAdd(std::atomic_ref<uint64_t> value_, jint delta_) {
+		return static_cast<jint>(value_.fetch_add(toSlot(delta_)));
+	}
+	jint addAndGet(std::atomic_ref<uint64_t> value_, jint delta_) {
+		return static_cast<jint>(static_cast<uint32_t>(value_.fetch_add(toSlot(delta_))) + static_cast<uint32_t>(delta_));
+	}
+}  // namespace
+
 extern "C" {
 	JNIEXPORT void JNICALL Java_java_util_concurrent_atomic_AtomicInteger_lazySet(JNIEnv* env, jobject obj, jint newValue) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		value->setField("value", sandvik::Object::make(static_cast<uint64_t>(static_cast<int64_t>(newValue))));
+		sandvik::native::getAtomicField(obj, "value").store(toSlot(newValue));
 	}
 
 	JNIEXPORT jint JNICALL Java_java_util_concurrent_atomic_AtomicInteger_getAndSet(JNIEnv* env, jobject obj, jint newValue) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return value->getAndSet(newValue);
+		return static_cast<jint>(sandvik::native::getAtomicField(obj, "value").exchange(toSlot(newValue)));
 	}
 	JNIEXPORT jboolean JNICALL Java_java_util_concurrent_atomic_AtomicInteger_compareAndSet(JNIEnv* env, jobject obj, jint expect, jint update) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return static_cast<jboolean>(value->compareAndSet(expect, update));
+		return static_cast<jboolean>(compareAndSet(sandvik::native::getAtomicField(obj, "value"), expect, update));
 	}
 
 	JNIEXPORT jboolean JNICALL Java_java_util_concurrent_atomic_AtomicInteger_weakCompareAndSet(JNIEnv* env, jobject obj, jint expect, jint update) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return static_cast<jboolean>(value->weakCompareAndSet(expect, update));
+		return static_cast<jboolean>(compareAndSet(sandvik::native::getAtomicField(obj, "value"), expect, update));
 	}
 	JNIEXPORT jint JNICALL Java_java_util_concurrent_atomic_AtomicInteger_getAndIncrement(JNIEnv* env, jobject obj) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return value->getAndAdd((int32_t)1);
+		return getAndAdd(sandvik::native::getAtomicField(obj, "value"), 1);
 	}
 	JNIEXPORT jint JNICALL Java_java_util_concurrent_atomic_AtomicInteger_getAndDecrement(JNIEnv* env, jobject obj) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return value->getAndAdd((int32_t)-1);
+		return getAndAdd(sandvik::native::getAtomicField(obj, "value"), -1);
 	}
 	JNIEXPORT jint JNICALL Java_java_util_concurrent_atomic_AtomicInteger_getAndAdd(JNIEnv* env, jobject obj, jint delta) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return value->getAndAdd(delta);
+		return getAndAdd(sandvik::native::getAtomicField(obj, "value"), delta);
 	}
 	JNIEXPORT jint JNICALL Java_java_util_concurrent_atomic_AtomicInteger_incrementAndGet(JNIEnv* env, jobject obj) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return value->addAndGet((int32_t)1);
+		return addAndGet(sandvik::native::getAtomicField(obj, "value"), 1);
 	}
 	JNIEXPORT jint JNICALL Java_java_util_concurrent_atomic_AtomicInteger_decrementAndGet(JNIEnv* env, jobject obj) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return value->addAndGet((int32_t)-1);
+		return addAndGet(sandvik::native::getAtomicField(obj, "value"), -1);
 	}
 	JNIEXPORT jint JNICALL Java_java_util_concurrent_atomic_AtomicInteger_addAndGet(JNIEnv* env, jobject obj, jint delta) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return value->addAndGet(static_cast<int32_t>(delta));
+		return addAndGet(sandvik::native::getAtomicField(obj, "value"), delta);
 	}
-}
\ No newline at end of file
+}
+
+namespace {
+	const sandvik::native::Registration registration("java.util.concurrent.atomic.AtomicInteger", {
+		{"lazySet", "(I)V", (void*)&Java_java_util_concurrent_atomic_AtomicInteger_lazySet},
+		{"getAndSet", "(I)I", (void*)&Java_java_util_concurrent_atomic_AtomicInteger_getAndSet},
+		{"compareAndSet", "(II)Z", (void*)&Java_java_util_concurrent_atomic_AtomicInteger_compareAndSet},
+		{"weakCompareAndSet", "(II)Z", (void*)&Java_java_util_concurrent_atomic_AtomicInteger_weakCompareAndSet},
+		{"getAndIncrement", "()I", (void*)&Java_java_util_concurrent_atomic_AtomicInteger_getAndIncrement},
+		{"getAndDecrement", "()I", (void*)&Java_java_util_concurrent_atomic_AtomicInteger_getAndDecrement},
+		{"getAndAdd", "(I)I", (void*)&Java_java_util_concurrent_atomic_AtomicInteger_getAndAdd},
+		{"incrementAndGet", "()I", (void*)&Java_java_util_concurrent_atomic_AtomicInteger_incrementAndGet},
+		{"decrementAndGet", "()I", (void*)&Java_java_util_concurrent_atomic_AtomicInteger_decrementAndGet},
+		{"addAndGet", "(I)I", (void*)&Java_java_util_concurrent_atomic_AtomicInteger_addAndGet},
+	});
+}  // namespace
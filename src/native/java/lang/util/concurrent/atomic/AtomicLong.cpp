@@ -31,55 +31,52 @@
 
 extern "C" {
 	JNIEXPORT void JNICALL Java_java_util_concurrent_atomic_AtomicLong_lazySet(JNIEnv* env, jobject obj, jlong newValue) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		value->setField("value", sandvik::Object::make(static_cast<uint64_t>(newValue)));
+		sandvik::native::getAtomicField(obj, "value").store(static_cast<uint64_t>(newValue));
 	}
 
 	JNIEXPORT jlong JNICALL Java_java_util_concurrent_atomic_AtomicLong_getAndSet(JNIEnv* env, jobject obj, jlong newValue) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return static_cast<jlong>(value->getAndSet(newValue));
+		return static_cast<jlong>(sandvik::native::getAtomicField(obj, "value").exchange(static_cast<uint64_t>(newValue)));
 	}
 	JNIEXPORT jboolean JNICALL Java_java_util_concurrent_atomic_AtomicLong_compareAndSet(JNIEnv* env, jobject obj, jlong expect, jlong update) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return static_cast<jboolean>(value->compareAndSet(expect, update));
+		auto expected = static_cast<uint64_t>(expect);
+		return static_cast<jboolean>(sandvik::native::getAtomicField(obj, "value").compare_exchange_strong(expected, static_cast<uint64_t>(update)));
 	}
 
 	JNIEXPORT jboolean JNICALL Java_java_util_concurrent_atomic_AtomicLong_weakCompareAndSet(JNIEnv* env, jobject obj, jlong expect, jlong update) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return static_cast<jboolean>(value->weakCompareAndSet(expect, update));
+		auto expected = static_cast<uint64_t>(expect);
+		return static_cast<jboolean>(sandvik::native::getAtomicField(obj, "value").compare_exchange_weak(expected, static_cast<uint64_t>(update)));
 	}
 	JNIEXPORT jlong JNICALL Java_java_util_concurrent_atomic_AtomicLong_getAndIncrement(JNIEnv* env, jobject obj) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return value->getAndAdd((int64_t)1);
+		return static_cast<jlong>(sandvik::native::getAtomicField(obj, "value").fetch_add(1));
 	}
 	JNIEXPORT jlong JNICALL Java_java_util_concurrent_atomic_AtomicLong_getAndDecrement(JNIEnv* env, jobject obj) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return value->getAndAdd((int64_t)-1);
+		return static_cast<jlong>(sandvik::native::getAtomicField(obj, "value").fetch_sub(1));
 	}
 	JNIEXPORT jlong JNICALL Java_java_util_concurrent_atomic_AtomicLong_getAndAdd(JNIEnv* env, jobject obj, jlong delta) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return value->getAndAdd(delta);
+		return static_cast<jlong>(sandvik::native::getAtomicField(obj, "value").fetch_add(static_cast<uint64_t>(delta)));
 	}
 	JNIEXPORT jlong JNICALL Java_java_util_concurrent_atomic_AtomicLong_incrementAndGet(JNIEnv* env, jobject obj) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return value->addAndGet((int64_t)1);
+		return static_cast<jlong>(sandvik::native::getAtomicField(obj, "value").fetch_add(1) + 1);
 	}
 	JNIEXPORT jlong JNICALL Java_java_util_concurrent_atomic_AtomicLong_decrementAndGet(JNIEnv* env, jobject obj) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return value->addAndGet((int64_t)-1);
+		return static_cast<jlong>(sandvik::native::getAtomicField(obj, "value").fetch_sub(1) - 1);
 	}
 	JNIEXPORT jlong JNICALL Java_java_util_concurrent_atomic_AtomicLong_addAndGet(JNIEnv* env, jobject obj, jlong delta) {
-		auto* this_ptr = sandvik::native::getObject(obj);
-		auto value = this_ptr->getField("value");
-		return value->addAndGet(static_cast<int64_t>(delta));
+		return static_cast<jlong>(sandvik::native::getAtomicField(obj, "value").fetch_add(static_cast<uint64_t>(delta)) + static_cast<uint64_t>(delta));
 	}
-}
\ No newline at end of file
+}
+
+namespace {
+	const sandvik::native::Registration registration("java.util.concurrent.atomic.AtomicLong", {
+		{"lazySet", "(J)V", (void*)&Java_java_util_concurrent_atomic_AtomicLong_lazySet},
+		{"getAndSet", "(J)J", (void*)&Java_java_util_concurrent_atomic_AtomicLong_getAndSet},
+		{"compareAndSet", "(JJ)Z", (void*)&Java_java_util_concurrent_atomic_AtomicLong_compareAndSet},
+		{"weakCompareAndSet", "(JJ)Z", (void*)&Java_java_util_concurrent_atomic_AtomicLong_weakCompareAndSet},
+		{"getAndIncrement", "()J", (void*)&Java_java_util_concurrent_atomic_AtomicLong_getAndIncrement},
+		{"getAndDecrement", "()J", (void*)&Java_java_util_concurrent_atomic_AtomicLong_getAndDecrement},
+		{"getAndAdd", "(J)J", (void*)&Java_java_util_concurrent_atomic_AtomicLong_getAndAdd},
+		{"incrementAndGet", "()J", (void*)&Java_java_util_concurrent_atomic_AtomicLong_incrementAndGet},
+		{"decrementAndGet", "()J", (void*)&Java_java_util_concurrent_atomic_AtomicLong_decrementAndGet},
+		{"addAndGet", "(J)J", (void*)&Java_java_util_concurrent_atomic_AtomicLong_addAndGet},
+	});
+}  // namespace
@@ -19,7 +19,9 @@
 #include "native_call.hpp"
 
 #include <cstring>
-#include <variant>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
 
 #include "exceptions.hpp"
 #include "jni.hpp"
@@ -31,11 +33,15 @@ using namespace sandvik;
 ffi_type* NativeCallHelper::getFFITypeForJNIType(char jniType) {
 	switch (jniType) {
 		case 'I':
+			return &ffi_type_sint32;
 		case 'Z':
+			return &ffi_type_uint8;
 		case 'B':
+			return &ffi_type_sint8;
 		case 'S':
+			return &ffi_type_sint16;
 		case 'C':
-			return &ffi_type_sint32;
+			return &ffi_type_uint16;
 		case 'J':
 			return &ffi_type_sint64;
 		case 'F':
@@ -50,176 +56,162 @@ ffi_type* NativeCallHelper::getFFITypeForJNIType(char jniType) {
 	}
 }
 
-ffi_type* NativeCallHelper::getFFITypeForReturn(const std::string& returnType) {
-	if (returnType.empty() || returnType == "V") {
-		return &ffi_type_void;
-	}
-	return getFFITypeForJNIType(returnType[0]);
-}
-
-void NativeCallHelper::prepareCallContext(CallContext& context, const std::string& paramTypes, const std::string& returnType,
-                                          std::vector<std::string>& argTypes) {
-	context.return_type = returnType;
-	context.arg_types.clear();
+std::unique_ptr<NativeBinding> NativeCallHelper::bind(void* functionPtr, const std::vector<std::string>& paramTypes, const std::string& returnType) {
+	auto binding = std::make_unique<NativeBinding>();
+	binding->function = functionPtr;
+	binding->returnType = returnType.empty() ? 'V' : returnType[0];
 
 	// Always reserve first two spots for JNIEnv* and jobject
-	context.arg_types.push_back(&ffi_type_pointer);  // JNIEnv*
-	context.arg_types.push_back(&ffi_type_pointer);  // jobject
-
-	// Process parameter types
-	for (size_t i = 0; i < paramTypes.size();) {
-		char typeChar = paramTypes[i];
-		// Skip opening parenthesis if present
-		if (typeChar == '(' && i == 0) {
-			i++;
-			continue;
-		}
-		// Skip closing parenthesis if present
-		if (typeChar == ')') {
-			break;
-		}
-		argTypes.push_back(std::string(1, typeChar));
-		context.arg_types.push_back(getFFITypeForJNIType(typeChar));
-
-		// Handle type descriptors that take more than one character
-		if (typeChar == 'L') {
-			while (i < paramTypes.size() && paramTypes[i] != ';') i++;
-			if (i < paramTypes.size()) i++;  // skip semicolon
-		} else if (typeChar == '[') {
-			// Skip all leading '[' for multi-dimensional arrays
-			while (i < paramTypes.size() && paramTypes[i] == '[') i++;
-			// If it's an object array, skip until the end of the object descriptor
-			if (i < paramTypes.size() && paramTypes[i] == 'L') {
-				while (i < paramTypes.size() && paramTypes[i] != ';') i++;
-				if (i < paramTypes.size()) i++;  // skip semicolon
-			} else {
-				// For primitive arrays, just skip the primitive type character
-				if (i < paramTypes.size()) i++;
-			}
-		} else {
-			i++;  // simple type
-		}
+	binding->argTypes.push_back(&ffi_type_pointer);  // JNIEnv*
+	binding->argTypes.push_back(&ffi_type_pointer);  // jobject
+	for (const auto& type : paramTypes) {
+		binding->paramTypes.push_back(type[0]);
+		binding->argTypes.push_back(getFFITypeForJNIType(type[0]));
+	}
+
+	// short signature: return type then parameter types, arrays are passed as objects
+	std::string shorty(1, binding->returnType == '[' ? 'L' : binding->returnType);
+	for (auto type : binding->paramTypes) {
+		shorty.push_back(type == '[' ? 'L' : type);
 	}
+	binding->stub = findDirectStub(shorty);
 
 	// Prepare the call interface
-	if (ffi_prep_cif(&context.cif, FFI_DEFAULT_ABI, context.arg_types.size(), getFFITypeForReturn(returnType), context.arg_types.data()) != FFI_OK) {
+	ffi_type* ffiReturnType = binding->returnType == 'V' ? &ffi_type_void : getFFITypeForJNIType(binding->returnType);
+	if (ffi_prep_cif(&binding->cif, FFI_DEFAULT_ABI, binding->argTypes.size(), ffiReturnType, binding->argTypes.data()) != FFI_OK) {
 		throw VmException("Failed to prepare FFI call interface");
 	}
-	context.prepared = true;
+	return binding;
 }
 
-uintptr_t NativeCallHelper::getArgValue(std::vector<ObjectRef>::iterator& it, const char jniType) {
-	switch (jniType) {
-		case 'I':
-		case 'Z':
-		case 'B':
-		case 'S':
-		case 'C':
-		case 'F': {
-			auto obj = *it;
-			++it;
-			if (!obj->isNumberObject()) {
-				throw VmException("Invalid argument type for JNI type: {}", jniType);
-			}
-			return static_cast<uintptr_t>(obj->getValue());
-		}
-		case 'J':
-		case 'D': {
-			auto lsb = *it;
-			++it;
-			auto msb = *it;
-			++it;
-			if (!lsb->isNumberObject() || !msb->isNumberObject()) {
-				throw VmException("Invalid argument type for JNI type: {}", jniType);
-			}
-			uint32_t lsb_value = lsb->getValue();
-			uint32_t msb_value = msb->getValue();
-			uintptr_t result = (static_cast<uintptr_t>(msb_value) << 32) | static_cast<uintptr_t>(lsb_value);
-			return result;
-		}
-		case 'L':
-		case '[':  // Objects and arrays
-		{
-			auto obj = *it;
-			++it;
-			return (uintptr_t)obj;
-		}
-		default:
-			throw VmException("Unsupported JNI type character: {}", jniType);
+uint64_t NativeCallHelper::invoke(const NativeBinding& binding, JNIEnv* env, jobject self, std::span<const uint64_t> args) {
+	if (args.size() != binding.paramTypes.size()) {
+		throw VmException("Native call with {} arguments, {} expected", args.size(), binding.paramTypes.size());
 	}
-}
-
-ObjectRef NativeCallHelper::getReturnObject(uintptr_t result, const char jniType) {
-	switch (jniType) {
-		case 'V':
-			return Object::makeNull();  // void return null object (should not be used)
-		case 'I':
-		case 'Z':
-		case 'B':
-		case 'S':
-		case 'C':
-		case 'J':
-		case 'F':
-		case 'D':
-			return Object::make((uint64_t)result);
-		case 'L':
-		case '[': {  // Objects and arrays
-			auto ret = (ObjectRef)result;
-			if (ret == nullptr) {
-				return Object::makeNull();
-			}
-			return ret;
-		}
-		default:
-			throw VmException("Unsupported JNI type character: {}", jniType);
+	if (binding.stub) {
+		return binding.stub(binding.function, env, self, args.data());
 	}
-}
 
-ObjectRef NativeCallHelper::invoke(void* functionPtr, JNIEnv* env, const std::vector<ObjectRef>& args, const std::string& returnType,
-                                   const std::string& paramTypes, bool isStatic, ObjectRef staticClass) {
-	// Create a temporary call context
-	std::vector<std::string> argTypes;
-	CallContext context;
-	prepareCallContext(context, paramTypes, returnType, argTypes);
+	const size_t count = binding.argTypes.size();
+	// argument storage lives on the stack unless the method has a large number of parameters
+	uint64_t stackValues[MAX_STACK_ARGS];
+	void* stackPointers[MAX_STACK_ARGS];
+	std::unique_ptr<uint64_t[]> heapValues;
+	std::unique_ptr<void*[]> heapPointers;
+	uint64_t* values = stackValues;
+	void** pointers = stackPointers;
+	if (count > MAX_STACK_ARGS) [[unlikely]] {
+		heapValues = std::make_unique<uint64_t[]>(count);
+		heapPointers = std::make_unique<void*[]>(count);
+		values = heapValues.get();
+		pointers = heapPointers.get();
+	}
 
-	std::vector<void*> arg_values;
 	// jni environment pointer
-	arg_values.push_back(&env);
+	pointers[0] = &env;
 	// jobject this reference
-	jobject this_ref;
-	if (isStatic) {
-		// static method
-		this_ref = (jobject)(uintptr_t)staticClass;
+	pointers[1] = &self;
+
+	// the values are passed in place, ffi reads the low bytes of the narrower types
+	for (size_t idx = 2; idx < count; ++idx) {
+		values[idx] = args[idx - 2];
+		pointers[idx] = &values[idx];
+	}
+
+	// Execute the call
+	uint64_t result_storage = 0;
+	ffi_call(const_cast<ffi_cif*>(&binding.cif), FFI_FN(binding.function), &result_storage, pointers);
+	return result_storage;
+}
+
+template <typename T>
+T NativeCallHelper::fromRaw(uint64_t value) {
+	if constexpr (std::is_same_v<T, jobject>) {
+		return (jobject)(uintptr_t)value;
+	} else if constexpr (std::is_same_v<T, jfloat>) {
+		auto bits = static_cast<uint32_t>(value);
+		jfloat result;
+		memcpy(&result, &bits, sizeof(result));
+		return result;
+	} else if constexpr (std::is_same_v<T, jdouble>) {
+		jdouble result;
+		memcpy(&result, &value, sizeof(result));
+		return result;
 	} else {
-		this_ref = (jobject)(uintptr_t)args[0];
+		return static_cast<T>(value);
 	}
-	arg_values.push_back(&this_ref);
-
-	// Prepare argument values
-	uintptr_t result_storage = 0;
-	uintptr_t* param_storage = nullptr;
-	if (args.size() > 0) {
-		size_t idx = 0;
-		param_storage = new uintptr_t[args.size()];
-		auto mutableArgs = args;  // Create a mutable copy of args
-		auto it = mutableArgs.begin();
-		if (!isStatic) {
-			// If not static, skip the first argument (this reference)
-			it++;
-		}
-		while (it != mutableArgs.end()) {
-			param_storage[idx] = getArgValue(it, argTypes[idx][0]);
-			arg_values.push_back((void*)&param_storage[idx]);
-			idx++;
-		}
+}
+
+template <typename T>
+uint64_t NativeCallHelper::toRaw(T value) {
+	if constexpr (std::is_same_v<T, jobject>) {
+		return (uintptr_t)value;
+	} else if constexpr (std::is_same_v<T, jfloat>) {
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	} else if constexpr (std::is_same_v<T, jdouble>) {
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	} else {
+		// sign or zero extended like the ffi return value
+		return static_cast<uint64_t>(static_cast<std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>(value));
 	}
+}
 
-	// Execute the call
-	ffi_call(&context.cif, FFI_FN(functionPtr), &result_storage, arg_values.data());
+template <typename R, typename... Args>
+uint64_t NativeCallHelper::directCall(void* function, JNIEnv* env, jobject self, const uint64_t* args) {
+	return directCallImpl<R, Args...>(function, env, self, args, std::index_sequence_for<Args...>{});
+}
 
-	// Process and return result
-	if (param_storage) {
-		delete[] param_storage;
+template <typename R, typename... Args, size_t... I>
+uint64_t NativeCallHelper::directCallImpl(void* function, JNIEnv* env, jobject self, const uint64_t* args, std::index_sequence<I...>) {
+	using Function = R(JNICALL*)(JNIEnv*, jobject, Args...);
+	auto call = reinterpret_cast<Function>(function);
+	if constexpr (std::is_void_v<R>) {
+		call(env, self, fromRaw<Args>(args[I])...);
+		return 0;
+	} else {
+		return toRaw<R>(call(env, self, fromRaw<Args>(args[I])...));
 	}
-	return getReturnObject(result_storage, returnType[0]);
+}
+
+DirectStub NativeCallHelper::findDirectStub(const std::string& shorty) {
+	// signatures of the small natives called in hot loops (String, StringBuilder, atomics, boxing helpers)
+	static const std::unordered_map<std::string, DirectStub> stubs = {
+	    {"V", &directCall<void>},
+	    {"Z", &directCall<jboolean>},
+	    {"I", &directCall<jint>},
+	    {"J", &directCall<jlong>},
+	    {"L", &directCall<jobject>},
+	    {"VI", &directCall<void, jint>},
+	    {"VJ", &directCall<void, jlong>},
+	    {"VL", &directCall<void, jobject>},
+	    {"ZI", &directCall<jboolean, jint>},
+	    {"ZL", &directCall<jboolean, jobject>},
+	    {"ZD", &directCall<jboolean, jdouble>},
+	    {"CI", &directCall<jchar, jint>},
+	    {"II", &directCall<jint, jint>},
+	    {"IF", &directCall<jint, jfloat>},
+	    {"IL", &directCall<jint, jobject>},
+	    {"JD", &directCall<jlong, jdouble>},
+	    {"JJ", &directCall<jlong, jlong>},
+	    {"DJ", &directCall<jdouble, jlong>},
+	    {"FI", &directCall<jfloat, jint>},
+	    {"LI", &directCall<jobject, jint>},
+	    {"LC", &directCall<jobject, jchar>},
+	    {"LZ", &directCall<jobject, jboolean>},
+	    {"LJ", &directCall<jobject, jlong>},
+	    {"LF", &directCall<jobject, jfloat>},
+	    {"LD", &directCall<jobject, jdouble>},
+	    {"LL", &directCall<jobject, jobject>},
+	    {"III", &directCall<jint, jint, jint>},
+	    {"ZII", &directCall<jboolean, jint, jint>},
+	    {"ZJJ", &directCall<jboolean, jlong, jlong>},
+	    {"LII", &directCall<jobject, jint, jint>},
+	    {"ILI", &directCall<jint, jobject, jint>},
+	};
+	auto it = stubs.find(shorty);
+	return it != stubs.end() ? it->second : nullptr;
 }
@@ -21,11 +21,13 @@
 
 #include <ffi.h>
 
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
-#include <variant>
+#include <utility>
 #include <vector>
 
 #include "jni/jni.h"
@@ -33,37 +35,61 @@
 #include "object.hpp"
 
 namespace sandvik {
+	/** @brief Precompiled trampoline calling a native function of a known signature without libffi */
+	using DirectStub = uint64_t (*)(void* function, JNIEnv* env, jobject self, const uint64_t* args);
+
+	/** @brief Native function of a method, resolved and prepared once on its first call */
+	struct NativeBinding {
+			/** resolved native function */
+			void* function = nullptr;
+			/** prepared call interface */
+			ffi_cif cif;
+			/** ffi types of the arguments: JNIEnv*, jobject, then the method parameters */
+			std::vector<ffi_type*> argTypes;
+			/** JNI type character of each method parameter */
+			std::string paramTypes;
+			/** JNI type character of the return value */
+			char returnType = 'V';
+			/** direct call stub of the signature, nullptr to call through libffi */
+			DirectStub stub = nullptr;
+	};
+
 	/** @brief Helper class to invoke native functions */
 	class NativeCallHelper {
 		public:
+			/** @brief Prepares the call interface of a native function, common signatures get a direct call stub
+			 * @param functionPtr Pointer to the native function
+			 * @param paramTypes Parameter types of the method in JNI format
+			 * @param returnType Return type of the method in JNI format
+			 * @return binding to pass to invoke */
+			static std::unique_ptr<NativeBinding> bind(void* functionPtr, const std::vector<std::string>& paramTypes, const std::string& returnType);
 			/** @brief method to invoke native functions
-			 * @param functionPtr Pointer to the native function to invoke
+			 * @param binding Native function and its prepared call interface
 			 * @param env Pointer to the JNI environment
-			 * @param args Vector of Object references representing the arguments
-			 * @param paramTypes String representing the parameter types in JNI format
-			 * @param isStatic Boolean indicating if the method is static
-			 * @param staticClass Object reference representing the static class (if applicable)
-			 * @param returnType String representing the return type in JNI format */
-			static ObjectRef invoke(void* functionPtr, JNIEnv* env, const std::vector<ObjectRef>& args, const std::string& returnType,
-			                        const std::string& paramTypes, bool isStatic, ObjectRef staticClass);
+			 * @param self Receiver of an instance method, class object of a static method
+			 * @param args JNI value of each parameter, read from the registers without boxing: bits of a primitive (a long or a
+			 * double in one value, a float in the low 32 bits) or the jobject pointer
+			 * @return Bits of the return value, the jobject pointer for a reference, 0 for void */
+			static uint64_t invoke(const NativeBinding& binding, JNIEnv* env, jobject self, std::span<const uint64_t> args);
 
 		private:
-			// Internal call context
-			struct CallContext {
-					ffi_cif cif;
-					std::vector<ffi_type*> arg_types;
-					std::string return_type;
-					bool prepared = false;
-			};
+			/** arguments passed without heap allocation */
+			static constexpr size_t MAX_STACK_ARGS = 16;
 
 			// Type conversion helpers
 			static ffi_type* getFFITypeForJNIType(char jniType);
-			static ffi_type* getFFITypeForReturn(const std::string& returnType);
-			static void prepareCallContext(CallContext& context, const std::string& paramTypes, const std::string& returnType,
-			                               std::vector<std::string>& argTypes);
-			static uintptr_t getArgValue(std::vector<ObjectRef>::iterator& it, const char jniType);
-			static ObjectRef getReturnObject(uintptr_t result, const char jniType);
+			template <typename T>
+			static T fromRaw(uint64_t value);
+			template <typename T>
+			static uint64_t toRaw(T value);
+
+			// Direct call stubs
+			static DirectStub findDirectStub(const std::string& shorty);
+			template <typename R, typename... Args>
+			static uint64_t directCall(void* function, JNIEnv* env, jobject self, const uint64_t* args);
+			template <typename R, typename... Args, size_t... I>
+			static uint64_t directCallImpl(void* function, JNIEnv* env, jobject self, const uint64_t* args, std::index_sequence<I...>);
 	};
 }  // namespace sandvik
 
-#endif  // __NATIVE_CALL_HELPER_HPP__
\ No newline at end of file
+#endif  // __NATIVE_CALL_HELPER_HPP__
@@ -20,13 +20,26 @@
 
 #include <fmt/format.h>
 
+#include <unordered_map>
+#include <vector>
+
 #include "array.hpp"
+#include "class.hpp"
 #include "exceptions.hpp"
+#include "field.hpp"
 #include "jni.hpp"
 #include "object.hpp"
 
 using namespace sandvik;
 
+namespace {
+	/** runtime natives by class name, filled during static initialization */
+	std::unordered_map<std::string, std::vector<native::RuntimeNative>>& runtimeNatives() {
+		static std::unordered_map<std::string, std::vector<native::RuntimeNative>> natives;
+		return natives;
+	}
+}  // namespace
+
 Object* native::getObject(jobject jobj) {
 	auto ptr = (Object*)jobj;
 	if (ptr == nullptr) {
@@ -67,4 +80,31 @@ NativeInterface* native::getNativeInterface(JNIEnv* env) {
 		throw VmException("Internal error: JNIEnv is not a NativeInterface");
 	}
 	return jenv;
-}
\ No newline at end of file
+}
+std::atomic_ref<uint64_t> native::getAtomicField(jobject jobj, const std::string& name_) {
+	auto ptr = native::getObject(jobj);
+	const auto* field = ptr->getClass().findInstanceField(name_);
+	if (field == nullptr || field->isReference()) {
+		throw VmException("Internal error: {} has no primitive field '{}'", ptr->toString(), name_);
+	}
+	return std::atomic_ref<uint64_t>(ptr->getFieldSlot(field->getSlot()).value);
+}
+
+native::Registration::Registration(const char* classname_, std::initializer_list<RuntimeNative> natives_) {
+	auto& natives = runtimeNatives()[classname_];
+	natives.insert(natives.end(), natives_.begin(), natives_.end());
+}
+
+void* native::findRuntimeNative(const std::string& classname_, const std::string& name_, const std::string& signature_) {
+	const auto& natives = runtimeNatives();
+	auto it = natives.find(classname_);
+	if (it == natives.end()) {
+		return nullptr;
+	}
+	for (const auto& native : it->second) {
+		if (name_ == native.name && signature_ == native.signature) {
+			return native.function;
+		}
+	}
+	return nullptr;
+}
@@ -19,6 +19,8 @@
 #ifndef __NATIVE_UTILS_HPP__
 #define __NATIVE_UTILS_HPP__
 
+#include <atomic>
+#include <initializer_list>
 #include <string>
 
 #include "jni/jni.h"
@@ -39,6 +41,26 @@ namespace sandvik {
 		Array* getArray(jobject jarray);
 		/** @brief Retrieves the native interface from the Java environment. */
 		NativeInterface* getNativeInterface(JNIEnv* env);
+		/** @brief Retrieves atomic access to a primitive instance field of a Java jobject. */
+		std::atomic_ref<uint64_t> getAtomicField(jobject jobj, const std::string& name_);
+
+		/** @brief Native method of the runtime (src/native), registered by its class name, name and descriptor. */
+		struct RuntimeNative {
+				const char* name;
+				const char* signature;
+				void* function;
+		};
+		/** @brief Static registration of the runtime natives of a class, declared next to their implementation.
+		 * Registered natives are bound without building and looking up their Java_ symbol.
+		 */
+		class Registration {
+			public:
+				Registration(const char* classname_, std::initializer_list<RuntimeNative> natives_);
+		};
+		/** @brief Finds a registered runtime native.
+		 * @return Function pointer, nullptr if the method is not registered.
+		 */
+		void* findRuntimeNative(const std::string& classname_, const std::string& name_, const std::string& signature_);
 	};  // namespace native
 };  // namespace sandvik
 
@@ -22,7 +22,11 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <mutex>
+#include <new>
 #include <stdexcept>
 
 #include "array.hpp"
@@ -177,8 +181,9 @@ namespace sandvik {
 		public:
 			/** Constructor for ObjectClass.
 			 * @param class_ Reference to the Class object.
+			 * @param slots_ Instance field storage, allocated in the same block right after the object.
 			 */
-			explicit ObjectClass(Class& class_);
+			ObjectClass(Class& class_, FieldSlot* slots_);
 			~ObjectClass() override = default;
 
 			/**
@@ -199,6 +204,24 @@ namespace sandvik {
 			 */
 			std::string toString() const override;
 
+			/**
+			 * @brief Sets the value of a field by name.
+			 * @param name_ Name of the field.
+			 * @param value_ ObjectRef to set as the field value.
+			 */
+			void setField(const std::string& name_, ObjectRef value_) override;
+			/**
+			 * @brief Gets the value of a field by name.
+			 * @param name_ Name of the field.
+			 * @return ObjectRef of the field value.
+			 */
+			ObjectRef getField(const std::string& name_) const override;
+
+			/** Visit outgoing references
+			 * @param visitor_ function to call for each referenced object
+			 */
+			void visitReferences(const std::function<void(Object*)>& visitor_) const override;
+
 		private:
 			Class& _class;
 	};
@@ -207,9 +230,10 @@ namespace sandvik {
 		public:
 			/** Constructor for ConstClassObject.
 			 * @param class_ Reference to the Class object.
+			 * @param slots_ Instance field storage.
 			 * @param classtype_ Reference to the Class type.
 			 */
-			ConstClassObject(Class& class_, Class& classtype_);
+			ConstClassObject(Class& class_, FieldSlot* slots_, Class& classtype_);
 			~ConstClassObject() override = default;
 
 			const Class& getClassType() const override;
@@ -244,9 +268,16 @@ namespace sandvik {
 		public:
 			/** Constructor for StringObject.
 			 * @param class_ Reference to the Class object.
+			 * @param slots_ Instance field storage.
 			 * @param value_ String value to initialize the object.
 			 */
-			StringObject(Class& class_, const std::string& value_);
+			StringObject(Class& class_, FieldSlot* slots_, const std::string& value_);
+			/** Constructor for StringObject.
+			 * @param class_ Reference to the Class object.
+			 * @param slots_ Instance field storage.
+			 * @param chars_ Java chars to initialize the object.
+			 */
+			StringObject(Class& class_, FieldSlot* slots_, const StringChars& chars_);
 			~StringObject() override = default;
 
 			/**
@@ -266,12 +297,26 @@ namespace sandvik {
 			 * @throw std::bad_cast if the object is not a string.
 			 */
 			std::u16string str16() const override;
+			/**
+			 * @brief Gets the characters of the string without copy.
+			 * @return Views on the Latin-1 or UTF-16 storage of the string.
+			 */
+			StringChars chars() const override;
+			/**
+			 * @brief Gets the java hash code of the string, computed on first use.
+			 * @return Cached hash code.
+			 */
+			int32_t stringHash() const override;
 			/**
 			 * @brief Set the string value of the object.
-			 * @param str_ String value.
-			 * @throw std::bad_cast if the object is not a string.
+			 * @param str_ UTF-8 string value.
 			 */
 			void setString(const std::string& str_) override;
+			/**
+			 * @brief Set the string value of the object from java chars.
+			 * @param chars_ Characters of the string.
+			 */
+			void setString(const StringChars& chars_) override;
 
 			/**
 			 * @brief Returns a toString string representation of the object.
@@ -286,7 +331,12 @@ namespace sandvik {
 			bool operator==(const Object& other) const override;
 
 		private:
-			std::string _value;
+			/** compact storage, one Latin-1 byte per char */
+			std::string _latin1;
+			/** UTF-16 storage, only used when a char does not fit in Latin-1 */
+			std::u16string _utf16;
+			/** cached hash code, 0 until computed */
+			mutable std::atomic<int32_t> _hash = 0;
 	};
 	/** @brief Null object representing Java null references. */
 	class NullObject : public Object {
@@ -316,41 +366,50 @@ using namespace sandvik;
 
 static const std::unique_ptr<NullObject> NULL_OBJ = std::make_unique<NullObject>();
 
+/** Allocate an ObjectClass (or derived) instance and its field slots as a single cell of the managed heap.
+ * @param class_ class of the instance
+ * @param args_ extra constructor arguments
+ * @return tracked object
+ */
+template <typename T, typename... Args>
+static ObjectRef makeInstance(Class& class_, Args&&... args_) {
+	static_assert(sizeof(T) % alignof(FieldSlot) == 0, "field slots must be aligned");
+	const auto count = class_.getInstanceFieldCount();
+	auto& gc = GC::getInstance();
+	void* mem = gc.allocate(sizeof(T) + count * sizeof(FieldSlot));
+	auto* slots = reinterpret_cast<FieldSlot*>(static_cast<uint8_t*>(mem) + sizeof(T));
+	try {
+		return new (mem) T(class_, slots, std::forward<Args>(args_)...);
+	} catch (...) {
+		gc.abandon(mem);
+		throw;
+	}
+}
+
 ObjectRef Object::make(Class& class_) {
 	if (class_.getFullname() == "java.lang.String") {
-		auto u = std::make_unique<StringObject>(class_, "");
-		auto ptr = u.get();
-		GC::getInstance().track(std::move(u));
-		return ptr;
+		return makeInstance<StringObject>(class_, std::string());
 	} else {
-		auto u = std::make_unique<ObjectClass>(class_);
-		auto ptr = u.get();
-		GC::getInstance().track(std::move(u));
-		return ptr;
+		return makeInstance<ObjectClass>(class_);
 	}
 }
 ObjectRef Object::make(uint64_t number_) {
-	auto u = std::make_unique<NumberObject>(number_);
-	auto ptr = u.get();
-	GC::getInstance().track(std::move(u));
-	return ptr;
+	return GC::getInstance().make<NumberObject>(number_);
 }
 ObjectRef Object::make(ClassLoader& classloader_, const std::string& str_) {
 	auto& clazz = classloader_.getOrLoad("java.lang.String");
-	auto u = std::make_unique<StringObject>(clazz, str_);
-	auto ptr = u.get();
-	GC::getInstance().track(std::move(u));
-	return ptr;
+	return makeInstance<StringObject>(clazz, str_);
+}
+ObjectRef Object::makeString(ClassLoader& classloader_, const StringChars& chars_) {
+	auto& clazz = classloader_.getOrLoad("java.lang.String");
+	return makeInstance<StringObject>(clazz, chars_);
 }
 ObjectRef Object::makeNull() {
 	return NULL_OBJ.get();
 }
 ObjectRef Object::makeConstClass(ClassLoader& classloader_, Class& classtype_) {
 	auto& clazz = classloader_.getOrLoad("java.lang.Class");
-	auto u = std::make_unique<ConstClassObject>(clazz, classtype_);
-	auto ptr = u.get();
-	GC::getInstance().track(std::move(u));
-	return ptr;
+	return makeInstance<ConstClassObject>(clazz, classtype_);
 }
 
 ObjectRef Object::makeArray(ClassLoader& classloader_, const Class& classtype_, const std::vector<uint32_t>& dimensions_) {
@@ -358,7 +417,36 @@ ObjectRef Object::makeArray(ClassLoader& classloader_, const Class& classtype_,
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-Object::Object() : _monitor(std::make_unique<Monitor>()) {
+namespace {
+	static_assert(sizeof(uintptr_t) == sizeof(uint64_t), "thin lock word needs 64 bits");
+	/** lock word tag of an inflated lock, the other bits are the Monitor address */
+	constexpr uintptr_t INFLATED = 1;
+	/** thin lock: owner thread id in the high 32 bits, recursion count above the tag bit */
+	constexpr uintptr_t RECURSION_ONE = 2;
+
+	inline uintptr_t thinLock(uint32_t owner_, uint32_t recursion_) {
+		return (static_cast<uintptr_t>(owner_) << 32) | (static_cast<uintptr_t>(recursion_) << 1);
+	}
+	inline uint32_t thinOwner(uintptr_t word_) {
+		return static_cast<uint32_t>(word_ >> 32);
+	}
+	inline uint32_t thinRecursion(uintptr_t word_) {
+		return static_cast<uint32_t>(word_) >> 1;
+	}
+	inline bool isInflated(uintptr_t word_) {
+		return word_ & INFLATED;
+	}
+	inline Monitor* monitorOf(uintptr_t word_) {
+		return reinterpret_cast<Monitor*>(word_ & ~INFLATED);
+	}
+}  // namespace
+
+Object::Object() = default;
+
+Object::~Object() {
+	if (auto word = _lock.load(std::memory_order_acquire); isInflated(word)) {
+		delete monitorOf(word);
+	}
 }
 
 bool Object::operator==(const Object& other) const {
@@ -381,27 +469,91 @@ ObjectRef Object::clone() const {
 }
 
 void Object::monitorEnter() {
-	_monitor->enter();
+	const auto self = Monitor::currentThreadId();
+	auto word = _lock.load(std::memory_order_acquire);
+	while (true) {
+		if (word == 0) {
+			if (_lock.compare_exchange_weak(word, thinLock(self, 1), std::memory_order_acquire, std::memory_order_acquire)) {
+				return;
+			}
+		} else if (isInflated(word)) {
+			monitorOf(word)->enter();
+			return;
+		} else if (thinOwner(word) == self) {
+			// only the owner changes the recursion count, but another thread may inflate the lock meanwhile
+			if (_lock.compare_exchange_weak(word, word + RECURSION_ONE, std::memory_order_relaxed, std::memory_order_acquire)) {
+				return;
+			}
+		} else {
+			// contention: inflate the thin lock on behalf of its owner, then block on the monitor
+			inflate()->enter();
+			return;
+		}
+	}
 }
 
 void Object::monitorExit() {
-	_monitor->exit();
+	const auto self = Monitor::currentThreadId();
+	auto word = _lock.load(std::memory_order_acquire);
+	while (true) {
+		if (isInflated(word)) {
+			monitorOf(word)->exit();
+			return;
+		}
+		if (word == 0 || thinOwner(word) != self) {
+			throw std::runtime_error("IllegalMonitorStateException: current thread does not own the monitor");
+		}
+		const auto next = thinRecursion(word) > 1 ? word - RECURSION_ONE : 0;
+		if (_lock.compare_exchange_weak(word, next, std::memory_order_release, std::memory_order_acquire)) {
+			return;
+		}
+	}
 }
 
-void Object::monitorCheck() const {
-	_monitor->check();
+bool Object::isLockInflated() const {
+	return isInflated(_lock.load(std::memory_order_acquire));
+}
+
+Monitor* Object::inflate() {
+	auto word = _lock.load(std::memory_order_acquire);
+	while (!isInflated(word)) {
+		auto monitor = word == 0 ? std::make_unique<Monitor>() : std::make_unique<Monitor>(thinOwner(word), thinRecursion(word));
+		if (_lock.compare_exchange_strong(word, reinterpret_cast<uintptr_t>(monitor.get()) | INFLATED, std::memory_order_acq_rel,
+		                                  std::memory_order_acquire)) {
+			return monitor.release();
+		}
+	}
+	return monitorOf(word);
+}
+
+void Object::monitorWait() const {
+	const auto self = Monitor::currentThreadId();
+	auto word = _lock.load(std::memory_order_acquire);
+	// thin lock: no Monitor to block on, yield until the owner releases it
+	while (word != 0 && !isInflated(word) && thinOwner(word) != self) {
+		std::this_thread::yield();
+		word = _lock.load(std::memory_order_acquire);
+	}
+	if (isInflated(word)) {
+		monitorOf(word)->check();
+	}
 }
 
 void Object::wait(uint64_t timeout_) {
-	_monitor->wait(timeout_);
+	inflate()->wait(timeout_);
 }
 
 void Object::notify() {
-	_monitor->notify();
+	// waiters only exist once the lock is inflated
+	if (auto word = _lock.load(std::memory_order_acquire); isInflated(word)) {
+		monitorOf(word)->notify();
+	}
 }
 
 void Object::notifyAll() {
-	_monitor->notifyAll();
+	if (auto word = _lock.load(std::memory_order_acquire); isInflated(word)) {
+		monitorOf(word)->notifyAll();
+	}
 }
 
 bool Object::isNumberObject() const {
@@ -477,10 +629,22 @@ std::u16string Object::str16() const {
 	throw std::bad_cast();
 }
 
+StringChars Object::chars() const {
+	throw std::bad_cast();
+}
+
+int32_t Object::stringHash() const {
+	throw std::bad_cast();
+}
+
 void Object::setString(const std::string& str_) {
 	throw std::bad_cast();
 }
 
+void Object::setString(const StringChars& chars_) {
+	throw std::bad_cast();
+}
+
 const Class& Object::getClassType() const {
 	throw std::bad_cast();
 }
@@ -496,30 +660,64 @@ int32_t Object::identityHashCode() const {
 	return static_cast<int32_t>(XXH32(&ptr, sizeof(ptr), 0));
 }
 
+namespace {
+	/** serializes the accesses to private fields with their insertions and concurrent marking, striped by object */
+	std::array<std::mutex, 64> privateFieldsMutexes;
+	std::mutex& privateFieldsMutex(const Object* obj_) {
+		return privateFieldsMutexes[(reinterpret_cast<uintptr_t>(obj_) / Heap::ALIGNMENT) % privateFieldsMutexes.size()];
+	}
+}  // namespace
+
 ObjectRef Object::getField(const std::string& name_) const {
 	monitorCheck();  // Ensure the current thread owns the monitor (if locked)
-	auto it = _fields.find(name_);
-	if (it != _fields.end()) {
-		return it->second;
+	{
+		std::lock_guard<std::mutex> lock(privateFieldsMutex(this));
+		if (_privateFields) {
+			auto it = _privateFields->find(name_);
+			if (it != _privateFields->end()) {
+				return it->second;
+			}
+		}
 	}
 	throw std::out_of_range(fmt::format("Field '{}' does not exist in object {}", name_, this->toString()));
 }
 
 void Object::setField(const std::string& name_, ObjectRef value_) {
 	monitorCheck();  // Ensure the current thread owns the monitor (if locked)
-	_fields[name_] = value_;
+	GC::writeBarrier(value_);
+	// the lookup races with insertions of other threads, the map may be rebalanced meanwhile
+	std::lock_guard<std::mutex> lock(privateFieldsMutex(this));
+	if (!_privateFields) {
+		_privateFields = std::make_unique<std::map<std::string, ObjectRef, std::less<>>>();
+	}
+	(*_privateFields)[name_] = value_;
+}
+
+void Object::throwInvalidSlot(uint32_t slot_) const {
+	throw std::out_of_range(fmt::format("Field slot {} does not exist in object {} ({} slots)", slot_, this->toString(), _slotCount));
 }
 
 void Object::setMarked(bool v_) {
-	_marked.store(v_, std::memory_order_relaxed);
+	const auto epoch = _markEpoch.load(std::memory_order_relaxed);
+	_mark.store(v_ ? epoch : epoch - 1, std::memory_order_relaxed);
 }
 bool Object::isMarked() const {
-	return _marked.load(std::memory_order_relaxed);
+	return _mark.load(std::memory_order_relaxed) == _markEpoch.load(std::memory_order_relaxed);
+}
+void Object::beginMarkCycle() {
+	_markEpoch.fetch_add(1, std::memory_order_relaxed);
 }
 void Object::visitReferences(const std::function<void(Object*)>& visitor_) const {
-	for (const auto& [name, obj] : _fields) {
+	if (!_privateFields) {
+		return;
+	}
+	// the running threads only insert fields while the heap is marked concurrently, the world is stopped otherwise
+	std::unique_lock<std::mutex> lock(privateFieldsMutex(this), std::defer_lock);
+	if (GC::isMarking()) {
+		lock.lock();
+	}
+	for (const auto& [name, obj] : *_privateFields) {
 		visitor_(obj);
-		obj->visitReferences(visitor_);
 	}
 }
 
@@ -588,7 +786,84 @@ std::string NumberObject::toString() const {
 	return fmt::format("{}", (int64_t)_value.load());
 }
 ///////////////////////////////////////////////////////////////////////////////
-StringObject::StringObject(Class& class_, const std::string& value_) : ObjectClass(class_), _value(value_) {
+namespace {
+	/** Decode (modified) UTF-8 into UTF-16 code units, bytes of an invalid sequence are taken as Latin-1 chars */
+	std::u16string decodeUtf8(std::string_view str_) {
+		std::u16string out;
+		out.reserve(str_.size());
+		size_t i = 0;
+		while (i < str_.size()) {
+			auto c = static_cast<unsigned char>(str_[i]);
+			auto continuation = [&](size_t n_) {
+				return i + n_ < str_.size() && (static_cast<unsigned char>(str_[i + n_]) & 0xC0) == 0x80;
+			};
+			auto byte = [&](size_t n_) {
+				return static_cast<uint32_t>(static_cast<unsigned char>(str_[i + n_]) & 0x3F);
+			};
+			if (c >= 0xC0 && c < 0xE0 && continuation(1)) {
+				out.push_back(static_cast<char16_t>(((c & 0x1F) << 6) | byte(1)));
+				i += 2;
+			} else if (c >= 0xE0 && c < 0xF0 && continuation(1) && continuation(2)) {
+				out.push_back(static_cast<char16_t>(((c & 0x0F) << 12) | (byte(1) << 6) | byte(2)));
+				i += 3;
+			} else if (c >= 0xF0 && c < 0xF8 && continuation(1) && continuation(2) && continuation(3)) {
+				uint32_t cp = (((c & 0x07) << 18) | (byte(1) << 12) | (byte(2) << 6) | byte(3)) - 0x10000;
+				out.push_back(static_cast<char16_t>(0xD800 + (cp >> 10)));
+				out.push_back(static_cast<char16_t>(0xDC00 + (cp & 0x3FF)));
+				i += 4;
+			} else {
+				out.push_back(c);
+				i += 1;
+			}
+		}
+		return out;
+	}
+	/** Encode a java char as UTF-8, surrogate pairs are joined by the caller */
+	void appendUtf8(std::string& out_, uint32_t cp_) {
+		if (cp_ < 0x80) {
+			out_.push_back(static_cast<char>(cp_));
+		} else if (cp_ < 0x800) {
+			out_.push_back(static_cast<char>(0xC0 | (cp_ >> 6)));
+			out_.push_back(static_cast<char>(0x80 | (cp_ & 0x3F)));
+		} else if (cp_ < 0x10000) {
+			out_.push_back(static_cast<char>(0xE0 | (cp_ >> 12)));
+			out_.push_back(static_cast<char>(0x80 | ((cp_ >> 6) & 0x3F)));
+			out_.push_back(static_cast<char>(0x80 | (cp_ & 0x3F)));
+		} else {
+			out_.push_back(static_cast<char>(0xF0 | (cp_ >> 18)));
+			out_.push_back(static_cast<char>(0x80 | ((cp_ >> 12) & 0x3F)));
+			out_.push_back(static_cast<char>(0x80 | ((cp_ >> 6) & 0x3F)));
+			out_.push_back(static_cast<char>(0x80 | (cp_ & 0x3F)));
+		}
+	}
+	bool isAscii(std::string_view str_) {
+		return std::all_of(str_.begin(), str_.end(), [](char c_) { return static_cast<unsigned char>(c_) < 0x80; });
+	}
+}  // namespace
+
+bool StringChars::operator==(const StringChars& other_) const {
+	if (isCompact() && other_.isCompact()) {
+		return latin1 == other_.latin1;
+	}
+	if (!isCompact() && !other_.isCompact()) {
+		return utf16 == other_.utf16;
+	}
+	if (size() != other_.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < size(); ++i) {
+		if ((*this)[i] != other_[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+StringObject::StringObject(Class& class_, FieldSlot* slots_, const std::string& value_) : ObjectClass(class_, slots_) {
+	setString(value_);
+}
+StringObject::StringObject(Class& class_, FieldSlot* slots_, const StringChars& chars_) : ObjectClass(class_, slots_) {
+	setString(chars_);
 }
 
 bool StringObject::operator==(const Object& other) const {
@@ -599,76 +874,126 @@ bool StringObject::operator==(const Object& other) const {
 	if (otherString == nullptr) {
 		return false;
 	}
-	return _value == otherString->_value;
+	// both strings are stored compact whenever possible, a compact string never equals a UTF-16 one
+	if (_utf16.empty() != otherString->_utf16.empty()) {
+		return false;
+	}
+	return _latin1 == otherString->_latin1 && _utf16 == otherString->_utf16;
 }
 
 bool StringObject::isString() const {
 	return true;
 }
 std::string StringObject::str() const {
-	return _value;
+	if (_utf16.empty() && isAscii(_latin1)) {
+		return _latin1;
+	}
+	auto view = chars();
+	std::string out;
+	out.reserve(view.size());
+	for (size_t i = 0; i < view.size(); ++i) {
+		uint32_t c = view[i];
+		if (c >= 0xD800 && c <= 0xDBFF && i + 1 < view.size() && view[i + 1] >= 0xDC00 && view[i + 1] <= 0xDFFF) {
+			c = 0x10000 + ((c - 0xD800) << 10) + (view[++i] - 0xDC00);
+		}
+		appendUtf8(out, c);
+	}
+	return out;
 }
 std::u16string StringObject::str16() const {
-	return std::u16string(_value.begin(), _value.end());
+	if (!_utf16.empty()) {
+		return _utf16;
+	}
+	std::u16string out(_latin1.size(), u'\0');
+	std::transform(_latin1.begin(), _latin1.end(), out.begin(), [](char c_) { return static_cast<char16_t>(static_cast<unsigned char>(c_)); });
+	return out;
+}
+StringChars StringObject::chars() const {
+	return StringChars{_latin1, _utf16};
+}
+int32_t StringObject::stringHash() const {
+	// racy initialization is benign, every thread computes the same value
+	auto hash = _hash.load(std::memory_order_relaxed);
+	if (hash == 0) {
+		auto view = chars();
+		uint32_t h = 0;
+		for (size_t i = 0; i < view.size(); ++i) {
+			h = 31 * h + view[i];
+		}
+		hash = static_cast<int32_t>(h);
+		_hash.store(hash, std::memory_order_relaxed);
+	}
+	return hash;
 }
 std::string StringObject::toString() const {
-	return "\"" + _value + "\"";
+	return "\"" + str() + "\"";
 }
 void StringObject::setString(const std::string& str_) {
-	_value = str_;
+	if (isAscii(str_)) {
+		_latin1 = str_;
+		_utf16.clear();
+		_hash.store(0, std::memory_order_relaxed);
+		return;
+	}
+	auto decoded = decodeUtf8(str_);
+	setString(StringChars{{}, decoded});
+}
+void StringObject::setString(const StringChars& chars_) {
+	std::string latin1;
+	std::u16string utf16;
+	if (chars_.isCompact()) {
+		latin1 = chars_.latin1;
+	} else if (std::all_of(chars_.utf16.begin(), chars_.utf16.end(), [](char16_t c_) { return c_ <= 0xFF; })) {
+		latin1.resize(chars_.utf16.size());
+		std::transform(chars_.utf16.begin(), chars_.utf16.end(), latin1.begin(), [](char16_t c_) { return static_cast<char>(c_); });
+	} else {
+		utf16 = chars_.utf16;
+	}
+	// chars_ may be a view on this string, swap in once copied
+	_latin1.swap(latin1);
+	_utf16.swap(utf16);
+	_hash.store(0, std::memory_order_relaxed);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-ObjectClass::ObjectClass(Class& class_) : _class(class_) {
-	for (const auto& fieldname : _class.getFieldList()) {
-		const auto& field = _class.getField(fieldname);
-		if (!field.isStatic()) {
-			logger.fdebug("New instance of {}: Adding field {} type={}", _class.getFullname(), fieldname, field.getType());
-			switch (field.getType()[0]) {
-				case 'I':
-				case 'Z':
-				case 'B':
-				case 'S':
-				case 'C':
-				case 'J':
-				case 'F':
-				case 'D':
-					_fields[fieldname] = Object::make(0);
-					break;
-				default:
-					_fields[fieldname] = Object::makeNull();
-					break;
-			}
+ObjectClass::ObjectClass(Class& class_, FieldSlot* slots_) : _class(class_) {
+	_slots = slots_;
+	_slotCount = _class.getInstanceFieldCount();
+	std::fill_n(_slots, _slotCount, FieldSlot{0});
+	for (auto slot : _class.getReferenceSlots()) {
+		_slots[slot].ref = Object::makeNull();
+	}
+}
+ObjectRef ObjectClass::getField(const std::string& name_) const {
+	if (const auto* field = _class.findInstanceField(name_)) {
+		monitorCheck();  // Ensure the current thread owns the monitor (if locked)
+		const auto& slot = _slots[field->getSlot()];
+		return field->isReference() ? slot.ref : Object::make(slot.value);
+	}
+	return Object::getField(name_);
+}
+void ObjectClass::setField(const std::string& name_, ObjectRef value_) {
+	if (const auto* field = _class.findInstanceField(name_)) {
+		monitorCheck();  // Ensure the current thread owns the monitor (if locked)
+		auto& slot = _slots[field->getSlot()];
+		if (field->isReference()) {
+			GC::writeBarrier(value_);
+			slot.ref = value_;
+		} else {
+			slot.value = value_->isNumberObject() ? static_cast<uint64_t>(value_->getLongValue()) : 0;
 		}
+		return;
 	}
-	Class* current = &_class;
-	while (current->hasSuperClass()) {
-		logger.fdebug("super class {}", current->getSuperClassname());
-		current = &current->getSuperClass();
-		for (const auto& fieldname : current->getFieldList()) {
-			const auto& field = current->getField(fieldname);
-			if (!field.isStatic()) {
-				logger.fdebug("New instance of {} inherits from ({}): Adding field {} type={}", _class.getFullname(), current->getFullname(), fieldname,
-				              field.getType());
-				switch (field.getType()[0]) {
-					case 'I':
-					case 'Z':
-					case 'B':
-					case 'S':
-					case 'C':
-					case 'J':
-					case 'F':
-					case 'D':
-						_fields[fieldname] = Object::make(0);
-						break;
-					default:
-						_fields[fieldname] = Object::makeNull();
-						break;
-				}
-			}
+	Object::setField(name_, value_);
+}
+void ObjectClass::visitReferences(const std::function<void(Object*)>& visitor_) const {
+	for (auto slot : _class.getReferenceSlots()) {
+		if (auto obj = _slots[slot].ref) {
+			visitor_(obj);
 		}
 	}
+	Object::visitReferences(visitor_);
 }
 bool ObjectClass::isClass() const {
 	return true;
@@ -680,7 +1005,7 @@ std::string ObjectClass::toString() const {
 	return _class.getFullname();
 }
 ///////////////////////////////////////////////////////////////////////////////
-ConstClassObject::ConstClassObject(Class& class_, Class& classtype_) : ObjectClass(class_), _type(classtype_) {
+ConstClassObject::ConstClassObject(Class& class_, FieldSlot* slots_, Class& classtype_) : ObjectClass(class_, slots_), _type(classtype_) {
 }
 
 bool ConstClassObject::operator==(const Object& other) const {
@@ -26,9 +26,12 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
+#include "gc.hpp"
+
 namespace sandvik {
 	class ClassLoader;
 	class Class;
@@ -38,6 +41,43 @@ namespace sandvik {
 
 	/** @brief Object reference type */
 	using ObjectRef = Object*;
+
+	/** @brief Instance field storage slot.
+	 *
+	 * Holds either a raw primitive value or a reference, depending on the type of the field
+	 * assigned to the slot when its class is linked.
+	 */
+	union FieldSlot {
+			uint64_t value;
+			ObjectRef ref;
+	};
+	/** @brief Characters of a java string.
+	 *
+	 * A string is stored compact, one Latin-1 byte per char, unless one of its chars is above U+00FF; it is then stored
+	 * as UTF-16 code units. The views point into the string object and stay valid as long as the object is alive.
+	 */
+	struct StringChars {
+			/** @brief Chars of a compact string */
+			std::string_view latin1;
+			/** @brief Chars of a non compact string, empty for a compact string */
+			std::u16string_view utf16;
+
+			bool isCompact() const {
+				return utf16.empty();
+			}
+			size_t size() const {
+				return isCompact() ? latin1.size() : utf16.size();
+			}
+			char16_t operator[](size_t idx_) const {
+				return isCompact() ? static_cast<char16_t>(static_cast<unsigned char>(latin1[idx_])) : utf16[idx_];
+			}
+			/** @brief Gets a view of count_ chars starting at pos_, bounds are checked by the caller. */
+			StringChars substr(size_t pos_, size_t count_) const {
+				return isCompact() ? StringChars{latin1.substr(pos_, count_), {}} : StringChars{{}, utf16.substr(pos_, count_)};
+			}
+			bool operator==(const StringChars& other_) const;
+	};
+
 	/**
 	 * @class Object
 	 * @brief Base class representing a generic java object.
@@ -49,7 +89,7 @@ namespace sandvik {
 	class Object {
 		public:
 			Object();
-			virtual ~Object() = default;
+			virtual ~Object();
 
 			/**
 			 * @brief Deleted copy constructor.
@@ -106,6 +146,14 @@ namespace sandvik {
 			 */
 			static ObjectRef make(ClassLoader& classloader_, const std::string& str_);
 
+			/**
+			 * @brief Creates a string ObjectRef from java chars.
+			 * @param classloader_ Reference to the ClassLoader.
+			 * @param chars_ Characters of the string, copied in the new object.
+			 * @return ObjectRef to the created object.
+			 */
+			static ObjectRef makeString(ClassLoader& classloader_, const StringChars& chars_);
+
 			/**
 			 * @brief Creates a constant class ObjectRef for Class<?> objects.
 			 * @param classloader_ Reference to the ClassLoader.
@@ -313,18 +361,69 @@ namespace sandvik {
 			virtual const Class& getClassType() const;
 
 			/**
-			 * @brief Sets the value of a field.
+			 * @brief Sets the value of a field by name.
+			 *
+			 * Slow path used by natives: primitive fields are unboxed from a number object.
+			 * Names not declared by the class are kept as VM private fields.
 			 * @param name_ Name of the field.
 			 * @param value_ ObjectRef to set as the field value.
 			 */
-			void setField(const std::string& name_, ObjectRef value_);
+			virtual void setField(const std::string& name_, ObjectRef value_);
 
 			/**
-			 * @brief Gets the value of a field.
+			 * @brief Gets the value of a field by name.
+			 *
+			 * Slow path used by natives: primitive fields are boxed in a number object.
 			 * @param name_ Name of the field.
 			 * @return ObjectRef of the field value.
 			 */
-			ObjectRef getField(const std::string& name_) const;
+			virtual ObjectRef getField(const std::string& name_) const;
+
+			/**
+			 * @brief Gets the raw value of a primitive instance field.
+			 * @param slot_ Slot of the field (see Field::getSlot).
+			 * @return Raw field value.
+			 */
+			inline uint64_t getFieldValue(uint32_t slot_) const {
+				return getFieldSlot(slot_).value;
+			}
+			/**
+			 * @brief Sets the raw value of a primitive instance field.
+			 * @param slot_ Slot of the field (see Field::getSlot).
+			 * @param value_ Raw field value.
+			 */
+			inline void setFieldValue(uint32_t slot_, uint64_t value_) {
+				getFieldSlot(slot_).value = value_;
+			}
+			/**
+			 * @brief Gets the value of a reference instance field.
+			 * @param slot_ Slot of the field (see Field::getSlot).
+			 * @return ObjectRef of the field value.
+			 */
+			inline ObjectRef getFieldObject(uint32_t slot_) const {
+				return getFieldSlot(slot_).ref;
+			}
+			/**
+			 * @brief Sets the value of a reference instance field.
+			 * @param slot_ Slot of the field (see Field::getSlot).
+			 * @param value_ ObjectRef to set as the field value.
+			 */
+			inline void setFieldObject(uint32_t slot_, ObjectRef value_) {
+				GC::writeBarrier(value_);
+				getFieldSlot(slot_).ref = value_;
+			}
+			/**
+			 * @brief Gets an instance field slot.
+			 * @param slot_ Slot of the field (see Field::getSlot).
+			 * @return Reference to the slot storage.
+			 * @throw std::out_of_range if the object has no such slot.
+			 */
+			inline FieldSlot& getFieldSlot(uint32_t slot_) const {
+				if (slot_ >= _slotCount) [[unlikely]] {
+					throwInvalidSlot(slot_);
+				}
+				return _slots[slot_];
+			}
 
 			///@}
 
@@ -339,7 +438,7 @@ namespace sandvik {
 			virtual bool isString() const;
 			/**
 			 * @brief Gets the string value of the object.
-			 * @return String value.
+			 * @return UTF-8 string value.
 			 * @throw std::bad_cast if the object is not a string.
 			 */
 			virtual std::string str() const;
@@ -349,22 +448,50 @@ namespace sandvik {
 			 * @throw std::bad_cast if the object is not a string.
 			 */
 			virtual std::u16string str16() const;
+			/**
+			 * @brief Gets the characters of the string without copy.
+			 * @return Views on the Latin-1 or UTF-16 storage of the string.
+			 * @throw std::bad_cast if the object is not a string.
+			 */
+			virtual StringChars chars() const;
+			/**
+			 * @brief Gets the java hash code of the string, computed once then cached.
+			 * @return s[0]*31^(n-1) + s[1]*31^(n-2) + ... + s[n-1]
+			 * @throw std::bad_cast if the object is not a string.
+			 */
+			virtual int32_t stringHash() const;
 			/**
 			 * @brief Set the string value of the object.
-			 * @param str_ String value.
+			 *
+			 * Strings are immutable, only the String constructors natives initialize the value.
+			 * @param str_ UTF-8 string value.
 			 * @throw std::bad_cast if the object is not a string.
 			 */
 			virtual void setString(const std::string& str_);
+			/**
+			 * @brief Set the string value of the object from java chars.
+			 * @param chars_ Characters of the string.
+			 * @throw std::bad_cast if the object is not a string.
+			 */
+			virtual void setString(const StringChars& chars_);
 			///@}
 
 			/**
 			 * @name Thread synchronization methods.
 			 */
 			///@{
-			/** @brief Enter monitor */
+			/** @brief Enter monitor
+			 *
+			 * An uncontended lock is a thin lock: the owner thread and recursion count are set in the lock word with a CAS.
+			 * The lock is inflated into a Monitor on contention or on wait.
+			 */
 			virtual void monitorEnter();
 			/** @brief Exit monitor */
 			virtual void monitorExit();
+			/** @brief Checks if the lock has been inflated into a Monitor.
+			 * @return true if the object owns a Monitor
+			 */
+			bool isLockInflated() const;
 
 			/** @brief Causes the current thread to wait until either another thread invokes the notify methods
 			 * @param timeout_ the maximum time to wait in milliseconds.
@@ -391,24 +518,53 @@ namespace sandvik {
 			 * @param v_ true to mark the object, false to unmark
 			 */
 			void setMarked(bool v_);
-			/** check if object is marked
+			/** check if object is marked in the current mark cycle
 			 * @return true if object is marked */
 			bool isMarked() const;
-			/** Visit outgoing references
+			/** Mark the object in the current mark cycle
+			 * @return true if the object was not marked yet (the caller has to visit its references)
+			 */
+			inline bool mark() {
+				const auto epoch = _markEpoch.load(std::memory_order_relaxed);
+				return _mark.exchange(epoch, std::memory_order_relaxed) != epoch;
+			}
+			/** Start a new mark cycle: every existing object becomes unmarked.
+			 * Objects created afterwards are marked (allocated black), so they survive the cycle.
+			 */
+			static void beginMarkCycle();
+			/** Visit outgoing references, the direct references only
 			 * @param visitor_ function to call for each referenced object
 			 */
 			virtual void visitReferences(const std::function<void(Object*)>& visitor_) const;
 			///@}
 
 		protected:
-			/** Check monitor ownership */
-			void monitorCheck() const;
-			/** Map storing field names and their corresponding values. */
-			std::map<std::string, ObjectRef, std::less<>> _fields;
-			/** Monitor for thread synchronization */
-			std::unique_ptr<Monitor> _monitor;
-			/** Mark bit for GC */
-			std::atomic<bool> _marked{false};
+			/** Check monitor ownership: block while another thread holds the lock */
+			inline void monitorCheck() const {
+				if (_lock.load(std::memory_order_acquire) != 0) [[unlikely]] {
+					monitorWait();
+				}
+			}
+			void monitorWait() const;
+			/** Inflate the lock word into a Monitor, keeping the thin lock owner
+			 * @return the monitor of the object
+			 */
+			Monitor* inflate();
+			/** throw std::out_of_range for an invalid field slot */
+			[[noreturn]] void throwInvalidSlot(uint32_t slot_) const;
+			/** Instance field slots, allocated with the object */
+			FieldSlot* _slots = nullptr;
+			/** Number of instance field slots */
+			uint32_t _slotCount = 0;
+			/** VM private fields set by natives that are not declared by the class, allocated on first use */
+			std::unique_ptr<std::map<std::string, ObjectRef, std::less<>>> _privateFields;
+			/** Lock word: 0 when unlocked, owner thread id and recursion count of a thin lock,
+			 * or pointer to the inflated Monitor tagged with the low bit */
+			std::atomic<uintptr_t> _lock{0};
+			/** Mark cycle the object was last marked in */
+			std::atomic<uint32_t> _mark{_markEpoch.load(std::memory_order_relaxed)};
+			/** Current mark cycle */
+			static inline std::atomic<uint32_t> _markEpoch{0};
 	};
 }  // namespace sandvik
 
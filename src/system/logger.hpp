@@ -68,6 +68,13 @@ namespace sandvik {
 			 * @return log level
 			 */
 			LogLevel getLevel() const;
+			/** return true if a message of the given level would be logged
+			 * @param level_ log level
+			 * @return true if level_ passes the current log level
+			 */
+			inline bool isEnabled(LogLevel level_) const {
+				return level_ >= _level;
+			}
 			/** set log level
 			 * @param level_ log level
 			 */
@@ -261,4 +268,30 @@ namespace sandvik {
 	}
 }  // namespace sandvik
 
+/** Level checked logging macros.
+ * The arguments are only evaluated and formatted if the level is enabled, so they are safe to use on hot paths.
+ * When built with __strip_debug_log__, LOG_DEBUG is compiled out entirely (arguments are still type checked).
+ */
+#define SANDVIK_LOG(level_, func_, ...)                                           \
+	do {                                                                          \
+		if (logger.isEnabled(::sandvik::Logger::LogLevel::level_)) [[unlikely]] { \
+			logger.func_(__VA_ARGS__);                                            \
+		}                                                                         \
+	} while (0)
+
+#ifdef __strip_debug_log__
+#define LOG_DEBUG(...)                  \
+	do {                                \
+		if constexpr (false) {          \
+			logger.fdebug(__VA_ARGS__); \
+		}                               \
+	} while (0)
+#else
+#define LOG_DEBUG(...) SANDVIK_LOG(DEBUG, fdebug, __VA_ARGS__)
+#endif
+#define LOG_INFO(...) SANDVIK_LOG(INFO, finfo, __VA_ARGS__)
+#define LOG_WARNING(...) SANDVIK_LOG(WARNING, fwarning, __VA_ARGS__)
+#define LOG_ERROR(...) SANDVIK_LOG(ERROR, ferror, __VA_ARGS__)
+#define LOG_OK(...) SANDVIK_LOG(OK, fok, __VA_ARGS__)
+
 #endif
@@ -73,21 +73,17 @@ void Thread::run(bool wait_) {
 		if (_name != "main") {
 			logger.addThread(id, _name);
 		}
-		logger.fdebug("Starting thread '{}'", _name);
+		LOG_DEBUG("Starting thread '{}'", _name);
+		onEnter();
 		while (_state.load() != ThreadState::Stopped && !done()) {
-			if (_state.load() == ThreadState::SuspendedRequested) {
-				std::unique_lock lock(_mtx);
-				_state.store(ThreadState::Suspended);  // Confirm suspension
-				_cv.notify_all();                      // Notify that the thread is suspended
-				_cv.wait(lock, [this]() { return _state.load() != ThreadState::Suspended; });
-			}
-			if (_state.load() == ThreadState::Stopped) {
+			if (!safepoint()) {
 				break;
 			}
 			loop();
 		}
+		onExit();
 		_state.store(ThreadState::Stopped);
-		logger.fdebug("End of thread '{}'", _name);
+		LOG_DEBUG("End of thread '{}'", _name);
 		logger.removeThread(id);
 	});
 	if (wait_ && _thread.joinable()) {
@@ -95,6 +91,16 @@ void Thread::run(bool wait_) {
 	}
 }
 
+bool Thread::safepoint() {
+	if (_state.load() == ThreadState::SuspendedRequested) {
+		std::unique_lock lock(_mtx);
+		_state.store(ThreadState::Suspended);  // Confirm suspension
+		_cv.notify_all();                      // Notify that the thread is suspended
+		_cv.wait(lock, [this]() { return _state.load() != ThreadState::Suspended; });
+	}
+	return _state.load() != ThreadState::Stopped;
+}
+
 void Thread::join() {
 	if (_thread.joinable()) {
 		_thread.join();
@@ -128,4 +134,5 @@ void Thread::resume() {
 void Thread::stop() {
 	_state.store(ThreadState::Stopped);
 	_cv.notify_all();  // Wake up the thread
+	onStop();
 }
@@ -64,6 +64,18 @@ namespace sandvik {
 			 * @return the thread state
 			 */
 			ThreadState getState() const;
+			/** @brief Checks if a suspend or stop request is pending.
+			 * @return true if the thread loop should take back control
+			 */
+			inline bool isInterruptRequested() const {
+				return _state.load(std::memory_order_relaxed) != ThreadState::Running;
+			}
+
+			/** @brief Parks the calling thread while a suspension is requested.
+			 * Called by the thread loop between two loop() calls, and by code running a nested loop on the thread.
+			 * @return false if the thread has been stopped
+			 */
+			bool safepoint();
 
 			/** @brief Suspends the thread execution. */
 			void suspend();
@@ -80,6 +92,15 @@ namespace sandvik {
 			/** @brief hook called when run() is about to start a new thread. */
 			virtual void onStart() {
 			}
+			/** @brief hook called on the new thread before its first loop. */
+			virtual void onEnter() {
+			}
+			/** @brief hook called on the thread after its last loop, before it is seen as stopped. */
+			virtual void onExit() {
+			}
+			/** @brief hook called by stop() once the stop request is set, to wake a loop blocked on its own condition. */
+			virtual void onStop() {
+			}
 
 		private:
 			std::string _name;
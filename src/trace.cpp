@@ -42,7 +42,7 @@ void Trace::enableCallTrace(bool enable_) {
 	_trace_calls = enable_;
 }
 
-void Trace::logInstruction(const uint64_t pc_, const std::string& function_, const uint8_t* bytecode_) {
+void Trace::logInstruction(const uint64_t pc_, std::string_view function_, const uint8_t* bytecode_) {
 	if (!_trace_instructions) {
 		return;
 	}
@@ -26,6 +26,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <system/singleton.hpp>
 #include <vector>
 
@@ -48,13 +49,21 @@ namespace sandvik {
 			 * @param enable_ enable/disable
 			 */
 			void enableCallTrace(bool enable_);
+			/** @return true if instruction trace is enabled */
+			inline bool isInstructionTraceEnabled() const {
+				return _trace_instructions;
+			}
+			/** @return true if call trace is enabled */
+			inline bool isCallTraceEnabled() const {
+				return _trace_calls;
+			}
 
-			/** log instruction trace entry.
+			/** log instruction trace entry, caller should check isInstructionTraceEnabled() first.
 			 * @param pc_ program counter
 			 * @param function_ function name and signature
 			 * @param bytecode_ opcode
 			 */
-			void logInstruction(const uint64_t pc_, const std::string& function_, const uint8_t* bytecode_);
+			void logInstruction(const uint64_t pc_, std::string_view function_, const uint8_t* bytecode_);
 			/** log call trace entry.
 			 * @param type_ invoke type
 			 * @param class_ class name
@@ -40,6 +40,15 @@
 
 using namespace sandvik;
 
+namespace {
+	/** class names of Vm::Throwable */
+	constexpr std::array<const char*, static_cast<size_t>(Vm::Throwable::COUNT)> THROWABLE_NAMES = {
+	    "java.lang.NullPointerException", "java.lang.ArrayIndexOutOfBoundsException", "java.lang.ArrayStoreException",
+	    "java.lang.ArithmeticException",  "java.lang.ClassCastException",             "java.lang.NegativeArraySizeException",
+	    "java.lang.InstantiationException", "java.lang.ExceptionInInitializerError", "java.lang.NoClassDefFoundError",
+	    "java.lang.Error"};
+}  // namespace
+
 Vm::Vm() : _classloader(std::make_unique<ClassLoader>()), _jnienv(std::make_unique<NativeInterface>(*this)) {
 	GC::getInstance().manageVm(this);
 	logger.info("VM instance created.");
@@ -59,7 +68,7 @@ Vm::Vm() : _classloader(std::make_unique<ClassLoader>()), _jnienv(std::make_uniq
 }
 
 Vm::~Vm() {
-	logger.debug("VM instance destroyed.");
+	LOG_DEBUG("VM instance destroyed.");
 	GC::getInstance().unmanageVm(this);
 }
 
@@ -94,6 +103,14 @@ void Vm::loadRt(const std::string& path) {
 				logger.error(e.what());
 			}
 		}
+		// pre-resolve the exceptions raised by the interpreter
+		for (size_t i = 0; i < _throwables.size(); ++i) {
+			try {
+				_throwables[i] = &_classloader->getOrLoad(THROWABLE_NAMES[i]);
+			} catch (const std::exception& e) {
+				logger.error(e.what());
+			}
+		}
 	}
 }
 
@@ -123,14 +140,14 @@ void Vm::loadLibrary(const std::string& libName_) {
 	lib->load();
 	if (lib->isLoaded()) {
 		if (!libName_.empty()) {
-			logger.fdebug("Loaded shared library {}", lib->getFullPath());
+			LOG_DEBUG("Loaded shared library {}", lib->getFullPath());
 		}
 		// Call JNI_OnLoad if it exists
 		void* JNI_onLoad = lib->getAddressOfSymbol("JNI_OnLoad");
 		if (JNI_onLoad) {
 			// jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved)
 			auto jniOnLoad = reinterpret_cast<void (*)(JavaVM*, void*)>(JNI_onLoad);
-			logger.fdebug("Executing native function JNI_OnLoad@{:#x} ", (uintptr_t)jniOnLoad);
+			LOG_DEBUG("Executing native function JNI_OnLoad@{:#x} ", (uintptr_t)jniOnLoad);
 			jniOnLoad(nullptr, nullptr);  // todo pass actual JavaVM
 		}
 		_sharedlibs.push_back(std::move(lib));
@@ -153,6 +170,23 @@ NativeInterface* Vm::getJNIEnv() const {
 	return _jnienv.get();
 }
 
+Class& Vm::getThrowableClass(Throwable type_) {
+	auto idx = static_cast<size_t>(type_);
+	if (auto* cls = _throwables[idx]) [[likely]] {
+		return *cls;
+	}
+	return _classloader->getOrLoad(THROWABLE_NAMES[idx]);
+}
+
+Class& Vm::getThrowableClass(const std::string& name_) {
+	for (size_t i = 0; i < THROWABLE_NAMES.size(); ++i) {
+		if (name_ == THROWABLE_NAMES[i]) {
+			return getThrowableClass(static_cast<Throwable>(i));
+		}
+	}
+	return _classloader->getOrLoad(name_);
+}
+
 void Vm::run() {
 	auto& clazz = _classloader->getMainActivityClass();
 	run(clazz, {});
@@ -165,7 +199,8 @@ void Vm::run(const std::string& mainClass_, const std::vector<std::string>& args
 void Vm::run(Class& clazz_, const std::vector<std::string>& args_) {
 	logger.info("Running class: " + clazz_.getFullname());
 
-	JThread& mainThread = newThread("main");
+	auto thread = newThread("main");
+	JThread& mainThread = *thread;
 
 	uint32_t nbRegisters = 0;
 	if (clazz_.hasMethod("onCreate", "(Landroid/os/Bundle;)V")) {
@@ -195,8 +230,10 @@ void Vm::run(Class& clazz_, const std::vector<std::string>& args_) {
 	try {
 		mainThread.newFrame(clazz_.getMethod("<clinit>", "()V"));
 	} catch (const std::exception& e) {
-		logger.debug(e.what());
+		LOG_DEBUG("{}", e.what());
 	}
+	// the class initializer frame, if any, runs before the main method
+	clazz_.setStaticInitialized();
 	_isRunning.store(true);
 	mainThread.run(true);
 	_isRunning.store(false);
@@ -208,47 +245,55 @@ void Vm::stop() {
 	_isRunning.store(false);
 }
 
-JThread& Vm::newThread(const std::string& name_) {
-	std::unique_lock lock(_mutex);
-	_threads.emplace_back(std::make_unique<JThread>(*this, *_classloader, name_));
-	return *(_threads.back());
+std::shared_ptr<JThread> Vm::newThread(const std::string& name_) {
+	auto thread = std::make_shared<JThread>(*this, *_classloader, _nextThreadId.fetch_add(1), name_);
+	std::vector<std::shared_ptr<JThread>> stopped;
+	{
+		std::unique_lock lock(_mutex);
+		stopped = reapThreads();
+		_threads.emplace(thread->getThreadId(), thread);
+	}
+	// stopped threads are joined when released, out of the registry lock
+	return thread;
 }
 
-JThread& Vm::newThread(ObjectRef thread_) {
-	std::unique_lock lock(_mutex);
-	_threads.emplace_back(std::make_unique<JThread>(*this, *_classloader, thread_));
-	return *(_threads.back());
+std::shared_ptr<JThread> Vm::newThread(ObjectRef thread_) {
+	auto thread = std::make_shared<JThread>(*this, *_classloader, _nextThreadId.fetch_add(1), thread_);
+	std::vector<std::shared_ptr<JThread>> stopped;
+	{
+		std::unique_lock lock(_mutex);
+		stopped = reapThreads();
+		_threads.emplace(thread->getThreadId(), thread);
+	}
+	// stopped threads are joined when released, out of the registry lock
+	return thread;
 }
 
-JThread& Vm::getThread(const std::string& name_) {
-	std::unique_lock lock(_mutex);
-	for (const auto& thread : _threads) {
-		if (thread->getName() == name_) {
-			return *thread;
-		}
-	}
-	throw VmException("Thread with name '{}' not found", name_);
+std::shared_ptr<JThread> Vm::getThread(uint64_t id_) const {
+	std::shared_lock lock(_mutex);
+	auto it = _threads.find(id_);
+	return it != _threads.end() ? it->second : nullptr;
 }
 
 JThread& Vm::currentThread() const {
-	std::unique_lock lock(_mutex);
-	auto currentId = std::this_thread::get_id();
-	for (const auto& thread : _threads) {
-		if (thread->getId() == currentId) {
-			return *thread;
-		}
+	auto* thread = JThread::current();
+	if (thread == nullptr || &thread->vm() != this) [[unlikely]] {
+		throw VmException("Current thread not found in VM");
 	}
-	throw VmException("Current thread not found in VM");
+	return *thread;
 }
 
-void Vm::deleteThread(const std::string& name_) {
-	std::unique_lock lock(_mutex);
-	for (auto it = _threads.begin(); it != _threads.end(); ++it) {
-		if ((*it)->getName() == name_) {
-			_threads.erase(it);
-			return;
+std::vector<std::shared_ptr<JThread>> Vm::reapThreads() {
+	std::vector<std::shared_ptr<JThread>> stopped;
+	for (auto it = _threads.begin(); it != _threads.end();) {
+		if (it->second->getState() == Thread::ThreadState::Stopped) {
+			stopped.push_back(std::move(it->second));
+			it = _threads.erase(it);
+		} else {
+			++it;
 		}
 	}
+	return stopped;
 }
 
 std::string Vm::getProperty(const std::string& name_) const {
@@ -265,7 +310,8 @@ void Vm::setProperty(const std::string& name_, const std::string& value_) {
 
 void Vm::visitReferences(const std::function<void(Object*)>& visitor_) const {
 	_classloader->visitReferences(visitor_);
-	for (const auto& thread : _threads) {
+	std::shared_lock lock(_mutex);
+	for (const auto& [id, thread] : _threads) {
 		thread->visitReferences(visitor_);
 	}
 }
@@ -279,25 +325,25 @@ void Vm::suspend() {
 	do {
 		all_suspended = true;
 		// Copy pointers to threads while holding the lock, then release the lock
-		std::vector<JThread*> threads_to_suspend;
+		std::vector<std::shared_ptr<JThread>> threads_to_suspend;
 		{
-			std::unique_lock lock(_mutex);
+			std::shared_lock lock(_mutex);
 			threads_to_suspend.reserve(_threads.size());
-			for (const auto& thread : _threads) {
+			for (const auto& [id, thread] : _threads) {
 				if (thread->getState() == Thread::ThreadState::Stopped) {
 					continue;
 				}
-				threads_to_suspend.push_back(thread.get());
+				threads_to_suspend.push_back(thread);
 			}
 		}
 		// Suspend each thread without holding the VM mutex to avoid deadlock with thread creation
-		for (auto thread : threads_to_suspend) {
+		for (const auto& thread : threads_to_suspend) {
 			thread->suspend();
 		}
 		// check if all threads are suspended
 		{
-			std::unique_lock lock(_mutex);
-			for (const auto& thread : _threads) {
+			std::shared_lock lock(_mutex);
+			for (const auto& [id, thread] : _threads) {
 				if (thread->getState() == Thread::ThreadState::Stopped) {
 					continue;
 				}
@@ -309,23 +355,24 @@ void Vm::suspend() {
 		}
 	} while (!all_suspended);
 
-	// take the opportunity to clean stopped threads while world is stopped
+	// take the opportunity to unregister stopped threads while world is stopped, resume() releases them
 	std::unique_lock lock(_mutex);
-	for (auto it = _threads.begin(); it != _threads.end(); ++it) {
-		if ((*it)->getState() == Thread::ThreadState::Stopped) {
-			_threads.erase(it);
-			return;
-		}
-	}
+	auto stopped = reapThreads();
+	_reaped.insert(_reaped.end(), std::make_move_iterator(stopped.begin()), std::make_move_iterator(stopped.end()));
 }
 
 void Vm::resume() {
 	if (_isRunning.load() == false) {
 		return;
 	}
-	// world is fully stopped, resume all threads
-	std::unique_lock lock(_mutex);
-	for (const auto& thread : _threads) {
-		thread->resume();
+	std::vector<std::shared_ptr<JThread>> reaped;
+	{
+		// world is fully stopped, resume all threads
+		std::unique_lock lock(_mutex);
+		for (const auto& [id, thread] : _threads) {
+			thread->resume();
+		}
+		reaped.swap(_reaped);
 	}
+	// the threads reaped by suspend() are joined when released, once the world runs again and out of the registry lock
 }
@@ -19,12 +19,15 @@
 #ifndef __JVM_HPP__
 #define __JVM_HPP__
 
+#include <array>
 #include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "object.hpp"
@@ -93,29 +96,25 @@ namespace sandvik {
 				return _isRunning.load();
 			}
 
-			/** Create a new thread
+			/** Create a new thread, terminated threads are reclaimed
 			 * @param name_ Name of the thread
-			 * @return Reference to the created thread
+			 * @return Created thread, shared with the thread registry
 			 */
-			JThread& newThread(const std::string& name_);
-			/** Create a new thread with an existing thread object
+			std::shared_ptr<JThread> newThread(const std::string& name_);
+			/** Create a new thread with an existing thread object, terminated threads are reclaimed
 			 * @param thread_ Java Thread Object
-			 * @return Reference to the created thread
+			 * @return Created thread, shared with the thread registry
 			 */
-			JThread& newThread(ObjectRef thread_);
-			/** Get a thread by name
-			 * @param name_ Name of the thread
-			 * @return Reference to the thread
+			std::shared_ptr<JThread> newThread(ObjectRef thread_);
+			/** Get a thread by identifier
+			 * @param id_ Identifier of the thread (see JThread::getThreadId)
+			 * @return Thread, nullptr if it has terminated and has been reclaimed
 			 */
-			JThread& getThread(const std::string& name_);
+			std::shared_ptr<JThread> getThread(uint64_t id_) const;
 			/** Get the current thread
-			 * @return Reference to the current thread
+			 * @return Reference to the java thread running on the calling thread
 			 */
 			JThread& currentThread() const;
-			/** Delete a thread by name
-			 * @param name_ Name of the thread
-			 */
-			void deleteThread(const std::string& name_);
 
 			/** Load a shared library
 			 * @param libName_ Name of the library
@@ -134,6 +133,45 @@ namespace sandvik {
 			 * @return Pointer to the JNI environment
 			 */
 			NativeInterface* getJNIEnv() const;
+			/** Default size of the stack of a thread */
+			static constexpr size_t DEFAULT_STACK_SIZE = 1024 * 1024;
+			/** Set the size of the stack of the threads created from now on, deep recursions raise a StackOverflowError
+			 * @param size_ Stack size in bytes, holding the frames and their registers
+			 */
+			inline void setStackSize(size_t size_) {
+				_stackSize = size_;
+			}
+			/** Get the size of the stack of a new thread
+			 * @return Stack size in bytes
+			 */
+			inline size_t getStackSize() const {
+				return _stackSize;
+			}
+
+			/** Exceptions raised by the interpreter, their classes are resolved once when the runtime is loaded */
+			enum class Throwable : uint8_t {
+				NULL_POINTER,
+				ARRAY_INDEX_OUT_OF_BOUNDS,
+				ARRAY_STORE,
+				ARITHMETIC,
+				CLASS_CAST,
+				NEGATIVE_ARRAY_SIZE,
+				INSTANTIATION,
+				EXCEPTION_IN_INITIALIZER,
+				NO_CLASS_DEF_FOUND,
+				ERROR,
+				COUNT
+			};
+			/** Get the class of an exception raised by the interpreter
+			 * @param type_ Exception type
+			 * @return Pre-resolved class, loaded on demand if the runtime is not loaded yet
+			 */
+			Class& getThrowableClass(Throwable type_);
+			/** Get the class of an exception by name, pre-resolved exceptions skip the class loader lookup
+			 * @param name_ Exception class name
+			 * @return Exception class
+			 */
+			Class& getThrowableClass(const std::string& name_);
 
 			/** Suspend all threads (used for garbage collection) */
 			void suspend();
@@ -152,19 +190,32 @@ namespace sandvik {
 			void visitReferences(const std::function<void(Object*)>& visitor_) const;
 
 		private:
+			/** Move the terminated threads out of the registry, the registry lock must be held.
+			 * The last owner of a thread joins it: the caller releases them once the lock is dropped.
+			 * @return the terminated threads
+			 */
+			std::vector<std::shared_ptr<JThread>> reapThreads();
+
 			friend class GC;
 			std::unique_ptr<ClassLoader> _classloader;
 			std::vector<std::string> _ldpath;
 			std::vector<std::unique_ptr<SharedLibrary>> _sharedlibs;
 
-			std::vector<std::unique_ptr<JThread>> _threads;
+			/** thread registry indexed by thread identifier */
+			std::unordered_map<uint64_t, std::shared_ptr<JThread>> _threads;
+			/** threads reaped while the world is stopped, released by resume() */
+			std::vector<std::shared_ptr<JThread>> _reaped;
+			std::atomic<uint64_t> _nextThreadId{1};
+			size_t _stackSize = DEFAULT_STACK_SIZE;
 
 			std::unique_ptr<NativeInterface> _jnienv;
 			std::map<std::string, std::string, std::less<>> _properties;
 			bool _isPrimitiveClassInitialized = false;
+			/** classes of the exceptions raised by the interpreter, indexed by Throwable */
+			std::array<Class*, static_cast<size_t>(Throwable::COUNT)> _throwables{};
 			std::atomic<bool> _isRunning{false};
 
-			mutable std::mutex _mutex;
+			mutable std::shared_mutex _mutex;
 	};
 }  // namespace sandvik
 
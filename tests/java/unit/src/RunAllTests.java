@@ -146,5 +146,8 @@ public class RunAllTests {
 
         System.out.println("== Running TestMonitorException ==");
         TestMonitorException.main(new String[]{});
+
+        System.out.println("== Running TestStaticInitError ==");
+        TestStaticInitError.main(new String[]{});
     }
 }
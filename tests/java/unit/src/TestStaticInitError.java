@@ -0,0 +1,37 @@
+class FailingInit {
+    static int val = compute();
+
+    static int compute() {
+        if (val == 0) throw new IllegalStateException("boom");
+        return val;
+    }
+}
+
+public class TestStaticInitError {
+    public static void main(String[] args) {
+        boolean success = true;
+
+        try {
+            int v = FailingInit.val;
+            System.out.println("fail: initializer did not throw " + v);
+            success = false;
+        } catch (ExceptionInInitializerError e) {
+            // the exception thrown by the initializer is kept as the cause
+            if (!(e.getCause() instanceof IllegalStateException) || !"boom".equals(e.getCause().getMessage())) {
+                System.out.println("fail: cause " + e.getCause());
+                success = false;
+            }
+        }
+
+        // the class is left erroneous, later accesses fail without running the initializer again
+        try {
+            int v = FailingInit.val;
+            System.out.println("fail: erroneous class accessed " + v);
+            success = false;
+        } catch (NoClassDefFoundError e) {
+            // expected
+        }
+
+        if (success) System.out.println("ok");
+    }
+}
@@ -248,6 +248,9 @@ TEST(VM, StringOps) {
 TEST(VM, StaticInit) {
 	run_common_test("TestStaticInit");
 }
+TEST(VM, StaticInitError) {
+	run_common_test("TestStaticInitError");
+}
 TEST(VM, Enums) {
 	run_common_test("TestEnums");
 }
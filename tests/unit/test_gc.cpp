@@ -16,16 +16,21 @@
  * along with this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <thread>
 #include <chrono>
 #include <string.h>
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 
 #include <class.hpp>
+#include <exceptions.hpp>
 #include <monitor.hpp>
 #include <object.hpp>
 #include <system/logger.hpp>
 #include <gc.hpp>
+#include <heap.hpp>
+#include <marker.hpp>
 
 using namespace sandvik;
 
@@ -47,3 +52,226 @@ TEST(gc, collect) {
 	EXPECT_EQ(GC::getInstance().getTrackedObjectCount(), 0u);
 	GC::getInstance().stop();
 }
+
+TEST(gc, heap) {
+	Heap heap;
+	auto make = [&heap]() { return new (heap.allocate(sizeof(Object))) Object(); };
+	std::vector<Object*> objects;
+	for (uint32_t i = 0; i < 10000; ++i) {
+		objects.push_back(make());
+	}
+	EXPECT_EQ(heap.getObjectCount(), 10000u);
+	EXPECT_EQ(heap.getArenaCount(), 1u);
+	for (const auto* obj : objects) {
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(obj) % Heap::ALIGNMENT, 0u);
+	}
+
+	// keep the first half alive, the second half is swept and reused
+	Object::beginMarkCycle();
+	EXPECT_FALSE(objects[0]->isMarked());
+	for (uint32_t i = 0; i < 5000; ++i) {
+		objects[i]->setMarked(true);
+	}
+	EXPECT_EQ(heap.sweep(), 5000u);
+	EXPECT_EQ(heap.getObjectCount(), 5000u);
+	for (uint32_t i = 0; i < 5000; ++i) {
+		make();
+	}
+	EXPECT_EQ(heap.getObjectCount(), 10000u);
+	EXPECT_EQ(heap.getArenaCount(), 1u);
+
+	// large objects bypass the TLAB, a dedicated arena is released once empty
+	new (heap.allocate(Heap::ARENA_SIZE * 2)) Object();
+	EXPECT_EQ(heap.getObjectCount(), 10001u);
+	EXPECT_EQ(heap.getArenaCount(), 2u);
+	Object::beginMarkCycle();
+	EXPECT_EQ(heap.sweep(), 0u);
+	EXPECT_EQ(heap.getArenaCount(), 1u);
+}
+
+TEST(gc, lazySweep) {
+	Heap heap;
+	auto make = [&heap]() { return new (heap.allocate(sizeof(Object))) Object(); };
+	constexpr uint32_t count = 100000;
+	std::vector<Object*> objects;
+	for (uint32_t i = 0; i < count; ++i) {
+		objects.push_back(make());
+	}
+	const auto arenas = heap.getArenaCount();
+	EXPECT_GT(arenas, 1u);
+
+	// only the last object survives, nothing is freed until the arenas are swept
+	Object::beginMarkCycle();
+	objects.back()->setMarked(true);
+	heap.startSweep();
+	EXPECT_TRUE(heap.isSweeping());
+	EXPECT_EQ(heap.getObjectCount(), count);
+
+	// objects allocated during the sweep are marked, the allocation path sweeps instead of growing the heap
+	std::vector<Object*> fresh;
+	for (uint32_t i = 0; i < count; ++i) {
+		fresh.push_back(make());
+	}
+	EXPECT_TRUE(fresh.front()->isMarked());
+	EXPECT_LE(heap.getArenaCount(), arenas + 1);
+	heap.finishSweep();
+	EXPECT_FALSE(heap.isSweeping());
+	EXPECT_EQ(heap.getObjectCount(), count + 1);
+	heap.release();
+}
+
+TEST(gc, concurrentCollect) {
+	auto& gc = GC::getInstance();
+	gc.setConcurrent(true);
+	gc.run();
+	const auto cycles = gc.getGcCycles();
+	const auto pauses = gc.getPauseCount();
+	for (uint32_t i = 0; i < 50; ++i) {
+		Object::make(i);
+	}
+	gc.requestCollect();
+	uint32_t cpt = 20;
+	while (gc.getGcCycles() == cycles && cpt > 0) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		--cpt;
+	}
+	EXPECT_EQ(gc.getGcCycles(), cycles + 1);
+	EXPECT_EQ(gc.getTrackedObjectCount(), 0u);
+	// root scan and remark pauses
+	EXPECT_EQ(gc.getPauseCount(), pauses + 2);
+	EXPECT_LE(gc.getPauseTime(50), gc.getPauseTime(100));
+	gc.stop();
+	gc.setConcurrent(false);
+}
+
+TEST(gc, pin) {
+	auto& gc = GC::getInstance();
+	gc.run();
+	auto collect = [&gc]() {
+		const auto cycles = gc.getGcCycles();
+		gc.requestCollect();
+		uint32_t cpt = 20;
+		while (gc.getGcCycles() == cycles && cpt > 0) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			--cpt;
+		}
+		EXPECT_EQ(gc.getGcCycles(), cycles + 1);
+	};
+	Object* pinned = nullptr;
+	for (uint32_t i = 0; i < 50; ++i) {
+		pinned = Object::make(i);
+	}
+	gc.pin(pinned);
+	gc.pin(pinned);
+	EXPECT_EQ(gc.getPinnedCount(), 1u);
+	collect();
+	EXPECT_EQ(gc.getTrackedObjectCount(), 1u);
+	EXPECT_EQ(pinned->getValue(), 49);
+
+	// pins are counted, the object is released with its last pin
+	gc.unpin(pinned);
+	collect();
+	EXPECT_EQ(gc.getTrackedObjectCount(), 1u);
+	gc.unpin(pinned);
+	EXPECT_EQ(gc.getPinnedCount(), 0u);
+	EXPECT_THROW(gc.unpin(pinned), VmException);
+	collect();
+	EXPECT_EQ(gc.getTrackedObjectCount(), 0u);
+	gc.stop();
+}
+
+TEST(gc, heapBytes) {
+	Heap heap;
+	for (uint32_t i = 0; i < 1000; ++i) {
+		new (heap.allocate(sizeof(Object))) Object();
+	}
+	const auto bytes = heap.getAllocatedBytes();
+	EXPECT_GE(bytes, 1000 * sizeof(Object));
+	// a large object weighs its size, not one object
+	new (heap.allocate(100000)) Object();
+	EXPECT_GE(heap.getAllocatedBytes(), bytes + 100000);
+	heap.addExternalBytes(4096);
+	EXPECT_GE(heap.getAllocatedBytes(), bytes + 100000 + 4096);
+	heap.addExternalBytes(-4096);
+	Object::beginMarkCycle();
+	heap.sweep();
+	EXPECT_EQ(heap.getAllocatedBytes(), 0u);
+}
+
+TEST(gc, heapSizing) {
+	auto& gc = GC::getInstance();
+	gc.setHeapSize(8 * 1024 * 1024, 64 * 1024 * 1024);
+	EXPECT_EQ(gc.getMinHeapSize(), 8u * 1024 * 1024);
+	EXPECT_EQ(gc.getMaxHeapSize(), 64u * 1024 * 1024);
+	EXPECT_EQ(gc.getHeapTarget(), gc.getMinHeapSize());
+	// the maximum is never below the minimum
+	gc.setHeapSize(8 * 1024 * 1024, 1024);
+	EXPECT_EQ(gc.getMaxHeapSize(), gc.getMinHeapSize());
+	gc.setTargetPause(5000);
+	EXPECT_EQ(gc.getTargetPause(), 5000u);
+	gc.setTargetPause(0);
+	gc.setHeapSize(GC::DEFAULT_MIN_HEAP_SIZE, GC::DEFAULT_MAX_HEAP_SIZE);
+}
+
+TEST(gc, parallelMark) {
+	std::vector<std::unique_ptr<Object>> objects;
+	auto make = [&objects]() {
+		objects.push_back(std::make_unique<Object>());
+		return objects.back().get();
+	};
+	// a long chain would overflow a recursive mark
+	auto* head = make();
+	auto* tail = head;
+	for (uint32_t i = 0; i < 100000; ++i) {
+		auto* next = make();
+		tail->setField("next", next);
+		tail = next;
+	}
+	tail->setField("next", head);
+	// a wide tree with back references
+	auto* root = make();
+	for (uint32_t i = 0; i < 100; ++i) {
+		auto* child = make();
+		root->setField(fmt::format("c{}", i), child);
+		for (uint32_t j = 0; j < 100; ++j) {
+			auto* leaf = make();
+			child->setField(fmt::format("c{}", j), leaf);
+			leaf->setField("root", root);
+		}
+	}
+	auto* unreachable = make();
+
+	for (uint32_t threads : {1u, 4u}) {
+		Marker marker;
+		marker.setThreadCount(threads);
+		EXPECT_EQ(marker.getThreadCount(), threads);
+		Object::beginMarkCycle();
+		marker.grey(head);
+		marker.grey(root);
+		marker.grey(nullptr);
+		EXPECT_EQ(marker.drain(), objects.size() - 1);
+		EXPECT_TRUE(std::ranges::all_of(objects, [unreachable](const auto& obj_) { return obj_.get() == unreachable || obj_->isMarked(); }));
+		EXPECT_FALSE(unreachable->isMarked());
+	}
+}
+
+TEST(gc, heapThreads) {
+	Heap heap;
+	constexpr uint32_t threads = 4;
+	constexpr uint32_t count = 20000;
+	std::vector<std::thread> workers;
+	for (uint32_t t = 0; t < threads; ++t) {
+		workers.emplace_back([&heap]() {
+			for (uint32_t i = 0; i < count; ++i) {
+				new (heap.allocate(sizeof(Object))) Object();
+			}
+		});
+	}
+	for (auto& worker : workers) {
+		worker.join();
+	}
+	EXPECT_EQ(heap.getObjectCount(), threads * count);
+	heap.release();
+	EXPECT_EQ(heap.getObjectCount(), 0u);
+	EXPECT_EQ(heap.getArenaCount(), 0u);
+}
@@ -0,0 +1,77 @@
+/*
+ * This file is part of Sandvik project.
+ * Copyright (C) 2025 Christophe Duvernois
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <string>
+#include <gtest/gtest.h>
+
+#include <system/logger.hpp>
+
+using namespace sandvik;
+
+namespace {
+	uint32_t sideEffect(uint32_t& counter_) {
+		return ++counter_;
+	}
+}  // namespace
+
+TEST(Logger, lazyArguments) {
+	auto level = logger.getLevel();
+	uint32_t counter = 0;
+
+	logger.setLevel(Logger::LogLevel::INFO);
+	LOG_DEBUG("not evaluated {}", sideEffect(counter));
+	EXPECT_EQ(counter, 0u);
+
+	logger.setLevel(Logger::LogLevel::DEBUG);
+	LOG_DEBUG("evaluated {}", sideEffect(counter));
+#ifdef __strip_debug_log__
+	EXPECT_EQ(counter, 0u);
+#else
+	EXPECT_EQ(counter, 1u);
+#endif
+	logger.setLevel(level);
+}
+
+TEST(Logger, instructionOverhead) {
+	// simulate the debug log line of an iget handler, once with eager formatting and once through the level checked macro
+	const std::string className = "com.example.Point";
+	const std::string fieldName = "x";
+	constexpr uint32_t instructions = 1000000;
+	auto level = logger.getLevel();
+	logger.setLevel(Logger::LogLevel::INFO);
+
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < instructions; ++i) {
+		logger.fdebug("iget {}.{}={}", className, fieldName, i);
+	}
+	auto eager = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / instructions;
+
+	// the arguments of a disabled log line are never evaluated
+	uint32_t evaluated = 0;
+	start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < instructions; ++i) {
+		LOG_DEBUG("iget {}.{}={}", className, fieldName, sideEffect(evaluated));
+	}
+	auto lazy = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / instructions;
+	EXPECT_EQ(evaluated, 0u);
+
+	// timings depend on the machine, they are only logged
+	logger.finfo("debug log overhead per instruction: eager {:.2f} ns, level checked {:.2f} ns", eager, lazy);
+	logger.setLevel(level);
+}
@@ -0,0 +1,333 @@
+/*
+ * This file is part of Sandvik project.
+ * Copyright (C) 2025 Christophe Duvernois
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdarg>
+#include <functional>
+#include <string.h>
+#include <gtest/gtest.h>
+
+#include <class.hpp>
+#include <classbuilder.hpp>
+#include <classloader.hpp>
+#include <exceptions.hpp>
+#include <frame.hpp>
+#include <interpreter.hpp>
+#include <jni.hpp>
+#include <jthread.hpp>
+#include <method.hpp>
+#include <native_call.hpp>
+#include <native_utils.hpp>
+#include <object.hpp>
+#include <system/logger.hpp>
+#include <vm.hpp>
+
+using namespace sandvik;
+
+namespace {
+	jlong JNICALL addNumbers(JNIEnv*, jobject, jint a_, jlong b_, jdouble c_) {
+		return a_ + b_ + static_cast<jlong>(c_);
+	}
+
+	jobject JNICALL second(JNIEnv*, jobject, jobject, jintArray array_) {
+		return array_;
+	}
+
+	jboolean JNICALL compareInts(JNIEnv*, jobject, jint a_, jint b_) {
+		return a_ == b_;
+	}
+
+	jint JNICALL floatBits(JNIEnv*, jclass, jfloat value_) {
+		jint bits;
+		memcpy(&bits, &value_, sizeof(bits));
+		return bits;
+	}
+
+	jchar JNICALL charAt(JNIEnv*, jobject, jint index_) {
+		return static_cast<jchar>(0xfff0 + index_);
+	}
+
+	jlong callStaticLongV(JNIEnv* env_, jclass class_, jmethodID method_, ...) {
+		va_list args;
+		va_start(args, method_);
+		auto ret = env_->CallStaticLongMethodV(class_, method_, args);
+		va_end(args);
+		return ret;
+	}
+
+	jlong callLongV(JNIEnv* env_, jobject obj_, jmethodID method_, ...) {
+		va_list args;
+		va_start(args, method_);
+		auto ret = env_->CallLongMethodV(obj_, method_, args);
+		va_end(args);
+		return ret;
+	}
+
+	jlong callNonvirtualLongV(JNIEnv* env_, jobject obj_, jclass class_, jmethodID method_, ...) {
+		va_list args;
+		va_start(args, method_);
+		auto ret = env_->CallNonvirtualLongMethodV(obj_, class_, method_, args);
+		va_end(args);
+		return ret;
+	}
+
+	/** Java thread running a native body, as the interpreter runs a native method on the thread calling it */
+	class NativeCaller : public JThread {
+		public:
+			NativeCaller(Vm& vm_, std::function<void(JThread&)> body_)
+			    : JThread(vm_, vm_.getClassLoader(), 0, "caller"), _body(std::move(body_)) {
+			}
+
+		protected:
+			void loop() override {
+				_body(*this);
+				_ran = true;
+			}
+			bool done() override {
+				return _ran;
+			}
+
+		private:
+			std::function<void(JThread&)> _body;
+			bool _ran = false;
+	};
+
+}  // namespace
+
+TEST(nativeCall, bind) {
+	auto binding = NativeCallHelper::bind((void*)&addNumbers, {"I", "J", "D"}, "J");
+	EXPECT_EQ(binding->paramTypes, "IJD");
+	EXPECT_EQ(binding->argTypes.size(), 5u);
+	EXPECT_EQ(binding->returnType, 'J');
+
+	double c = 4.0;
+	uint64_t bits;
+	memcpy(&bits, &c, sizeof(bits));
+	// a long or a double is passed in one value
+	const std::vector<uint64_t> args = {3, 0x100000000ULL, bits};
+	// the binding is reused across calls
+	for (uint32_t i = 0; i < 3; ++i) {
+		auto ret = NativeCallHelper::invoke(*binding, nullptr, nullptr, args);
+		EXPECT_EQ(static_cast<int64_t>(ret), 0x100000007LL);
+	}
+	EXPECT_THROW(NativeCallHelper::invoke(*binding, nullptr, nullptr, std::span(args).first(2)), VmException);
+}
+
+TEST(nativeCall, objects) {
+	auto binding = NativeCallHelper::bind((void*)&second, {"Ljava/lang/String;", "[I"}, "[I");
+	EXPECT_EQ(binding->paramTypes, "L[");
+	auto self = Object::make(1);
+	auto str = Object::make(2);
+	auto array = Object::make(3);
+	const std::vector<uint64_t> args = {(uintptr_t)str, (uintptr_t)array};
+	auto ret = NativeCallHelper::invoke(*binding, nullptr, (jobject)self, args);
+	EXPECT_EQ((ObjectRef)(uintptr_t)ret, array);
+}
+
+TEST(nativeCall, directStub) {
+	auto compare = NativeCallHelper::bind((void*)&compareInts, {"I", "I"}, "Z");
+	ASSERT_NE(compare->stub, nullptr);
+	auto self = (jobject)Object::make(0);
+	const std::vector<uint64_t> same = {7, 7};
+	const std::vector<uint64_t> different = {7, 8};
+	EXPECT_EQ(NativeCallHelper::invoke(*compare, nullptr, self, same), 1u);
+	EXPECT_EQ(NativeCallHelper::invoke(*compare, nullptr, self, different), 0u);
+
+	auto bits = NativeCallHelper::bind((void*)&floatBits, {"F"}, "I");
+	ASSERT_NE(bits->stub, nullptr);
+	float value = -1.5f;
+	uint32_t raw;
+	memcpy(&raw, &value, sizeof(raw));
+	const std::vector<uint64_t> floatArgs = {raw};
+	EXPECT_EQ(static_cast<uint32_t>(NativeCallHelper::invoke(*bits, nullptr, nullptr, floatArgs)), raw);
+
+	auto chars = NativeCallHelper::bind((void*)&charAt, {"I"}, "C");
+	ASSERT_NE(chars->stub, nullptr);
+	const std::vector<uint64_t> index = {15};
+	EXPECT_EQ(NativeCallHelper::invoke(*chars, nullptr, self, index), 0xffffu);
+	EXPECT_THROW(NativeCallHelper::invoke(*chars, nullptr, self, {}), VmException);
+}
+
+TEST(nativeCall, runtimeNatives) {
+	const native::Registration registration("sandvik.Test", {
+		{"add", "(IJD)J", (void*)&addNumbers},
+		{"compare", "(II)Z", (void*)&compareInts},
+	});
+	EXPECT_EQ(native::findRuntimeNative("sandvik.Test", "add", "(IJD)J"), (void*)&addNumbers);
+	EXPECT_EQ(native::findRuntimeNative("sandvik.Test", "compare", "(II)Z"), (void*)&compareInts);
+	EXPECT_EQ(native::findRuntimeNative("sandvik.Test", "compare", "(JJ)Z"), nullptr);
+	EXPECT_EQ(native::findRuntimeNative("sandvik.Unknown", "add", "(IJD)J"), nullptr);
+	// runtime natives of the library are registered at load time
+	EXPECT_NE(native::findRuntimeNative("java.lang.String", "length", "()I"), nullptr);
+}
+
+TEST(nativeCall, callOverhead) {
+	// String.charAt(int) like native, through its direct stub, a cached ffi binding and a binding prepared on each call.
+	// The timings depend on the machine and are only logged, the calls are checked for their result.
+	constexpr uint32_t calls = 100000;
+	auto self = (jobject)Object::make(0);
+	const std::vector<uint64_t> args = {1};
+	auto measure = [&](auto&& call_, uint64_t expected_) {
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < calls; ++i) {
+			EXPECT_EQ(call_(), expected_);
+		}
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+	};
+	auto direct = NativeCallHelper::bind((void*)&charAt, {"I"}, "C");
+	auto ffi = NativeCallHelper::bind((void*)&charAt, {"I"}, "C");
+	ffi->stub = nullptr;
+
+	auto directTime = measure([&]() { return NativeCallHelper::invoke(*direct, nullptr, self, args); }, 0xfff1);
+	auto ffiTime = measure([&]() { return NativeCallHelper::invoke(*ffi, nullptr, self, args); }, 0xfff1);
+	auto uncachedTime = measure(
+	    [&]() {
+		    auto binding = NativeCallHelper::bind((void*)&charAt, {"I"}, "C");
+		    binding->stub = nullptr;
+		    return NativeCallHelper::invoke(*binding, nullptr, self, args);
+	    },
+	    0xfff1);
+
+	// static native with wide arguments, passed unboxed as they are read from the registers
+	double c = 4.0;
+	uint64_t bits;
+	memcpy(&bits, &c, sizeof(bits));
+	const std::vector<uint64_t> wideArgs = {3, 0x100000000ULL, bits};
+	auto wide = NativeCallHelper::bind((void*)&addNumbers, {"I", "J", "D"}, "J");
+	auto wideTime = measure([&]() { return NativeCallHelper::invoke(*wide, nullptr, nullptr, wideArgs); }, 0x100000007ULL);
+
+	logger.finfo("native call overhead: direct stub {:.2f} ns, cached ffi {:.2f} ns, uncached ffi {:.2f} ns, static (IJD)J ffi {:.2f} ns", directTime,
+	             ffiTime, uncachedTime, wideTime);
+}
+
+TEST(nativeCall, javaCallback) {
+	Vm vm;
+	auto& classloader = vm.getClassLoader();
+	ClassBuilder(classloader, "java.lang", "java.lang.Object").finalize();
+	ClassBuilder(classloader, "java.lang", "java.lang.String").finalize();
+	ClassBuilder(classloader, "java.lang", "java.lang.Class").finalize();
+	ClassBuilder thread(classloader, "java.lang", "java.lang.Thread");
+	thread.addField("name", "Ljava/lang/String;", false);
+	thread.addField("priority", "I", false);
+	thread.addField("eetop", "J", false);
+	thread.finalize();
+	ClassBuilder npe(classloader, "java.lang", "java.lang.NullPointerException");
+	npe.addField("detailMessage", "Ljava/lang/String;", false);
+	npe.finalize();
+
+	// each picker returns one of its (IJFD) arguments: v0 int, v1-v2 long, v3 float, v4-v5 double
+	auto noop = [](Frame&, std::vector<ObjectRef>&) {};
+	ClassBuilder callee(classloader, "com.example", "com.example.Callee");
+	callee.addMethod("pickInt", "(IJFD)I", ACC_PUBLIC | ACC_STATIC, noop);
+	callee.setBytecode("pickInt", "(IJFD)I", 6, {0x0f, 0x00});  // return v0
+	callee.addMethod("pickLong", "(IJFD)J", ACC_PUBLIC | ACC_STATIC, noop);
+	callee.setBytecode("pickLong", "(IJFD)J", 6, {0x10, 0x01});  // return-wide v1
+	callee.addMethod("pickFloat", "(IJFD)F", ACC_PUBLIC | ACC_STATIC, noop);
+	callee.setBytecode("pickFloat", "(IJFD)F", 6, {0x0f, 0x03});  // return v3
+	callee.addMethod("pickDouble", "(IJFD)D", ACC_PUBLIC | ACC_STATIC, noop);
+	callee.setBytecode("pickDouble", "(IJFD)D", 6, {0x10, 0x04});  // return-wide v4
+	callee.addMethod("pickObject", "(Ljava/lang/Object;)Ljava/lang/Object;", ACC_PUBLIC | ACC_STATIC, noop);
+	callee.setBytecode("pickObject", "(Ljava/lang/Object;)Ljava/lang/Object;", 1, {0x11, 0x00});  // return-object v0
+	callee.addMethod("fail", "()V", ACC_PUBLIC | ACC_STATIC, noop);
+	callee.setBytecode("fail", "()V", 1, {0x12, 0x00, 0x27, 0x00});  // const/4 v0, 0; throw v0
+	callee.finalize();
+	// tag(J)J returns its argument in Base, 2 in Derived: this in v2, the long in v3-v4
+	ClassBuilder base(classloader, "com.example", "com.example.Base");
+	base.addVirtualMethod("tag", "(J)J", ACC_PUBLIC, noop);
+	base.setBytecode("tag", "(J)J", 5, {0x10, 0x03});  // return-wide v3
+	base.finalize();
+	ClassBuilder derived(classloader, "com.example", "com.example.Derived");
+	derived.setSuperClass("com.example.Base");
+	derived.addVirtualMethod("tag", "(J)J", ACC_PUBLIC, noop);
+	derived.setBytecode("tag", "(J)J", 5, {0x16, 0x00, 0x02, 0x00, 0x10, 0x00});  // const-wide/16 v0, 2; return-wide v0
+	derived.finalize();
+	ClassBuilder caller(classloader, "com.example", "com.example.Caller");
+	caller.addMethod("run", "()V", ACC_PUBLIC | ACC_STATIC | ACC_NATIVE, noop);
+	caller.finalize();
+
+	auto& calleeClass = classloader.getOrLoad("com.example.Callee");
+	auto& baseClass = classloader.getOrLoad("com.example.Base");
+	auto& derivedClass = classloader.getOrLoad("com.example.Derived");
+	auto& callerMethod = classloader.getOrLoad("com.example.Caller").getMethod("run", "()V");
+	auto firstId = vm.newThread("before")->getThreadId();
+	auto* argument = Object::make(7);
+	auto* receiver = Object::make(derivedClass);
+
+	auto body = [&](JThread& thread_) {
+		JNIEnv* env = vm.getJNIEnv();
+		// the frame of the native method calling back into java
+		auto& callerFrame = thread_.newFrame(callerMethod);
+		auto cls = (jclass)calleeClass.getClassObject();
+		auto pickInt = env->GetStaticMethodID(cls, "pickInt", "(IJFD)I");
+		auto pickLong = env->GetStaticMethodID(cls, "pickLong", "(IJFD)J");
+		auto pickFloat = env->GetStaticMethodID(cls, "pickFloat", "(IJFD)F");
+		auto pickDouble = env->GetStaticMethodID(cls, "pickDouble", "(IJFD)D");
+
+		// variadic arguments are promoted (float to double), the wide ones take two registers
+		const jlong wide = 0x123456789abcdefLL;
+		EXPECT_EQ(env->CallStaticIntMethod(cls, pickInt, -3, wide, 1.5f, -2.25), -3);
+		EXPECT_EQ(env->CallStaticLongMethod(cls, pickLong, -3, wide, 1.5f, -2.25), wide);
+		EXPECT_EQ(env->CallStaticFloatMethod(cls, pickFloat, -3, wide, 1.5f, -2.25), 1.5f);
+		EXPECT_EQ(env->CallStaticDoubleMethod(cls, pickDouble, -3, wide, 1.5f, -2.25), -2.25);
+		EXPECT_EQ(callStaticLongV(env, cls, pickLong, 4, -wide, 0.5f, 8.0), -wide);
+		jvalue args[4];
+		args[0].i = 9;
+		args[1].j = wide;
+		args[2].f = -0.75f;
+		args[3].d = 1e300;
+		EXPECT_EQ(env->CallStaticIntMethodA(cls, pickInt, args), 9);
+		EXPECT_EQ(env->CallStaticLongMethodA(cls, pickLong, args), wide);
+		EXPECT_EQ(env->CallStaticFloatMethodA(cls, pickFloat, args), -0.75f);
+		EXPECT_EQ(env->CallStaticDoubleMethodA(cls, pickDouble, args), 1e300);
+		auto pickObject = env->GetStaticMethodID(cls, "pickObject", "(Ljava/lang/Object;)Ljava/lang/Object;");
+		EXPECT_EQ(native::getObject(env->CallStaticObjectMethod(cls, pickObject, (jobject)argument)), argument);
+
+		// virtual calls dispatch on the receiver, non virtual ones run the method of the given class
+		auto baseCls = (jclass)baseClass.getClassObject();
+		auto tag = env->GetMethodID(baseCls, "tag", "(J)J");
+		auto obj = (jobject)receiver;
+		EXPECT_EQ(env->CallLongMethod(obj, tag, wide), 2);
+		EXPECT_EQ(callLongV(env, obj, tag, wide), 2);
+		EXPECT_EQ(env->CallLongMethodA(obj, tag, &args[1]), 2);
+		EXPECT_EQ(env->CallNonvirtualLongMethod(obj, baseCls, tag, wide), wide);
+		EXPECT_EQ(callNonvirtualLongV(env, obj, baseCls, tag, -wide), -wide);
+		EXPECT_EQ(env->CallNonvirtualLongMethodA(obj, baseCls, tag, &args[1]), wide);
+
+		// an uncaught java exception stays pending at the JNI boundary, calls return zero until it is cleared
+		env->CallStaticVoidMethod(cls, env->GetStaticMethodID(cls, "fail", "()V"));
+		EXPECT_TRUE(env->ExceptionCheck());
+		auto pending = native::getObject(env->ExceptionOccurred());
+		ASSERT_NE(pending, nullptr);
+		EXPECT_EQ(pending->getClass().getFullname(), "java.lang.NullPointerException");
+		EXPECT_EQ(env->CallStaticIntMethod(cls, pickInt, 5, wide, 1.5f, -2.25), 0);
+		env->ExceptionClear();
+		EXPECT_FALSE(env->ExceptionCheck());
+		EXPECT_EQ(env->CallStaticIntMethod(cls, pickInt, 5, wide, 1.5f, -2.25), 5);
+
+		// the callbacks ran nested on this thread, the frame of the caller is back on top
+		EXPECT_EQ(JThread::current(), &thread_);
+		EXPECT_EQ(thread_.stackDepth(), 1u);
+		EXPECT_EQ(&thread_.currentFrame(), &callerFrame);
+		thread_.popFrame();
+	};
+	NativeCaller rt(vm, body);
+	rt.run(true);
+	EXPECT_TRUE(rt.end());
+	// no thread was created for the callbacks
+	EXPECT_EQ(vm.newThread("after")->getThreadId(), firstId + 1);
+}
@@ -19,18 +19,23 @@
 #include <thread>
 #include <chrono>
 #include <string.h>
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 
 #include <class.hpp>
 #include <classbuilder.hpp>
 #include <classloader.hpp>
+#include <exceptions.hpp>
 #include <field.hpp>
 #include <frame.hpp>
 #include <array.hpp>
+#include <jthread.hpp>
+#include <loader/dex.hpp>
 #include <method.hpp>
 #include <monitor.hpp>
 #include <object.hpp>
 #include <system/logger.hpp>
+#include <vm.hpp>
 
 using namespace sandvik;
 
@@ -156,6 +161,46 @@ TEST(object, string16) {
 	EXPECT_EQ(obj_b->str(), "hello");
 }
 
+TEST(object, compactString) {
+	ClassLoader classloader;
+	java::lang::String(classloader);
+
+	auto ascii = Object::make(classloader, "hello");
+	EXPECT_TRUE(ascii->chars().isCompact());
+	EXPECT_EQ(ascii->chars().latin1, "hello");
+	EXPECT_EQ(ascii->stringHash(), 99162322);
+	EXPECT_EQ(ascii->stringHash(), 99162322);
+
+	// latin-1 chars stay compact, the utf-8 value is re-encoded
+	auto latin1 = Object::make(classloader, "caf\u00e9");
+	EXPECT_TRUE(latin1->chars().isCompact());
+	EXPECT_EQ(latin1->chars().size(), 4u);
+	EXPECT_EQ(latin1->chars()[3], u'\u00e9');
+	EXPECT_EQ(latin1->str(), "caf\u00e9");
+	EXPECT_EQ(latin1->stringHash(), 3045921);
+
+	auto utf16 = Object::make(classloader, "1\u20ac");
+	EXPECT_FALSE(utf16->chars().isCompact());
+	EXPECT_EQ(utf16->chars().size(), 2u);
+	EXPECT_EQ(utf16->chars()[1], u'\u20ac');
+	EXPECT_EQ(utf16->str16(), u"1\u20ac");
+	EXPECT_EQ(utf16->str(), "1\u20ac");
+
+	// supplementary characters are stored as a surrogate pair
+	auto supplementary = Object::make(classloader, "\U0001F600");
+	EXPECT_EQ(supplementary->chars().size(), 2u);
+	EXPECT_EQ(supplementary->str(), "\U0001F600");
+
+	// the same chars are equal whatever the way the string was built
+	auto narrowed = Object::makeString(classloader, StringChars{{}, u"caf\u00e9"});
+	EXPECT_TRUE(narrowed->chars().isCompact());
+	EXPECT_TRUE(*narrowed == *latin1);
+	EXPECT_EQ(narrowed->stringHash(), latin1->stringHash());
+	auto prefix = Object::makeString(classloader, utf16->chars().substr(0, 1));
+	EXPECT_TRUE(prefix->chars().isCompact());
+	EXPECT_EQ(prefix->str(), "1");
+}
+
 TEST(object, array) {
 	ClassLoader classloader;
 	ClassBuilder(classloader, "", "int").finalize();
@@ -168,7 +213,7 @@ TEST(object, array) {
 		for (uint32_t j = 0; j < 3; ++j) {
 			auto elem = array->getElement({i, j});
 			logger.fdebug("Element [{}][{}]: {}", i, j, elem->toString());
-			EXPECT_TRUE(elem->isNull());
+			EXPECT_EQ(elem->getValue(), 0);
 			array->setElement({i, j}, Object::make(i * 3 + j + 1));
 		}
 	}
@@ -193,6 +238,327 @@ TEST(object, array) {
 	}
 }
 
+TEST(object, primitiveArray) {
+	ClassLoader classloader;
+	ClassBuilder(classloader, "", "byte").finalize();
+	ClassBuilder(classloader, "", "char").finalize();
+	ClassBuilder(classloader, "", "long").finalize();
+
+	auto bytes = Array::make(classloader.getOrLoad("byte"), 4);
+	EXPECT_EQ(bytes->getElementType(), Array::ElementType::BYTE);
+	EXPECT_EQ(bytes->getElementSize(), 1u);
+	bytes->setPrimitive<int8_t>(0, -1);
+	bytes->setElement(1, Object::make(0x17f));
+	EXPECT_EQ(bytes->getRawData()[0], 0xff);
+	EXPECT_EQ(bytes->getElement(0)->getValue(), -1);
+	EXPECT_EQ(bytes->getPrimitive<int8_t>(1), 0x7f);
+	EXPECT_EQ(bytes->getPrimitive<int8_t>(3), 0);
+
+	auto chars = Array::make(classloader.getOrLoad("char"), 2);
+	EXPECT_EQ(chars->getElementSize(), 2u);
+	chars->setPrimitive<uint16_t>(0, 0xffff);
+	EXPECT_EQ(chars->getElement(0)->getValue(), 0xffff);
+
+	auto longs = Array::make(classloader.getOrLoad("long"), {2, 2});
+	longs->setElement({1, 1}, Object::make(0x123456789abcdefULL));
+	auto row = longs->getArray(1);
+	EXPECT_EQ(row->getElementSize(), 8u);
+	EXPECT_EQ(row->getPrimitive<int64_t>(1), 0x123456789abcdefLL);
+	auto copy = static_cast<ArrayRef>(row->clone());
+	EXPECT_EQ(copy->getPrimitive<int64_t>(1), 0x123456789abcdefLL);
+
+	// primitive storage holds no references, the rows of a multi-dimensional array are referenced
+	uint32_t visited = 0;
+	bytes->visitReferences([&visited](Object*) { ++visited; });
+	row->visitReferences([&visited](Object*) { ++visited; });
+	EXPECT_EQ(visited, 0u);
+	longs->visitReferences([&visited](Object*) { ++visited; });
+	EXPECT_EQ(visited, 2u);
+}
+
+TEST(object, arrayCopy) {
+	ClassLoader classloader;
+	ClassBuilder(classloader, "", "int").finalize();
+	ClassBuilder(classloader, "", "long").finalize();
+
+	auto ints = Array::make(classloader.getOrLoad("int"), 8);
+	for (int32_t i = 0; i < 8; ++i) {
+		ints->setPrimitive<int32_t>(i, i);
+	}
+	// overlapping ranges behave as if copied through a temporary
+	Array::copy(*ints, 0, *ints, 2, 5);
+	const int32_t expected[] = {0, 1, 0, 1, 2, 3, 4, 7};
+	for (int32_t i = 0; i < 8; ++i) {
+		EXPECT_EQ(ints->getPrimitive<int32_t>(i), expected[i]);
+	}
+	auto other = Array::make(classloader.getOrLoad("int"), 3);
+	Array::copy(*ints, 5, *other, 0, 3);
+	EXPECT_EQ(other->getPrimitive<int32_t>(0), 3);
+	EXPECT_EQ(other->getPrimitive<int32_t>(2), 7);
+
+	EXPECT_THROW(Array::copy(*ints, 6, *other, 0, 3), ArrayIndexOutOfBoundsException);
+	EXPECT_THROW(Array::copy(*ints, 0, *other, -1, 1), ArrayIndexOutOfBoundsException);
+	EXPECT_THROW(Array::copy(*ints, 0, *Array::make(classloader.getOrLoad("long"), 8), 0, 1), ArrayStoreException);
+
+	// rows are copied by reference, both arrays share them afterwards
+	auto matrix = Array::make(classloader.getOrLoad("int"), {2, 3});
+	auto shared = Array::make(classloader.getOrLoad("int"), {3, 3});
+	Array::copy(*matrix, 0, *shared, 1, 2);
+	EXPECT_EQ(shared->getArray(1), matrix->getArray(0));
+	EXPECT_EQ(shared->getArray(2), matrix->getArray(1));
+	matrix->getArray(1)->setPrimitive<int32_t>(2, 42);
+	EXPECT_EQ(shared->getArray(2)->getPrimitive<int32_t>(2), 42);
+	EXPECT_EQ(shared->getElement({2, 2})->getValue(), 42);
+	EXPECT_THROW(Array::copy(*matrix, 0, *Array::make(classloader.getOrLoad("long"), {2, 3}), 0, 1), ArrayStoreException);
+
+	// rows of any array type can be stored in an Object[]
+	java::lang::String(classloader);
+	auto objects = Array::make(classloader.getOrLoad("java.lang.Object"), 3);
+	Array::copy(*matrix, 0, *objects, 1, 2);
+	EXPECT_TRUE(objects->getElement(0)->isNull());
+	EXPECT_EQ(objects->getElement(1), matrix->getArray(0));
+	EXPECT_EQ(objects->getElement(2), matrix->getArray(1));
+	auto strings = Array::make(classloader.getOrLoad("java.lang.String"), {2, 2});
+	Array::copy(*strings, 0, *objects, 0, 2);
+	EXPECT_EQ(objects->getElement(0), strings->getArray(0));
+	EXPECT_THROW(Array::copy(*ints, 0, *objects, 0, 1), ArrayStoreException);
+}
+
+TEST(object, fieldSlots) {
+	ClassLoader classloader;
+	java::lang::String(classloader);
+	ClassBuilder builder(classloader, "com.example", "com.example.Point");
+	builder.addField("x", "I", false);
+	builder.addField("y", "J", false);
+	builder.addField("label", "Ljava/lang/String;", false);
+	builder.addField("count", "I", true);
+	builder.finalize();
+	auto& clazz = classloader.getOrLoad("com.example.Point");
+
+	// static fields do not take an instance slot
+	EXPECT_EQ(clazz.getInstanceFieldCount(), 3u);
+	ASSERT_EQ(clazz.getReferenceSlots().size(), 1u);
+	EXPECT_EQ(clazz.getReferenceSlots()[0], clazz.getField("label").getSlot());
+	EXPECT_EQ(clazz.findInstanceField("count"), nullptr);
+
+	auto obj = Object::make(clazz);
+	const auto x = clazz.getField("x").getSlot();
+	const auto y = clazz.getField("y").getSlot();
+	const auto label = clazz.getField("label").getSlot();
+	EXPECT_EQ(obj->getFieldValue(x), 0u);
+	EXPECT_EQ(obj->getFieldValue(y), 0u);
+	EXPECT_TRUE(obj->getFieldObject(label)->isNull());
+
+	obj->setFieldValue(x, static_cast<uint64_t>(-5));
+	obj->setFieldValue(y, 0x123456789abcdefull);
+	obj->setFieldObject(label, Object::make(classloader, "origin"));
+	EXPECT_EQ(static_cast<int32_t>(obj->getFieldValue(x)), -5);
+	EXPECT_EQ(obj->getField("y")->getLongValue(), 0x123456789abcdefll);
+	EXPECT_EQ(obj->getField("label")->str(), "origin");
+
+	// name based access writes the same slots
+	obj->setField("x", Object::make(7));
+	EXPECT_EQ(obj->getFieldValue(x), 7u);
+	EXPECT_THROW(obj->getFieldValue(3), std::out_of_range);
+}
+
+TEST(object, concurrentLink) {
+	ClassLoader classloader;
+	java::lang::String(classloader);
+	ClassBuilder base(classloader, "com.example", "com.example.Base");
+	for (int i = 0; i < 32; ++i) {
+		base.addField(fmt::format("f{}", i), "I", false);
+	}
+	base.finalize();
+	ClassBuilder derived(classloader, "com.example", "com.example.Derived");
+	derived.setSuperClass("com.example.Base");
+	derived.addField("label", "Ljava/lang/String;", false);
+	derived.finalize();
+	auto& clazz = classloader.getOrLoad("com.example.Derived");
+
+	// every thread sees the complete layout, whichever links the class
+	std::atomic<bool> start = false;
+	std::vector<std::thread> threads;
+	std::vector<uint32_t> counts(8);
+	for (size_t i = 0; i < counts.size(); ++i) {
+		threads.emplace_back([&, i]() {
+			while (!start) {
+			}
+			counts[i] = clazz.getInstanceFieldCount();
+		});
+	}
+	start = true;
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	for (auto count : counts) {
+		EXPECT_EQ(count, 33u);
+	}
+	EXPECT_EQ(clazz.getReferenceSlots().size(), 1u);
+}
+
+TEST(object, vtable) {
+	ClassLoader classloader;
+	auto noop = [](Frame&, std::vector<ObjectRef>&) {};
+	ClassBuilder task(classloader, "com.example", "com.example.Task");
+	task.setInterface();
+	task.addVirtualMethod("run", "()V", ACC_PUBLIC | ACC_ABSTRACT, noop);
+	task.finalize();
+	ClassBuilder base(classloader, "com.example", "com.example.Base");
+	base.addVirtualMethod("a", "()V", ACC_PUBLIC, noop);
+	base.addVirtualMethod("b", "()V", ACC_PUBLIC, noop);
+	base.addMethod("<init>", "()V", ACC_PUBLIC | ACC_CONSTRUCTOR, noop);
+	base.finalize();
+	ClassBuilder derived(classloader, "com.example", "com.example.Derived");
+	derived.setSuperClass("com.example.Base");
+	derived.addInterface("com.example.Task");
+	derived.addVirtualMethod("b", "()V", ACC_PUBLIC, noop);
+	derived.addVirtualMethod("c", "()V", ACC_PUBLIC, noop);
+	derived.addVirtualMethod("run", "()V", ACC_PUBLIC, noop);
+	derived.finalize();
+	auto& baseClass = classloader.getOrLoad("com.example.Base");
+	auto& derivedClass = classloader.getOrLoad("com.example.Derived");
+	auto& taskClass = classloader.getOrLoad("com.example.Task");
+
+	// exception free lookups
+	EXPECT_EQ(derivedClass.findMethod("a", "()V"), nullptr);
+	EXPECT_EQ(derivedClass.findVirtualMethod("a", "()V"), &baseClass.getMethod("a", "()V"));
+	EXPECT_EQ(derivedClass.findVirtualMethod("<init>", "()V"), nullptr);
+	EXPECT_EQ(derivedClass.findVirtualMethod("missing", "()V"), nullptr);
+
+	// an override keeps the vtable index of the overridden method
+	auto& baseB = baseClass.getMethod("b", "()V");
+	auto& derivedB = derivedClass.getMethod("b", "()V");
+	EXPECT_EQ(baseB.getVtableIndex(), derivedB.getVtableIndex());
+	EXPECT_EQ(derivedClass.getVirtualMethod(baseB.getVtableIndex()), &derivedB);
+	EXPECT_EQ(baseClass.getVirtualMethod(baseB.getVtableIndex()), &baseB);
+	EXPECT_EQ(baseClass.getVirtualMethod(derivedClass.getMethod("c", "()V").getVtableIndex()), nullptr);
+	EXPECT_EQ(derivedClass.getVirtualMethod(Method::NO_VTABLE_INDEX), nullptr);
+
+	// interface methods are dispatched through the itable
+	auto* run = taskClass.findInterfaceMethod("run", "()V");
+	ASSERT_NE(run, nullptr);
+	EXPECT_EQ(derivedClass.getInterfaceMethod(taskClass, run->getVtableIndex()), &derivedClass.getMethod("run", "()V"));
+	EXPECT_EQ(baseClass.getInterfaceMethod(taskClass, run->getVtableIndex()), nullptr);
+
+	// default and miranda methods get a vtable slot in the class that does not implement them
+	ClassBuilder named(classloader, "com.example", "com.example.Named");
+	named.setInterface();
+	named.addVirtualMethod("name", "()V", ACC_PUBLIC, noop);
+	named.addVirtualMethod("size", "()V", ACC_PUBLIC | ACC_ABSTRACT, noop);
+	named.finalize();
+	ClassBuilder partial(classloader, "com.example", "com.example.Partial");
+	partial.setSuperClass("com.example.Base");
+	partial.addInterface("com.example.Named");
+	partial.finalize();
+	ClassBuilder full(classloader, "com.example", "com.example.Full");
+	full.setSuperClass("com.example.Partial");
+	full.addVirtualMethod("size", "()V", ACC_PUBLIC, noop);
+	full.finalize();
+	auto& namedClass = classloader.getOrLoad("com.example.Named");
+	auto& partialClass = classloader.getOrLoad("com.example.Partial");
+	auto& fullClass = classloader.getOrLoad("com.example.Full");
+	auto& name = namedClass.getMethod("name", "()V");
+	auto& size = namedClass.getMethod("size", "()V");
+	EXPECT_EQ(partialClass.findVirtualMethod("name", "()V"), &name);
+	EXPECT_EQ(partialClass.findVirtualMethod("size", "()V"), &size);
+	EXPECT_EQ(fullClass.findVirtualMethod("name", "()V"), &name);
+	// the override takes the miranda slot, the interface method keeps its interface index
+	auto& fullSize = fullClass.getMethod("size", "()V");
+	EXPECT_EQ(fullClass.findVirtualMethod("size", "()V"), &fullSize);
+	EXPECT_EQ(partialClass.getVirtualMethod(fullSize.getVtableIndex()), &size);
+	EXPECT_EQ(fullClass.getVirtualMethod(fullSize.getVtableIndex()), &fullSize);
+	EXPECT_EQ(partialClass.getInterfaceMethod(namedClass, size.getVtableIndex()), nullptr);
+	EXPECT_EQ(fullClass.getInterfaceMethod(namedClass, size.getVtableIndex()), &fullSize);
+	EXPECT_EQ(fullClass.getInterfaceMethod(namedClass, name.getVtableIndex()), &name);
+}
+
+TEST(object, tryRange) {
+	ClassLoader classloader;
+	ClassBuilder builder(classloader, "com.example", "com.example.Guarded");
+	builder.addMethod("run", "()V", ACC_PUBLIC | ACC_STATIC, [](Frame&, std::vector<ObjectRef>&) {});
+	// added out of order, code units [2, 5) and [8, 10)
+	builder.addTryRange("run", "()V", 8, 10, 0x20);
+	builder.addTryRange("run", "()V", 2, 5, 0x10);
+	builder.finalize();
+	auto& method = classloader.getOrLoad("com.example.Guarded").getMethod("run", "()V");
+
+	// the pc is a byte offset, the ranges are in code units: start is inclusive, end is exclusive
+	EXPECT_EQ(method.findTryRange(0), nullptr);
+	EXPECT_EQ(method.findTryRange(3), nullptr);
+	ASSERT_NE(method.findTryRange(4), nullptr);
+	EXPECT_EQ(method.findTryRange(4)->catchAll, 0x10u);
+	EXPECT_EQ(method.findTryRange(9), method.findTryRange(4));
+	EXPECT_EQ(method.findTryRange(10), nullptr);
+	EXPECT_EQ(method.findTryRange(15), nullptr);
+	ASSERT_NE(method.findTryRange(16), nullptr);
+	EXPECT_EQ(method.findTryRange(16)->catchAll, 0x20u);
+	EXPECT_EQ(method.findTryRange(19), method.findTryRange(16));
+	EXPECT_EQ(method.findTryRange(20), nullptr);
+	EXPECT_EQ(method.findTryRange(0xffff), nullptr);
+}
+
+TEST(object, inlineCache) {
+	ClassLoader classloader;
+	auto noop = [](Frame&, std::vector<ObjectRef>&) {};
+	std::vector<Class*> receivers;
+	for (uint32_t i = 0; i <= InlineCache::SIZE; ++i) {
+		ClassBuilder builder(classloader, "com.example", fmt::format("com.example.Shape{}", i));
+		builder.addVirtualMethod("area", "()I", ACC_PUBLIC, noop);
+		builder.finalize();
+		receivers.push_back(&classloader.getOrLoad(fmt::format("com.example.Shape{}", i)));
+	}
+	auto target = [&](uint32_t i_) {
+		return &receivers[i_]->getMethod("area", "()I");
+	};
+
+	InlineCache cache;
+	EXPECT_EQ(cache.lookup(receivers[0]), nullptr);
+	cache.record(receivers[0], target(0));
+	EXPECT_EQ(cache.lookup(receivers[0]), target(0));
+	EXPECT_EQ(cache.size(), 1u);
+	// recording the same receiver again keeps the site monomorphic
+	cache.record(receivers[0], target(0));
+	EXPECT_EQ(cache.size(), 1u);
+
+	for (uint32_t i = 1; i <= InlineCache::SIZE; ++i) {
+		EXPECT_EQ(cache.lookup(receivers[i]), nullptr);
+		cache.record(receivers[i], target(i));
+	}
+	EXPECT_EQ(cache.size(), InlineCache::SIZE);
+	EXPECT_TRUE(cache.isMegamorphic());
+	EXPECT_EQ(cache.lookup(receivers[InlineCache::SIZE]), nullptr);
+	EXPECT_EQ(cache.lookup(receivers[InlineCache::SIZE - 1]), target(InlineCache::SIZE - 1));
+#ifndef __strip_cache_stats__
+	EXPECT_EQ(cache.hits(), 2u);
+	EXPECT_EQ(cache.misses(), 2u + InlineCache::SIZE);
+#else
+	EXPECT_EQ(cache.hits(), 0u);
+	EXPECT_EQ(cache.misses(), 0u);
+#endif
+}
+
+TEST(object, symbolCache) {
+	SymbolCache<std::string> cache;
+	cache.assign(2);
+	EXPECT_EQ(cache.size(), 2u);
+	EXPECT_EQ(cache.get(0), nullptr);
+
+	// threads decoding the same id concurrently all get the value published first
+	std::vector<const std::string*> published(8);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < published.size(); ++i) {
+		threads.emplace_back([&cache, &published, i]() { published[i] = &cache.publish(1, fmt::format("value{}", i)); });
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	for (const auto* value : published) {
+		EXPECT_EQ(value, cache.get(1));
+	}
+	EXPECT_EQ(cache.get(0), nullptr);
+}
+
 TEST(object, lock) {
 	logger.setLevel(Logger::LogLevel::DEBUG);
 	auto obj = std::make_shared<Object>();
@@ -216,6 +582,48 @@ TEST(object, lock) {
 	writer.join();
 }
 
+TEST(object, thinLock) {
+	auto obj = std::make_shared<Object>();
+
+	// uncontended and recursive locking stays thin
+	obj->monitorEnter();
+	obj->monitorEnter();
+	EXPECT_FALSE(obj->isLockInflated());
+	obj->monitorExit();
+	obj->monitorExit();
+	EXPECT_FALSE(obj->isLockInflated());
+	EXPECT_THROW(obj->monitorExit(), std::runtime_error);
+	obj->notifyAll();
+	EXPECT_FALSE(obj->isLockInflated());
+
+	// contention inflates the lock, recursion count of the owner is kept
+	obj->monitorEnter();
+	obj->monitorEnter();
+	std::atomic<bool> acquired = false;
+	std::thread contender([obj, &acquired]() {
+		obj->monitorEnter();
+		acquired = true;
+		obj->monitorExit();
+	});
+	while (!obj->isLockInflated()) {
+		std::this_thread::yield();
+	}
+	obj->monitorExit();
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_FALSE(acquired);
+	obj->monitorExit();
+	contender.join();
+	EXPECT_TRUE(acquired);
+
+	// wait inflates the lock
+	auto other = std::make_shared<Object>();
+	other->monitorEnter();
+	EXPECT_FALSE(other->isLockInflated());
+	other->wait(1);
+	EXPECT_TRUE(other->isLockInflated());
+	other->monitorExit();
+}
+
 TEST(object, wait_notify) {
 	logger.setLevel(Logger::LogLevel::DEBUG);
 	auto obj = std::make_shared<Object>();
@@ -309,4 +717,129 @@ TEST(object, atomic) {
 	}
 	for (auto& th : threads) th.join();
 	EXPECT_EQ(concurrent->getLongValue(), static_cast<int64_t>(nthreads) * iters);
-}
\ No newline at end of file
+}
+TEST(object, classInitialization) {
+	ClassLoader classloader;
+	ClassBuilder(classloader, "test", "test.Init").finalize();
+	ClassBuilder(classloader, "test", "test.Broken").finalize();
+	auto& cls = classloader.getOrLoad("test.Init");
+	EXPECT_FALSE(cls.isStaticInitialized());
+
+	EXPECT_TRUE(cls.beginInitialization());
+	EXPECT_EQ(cls.getInitState(), Class::InitState::IN_PROGRESS);
+	// recursive request of the initializing thread
+	EXPECT_FALSE(cls.beginInitialization());
+
+	// another thread waits for the end of the initialization
+	std::atomic<bool> waited = false;
+	std::thread other([&]() {
+		EXPECT_FALSE(cls.beginInitialization());
+		EXPECT_TRUE(cls.isStaticInitialized());
+		waited = true;
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_FALSE(waited);
+	cls.endInitialization(true);
+	other.join();
+	EXPECT_TRUE(waited);
+	EXPECT_FALSE(cls.beginInitialization());
+
+	auto& broken = classloader.getOrLoad("test.Broken");
+	EXPECT_TRUE(broken.beginInitialization());
+	broken.endInitialization(false);
+	EXPECT_EQ(broken.getInitState(), Class::InitState::ERRONEOUS);
+	EXPECT_THROW(broken.beginInitialization(), NoClassDefFoundError);
+}
+
+TEST(object, classObject) {
+	ClassLoader classloader;
+	ClassBuilder(classloader, "test", "test.Natives").finalize();
+	auto& cls = classloader.getOrLoad("test.Natives");
+	// the jclass of the static native calls is created once, and kept alive by the class
+	auto* obj = cls.getClassObject();
+	EXPECT_EQ(cls.getClassObject(), obj);
+	EXPECT_EQ(&obj->getClass(), &cls);
+	bool visited = false;
+	cls.visitReferences([&](Object* ref_) { visited |= ref_ == obj; });
+	EXPECT_TRUE(visited);
+}
+
+TEST(object, frameStack) {
+	Vm vm;
+	auto& classloader = vm.getClassLoader();
+	java::lang::String(classloader);
+	ClassBuilder thread(classloader, "java.lang", "java.lang.Thread");
+	thread.addField("name", "Ljava/lang/String;", false);
+	thread.addField("priority", "I", false);
+	thread.addField("eetop", "J", false);
+	thread.finalize();
+	ClassBuilder builder(classloader, "test", "test.Recursive");
+	builder.addMethod("recurse", "()V", ACC_PUBLIC | ACC_STATIC, [](Frame&, std::vector<ObjectRef>&) {});
+	builder.finalize();
+	auto& method = classloader.getOrLoad("test.Recursive").getMethod("recurse", "()V");
+
+	// room for 4 frames
+	const auto frameSize = Frame::getFrameSize(method.getNbRegisters());
+	vm.setStackSize(4 * frameSize + frameSize / 2);
+	auto rt = vm.newThread("stack");
+	EXPECT_TRUE(rt->end());
+
+	// frames are laid out one after the other in the thread stack
+	auto& first = rt->newFrame(method);
+	auto& second = rt->newFrame(method);
+	EXPECT_EQ(first.getCaller(), nullptr);
+	EXPECT_EQ(second.getCaller(), &first);
+	EXPECT_EQ(static_cast<size_t>(reinterpret_cast<std::byte*>(&second) - reinterpret_cast<std::byte*>(&first)), frameSize);
+	rt->newFrame(method);
+	rt->newFrame(method);
+	EXPECT_THROW(rt->newFrame(method), StackOverflowError);
+	EXPECT_EQ(rt->stackDepth(), 4u);
+
+	// popping moves the top of the stack back, the slot is reused by the next frame
+	rt->popFrame();
+	rt->popFrame();
+	EXPECT_EQ(&rt->currentFrame(), &second);
+	rt->popFrame();
+	EXPECT_EQ(&rt->newFrame(method), &second);
+	rt->popFrame();
+	rt->popFrame();
+	EXPECT_TRUE(rt->end());
+	EXPECT_EQ(rt->stackDepth(), 0u);
+}
+
+TEST(object, localReferences) {
+	Vm vm;
+	auto& classloader = vm.getClassLoader();
+	java::lang::String(classloader);
+	ClassBuilder thread(classloader, "java.lang", "java.lang.Thread");
+	thread.addField("name", "Ljava/lang/String;", false);
+	thread.addField("priority", "I", false);
+	thread.addField("eetop", "J", false);
+	thread.finalize();
+	auto rt = vm.newThread("native");
+	auto isRoot = [&rt](Object* obj_) {
+		bool found = false;
+		rt->visitReferences([&](Object* ref_) { found |= ref_ == obj_; });
+		return found;
+	};
+
+	// objects held by a native call are roots until its local reference frame is closed
+	auto outer = rt->pushLocalFrame();
+	auto* boxed = rt->addLocalRef(Object::make(42));
+	auto inner = rt->pushLocalFrame();
+	auto* created = rt->addLocalRef(Object::make(7));
+	EXPECT_TRUE(isRoot(boxed));
+	EXPECT_TRUE(isRoot(created));
+	rt->popLocalFrame(inner);
+	EXPECT_TRUE(isRoot(boxed));
+	EXPECT_FALSE(isRoot(created));
+	rt->popLocalFrame(outer);
+	EXPECT_FALSE(isRoot(boxed));
+
+	// a throwable raised by a native call is a root until it is delivered
+	auto* pending = Object::make(13);
+	rt->setPendingException(pending);
+	EXPECT_TRUE(isRoot(pending));
+	rt->setPendingException(nullptr);
+	EXPECT_FALSE(isRoot(pending));
+}
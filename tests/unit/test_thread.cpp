@@ -21,8 +21,15 @@
 
 #include <chrono>
 #include <atomic>
+#include <memory>
 #include <thread>
+#include <class.hpp>
+#include <classbuilder.hpp>
+#include <classloader.hpp>
+#include <interpreter.hpp>
+#include <jthread.hpp>
 #include <system/thread.hpp>
+#include <vm.hpp>
 
 using namespace sandvik;
 
@@ -212,3 +219,82 @@ TEST(Thread, restartAfterStop) {
 	thread.join();
 	EXPECT_FALSE(thread.isRunning());
 }
+
+class HookThread : public Thread {
+	public:
+		HookThread(const std::string& name) : Thread(name) {}
+
+		std::thread::id enterId;
+		std::thread::id exitId;
+		Thread::ThreadState exitState = Thread::ThreadState::NotStarted;
+
+	protected:
+		void onEnter() override {
+			enterId = std::this_thread::get_id();
+		}
+
+		void onExit() override {
+			exitId = std::this_thread::get_id();
+			exitState = getState();
+		}
+
+		void loop() override {
+			_loops++;
+		}
+
+		bool done() override {
+			return _loops >= 3;
+		}
+
+	private:
+		int _loops = 0;
+};
+
+TEST(Thread, enterExitHooks) {
+	HookThread thread("HookThread");
+	thread.run(true);
+	// both hooks run on the thread itself, the exit hook before the thread is seen as stopped
+	EXPECT_NE(thread.enterId, std::thread::id());
+	EXPECT_NE(thread.enterId, std::this_thread::get_id());
+	EXPECT_EQ(thread.enterId, thread.exitId);
+	EXPECT_EQ(Thread::ThreadState::Running, thread.exitState);
+	EXPECT_EQ(Thread::ThreadState::Stopped, thread.getState());
+}
+
+TEST(Thread, vmReapThreads) {
+	Vm vm;
+	auto& classloader = vm.getClassLoader();
+	ClassBuilder(classloader, "java.lang", "java.lang.String").finalize();
+	ClassBuilder builder(classloader, "java.lang", "java.lang.Thread");
+	builder.addField("name", "Ljava/lang/String;", false);
+	builder.addField("priority", "I", false);
+	builder.addField("eetop", "J", false);
+	builder.finalize();
+
+	uint64_t firstId = 0;
+	uint64_t secondId = 0;
+	std::weak_ptr<JThread> released;
+	{
+		auto first = vm.newThread("first");
+		auto second = vm.newThread("second");
+		firstId = first->getThreadId();
+		secondId = second->getThreadId();
+		released = first;
+		// no frame to run, the threads finish right away
+		first->run(true);
+		second->run(true);
+		EXPECT_EQ(Thread::ThreadState::Stopped, first->getState());
+		EXPECT_EQ(Thread::ThreadState::Stopped, second->getState());
+		EXPECT_EQ(vm.getThread(firstId), first);
+	}
+	// terminated threads stay registered until the next thread creation reclaims them
+	EXPECT_NE(vm.getThread(firstId), nullptr);
+	auto third = vm.newThread("third");
+	EXPECT_EQ(vm.getThread(firstId), nullptr);
+	EXPECT_EQ(vm.getThread(secondId), nullptr);
+	EXPECT_TRUE(released.expired());
+	// a thread not started yet is kept
+	EXPECT_EQ(vm.getThread(third->getThreadId()), third);
+	vm.newThread("fourth");
+	EXPECT_EQ(vm.getThread(third->getThreadId()), third);
+}